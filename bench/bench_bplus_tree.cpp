@@ -0,0 +1,89 @@
+// BPlusTree с разной арностью против BinaryTree: вставка, поиск и подсчет
+// ключей в диапазоне. Ключи вставляются в случайном порядке.
+#include <cstdio>
+
+#include "bench_common.h"
+#include "../src/core/internal/binary_tree/binary_tree.h"
+#include "../src/core/internal/bplus_tree/bplus_tree.h"
+
+namespace
+{
+constexpr int kRangeSpan = 200;     // 100 ключей: четные ключи идут через один
+
+void printRow(const char* name, int size, double insertNs, double findNs, double rangeNs, int height)
+{
+    std::printf("%10d %-14s %11.1f %11.1f %11.1f %7d\n", size, name, insertNs, findNs, rangeNs, height);
+}
+}
+
+void runBPlusTreeBench(const BenchOptions& options)
+{
+    benchSection("bplus: BPlusTree fanouts vs BinaryTree (ns per operation)");
+    std::printf("%10s %-14s %11s %11s %11s %7s\n", "keys", "structure", "insert", "find", "range 100", "height");
+
+    const int lookupCount = options.quick ? 1 << 14 : 1 << 20;
+    const int rangeCount = lookupCount / 16;
+
+    for (int size : benchSizes(options, {1 << 14, 1 << 17, 1 << 20}, {1 << 22})) {
+        const std::vector<int> keys = benchShuffledKeys(size, 1);
+        const std::vector<int> lookups = benchLookupKeys(keys, lookupCount, 2);
+        const std::vector<int> rangeStarts = benchLookupKeys(keys, rangeCount, 3);
+
+        {
+            // Рост RSS - за все прогоны вставки: clear отдает узлы malloc,
+            // и следующий прогон берет ту же память
+            const std::int64_t rssBefore = benchResidentBytes();
+            BinaryTree tree;
+            const double insertNs = benchNsPerOp(options, size, [&]() { tree.clear(); }, [&]() {
+                for (int key : keys) {
+                    tree.insert(key);
+                }
+            });
+            const std::int64_t rssAfter = benchResidentBytes();
+            const double findNs = benchNsPerOp(options, lookupCount, [&]() {
+                std::uintptr_t found = 0;
+                for (int key : lookups) {
+                    found += std::uintptr_t(tree.find(key));
+                }
+                benchConsume(found);
+            });
+            const double rangeNs = benchNsPerOp(options, rangeCount, [&]() {
+                std::uintptr_t total = 0;
+                for (int low : rangeStarts) {
+                    total += std::uintptr_t(tree.countRange(low, low + kRangeSpan - 1));
+                }
+                benchConsume(total);
+            });
+            printRow("BinaryTree", size, insertNs, findNs, rangeNs, tree.height());
+            benchPrintCounters(options, "BinaryTree", size, tree.statistics());
+            benchPrintMemory(options, "BinaryTree", tree, rssBefore, rssAfter);
+        }
+
+        for (int fanout : {4, 16, 64, 256}) {
+            BPlusTree tree(fanout);
+            const double insertNs = benchNsPerOp(options, size, [&]() { tree.clear(); }, [&]() {
+                for (int key : keys) {
+                    tree.insert(key);
+                }
+            });
+            const double findNs = benchNsPerOp(options, lookupCount, [&]() {
+                std::uintptr_t found = 0;
+                for (int key : lookups) {
+                    found += tree.contains(key);
+                }
+                benchConsume(found);
+            });
+            const double rangeNs = benchNsPerOp(options, rangeCount, [&]() {
+                std::uintptr_t total = 0;
+                for (int low : rangeStarts) {
+                    total += std::uintptr_t(tree.countRange(low, low + kRangeSpan - 1));
+                }
+                benchConsume(total);
+            });
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "B+ fanout %d", fanout);
+            printRow(name, size, insertNs, findNs, rangeNs, tree.height());
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#include "bench_common.h"
+
+#include <QJsonDocument>
+#include <QStringList>
+
+#include <cstdio>
+#include <random>
+
+#include "../src/core/internal/binary_tree/binary_tree.h"
+#include "../src/core/utils/memory_report.h"
+
+namespace
+{
+volatile std::uintptr_t g_sink = 0;
+}
+
+void benchConsume(std::uintptr_t value)
+{
+    g_sink = g_sink + value;
+}
+
+std::vector<int> benchShuffledKeys(int count, std::uint32_t seed)
+{
+    std::vector<int> keys(std::size_t(std::max(0, count)));
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = int(2 * i);
+    }
+
+    std::mt19937 random(seed);
+    std::shuffle(keys.begin(), keys.end(), random);
+    return keys;
+}
+
+std::vector<int> benchLookupKeys(const std::vector<int>& keys, int count, std::uint32_t seed)
+{
+    std::vector<int> lookups;
+    if (keys.empty()) return lookups;
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<std::size_t> pick(0, keys.size() - 1);
+    lookups.reserve(std::size_t(std::max(0, count)));
+    for (int i = 0; i < count; ++i) {
+        const int key = keys[pick(random)];
+        lookups.push_back((i & 1) ? key + 1 : key);
+    }
+    return lookups;
+}
+
+std::vector<int> benchSizes(const BenchOptions& options, std::vector<int> regular, std::vector<int> large)
+{
+    if (options.quick) {
+        regular.resize(std::min<std::size_t>(regular.size(), 1));
+        return regular;
+    }
+    if (options.large) {
+        regular.insert(regular.end(), large.begin(), large.end());
+    }
+    return regular;
+}
+
+void benchSection(const char* title)
+{
+    std::printf("\n== %s\n", title);
+}
+
+void benchPrintCounters(const BenchOptions& options, const char* label, int size,
+                        const OperationStatistics& statistics)
+{
+    if (!options.counters) return;
+
+    std::printf("  counters: %s, %d keys\n", label, size);
+    std::printf("    operation,%s\n", qPrintable(OperationCounters::csvHeader()));
+    for (int i = 0; i < OperationStatistics::kOperationKinds; ++i) {
+        const TreeOperation operation = TreeOperation(i);
+        const OperationCounters& total = statistics.total(operation);
+        if (total.operations == 0) continue;
+
+        std::printf("    %s,%s\n", qPrintable(treeOperationName(operation)), qPrintable(total.toCsvRow()));
+    }
+    std::printf("    total,%s\n", qPrintable(statistics.total().toCsvRow()));
+}
+
+std::int64_t benchResidentBytes()
+{
+    return MemoryReport::residentSetBytes();
+}
+
+void benchPrintMemory(const BenchOptions& options, const char* label, const BinaryTree& tree,
+                      std::int64_t rssBefore, std::int64_t rssAfter)
+{
+    if (!options.memory) return;
+
+    MemoryReport report;
+    report.setElementCount(tree.size());
+    tree.appendMemoryUsage(report);
+    if (rssBefore >= 0 && rssAfter >= 0) {
+        report.setRssDelta(rssAfter - rssBefore);
+    }
+
+    std::printf("  memory: %s\n", label);
+    for (const QString& line : report.toText().split('\n')) {
+        std::printf("    %s\n", qPrintable(line));
+    }
+    std::printf("    json: %s\n", QJsonDocument(report.toJson()).toJson(QJsonDocument::Compact).constData());
+}
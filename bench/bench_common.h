@@ -0,0 +1,88 @@
+// bench/bench_common.h
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Общее для сценариев dsat_bench: замер на std::chrono, наборы ключей
+// и размеров. Каждый сценарий печатает свою таблицу в stdout.
+
+class BinaryTree;
+class OperationStatistics;
+
+struct BenchOptions
+{
+    bool quick = false;     // Только малые размеры: проверить, что сценарии идут
+    bool large = false;     // Добавить размеры в миллионы ключей
+    bool counters = false;  // Под строками таблиц - счетчики работы BinaryTree
+    bool memory = false;    // Под строками таблиц - память BinaryTree по категориям
+    int repeats = 3;        // Из прогонов берется лучший
+};
+
+// Лучшее из options.repeats время run(), в наносекундах на одну из operations операций.
+// prepare() вызывается перед каждым прогоном и в замер не входит
+template <typename Prepare, typename Run>
+double benchNsPerOp(const BenchOptions& options, std::int64_t operations, Prepare&& prepare, Run&& run)
+{
+    double best = 0.0;
+    for (int i = 0; i < std::max(1, options.repeats); ++i) {
+        prepare();
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        const double perOp = elapsed.count() / double(std::max<std::int64_t>(1, operations));
+        if (i == 0 || perOp < best) best = perOp;
+    }
+    return best;
+}
+
+template <typename Run>
+double benchNsPerOp(const BenchOptions& options, std::int64_t operations, Run&& run)
+{
+    return benchNsPerOp(options, operations, []() {}, run);
+}
+
+// Результат замеряемой работы: без него компилятор вправе ее выбросить
+void benchConsume(std::uintptr_t value);
+
+// Четные ключи 0, 2, ..., 2 * (count - 1) в случайном порядке:
+// нечетные заведомо промахиваются
+std::vector<int> benchShuffledKeys(int count, std::uint32_t seed);
+// count запросов: половина - ключи из keys, половина - промахи
+std::vector<int> benchLookupKeys(const std::vector<int>& keys, int count, std::uint32_t seed);
+
+// Размеры структур для сценария: quick - только первый, large - еще и крупные
+std::vector<int> benchSizes(const BenchOptions& options, std::vector<int> regular,
+                            std::vector<int> large = {});
+
+void benchSection(const char* title);
+
+// С --counters печатает OperationStatistics дерева: строка CSV на каждый вид
+// операций, который встречался, и итог. Суммы за все прогоны сценария,
+// поэтому рядом всегда стоит число операций
+void benchPrintCounters(const BenchOptions& options, const char* label, int size,
+                        const OperationStatistics& statistics);
+
+// Резидентная память процесса в байтах, -1 - неизвестно
+std::int64_t benchResidentBytes();
+// С --memory печатает MemoryReport дерева: байты на узел по категориям и
+// рост RSS за построение (замеры benchResidentBytes до и после), затем он же в JSON.
+// Память, освобожденная прошлыми размерами, остается у malloc и идет в дело
+// снова, поэтому рост RSS бывает меньше учтенного
+void benchPrintMemory(const BenchOptions& options, const char* label, const BinaryTree& tree,
+                      std::int64_t rssBefore, std::int64_t rssAfter);
+
+// Сценарии (bench_*.cpp)
+void runFrozenIndexBench(const BenchOptions& options);
+void runFindBatchBench(const BenchOptions& options);
+void runBPlusTreeBench(const BenchOptions& options);
+void runSplayBench(const BenchOptions& options);
+void runDaryHeapBench(const BenchOptions& options);
+void runRobinHoodBench(const BenchOptions& options);
+void runTreeJoinBench(const BenchOptions& options);
+
+#endif // BENCH_COMMON_H
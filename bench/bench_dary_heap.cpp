@@ -0,0 +1,175 @@
+// DaryHeap с арностью 2, 4 и 8 против std::priority_queue: push, pop и
+// decreaseKey. У std::priority_queue нет decreaseKey, поэтому для нее
+// берется обычная замена из алгоритма Дейкстры: новая запись с меньшим
+// приоритетом, а устаревшие пропускаются при извлечении.
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <random>
+
+#include "bench_common.h"
+#include "../src/core/internal/heap/dary_heap.h"
+
+namespace
+{
+struct HeapTimes
+{
+    double pushNs = 0.0;
+    double popNs = 0.0;
+    double decreaseNs = 0.0;
+    double drainNs = 0.0;   // Извлечение всего после decreaseKey, на элемент
+};
+
+struct Decrease
+{
+    int element;
+    int delta;
+};
+
+std::vector<Decrease> randomDecreases(int size, int count, std::uint32_t seed)
+{
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> element(0, size - 1);
+    std::uniform_int_distribution<int> delta(1, 1 << 16);
+
+    std::vector<Decrease> decreases(std::size_t(std::max(0, count)));
+    for (Decrease& decrease : decreases) {
+        decrease = {element(random), delta(random)};
+    }
+    return decreases;
+}
+
+HeapTimes measureDaryHeap(const BenchOptions& options, int arity, const std::vector<int>& priorities,
+                          const std::vector<Decrease>& decreases)
+{
+    const int size = int(priorities.size());
+    HeapTimes times;
+    DaryHeap heap(arity);
+    std::vector<DaryHeap::Handle> handles(priorities.size());
+
+    auto fill = [&]() {
+        heap.clear();
+        for (std::size_t i = 0; i < priorities.size(); ++i) {
+            handles[i] = heap.push(priorities[i]);
+        }
+    };
+
+    times.pushNs = benchNsPerOp(options, size, [&]() { heap.clear(); }, [&]() {
+        for (std::size_t i = 0; i < priorities.size(); ++i) {
+            handles[i] = heap.push(priorities[i]);
+        }
+    });
+
+    times.popNs = benchNsPerOp(options, size, fill, [&]() {
+        std::int64_t sum = 0;
+        while (!heap.isEmpty()) {
+            sum += heap.pop();
+        }
+        benchConsume(std::uintptr_t(sum));
+    });
+
+    times.decreaseNs = benchNsPerOp(options, std::int64_t(decreases.size()), fill, [&]() {
+        for (const Decrease& decrease : decreases) {
+            const DaryHeap::Handle handle = handles[std::size_t(decrease.element)];
+            heap.decreaseKey(handle, heap.priority(handle) - decrease.delta);
+        }
+    });
+
+    times.drainNs = benchNsPerOp(options, size, [&]() {
+        fill();
+        for (const Decrease& decrease : decreases) {
+            const DaryHeap::Handle handle = handles[std::size_t(decrease.element)];
+            heap.decreaseKey(handle, heap.priority(handle) - decrease.delta);
+        }
+    }, [&]() {
+        std::int64_t sum = 0;
+        while (!heap.isEmpty()) {
+            sum += heap.pop();
+        }
+        benchConsume(std::uintptr_t(sum));
+    });
+
+    return times;
+}
+
+HeapTimes measurePriorityQueue(const BenchOptions& options, const std::vector<int>& priorities,
+                               const std::vector<Decrease>& decreases)
+{
+    using Entry = std::pair<int, int>;     // Приоритет, номер элемента
+    using Queue = std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>;
+
+    const int size = int(priorities.size());
+    HeapTimes times;
+    Queue queue;
+    std::vector<int> current(priorities.size());
+
+    auto fill = [&]() {
+        queue = Queue();
+        for (std::size_t i = 0; i < priorities.size(); ++i) {
+            current[i] = priorities[i];
+            queue.push({priorities[i], int(i)});
+        }
+    };
+    auto drain = [&]() {
+        std::int64_t sum = 0;
+        while (!queue.empty()) {
+            const Entry top = queue.top();
+            queue.pop();
+            // Устаревшая запись: приоритет элемента с тех пор уменьшили
+            if (top.first != current[std::size_t(top.second)]) continue;
+            sum += top.first;
+        }
+        benchConsume(std::uintptr_t(sum));
+    };
+    auto decrease = [&]() {
+        for (const Decrease& step : decreases) {
+            int& priority = current[std::size_t(step.element)];
+            priority -= step.delta;
+            queue.push({priority, step.element});
+        }
+    };
+
+    times.pushNs = benchNsPerOp(options, size, [&]() { queue = Queue(); }, [&]() {
+        for (std::size_t i = 0; i < priorities.size(); ++i) {
+            current[i] = priorities[i];
+            queue.push({priorities[i], int(i)});
+        }
+    });
+    times.popNs = benchNsPerOp(options, size, fill, drain);
+    times.decreaseNs = benchNsPerOp(options, std::int64_t(decreases.size()), fill, decrease);
+    times.drainNs = benchNsPerOp(options, size, [&]() { fill(); decrease(); }, drain);
+
+    return times;
+}
+
+void printRow(int size, const char* name, const HeapTimes& times)
+{
+    std::printf("%10d %-20s %9.1f %9.1f %10.1f %13.1f\n",
+                size, name, times.pushNs, times.popNs, times.decreaseNs, times.drainNs);
+}
+}
+
+void runDaryHeapBench(const BenchOptions& options)
+{
+    benchSection("heap: DaryHeap arities vs std::priority_queue (ns per operation)");
+    std::printf("%10s %-20s %9s %9s %10s %13s\n", "elements", "structure", "push", "pop", "decrease", "drain after");
+
+    for (int size : benchSizes(options, {1 << 10, 1 << 16, 1 << 20}, {1 << 23})) {
+        std::mt19937 random(1);
+        std::uniform_int_distribution<int> priority(0, 1 << 30);
+        std::vector<int> priorities(static_cast<std::size_t>(size));
+        for (int& value : priorities) {
+            value = priority(random);
+        }
+        // decreaseKey на половине элементов (с повторами), как в плотном графе у Дейкстры
+        const std::vector<Decrease> decreases = randomDecreases(size, size / 2, 2);
+
+        printRow(size, "std::priority_queue", measurePriorityQueue(options, priorities, decreases));
+        for (int arity : {2, 4, 8}) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "DaryHeap d=%d", arity);
+            printRow(size, name, measureDaryHeap(options, arity, priorities, decreases));
+        }
+    }
+}
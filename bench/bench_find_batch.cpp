@@ -0,0 +1,55 @@
+// BinaryTree::findBatch (чередование поисков с предвыборкой) против цикла
+// find по тем же ключам. Пакеты разной длины: короткий пакет не успевает
+// заполнить окно одновременных поисков.
+#include <cstdio>
+#include <span>
+
+#include "bench_common.h"
+#include "../src/core/internal/binary_tree/binary_tree.h"
+
+void runFindBatchBench(const BenchOptions& options)
+{
+    benchSection("batch: BinaryTree::findBatch vs find loop (ns per lookup, half misses)");
+    std::printf("%10s %12s %12s %12s %12s %9s\n",
+                "keys", "find loop", "batch 16", "batch 256", "batch all", "speedup");
+
+    const int lookupCount = options.quick ? 1 << 14 : 1 << 20;
+
+    for (int size : benchSizes(options, {1 << 10, 1 << 14, 1 << 17, 1 << 20}, {1 << 22, 1 << 23})) {
+        const std::vector<int> keys = benchShuffledKeys(size, 1);
+        const std::vector<int> lookups = benchLookupKeys(keys, lookupCount, 2);
+        std::vector<TreeNode*> out(lookups.size());
+
+        const std::int64_t rssBefore = benchResidentBytes();
+        BinaryTree tree;
+        tree.buildFromValues(QVector<int>(keys.begin(), keys.end()));
+        const std::int64_t rssAfter = benchResidentBytes();
+
+        const double loopNs = benchNsPerOp(options, lookupCount, [&]() {
+            for (std::size_t i = 0; i < lookups.size(); ++i) {
+                out[i] = tree.find(lookups[i]);
+            }
+            benchConsume(std::uintptr_t(out.back()));
+        });
+
+        auto batchNs = [&](std::size_t batch) {
+            return benchNsPerOp(options, lookupCount, [&]() {
+                for (std::size_t first = 0; first < lookups.size(); first += batch) {
+                    const std::size_t length = std::min(batch, lookups.size() - first);
+                    tree.findBatch(std::span<const int>(lookups).subspan(first, length),
+                                   std::span<TreeNode*>(out).subspan(first, length));
+                }
+                benchConsume(std::uintptr_t(out.back()));
+            });
+        };
+
+        const double batch16Ns = batchNs(16);
+        const double batch256Ns = batchNs(256);
+        const double batchAllNs = batchNs(lookups.size());
+
+        std::printf("%10d %12.1f %12.1f %12.1f %12.1f %8.2fx\n",
+                    size, loopNs, batch16Ns, batch256Ns, batchAllNs, loopNs / batchAllNs);
+        benchPrintCounters(options, "BinaryTree", size, tree.statistics());
+        benchPrintMemory(options, "BinaryTree", tree, rssBefore, rssAfter);
+    }
+}
@@ -0,0 +1,58 @@
+// Поиск по снимку freeze() (Эйтцингер) против спуска по указателям
+// BinaryTree::find. Дерево строится вставками в случайном порядке,
+// поэтому соседние по пути узлы лежат в памяти где попало.
+#include <cstdio>
+
+#include "bench_common.h"
+#include "../src/core/internal/binary_tree/binary_tree.h"
+
+void runFrozenIndexBench(const BenchOptions& options)
+{
+    benchSection("frozen: FrozenTreeIndex vs BinaryTree::find (ns per lookup, half misses)");
+    std::printf("%10s %12s %12s %12s %9s %11s\n",
+                "keys", "tree find", "frozen find", "lowerBound", "speedup", "freeze ms");
+
+    const int lookupCount = options.quick ? 1 << 14 : 1 << 20;
+
+    for (int size : benchSizes(options, {1 << 10, 1 << 14, 1 << 17, 1 << 20}, {1 << 22, 1 << 23})) {
+        const std::vector<int> keys = benchShuffledKeys(size, 1);
+        const std::vector<int> lookups = benchLookupKeys(keys, lookupCount, 2);
+
+        const std::int64_t rssBefore = benchResidentBytes();
+        BinaryTree tree;
+        tree.buildFromValues(QVector<int>(keys.begin(), keys.end()));
+        const std::int64_t rssAfter = benchResidentBytes();
+
+        FrozenTreeIndex index;
+        const double freezeNs = benchNsPerOp(options, 1, [&]() { index = tree.freeze(); });
+
+        const double treeNs = benchNsPerOp(options, lookupCount, [&]() {
+            std::uintptr_t found = 0;
+            for (int key : lookups) {
+                found += std::uintptr_t(tree.find(key));
+            }
+            benchConsume(found);
+        });
+
+        const double frozenNs = benchNsPerOp(options, lookupCount, [&]() {
+            std::uintptr_t found = 0;
+            for (int key : lookups) {
+                found += std::uintptr_t(index.find(key));
+            }
+            benchConsume(found);
+        });
+
+        const double lowerBoundNs = benchNsPerOp(options, lookupCount, [&]() {
+            std::uintptr_t found = 0;
+            for (int key : lookups) {
+                found += std::uintptr_t(index.lowerBound(key));
+            }
+            benchConsume(found);
+        });
+
+        std::printf("%10d %12.1f %12.1f %12.1f %8.2fx %11.2f\n",
+                    size, treeNs, frozenNs, lowerBoundNs, treeNs / frozenNs, freezeNs / 1e6);
+        benchPrintCounters(options, "BinaryTree", size, tree.statistics());
+        benchPrintMemory(options, "BinaryTree", tree, rssBefore, rssAfter);
+    }
+}
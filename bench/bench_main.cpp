@@ -0,0 +1,81 @@
+// Микробенчмарки основных структур: dsat_bench [--quick] [--large]
+// [--counters] [--memory] [--repeats N] [сценарий...]. Без имен идут все сценарии
+// по порядку. Время - steady_clock, лучший из нескольких прогонов, нс на операцию.
+// --counters добавляет к деревьям BinaryTree счетчики работы по видам операций,
+// --memory - их память по категориям и рост RSS за построение.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bench_common.h"
+
+namespace
+{
+struct BenchCase
+{
+    const char* name;
+    const char* description;
+    void (*run)(const BenchOptions& options);
+};
+
+const BenchCase kCases[] = {
+    {"frozen", "FrozenTreeIndex (Eytzinger) vs BinaryTree::find", runFrozenIndexBench},
+    {"batch", "BinaryTree::findBatch vs a loop of find", runFindBatchBench},
+    {"bplus", "BPlusTree fanouts vs BinaryTree: insert, find, range", runBPlusTreeBench},
+    {"splay", "splay mode vs plain BinaryTree on Zipf lookups", runSplayBench},
+    {"heap", "DaryHeap arities vs std::priority_queue: push, pop, decreaseKey", runDaryHeapBench},
+    {"robin", "RobinHoodHashTable load factors vs std::unordered_set", runRobinHoodBench},
+    {"join", "BinaryTree union/intersection/difference vs per-key loops", runTreeJoinBench},
+};
+
+void printUsage()
+{
+    std::printf("usage: dsat_bench [--quick] [--large] [--counters] [--memory] [--repeats N] [case...]\n");
+    for (const BenchCase& benchCase : kCases) {
+        std::printf("  %-10s %s\n", benchCase.name, benchCase.description);
+    }
+}
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    std::vector<const BenchCase*> selected;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--quick") == 0) {
+            options.quick = true;
+        } else if (std::strcmp(arg, "--large") == 0) {
+            options.large = true;
+        } else if (std::strcmp(arg, "--counters") == 0) {
+            options.counters = true;
+        } else if (std::strcmp(arg, "--memory") == 0) {
+            options.memory = true;
+        } else if (std::strcmp(arg, "--repeats") == 0 && i + 1 < argc) {
+            options.repeats = std::max(1, std::atoi(argv[++i]));
+        } else {
+            const BenchCase* found = nullptr;
+            for (const BenchCase& benchCase : kCases) {
+                if (std::strcmp(arg, benchCase.name) == 0) found = &benchCase;
+            }
+            if (!found) {
+                printUsage();
+                return 2;
+            }
+            selected.push_back(found);
+        }
+    }
+
+    if (selected.empty()) {
+        for (const BenchCase& benchCase : kCases) {
+            selected.push_back(&benchCase);
+        }
+    }
+
+    for (const BenchCase* benchCase : selected) {
+        benchCase->run(options);
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+// RobinHoodHashTable при разной заполненности против std::unordered_set:
+// вставка, поиск с попаданием и с промахом, удаление. Число ключей
+// подбирается так, чтобы таблица с данным maxLoadFactor после reserve
+// получила ровно capacity слотов и заполнилась до этого коэффициента.
+#include <algorithm>
+#include <cstdio>
+#include <unordered_set>
+
+#include "bench_common.h"
+#include "../src/core/internal/hash_table/robin_hood_table.h"
+
+namespace
+{
+struct HashTimes
+{
+    double insertNs = 0.0;
+    double hitNs = 0.0;
+    double missNs = 0.0;
+    double removeNs = 0.0;
+};
+
+// Нечетные ключи: в наборе только четные
+std::vector<int> missKeys(const std::vector<int>& keys)
+{
+    std::vector<int> misses(keys.size());
+    std::transform(keys.begin(), keys.end(), misses.begin(), [](int key) { return key + 1; });
+    return misses;
+}
+
+template <typename Contains>
+double lookupNs(const BenchOptions& options, const std::vector<int>& lookups, Contains&& contains)
+{
+    return benchNsPerOp(options, std::int64_t(lookups.size()), [&]() {
+        std::uintptr_t found = 0;
+        for (int key : lookups) {
+            found += contains(key);
+        }
+        benchConsume(found);
+    });
+}
+
+// maxProbe < 0 - у структуры нет дистанций пробирования
+void printRow(int capacity, const char* name, double load, int maxProbe, const HashTimes& times)
+{
+    char probe[16] = "-";
+    if (maxProbe >= 0) std::snprintf(probe, sizeof(probe), "%d", maxProbe);
+    std::printf("%10d %-20s %6.3f %6s %9.1f %9.1f %9.1f %9.1f\n", capacity, name, load, probe,
+                times.insertNs, times.hitNs, times.missNs, times.removeNs);
+}
+}
+
+void runRobinHoodBench(const BenchOptions& options)
+{
+    benchSection("robin: RobinHoodHashTable load factors vs std::unordered_set (ns per operation)");
+    std::printf("%10s %-20s %6s %6s %9s %9s %9s %9s\n",
+                "capacity", "structure", "load", "probe", "insert", "hit", "miss", "remove");
+
+    for (int capacity : benchSizes(options, {1 << 12, 1 << 16, 1 << 20}, {1 << 23})) {
+        for (double loadFactor : {0.5, 0.75, 0.875, 0.95}) {
+            const int count = int(capacity * loadFactor);
+            const std::vector<int> keys = benchShuffledKeys(count, 1);
+            const std::vector<int> misses = missKeys(keys);
+
+            RobinHoodHashTable table(loadFactor);
+            auto fill = [&]() {
+                table.clear();
+                table.reserve(count);
+                for (int key : keys) {
+                    table.insert(key);
+                }
+            };
+
+            HashTimes times;
+            times.insertNs = benchNsPerOp(options, count, [&]() {
+                table.clear();
+                table.reserve(count);
+            }, [&]() {
+                for (int key : keys) {
+                    table.insert(key);
+                }
+            });
+            times.hitNs = lookupNs(options, keys, [&](int key) { return table.contains(key); });
+            times.missNs = lookupNs(options, misses, [&](int key) { return table.contains(key); });
+            // Слоты и дистанции - до удаления, пока таблица заполнена
+            const double load = table.loadFactor();
+            const int maxProbe = table.maxProbeDistance();
+            const int tableCapacity = table.capacity();
+            times.removeNs = benchNsPerOp(options, count, fill, [&]() {
+                for (int key : keys) {
+                    table.remove(key);
+                }
+            });
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "Robin Hood max %.3f", loadFactor);
+            printRow(tableCapacity, name, load, maxProbe, times);
+        }
+
+        // Ключей столько же, сколько у самой плотной таблицы
+        const int count = int(capacity * 0.95);
+        const std::vector<int> keys = benchShuffledKeys(count, 1);
+        const std::vector<int> misses = missKeys(keys);
+
+        std::unordered_set<int> set;
+        auto fill = [&]() {
+            set.clear();
+            set.reserve(std::size_t(count));
+            set.insert(keys.begin(), keys.end());
+        };
+
+        HashTimes times;
+        times.insertNs = benchNsPerOp(options, count, [&]() {
+            set.clear();
+            set.reserve(std::size_t(count));
+        }, [&]() {
+            for (int key : keys) {
+                set.insert(key);
+            }
+        });
+        times.hitNs = lookupNs(options, keys, [&](int key) { return set.count(key); });
+        times.missNs = lookupNs(options, misses, [&](int key) { return set.count(key); });
+        const double load = set.load_factor();
+        const int buckets = int(set.bucket_count());
+        times.removeNs = benchNsPerOp(options, count, fill, [&]() {
+            for (int key : keys) {
+                set.erase(key);
+            }
+        });
+        printRow(buckets, "std::unordered_set", load, -1, times);
+    }
+}
@@ -0,0 +1,81 @@
+// Splay-режим BinaryTree против обычного поиска на запросах с распределением
+// Ципфа: ключ ранга r запрашивается с вероятностью ~ 1 / r^s. При s = 0
+// запросы равномерны, и подъем узлов в корень только мешает.
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "bench_common.h"
+#include "../src/core/internal/binary_tree/binary_tree.h"
+
+namespace
+{
+// count запросов к keys: ранги по Ципфу с показателем exponent, ранг r - ключ keys[r]
+std::vector<int> zipfLookups(const std::vector<int>& keys, double exponent, int count, std::uint32_t seed)
+{
+    std::vector<double> cdf(keys.size());
+    double total = 0.0;
+    for (std::size_t rank = 0; rank < keys.size(); ++rank) {
+        total += 1.0 / std::pow(double(rank + 1), exponent);
+        cdf[rank] = total;
+    }
+
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> uniform(0.0, total);
+    std::vector<int> lookups;
+    lookups.reserve(std::size_t(count));
+    for (int i = 0; i < count; ++i) {
+        const auto rank = std::lower_bound(cdf.begin(), cdf.end(), uniform(random)) - cdf.begin();
+        lookups.push_back(keys[std::size_t(std::min<std::ptrdiff_t>(rank, std::ptrdiff_t(keys.size()) - 1))]);
+    }
+    return lookups;
+}
+}
+
+void runSplayBench(const BenchOptions& options)
+{
+    benchSection("splay: splay mode vs plain BinaryTree on Zipf lookups (ns per access)");
+    std::printf("%10s %8s %12s %12s %9s\n", "keys", "zipf s", "plain find", "splay", "speedup");
+
+    const int lookupCount = options.quick ? 1 << 14 : 1 << 20;
+
+    for (int size : benchSizes(options, {1 << 14, 1 << 17, 1 << 20}, {1 << 22})) {
+        const std::vector<int> keys = benchShuffledKeys(size, 1);
+        const QVector<int> values(keys.begin(), keys.end());
+
+        for (double exponent : {0.0, 0.8, 1.0, 1.2}) {
+            const std::vector<int> lookups = zipfLookups(keys, exponent, lookupCount, 4);
+
+            BinaryTree plain;
+            plain.buildFromValues(values);
+            const double plainNs = benchNsPerOp(options, lookupCount, [&]() {
+                std::uintptr_t found = 0;
+                for (int key : lookups) {
+                    found += std::uintptr_t(plain.access(key));
+                }
+                benchConsume(found);
+            });
+
+            // Дерево подстраивается под запросы от прогона к прогону: лучший
+            // прогон - уже "прогретое" дерево, как в долгой работе
+            BinaryTree splay;
+            splay.buildFromValues(values);
+            splay.setSplayMode(true);
+            const double splayNs = benchNsPerOp(options, lookupCount, [&]() {
+                std::uintptr_t found = 0;
+                for (int key : lookups) {
+                    found += std::uintptr_t(splay.access(key));
+                }
+                benchConsume(found);
+            });
+
+            std::printf("%10d %8.1f %12.1f %12.1f %8.2fx\n", size, exponent, plainNs, splayNs, plainNs / splayNs);
+
+            char label[48];
+            std::snprintf(label, sizeof(label), "plain, zipf s %.1f", exponent);
+            benchPrintCounters(options, label, size, plain.statistics());
+            std::snprintf(label, sizeof(label), "splay, zipf s %.1f", exponent);
+            benchPrintCounters(options, label, size, splay.statistics());
+        }
+    }
+}
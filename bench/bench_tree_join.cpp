@@ -0,0 +1,155 @@
+// BinaryTree::unionWith/intersectWith/differenceWith против поключевых
+// операций: insertUnique ключей other (объединение), find + insertUnique
+// в новое дерево (пересечение), remove ключей other (разность).
+// Операции над множествами - в одном потоке пула и в нескольких, со
+// случайными деревьями (перед операцией перестраиваются в декартовы) и
+// с уже декартовыми. Размеры - по обе стороны TreeJoin::kParallelMinNodes.
+#include <QThreadPool>
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <random>
+
+#include "bench_common.h"
+#include "../src/core/internal/binary_tree/binary_tree.h"
+
+namespace
+{
+enum class SetOp
+{
+    Union,
+    Intersection,
+    Difference
+};
+
+// count различных ключей из [0, range) в случайном порядке
+QVector<int> randomKeys(int count, int range, std::uint32_t seed)
+{
+    std::vector<int> all(static_cast<std::size_t>(range));
+    std::iota(all.begin(), all.end(), 0);
+    std::mt19937 random(seed);
+    std::shuffle(all.begin(), all.end(), random);
+    return QVector<int>(all.begin(), all.begin() + count);
+}
+
+void applySetOp(SetOp op, BinaryTree& tree, BinaryTree& other)
+{
+    switch (op) {
+    case SetOp::Union: tree.unionWith(other); break;
+    case SetOp::Intersection: tree.intersectWith(other); break;
+    case SetOp::Difference: tree.differenceWith(other); break;
+    }
+}
+
+// То же поключевыми операциями; результат - в tree (пересечение - в result)
+void applyPerKey(SetOp op, BinaryTree& tree, const QVector<int>& otherKeys, BinaryTree& result)
+{
+    switch (op) {
+    case SetOp::Union:
+        for (int key : otherKeys) {
+            tree.insertUnique(key);
+        }
+        break;
+    case SetOp::Intersection:
+        for (int key : otherKeys) {
+            if (tree.find(key)) result.insertUnique(key);
+        }
+        break;
+    case SetOp::Difference:
+        for (int key : otherKeys) {
+            tree.remove(key);
+        }
+        break;
+    }
+}
+
+// Перестройка в декартово дерево без изменения ключей
+void makeTreap(BinaryTree& tree)
+{
+    BinaryTree empty;
+    tree.unionWith(empty);
+}
+
+// statistics - счетчики дерева-результата за все прогоны
+double setOpMs(const BenchOptions& options, SetOp op, const QVector<int>& keysA, const QVector<int>& keysB,
+               int threads, bool treaps, OperationStatistics* statistics = nullptr)
+{
+    QThreadPool* pool = QThreadPool::globalInstance();
+    const int savedThreads = pool->maxThreadCount();
+    pool->setMaxThreadCount(threads);
+
+    BinaryTree a;
+    BinaryTree b;
+    const double ns = benchNsPerOp(options, 1, [&]() {
+        a.buildFromValues(keysA);
+        b.buildFromValues(keysB);
+        if (treaps) {
+            makeTreap(a);
+            makeTreap(b);
+        }
+    }, [&]() {
+        applySetOp(op, a, b);
+    });
+    benchConsume(std::uintptr_t(a.size()));
+    if (statistics) {
+        *statistics = a.statistics();
+    }
+
+    pool->setMaxThreadCount(savedThreads);
+    return ns / 1e6;
+}
+}
+
+void runTreeJoinBench(const BenchOptions& options)
+{
+    // Параллельная колонка - хотя бы 2 потока, даже если ядро одно
+    const int threads = std::max(2, QThreadPool::globalInstance()->maxThreadCount());
+
+    char title[160];
+    std::snprintf(title, sizeof(title),
+                  "join: set operations vs per-key loops, n x n random keys in [0, 4n) (ms per operation, %d threads)",
+                  threads);
+    benchSection(title);
+    std::printf("%10s %-13s %10s %10s %10s %12s %12s\n",
+                "n", "operation", "per key", "join 1t", "join Nt", "treaps 1t", "treaps Nt");
+
+    const struct
+    {
+        const char* name;
+        SetOp op;
+    } ops[] = {{"union", SetOp::Union}, {"intersection", SetOp::Intersection}, {"difference", SetOp::Difference}};
+
+    // 4K x 4K - ниже порога параллельности (16K на двоих), 1M x 1M - выше
+    for (int size : benchSizes(options, {1 << 12, 1 << 20}, {1 << 22})) {
+        const QVector<int> keysA = randomKeys(size, 4 * size, 1);
+        const QVector<int> keysB = randomKeys(size, 4 * size, 2);
+
+        for (const auto& op : ops) {
+            BinaryTree a;
+            BinaryTree result;
+            const double perKeyMs = benchNsPerOp(options, 1, [&]() {
+                a.buildFromValues(keysA);
+                result.clear();
+            }, [&]() {
+                applyPerKey(op.op, a, keysB, result);
+            }) / 1e6;
+            benchConsume(std::uintptr_t(a.size() + result.size()));
+
+            OperationStatistics joinStatistics;
+            const double joinMs = setOpMs(options, op.op, keysA, keysB, 1, false, &joinStatistics);
+            const double joinParallelMs = setOpMs(options, op.op, keysA, keysB, threads, false);
+            const double treapsMs = setOpMs(options, op.op, keysA, keysB, 1, true);
+            const double treapsParallelMs = setOpMs(options, op.op, keysA, keysB, threads, true);
+
+            std::printf("%10d %-13s %10.1f %10.1f %10.1f %12.1f %12.1f\n", size, op.name, perKeyMs,
+                        joinMs, joinParallelMs, treapsMs, treapsParallelMs);
+
+            char label[48];
+            std::snprintf(label, sizeof(label), "%s per key", op.name);
+            benchPrintCounters(options, label, size, a.statistics());
+            std::snprintf(label, sizeof(label), "%s join 1t", op.name);
+            benchPrintCounters(options, label, size, joinStatistics);
+        }
+    }
+}
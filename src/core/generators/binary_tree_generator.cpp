@@ -1,10 +1,94 @@
 #include "binary_tree_generator.h"
 
+#include <QElapsedTimer>
 
 
 BinaryTreeGenerator::BinaryTreeGenerator(QObject* parent)
     : QObject(parent)
-{}
+{
+    // Нулевой интервал: следующий кусок сразу после обработки событий
+    m_chunkTimer.setInterval(0);
+    connect(&m_chunkTimer, &QTimer::timeout, this, &BinaryTreeGenerator::generateChunk);
+}
+
+void BinaryTreeGenerator::startGeneration(BinaryTreeType type, int nodeCount, quint32 seed)
+{
+    cancel();
+
+    m_random.seed(seed);
+    m_buildType = type;
+    m_buildTotal = qBound(0, nodeCount, kMaxNodeCount);
+    m_building = new BinaryTree(this);
+    m_builder.emplace(m_building);
+
+    emit generationProgress(0, m_buildTotal);
+    m_chunkTimer.start();
+}
+
+void BinaryTreeGenerator::cancel()
+{
+    if (!m_building) return;
+
+    m_chunkTimer.stop();
+    m_builder.reset();
+    delete m_building;
+    m_building = nullptr;
+
+    emit generationCancelled();
+}
+
+void BinaryTreeGenerator::generateChunk()
+{
+    QElapsedTimer clock;
+    clock.start();
+
+    qint64 done = m_builder->count();
+
+    while (done < m_buildTotal)
+    {
+        const qint64 chunkEnd = qMin(m_buildTotal, done + kNodesBetweenClockChecks);
+
+        for (; done < chunkEnd; ++done)
+        {
+            // Уникальные ключи без множества уже выданных: по одному на пару [2i, 2i + 1]
+            const int jitter = int(m_random.generate() & 1u);
+
+            switch (m_buildType)
+            {
+            case Random:
+                // Случайные приоритеты - то же распределение, что у вставки в случайном порядке
+                m_builder->appendInOrder(int(2 * done) + jitter, m_random.generate64());
+                break;
+            case LeftHeavy:
+                // Вставка по убыванию: каждый ключ - левый ребенок предыдущего
+                m_builder->appendToChain(int(2 * (m_buildTotal - 1 - done)) + jitter, true);
+                break;
+            case RightHeavy:
+                m_builder->appendToChain(int(2 * done) + jitter, false);
+                break;
+            }
+        }
+
+        if (clock.elapsed() >= kChunkBudgetMs)
+        {
+            break;
+        }
+    }
+
+    emit generationProgress(done, m_buildTotal);
+
+    if (done < m_buildTotal)
+    {
+        return;
+    }
+
+    m_chunkTimer.stop();
+    m_builder.reset();
+    BinaryTree* tree = m_building;
+    m_building = nullptr;
+
+    emit treeGenerated(tree);
+}
 
 BinaryTree* BinaryTreeGenerator::generateTree(BinaryTreeType type, int nodeCount, bool allowDuplicates)
 {
@@ -5,10 +5,13 @@
 #include <QObject>
 #include <QRandomGenerator>
 #include <QSet>
+#include <QTimer>
 
 #include <algorithm>
+#include <optional>
 
 #include "../internal/binary_tree/binary_tree.h"
+#include "../internal/binary_tree/binary_tree_builder.h"
 #include "../internal/binary_tree/tree_node.h"
 
 enum BinaryTreeType
@@ -33,12 +36,39 @@ public:
     BinaryTree* generateLeftHeavyTree(int nodeCount, bool allowDuplicates = false);
     BinaryTree* generateRightHeavyTree(int nodeCount, bool allowDuplicates = false);
 
+    // Генерация больших деревьев (до kMaxNodeCount узлов) кусками по таймеру:
+    // интерфейс не замирает, прогресс идет сигналами, сборку можно прервать.
+    // Ключи уникальны, из [0, 2 * nodeCount); при одном seed дерево то же.
+    // Дерево строится без спуска от корня (BinaryTreeBuilder), поэтому
+    // время линейно и для вырожденных типов. Готовое дерево - в treeGenerated.
+    void startGeneration(BinaryTreeType type, int nodeCount, quint32 seed);
+    // Прерывает сборку и сразу освобождает уже построенную часть
+    void cancel();
+    bool isGenerating() const { return m_building != nullptr; }
+
+    static constexpr int kMaxNodeCount = 100000000;
+
 signals:
     void treeGenerated(BinaryTree* tree);
+    void generationProgress(qint64 done, qint64 total);
+    void generationCancelled();
 
 private:
+    // Время одного куска: остальное в кадре достается интерфейсу
+    static constexpr int kChunkBudgetMs = 12;
+    static constexpr int kNodesBetweenClockChecks = 4096;
+
     QVector<int> generateValues(int count, bool allowDuplicates) const;
     int randomInt(int max) const;
+
+    void generateChunk();
+
+    QTimer m_chunkTimer;
+    QRandomGenerator m_random;
+    BinaryTree* m_building = nullptr;
+    std::optional<BinaryTreeBuilder> m_builder;
+    BinaryTreeType m_buildType = Random;
+    qint64 m_buildTotal = 0;
 };
 
 
@@ -0,0 +1,46 @@
+#include "bplus_tree_generator.h"
+
+BPlusTreeGenerator::BPlusTreeGenerator(QObject* parent)
+    : QObject(parent)
+{}
+
+BPlusTree* BPlusTreeGenerator::generateTree(BPlusTreeOrder order, int keyCount, int fanout)
+{
+    QVector<int> keys = generateKeys(keyCount);
+
+    switch (order)
+    {
+    case BPlusTreeOrder::Random:
+        std::shuffle(keys.begin(), keys.end(), *QRandomGenerator::global());
+        break;
+    case BPlusTreeOrder::Ascending:
+        std::sort(keys.begin(), keys.end());
+        break;
+    case BPlusTreeOrder::Descending:
+        std::sort(keys.begin(), keys.end(), std::greater<int>());
+        break;
+    }
+
+    BPlusTree* tree = new BPlusTree(fanout, this);
+    for (int key : keys)
+    {
+        tree->insert(key);
+    }
+
+    emit treeGenerated(tree);
+    return tree;
+}
+
+QVector<int> BPlusTreeGenerator::generateKeys(int count) const
+{
+    // Уникальные ключи из [0, 2 * count): B+ дерево хранит множество
+    QVector<int> keys;
+    keys.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        keys.append(2 * i + int(QRandomGenerator::global()->bounded(2)));
+    }
+
+    return keys;
+}
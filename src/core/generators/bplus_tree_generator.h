@@ -0,0 +1,39 @@
+// generators/bplus_tree_generator.h
+#ifndef BPLUSTREEGENERATOR_H
+#define BPLUSTREEGENERATOR_H
+
+#include <QObject>
+#include <QRandomGenerator>
+
+#include <algorithm>
+
+#include "../internal/bplus_tree/bplus_tree.h"
+
+// Порядок вставки сильно влияет на заполненность листьев:
+// при возрастающих ключах левые листья остаются заполненными наполовину
+enum class BPlusTreeOrder
+{
+    Random,
+    Ascending,
+    Descending
+};
+
+class BPlusTreeGenerator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BPlusTreeGenerator(QObject* parent = nullptr);
+
+    BPlusTree* generateTree(BPlusTreeOrder order,
+                            int keyCount,
+                            int fanout = BPlusTree::kDefaultFanout);
+
+signals:
+    void treeGenerated(BPlusTree* tree);
+
+private:
+    QVector<int> generateKeys(int count) const;
+};
+
+#endif // BPLUSTREEGENERATOR_H
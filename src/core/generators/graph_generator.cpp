@@ -0,0 +1,81 @@
+#include "graph_generator.h"
+
+#include <cmath>
+#include <vector>
+
+GraphGenerator::GraphGenerator(QObject* parent)
+    : QObject(parent)
+{}
+
+int GraphGenerator::randomWeight(int maxWeight) const
+{
+    return 1 + int(QRandomGenerator::global()->bounded(qMax(1, maxWeight)));
+}
+
+CsrGraph* GraphGenerator::generateGraph(GraphShape shape, int vertexCount, int averageDegree, int maxWeight)
+{
+    vertexCount = qMax(1, vertexCount);
+    averageDegree = qMax(1, averageDegree);
+
+    QRandomGenerator* random = QRandomGenerator::global();
+    std::vector<CsrGraph::Edge> edges;
+
+    switch (shape)
+    {
+    case GraphShape::Random:
+    {
+        const qint64 edgeCount = qint64(vertexCount) * averageDegree / 2;
+        edges.reserve(std::size_t(edgeCount));
+        for (qint64 i = 0; i < edgeCount; ++i)
+        {
+            edges.push_back({int(random->bounded(vertexCount)), int(random->bounded(vertexCount)),
+                             randomWeight(maxWeight)});
+        }
+        break;
+    }
+    case GraphShape::Grid:
+    {
+        const int side = qMax(1, int(std::ceil(std::sqrt(double(vertexCount)))));
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            if ((v + 1) % side != 0 && v + 1 < vertexCount)
+            {
+                edges.push_back({v, v + 1, randomWeight(maxWeight)});
+            }
+            if (v + side < vertexCount)
+            {
+                edges.push_back({v, v + side, randomWeight(maxWeight)});
+            }
+        }
+        break;
+    }
+    case GraphShape::ScaleFree:
+    {
+        // Выбор случайного конца уже существующего ребра равносилен
+        // выбору вершины с вероятностью, пропорциональной степени
+        const int perVertex = qMax(1, averageDegree / 2);
+        std::vector<int> endpoints;
+        endpoints.reserve(std::size_t(vertexCount) * perVertex * 2);
+
+        for (int v = 1; v < vertexCount; ++v)
+        {
+            for (int i = 0; i < perVertex; ++i)
+            {
+                const int target = endpoints.empty()
+                    ? 0
+                    : endpoints[std::size_t(random->bounded(int(endpoints.size())))];
+                edges.push_back({v, target, randomWeight(maxWeight)});
+                endpoints.push_back(v);
+                endpoints.push_back(target);
+            }
+        }
+        break;
+    }
+    }
+
+    CsrGraph* graph = new CsrGraph(this);
+    graph->build(vertexCount, edges);
+
+    emit graphGenerated(graph);
+    return graph;
+}
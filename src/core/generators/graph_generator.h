@@ -0,0 +1,37 @@
+// generators/graph_generator.h
+#ifndef GRAPHGENERATOR_H
+#define GRAPHGENERATOR_H
+
+#include <QObject>
+#include <QRandomGenerator>
+
+#include "../internal/graph/csr_graph.h"
+
+enum class GraphShape
+{
+    Random,             // Случайные ребра (Эрдеш-Реньи)
+    Grid,               // Квадратная решетка
+    ScaleFree           // Предпочтительное присоединение (Барабаши-Альберт)
+};
+
+class GraphGenerator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GraphGenerator(QObject* parent = nullptr);
+
+    // averageDegree влияет на Random и ScaleFree; веса ребер случайные из [1, maxWeight]
+    CsrGraph* generateGraph(GraphShape shape,
+                            int vertexCount,
+                            int averageDegree = 4,
+                            int maxWeight = 100);
+
+signals:
+    void graphGenerated(CsrGraph* graph);
+
+private:
+    int randomWeight(int maxWeight) const;
+};
+
+#endif // GRAPHGENERATOR_H
@@ -0,0 +1,20 @@
+#include "hash_table_generator.h"
+
+HashTableGenerator::HashTableGenerator(QObject* parent)
+    : QObject(parent)
+{}
+
+RobinHoodHashTable* HashTableGenerator::generateTable(int keyCount, double maxLoadFactor)
+{
+    RobinHoodHashTable* table = new RobinHoodHashTable(maxLoadFactor, this);
+    table->reserve(keyCount);
+
+    const int range = qMax(1, keyCount * 4);
+    while (table->size() < keyCount)
+    {
+        table->insert(int(QRandomGenerator::global()->bounded(range)));
+    }
+
+    emit tableGenerated(table);
+    return table;
+}
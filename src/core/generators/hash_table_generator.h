@@ -0,0 +1,25 @@
+// generators/hash_table_generator.h
+#ifndef HASHTABLEGENERATOR_H
+#define HASHTABLEGENERATOR_H
+
+#include <QObject>
+#include <QRandomGenerator>
+
+#include "../internal/hash_table/robin_hood_table.h"
+
+class HashTableGenerator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HashTableGenerator(QObject* parent = nullptr);
+
+    // Ключи уникальные, из [0, 4 * keyCount)
+    RobinHoodHashTable* generateTable(int keyCount,
+                                      double maxLoadFactor = RobinHoodHashTable::kDefaultMaxLoadFactor);
+
+signals:
+    void tableGenerated(RobinHoodHashTable* table);
+};
+
+#endif // HASHTABLEGENERATOR_H
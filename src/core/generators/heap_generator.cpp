@@ -0,0 +1,33 @@
+#include "heap_generator.h"
+
+HeapGenerator::HeapGenerator(QObject* parent)
+    : QObject(parent)
+{}
+
+DaryHeap* HeapGenerator::generateHeap(int count, int arity, bool bulkBuild)
+{
+    std::vector<int> priorities;
+    priorities.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        priorities.push_back(int(QRandomGenerator::global()->bounded(count * 4 + 1)));
+    }
+
+    DaryHeap* heap = new DaryHeap(arity, this);
+
+    if (bulkBuild)
+    {
+        heap->buildFromValues(priorities);
+    }
+    else
+    {
+        for (int priority : priorities)
+        {
+            heap->push(priority);
+        }
+    }
+
+    emit heapGenerated(heap);
+    return heap;
+}
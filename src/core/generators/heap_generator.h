@@ -0,0 +1,25 @@
+// generators/heap_generator.h
+#ifndef HEAPGENERATOR_H
+#define HEAPGENERATOR_H
+
+#include <QObject>
+#include <QRandomGenerator>
+
+#include "../internal/heap/dary_heap.h"
+
+class HeapGenerator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HeapGenerator(QObject* parent = nullptr);
+
+    // bulkBuild = true - построение за O(n) через buildFromValues,
+    // иначе n последовательных push (как в реальной очереди)
+    DaryHeap* generateHeap(int count, int arity = 4, bool bulkBuild = true);
+
+signals:
+    void heapGenerated(DaryHeap* heap);
+};
+
+#endif // HEAPGENERATOR_H
@@ -2,7 +2,35 @@
 #include "binary_tree.h"
 
 #include <QDebug>
+#include <QSet>
 #include <algorithm>
+#include <vector>
+
+#include "../../utils/prefetch.h"
+#include "../../utils/memory_report.h"
+
+namespace {
+
+// Переносит узлы-детей from к to (кроме удаляемых), снимая их с начала
+// списка детей: так QObject убирает ребенка за O(1)
+void moveTreeNodes(QObject& from, QObject& to, const QSet<const TreeNode*>* deleted)
+{
+    const QObjectList& children = from.children();
+    qsizetype skipped = 0;
+
+    while (children.size() > skipped) {
+        TreeNode* node = qobject_cast<TreeNode*>(children.at(skipped));
+        if (!node) {
+            ++skipped;
+        } else if (deleted && deleted->contains(node)) {
+            delete node;
+        } else {
+            static_cast<QObject*>(node)->setParent(&to);
+        }
+    }
+}
+
+} // namespace
 
 BinaryTree::BinaryTree(QObject* parent) : QObject(parent)
 {
@@ -13,139 +41,442 @@ BinaryTree::~BinaryTree()
     clear();
 }
 
+BinaryTree::CountingScope::CountingScope(const BinaryTree* tree, TreeOperation operation)
+    : m_tree(tree)
+{
+    if (m_tree->m_countingDepth++ == 0) {
+        m_tree->m_counters.reset();
+        m_tree->m_countingOperation = operation;
+        if (m_tree->m_tracer) {
+            m_tree->m_tracer->operationStarted(operation);
+        }
+    }
+}
+
+BinaryTree::CountingScope::~CountingScope()
+{
+    if (--m_tree->m_countingDepth == 0) {
+        if (m_tree->m_tracer) {
+            m_tree->m_tracer->operationFinished();
+        }
+        m_tree->m_statistics.record(m_tree->m_countingOperation, m_tree->m_counters);
+        emit const_cast<BinaryTree*>(m_tree)->countersUpdated();
+    }
+}
+
+void BinaryTree::resetStatistics()
+{
+    m_statistics.reset();
+    m_counters.reset();
+    emit countersUpdated();
+}
+
 void BinaryTree::insert(int value)
 {
+    insertValue(value, false);
+}
+
+bool BinaryTree::insertUnique(int value)
+{
+    return insertValue(value, true);
+}
+
+bool BinaryTree::insertValue(int value, bool unique)
+{
+    CountingScope counting(this, TreeOperation::Insert);
     emit operationStarted(QString("Вставка значения %1").arg(value));
 
-    if (m_root == nullptr) {
-        m_root = new TreeNode(value, this);
-        m_size++;
-        emit nodeInserted(m_root);
-        emit structureChanged();
-        emit operationFinished("Вставка завершена");
-        return;
+    // Спуск без рекурсии: вырожденное дерево бывает глубиной в миллионы узлов
+    TreeNode* parent = nullptr;
+    TreeNode* current = m_root;
+    int depth = 0;
+
+    while (current) {
+        // Для учебных целей - выделяем сравнение
+        touchNode(current, depth++);
+        ++m_counters.comparisons;
+        emit comparisonMade(current, nullptr);
+
+        if (unique && value == current->value()) {
+            if (m_splayMode && splayInternal(current) > 0) {
+                emit structureChanged();
+            }
+            emit operationFinished("Значение уже есть");
+            return false;
+        }
+
+        parent = current;
+        // Дубликаты идут в правое поддерево (простейшая политика)
+        current = value < current->value() ? current->left() : current->right();
     }
 
-    TreeNode* newNode = insertRecursive(m_root, value);
-    if (newNode) {
-        m_size++;
-        emit nodeInserted(newNode);
-        emit structureChanged();
+    TreeNode* newNode = linkNewNode(parent, value);
+    ++m_counters.allocations;
+    emit nodeInserted(newNode);
+
+    if (m_splayMode) {
+        splayInternal(newNode);
     }
+    emit structureChanged();
 
     emit operationFinished("Вставка завершена");
+    return true;
 }
 
-TreeNode* BinaryTree::insertRecursive(TreeNode* node, int value, TreeNode* parent)
+TreeNode* BinaryTree::linkNewNode(TreeNode* parent, int value)
 {
-    if (!node) {
-        TreeNode* newNode = new TreeNode(value, this);
-        newNode->setParent(parent);
-        return newNode;
-    }
-
-    // Для учебных целей - выделяем сравнение
-    emit comparisonMade(node, nullptr);
-
-    if (value < node->value()) {
-        TreeNode* leftChild = insertRecursive(node->left(), value, node);
-        if (leftChild && !node->left()) {
-            node->setLeft(leftChild);
-        }
+    TreeNode* node = new TreeNode(value, this);
+    node->setParent(parent);
+    m_hashTreap = false;
+
+    if (!parent) {
+        m_root = node;
+    } else if (value < parent->value()) {
+        parent->setLeft(node);
     } else {
-        // Дубликаты идут в правое поддерево (простейшая политика)
-        TreeNode* rightChild = insertRecursive(node->right(), value, node);
-        if (rightChild && !node->right()) {
-            node->setRight(rightChild);
-        }
+        parent->setRight(node);
     }
 
+    m_size++;
     return node;
 }
 
 void BinaryTree::remove(int value)
 {
+    CountingScope counting(this, TreeOperation::Remove);
     emit operationStarted(QString("Удаление значения %1").arg(value));
 
-    TreeNode* nodeToRemove = find(value);
-    if (!nodeToRemove) {
+    TreeNode* node = m_root;
+    int depth = 0;
+
+    while (node) {
+        touchNode(node, depth);
+        ++m_counters.comparisons;
+        emit comparisonMade(node, nullptr);
+
+        if (value == node->value()) {
+            break;
+        }
+        node = value < node->value() ? node->left() : node->right();
+        ++depth;
+    }
+
+    if (!node) {
         emit operationFinished("Значение не найдено");
         return;
     }
 
-    m_root = removeRecursive(m_root, value);
-    emit nodeRemoved(nodeToRemove);
+    TreeNode* victim = node;
+    if (node->hasLeft() && node->hasRight()) {
+        // Два ребенка: значение заменяется минимумом правого поддерева,
+        // а удаляется узел минимума - у него нет левого ребенка
+        victim = findMin(node->right());
+        const_cast<int&>(node->m_value) = victim->value();
+    }
+
+    unlinkNode(victim);
+    ++m_counters.deallocations;
     emit structureChanged();
 
     emit operationFinished("Удаление завершено");
 }
 
-TreeNode* BinaryTree::removeRecursive(TreeNode* node, int value)
+TreeNode* BinaryTree::find(int value) const
 {
-    if (!node) {
-        return nullptr;
+    CountingScope counting(this, TreeOperation::Find);
+    TreeNode* current = m_root;
+    int depth = 0;
+
+    while (current) {
+        touchNode(current, depth++);
+        ++m_counters.comparisons;
+        emit const_cast<BinaryTree*>(this)->comparisonMade(current, nullptr);
+
+        if (value == current->value()) {
+            return current;
+        } else if (value < current->value()) {
+            current = current->left();
+        } else {
+            current = current->right();
+        }
     }
 
-    emit comparisonMade(node, nullptr);
+    return nullptr;
+}
 
-    if (value < node->value()) {
-        node->setLeft(removeRecursive(node->left(), value));
-    } else if (value > node->value()) {
-        node->setRight(removeRecursive(node->right(), value));
-    } else {
-        // Нашли узел для удаления
-        m_size--;
-
-        if (!node->hasLeft() && !node->hasRight()) {
-            // Лист
-            node->deleteLater();
-            return nullptr;
-        } else if (!node->hasLeft()) {
-            // Только правый ребенок
-            TreeNode* rightChild = node->right();
-            if (rightChild) {
-                rightChild->setParent(node->parent());
+int BinaryTree::countRange(int low, int high) const
+{
+    CountingScope counting(this, TreeOperation::Range);
+    if (low > high) return 0;
+
+    // Стек - левые предки текущего узла, как в итеративном обходе по порядку.
+    // Поддеревья левее low не посещаются
+    std::vector<TreeNode*> stack;
+    TreeNode* node = m_root;
+    int count = 0;
+
+    while (node || !stack.empty()) {
+        while (node) {
+            touchNode(node);
+            ++m_counters.comparisons;
+            if (node->value() < low) {
+                node = node->right();
+            } else {
+                stack.push_back(node);
+                node = node->left();
+            }
+        }
+
+        if (stack.empty()) break;
+
+        node = stack.back();
+        stack.pop_back();
+        if (node->value() > high) break;
+
+        ++count;
+        node = node->right();
+    }
+
+    return count;
+}
+
+void BinaryTree::findBatch(std::span<const int> keys, std::span<TreeNode*> out) const
+{
+    Q_ASSERT(out.size() >= keys.size());
+    const int count = int(keys.size());
+    if (count <= 0) return;
+
+    CountingScope counting(this, TreeOperation::Find);
+
+    if (!m_root) {
+        std::fill_n(out.begin(), count, nullptr);
+        return;
+    }
+
+    // Окно из kBatchWidth одновременных поисков. Закончивший поиск сразу
+    // берет следующий ключ, поэтому окно остается полным до конца пакета.
+    constexpr int kBatchWidth = 16;
+
+    struct Cursor {
+        int index;
+        TreeNode* node;
+        int depth;
+    };
+
+    Cursor cursors[kBatchWidth];
+    int active = 0;
+    int next = 0;
+    // Счет в локальных переменных, чтобы не трогать члены дерева в горячем цикле
+    quint64 touched = 0;
+    int maxDepth = 0;
+    const bool countVisits = m_countVisits;
+    NodeAccessTracer* tracer = m_tracer;
+
+    while (active < kBatchWidth && next < count) {
+        cursors[active++] = {next++, m_root, 0};
+    }
+
+    while (active > 0) {
+        for (int i = 0; i < active;) {
+            Cursor& cursor = cursors[i];
+            TreeNode* node = cursor.node;
+            const int key = keys[cursor.index];
+            const int value = node->value();
+            ++touched;
+            if (countVisits) {
+                node->recordVisit();
             }
-            node->deleteLater();
-            return rightChild;
-        } else if (!node->hasRight()) {
-            // Только левый ребенок
-            TreeNode* leftChild = node->left();
-            if (leftChild) {
-                leftChild->setParent(node->parent());
+            if (tracer) {
+                // Курсоры чередуются - трасса идет в том же порядке, что и чтения
+                tracer->nodeTouched(node, cursor.depth, NodeRead::Object);
+            }
+
+            // Сырые ссылки, а не left()/right(): QPointer читает еще и guard-блок
+            // ребенка, который prefetch узла не подгружает (см. TreeNode::m_rawLeft)
+            TreeNode* child = nullptr;
+            if (key != value) {
+                child = key < value ? node->m_rawLeft : node->m_rawRight;
+            }
+
+            if (child) {
+                // Пока остальные курсоры делают свой шаг, узел успеет подгрузиться;
+                // значение и сырые ссылки лежат в его начале, другого промаха на
+                // этом уровне нет
+                prefetchForRead(child);
+                cursor.node = child;
+                ++cursor.depth;
+                ++i;
+                continue;
+            }
+
+            out[cursor.index] = (key == value) ? node : nullptr;
+            maxDepth = std::max(maxDepth, cursor.depth);
+
+            if (next < count) {
+                // Корень почти всегда в кэше, новый поиск стартует без ожидания
+                cursor = {next++, m_root, 0};
+                ++i;
+            } else {
+                // Ключи кончились - сжимаем окно, текущий слот занимает последний курсор
+                cursor = cursors[--active];
             }
-            node->deleteLater();
-            return leftChild;
-        } else {
-            // Два ребенка
-            TreeNode* minNode = findMin(node->right());
-            // Копируем значение (нужно сделать m_value не const в TreeNode)
-            const_cast<int&>(node->m_value) = minNode->value();
-            // Удаляем минимальный узел
-            node->setRight(removeRecursive(node->right(), minNode->value()));
         }
     }
 
-    return node;
+    // Пакет идет одной записью, но с числом поисков в operations
+    m_counters.operations = count;
+    m_counters.comparisons += touched;
+    m_counters.nodesTouched += touched;
+    m_counters.maxDepth = std::max(m_counters.maxDepth, maxDepth);
 }
 
-TreeNode* BinaryTree::find(int value) const
+QVector<TreeNode*> BinaryTree::findBatch(const QVector<int>& keys) const
 {
+    QVector<TreeNode*> result(keys.size(), nullptr);
+    findBatch(std::span<const int>(keys.constData(), keys.size()),
+              std::span<TreeNode*>(result.data(), result.size()));
+    return result;
+}
+
+FrozenTreeIndex BinaryTree::freeze() const
+{
+    std::vector<int> keys;
+    std::vector<TreeNode*> nodes;
+    keys.reserve(m_size);
+    nodes.reserve(m_size);
+
+    // Симметричный обход без рекурсии: дерево может быть вырожденным
+    std::vector<TreeNode*> stack;
     TreeNode* current = m_root;
+    while (current || !stack.empty()) {
+        while (current) {
+            stack.push_back(current);
+            current = current->left();
+        }
+
+        current = stack.back();
+        stack.pop_back();
+
+        keys.push_back(current->value());
+        nodes.push_back(current);
+
+        current = current->right();
+    }
+
+    return FrozenTreeIndex(keys, nodes);
+}
+
+int BinaryTree::height() const
+{
+    // По уровням: глубина вырожденного дерева - миллионы узлов
+    int levels = 0;
+    QVector<TreeNode*> level;
+    QVector<TreeNode*> next;
+    if (m_root) {
+        level.append(m_root);
+    }
+
+    while (!level.isEmpty()) {
+        ++levels;
+        next.clear();
+        for (TreeNode* node : level) {
+            if (node->left()) next.append(node->left());
+            if (node->right()) next.append(node->right());
+        }
+        level.swap(next);
+    }
+
+    return levels;
+}
+
+TreeNode* BinaryTree::access(int value)
+{
+    if (!m_splayMode) {
+        return find(value);
+    }
+
+    CountingScope counting(this, TreeOperation::Access);
+    TreeNode* current = m_root;
+    TreeNode* last = nullptr;
+    int depth = 0;
 
     while (current) {
-        emit const_cast<BinaryTree*>(this)->comparisonMade(current, nullptr);
+        touchNode(current, depth++);
+        ++m_counters.comparisons;
+        emit comparisonMade(current, nullptr);
+        last = current;
 
         if (value == current->value()) {
-            return current;
-        } else if (value < current->value()) {
-            current = current->left();
-        } else {
-            current = current->right();
+            break;
         }
+        current = value < current->value() ? current->left() : current->right();
     }
 
-    return nullptr;
+    // Даже при промахе поднимаем последний узел пути: соседние ключи
+    // тоже становятся дешевле
+    if (last && splayInternal(last) > 0) {
+        emit structureChanged();
+    }
+
+    return current;
+}
+
+void BinaryTree::splay(TreeNode* node)
+{
+    CountingScope counting(this, TreeOperation::Splay);
+    if (splayInternal(node) > 0) {
+        emit structureChanged();
+    }
+}
+
+int BinaryTree::splayInternal(TreeNode* node)
+{
+    if (!node) return 0;
+
+    // Восходящий splay: родительские указатели уже есть, поэтому цикл
+    // идет от узла к корню без рекурсии и без стека.
+    // Вызывающий уже внутри CountingScope: счетчики те же, что у
+    // rotateLeft/rotateRight, но без их вложенного CountingScope и пары
+    // строковых сигналов на каждый из десятков поворотов
+    int rotations = 0;
+
+    PlannedRotation plan[2];
+    while (const int count = planSplayStep(node, plan)) {
+        for (int i = 0; i < count; ++i) {
+            ++m_counters.rotations;
+            m_counters.nodesTouched += plan[i].node->parent() ? 3 : 2;
+            rotateLinks(plan[i].node, plan[i].left);
+        }
+        rotations += count;
+    }
+
+    return rotations;
+}
+
+int BinaryTree::planSplayStep(TreeNode* node, PlannedRotation (&plan)[2])
+{
+    TreeNode* parent = node ? node->parent() : nullptr;
+    if (!parent) return 0;
+
+    TreeNode* grand = parent->parent();
+    const bool nodeIsLeft = parent->left() == node;
+
+    if (!grand) {
+        // zig
+        plan[0] = {parent, !nodeIsLeft};
+        return 1;
+    }
+
+    if ((grand->left() == parent) == nodeIsLeft) {
+        // zig-zig: сначала дед, потом родитель
+        plan[0] = {grand, !nodeIsLeft};
+        plan[1] = {parent, !nodeIsLeft};
+    } else {
+        // zig-zag: узел поднимается дважды
+        plan[0] = {parent, !nodeIsLeft};
+        plan[1] = {grand, nodeIsLeft};
+    }
+    return 2;
 }
 
 TreeNode* BinaryTree::findMin(TreeNode* node) const
@@ -153,6 +484,7 @@ TreeNode* BinaryTree::findMin(TreeNode* node) const
     if (!node) return nullptr;
 
     while (node->left()) {
+        touchNode(node);
         node = node->left();
     }
 
@@ -161,24 +493,40 @@ TreeNode* BinaryTree::findMin(TreeNode* node) const
 
 void BinaryTree::clear()
 {
-    deleteSubtree(m_root);
+    CountingScope counting(this, TreeOperation::Clear);
     m_root = nullptr;
     m_size = 0;
+    m_hashTreap = true;
+
+    // Слушатели забывают указатели на узлы до того, как узлы исчезнут
     emit treeCleared();
+    deleteAllNodes();
     emit structureChanged();
 }
 
-void BinaryTree::deleteSubtree(TreeNode* node)
+void BinaryTree::deleteAllNodes()
 {
-    if (!node) return;
-
-    deleteSubtree(node->left());
-    deleteSubtree(node->right());
-    node->deleteLater();
+    // Узлы - QObject-дети дерева. Удаляем их сразу и в порядке списка детей:
+    // QObject убирает себя из начала списка за O(1). Обход по ссылкам
+    // вырожденного дерева переполнил бы стек, а deleteLater на миллионы
+    // узлов забивает очередь событий, и удаление объекта с отложенным
+    // событием ищет его по всей очереди.
+    const QObjectList& children = this->children();
+    qsizetype skipped = 0;
+
+    while (children.size() > skipped) {
+        if (TreeNode* node = qobject_cast<TreeNode*>(children.at(skipped))) {
+            delete node;
+            ++m_counters.deallocations;
+        } else {
+            ++skipped;
+        }
+    }
 }
 
 void BinaryTree::buildFromValues(const QVector<int>& values)
 {
+    CountingScope counting(this, TreeOperation::Build);
     clear();
 
     emit operationStarted("Построение дерева из списка значений");
@@ -190,11 +538,341 @@ void BinaryTree::buildFromValues(const QVector<int>& values)
     emit operationFinished("Дерево построено");
 }
 
+void BinaryTree::unionWith(BinaryTree& other)
+{
+    if (&other == this) return;
+    runSetOperation(TreeJoin::Operation::Union, other, "Объединение деревьев");
+}
+
+void BinaryTree::intersectWith(BinaryTree& other)
+{
+    if (&other == this) return;
+    runSetOperation(TreeJoin::Operation::Intersection, other, "Пересечение деревьев");
+}
+
+void BinaryTree::differenceWith(BinaryTree& other)
+{
+    if (&other == this) {
+        clear();
+        return;
+    }
+    runSetOperation(TreeJoin::Operation::Difference, other, "Разность деревьев");
+}
+
+void BinaryTree::runSetOperation(TreeJoin::Operation operation, BinaryTree& other, const QString& description)
+{
+    CountingScope counting(this, TreeOperation::SetOperation);
+    emit operationStarted(description);
+
+    const int combinedSize = m_size + other.m_size;
+    TreeJoin join(TreeJoin::parallelDepthFor(combinedSize));
+
+    // Узлы меняют владельца и исчезают: слушатели обоих деревьев
+    // забывают указатели заранее, как при clear()
+    emit treeCleared();
+    emit other.treeCleared();
+
+    TreeNode* a = m_hashTreap ? m_root : join.rebuildAsTreap(m_root);
+    TreeNode* b = other.m_hashTreap ? other.m_root : join.rebuildAsTreap(other.m_root);
+
+    m_root = join.apply(operation, a, b);
+    m_hashTreap = true;
+    other.m_root = nullptr;
+    other.m_size = 0;
+    other.m_hashTreap = true;
+
+    const qint64 deleted = adoptNodes(other, join.dropped());
+    m_size = int(combinedSize - deleted);
+
+    m_counters.comparisons += join.comparisons();
+    m_counters.deallocations += deleted;
+
+    emit structureChanged();
+    emit other.structureChanged();
+    emit operationFinished("Операция над множествами завершена");
+}
+
+qint64 BinaryTree::adoptNodes(BinaryTree& other, const std::vector<TreeNode*>& droppedRoots)
+{
+    // Выброшенные поддеревья - в плоский набор узлов
+    QSet<const TreeNode*> deleted;
+    std::vector<TreeNode*> own;
+    std::vector<TreeNode*> stack(droppedRoots.begin(), droppedRoots.end());
+
+    while (!stack.empty()) {
+        TreeNode* node = stack.back();
+        stack.pop_back();
+
+        if (node->left()) stack.push_back(node->left());
+        if (node->right()) stack.push_back(node->right());
+
+        // Бывший родитель мог остаться в результате: деструктор не должен
+        // трогать его ссылки
+        node->m_parent = nullptr;
+        deleted.insert(node);
+        if (static_cast<QObject*>(node)->parent() == this) {
+            own.push_back(node);
+        }
+    }
+
+    if (own.size() <= std::size_t(kDirectDeleteLimit)) {
+        for (TreeNode* node : own) {
+            delete node;
+        }
+    } else {
+        QObject holder;
+        moveTreeNodes(*this, holder, nullptr);
+        moveTreeNodes(holder, *this, &deleted);
+    }
+    moveTreeNodes(other, *this, &deleted);
+
+    return deleted.size();
+}
+
+void BinaryTree::resetVisitCounts()
+{
+    std::vector<TreeNode*> stack;
+    if (m_root) {
+        stack.push_back(m_root);
+    }
+
+    while (!stack.empty()) {
+        TreeNode* node = stack.back();
+        stack.pop_back();
+        node->resetVisits();
+
+        if (node->left()) stack.push_back(node->left());
+        if (node->right()) stack.push_back(node->right());
+    }
+}
+
+void BinaryTree::appendMemoryUsage(MemoryReport& report) const
+{
+    qint64 nodeBytes = 0;
+    qint64 privateBytes = 0;
+    qint64 guardBytes = 0;
+    qint64 guardedNodes = 0;
+
+    std::vector<const TreeNode*> stack;
+    if (m_root) {
+        stack.push_back(m_root);
+    }
+
+    while (!stack.empty()) {
+        const TreeNode* node = stack.back();
+        stack.pop_back();
+
+        nodeBytes += MemoryReport::allocationBytes(node, sizeof(TreeNode));
+        privateBytes += MemoryReport::allocationBytes(node->qobjectPrivate(), sizeof(QObjectData));
+
+        // На узел смотрят QPointer родителя и детей - у него есть общий guard-блок
+        if (const void* guard = node->guardBlock()) {
+            guardBytes += MemoryReport::allocationBytes(guard, sizeof(QtSharedPointer::ExternalRefCountData));
+            ++guardedNodes;
+        }
+
+        if (node->left()) stack.push_back(node->left());
+        if (node->right()) stack.push_back(node->right());
+    }
+
+    const qint64 nodes = m_size;
+    report.add("core", "TreeNode objects", nodes, nodeBytes);
+    report.add("core", "QObjectPrivate blocks", nodes, privateBytes);
+    report.add("core", "QPointer guard blocks", guardedNodes, guardBytes);
+
+    // Узлы - QObject-дети дерева, их список лежит в приватных данных дерева
+    const QObjectList& children = this->children();
+    report.add("core", "Tree children list", children.size(),
+               MemoryReport::estimateAllocation(children.capacity() * sizeof(QObject*) + sizeof(QArrayData)), true);
+}
+
+// === Пошаговые операции ===
+
+TreeTask BinaryTree::insertSteps(int value)
+{
+    OperationCounters counters;
+    startSteps(TreeOperation::Insert);
+    emit operationStarted(QString("Вставка значения %1").arg(value));
+
+    TreeNode* parent = nullptr;
+    TreeNode* current = m_root;
+    int depth = 0;
+
+    while (current) {
+        touchStepNode(counters, current, depth);
+        ++counters.comparisons;
+        co_await TreeStep{TreeStep::Kind::Compare, current, depth};
+
+        parent = current;
+        // Дубликаты идут в правое поддерево, как в insert()
+        current = value < current->value() ? current->left() : current->right();
+        ++depth;
+    }
+
+    TreeNode* node = linkNewNode(parent, value);
+    ++counters.allocations;
+    emit nodeInserted(node);
+    emit structureChanged();
+    co_await TreeStep{TreeStep::Kind::Inserted, node, depth};
+
+    if (m_splayMode) {
+        co_await splaySteps(node, depth, counters);
+    }
+
+    finishSteps(TreeOperation::Insert, counters);
+    emit operationFinished("Вставка завершена");
+}
+
+TreeTask BinaryTree::removeSteps(int value)
+{
+    OperationCounters counters;
+    startSteps(TreeOperation::Remove);
+    emit operationStarted(QString("Удаление значения %1").arg(value));
+
+    TreeNode* current = m_root;
+    int depth = 0;
+
+    while (current) {
+        touchStepNode(counters, current, depth);
+        ++counters.comparisons;
+        co_await TreeStep{TreeStep::Kind::Compare, current, depth};
+
+        if (value == current->value()) {
+            break;
+        }
+        current = value < current->value() ? current->left() : current->right();
+        ++depth;
+    }
+
+    if (!current) {
+        co_await TreeStep{TreeStep::Kind::NotFound, nullptr, depth};
+        finishSteps(TreeOperation::Remove, counters);
+        emit operationFinished("Значение не найдено");
+        co_return;
+    }
+
+    co_await TreeStep{TreeStep::Kind::Found, current, depth};
+
+    TreeNode* victim = current;
+    if (current->hasLeft() && current->hasRight()) {
+        // Два ребенка: значение заменяется минимумом правого поддерева,
+        // а удаляется узел минимума
+        victim = current->right();
+        touchStepNode(counters, victim, ++depth);
+        co_await TreeStep{TreeStep::Kind::Visit, victim, depth};
+
+        while (victim->left()) {
+            victim = victim->left();
+            touchStepNode(counters, victim, ++depth);
+            co_await TreeStep{TreeStep::Kind::Visit, victim, depth};
+        }
+
+        const_cast<int&>(current->m_value) = victim->value();
+    }
+
+    unlinkNode(victim);
+    ++counters.deallocations;
+    emit structureChanged();
+
+    finishSteps(TreeOperation::Remove, counters);
+    emit operationFinished("Удаление завершено");
+}
+
+TreeTask BinaryTree::findSteps(int value)
+{
+    OperationCounters counters;
+    startSteps(m_splayMode ? TreeOperation::Access : TreeOperation::Find);
+
+    TreeNode* current = m_root;
+    TreeNode* last = nullptr;
+    int depth = 0;
+
+    while (current) {
+        touchStepNode(counters, current, depth);
+        ++counters.comparisons;
+        co_await TreeStep{TreeStep::Kind::Compare, current, depth};
+
+        last = current;
+        if (value == current->value()) {
+            break;
+        }
+        current = value < current->value() ? current->left() : current->right();
+        ++depth;
+    }
+
+    if (current) {
+        co_await TreeStep{TreeStep::Kind::Found, current, depth};
+    } else {
+        co_await TreeStep{TreeStep::Kind::NotFound, last, qMax(0, depth - 1)};
+    }
+
+    // Как в access(): при промахе поднимается последний узел пути
+    if (m_splayMode && last) {
+        co_await splaySteps(last, current ? depth : depth - 1, counters);
+    }
+
+    finishSteps(m_splayMode ? TreeOperation::Access : TreeOperation::Find, counters);
+}
+
+TreeTask BinaryTree::splaySteps(TreeNode* node, int depth, OperationCounters& counters)
+{
+    PlannedRotation plan[2];
+
+    // Остановка и structureChanged - на шаг splay (zig, zig-zig, zig-zag),
+    // а не на каждый поворот: сами повороты визуализатор видит по nodeRotated
+    while (const int count = planSplayStep(node, plan)) {
+        for (int i = 0; i < count; ++i) {
+            ++counters.rotations;
+            counters.nodesTouched += plan[i].node->parent() ? 3 : 2;
+            rotateLinks(plan[i].node, plan[i].left);
+        }
+        depth -= count;
+        emit structureChanged();
+        co_await TreeStep{TreeStep::Kind::Rotated, node, depth};
+    }
+}
+
+void BinaryTree::unlinkNode(TreeNode* node)
+{
+    TreeNode* child = node->hasLeft() ? node->left() : node->right();
+    if (child) {
+        child->setParent(node->parent());
+    }
+
+    if (node->parent()) {
+        updateParentLink(node, child);
+    } else {
+        m_root = child;
+    }
+
+    m_size--;
+    m_hashTreap = false;
+    emit nodeRemoved(node);
+    node->deleteLater();
+}
+
+void BinaryTree::startSteps(TreeOperation operation)
+{
+    if (m_tracer) {
+        m_tracer->operationStarted(operation);
+    }
+}
+
+void BinaryTree::finishSteps(TreeOperation operation, const OperationCounters& counters)
+{
+    if (m_tracer) {
+        m_tracer->operationFinished();
+    }
+    m_statistics.record(operation, counters);
+    emit countersUpdated();
+}
+
 // === Методы для алгоритмов балансировки ===
 
 void BinaryTree::setRoot(TreeNode* newRoot)
 {
     if (m_root == newRoot) return;
+    m_hashTreap = false;
 
     // Отсоединяем старый корень
     if (m_root) {
@@ -213,35 +891,13 @@ void BinaryTree::rotateLeft(TreeNode* node)
 {
     if (!node || !node->right()) return;
 
+    CountingScope counting(this, TreeOperation::Rotate);
+    ++m_counters.rotations;
+    // Узел, опорный узел и родитель, чья ссылка переписывается
+    m_counters.nodesTouched += node->parent() ? 3 : 2;
     emit operationStarted("Поворот влево");
 
-    TreeNode* pivot = node->right();
-    TreeNode* parent = node->parent();
-
-    // Перенаправляем связи
-    node->setRight(pivot->left());
-    if (pivot->left()) {
-        pivot->left()->setParent(node);
-    }
-
-    pivot->setLeft(node);
-    node->setParent(pivot);
-
-    pivot->setParent(parent);
-
-    // Обновляем ссылку родителя
-    if (parent) {
-        if (parent->left() == node) {
-            parent->setLeft(pivot);
-        } else {
-            parent->setRight(pivot);
-        }
-    }
-
-    // Если поворачивали корень
-    if (node == m_root) {
-        m_root = pivot;
-    }
+    rotateLinks(node, true);
 
     emit structureChanged();
     emit operationFinished("Поворот завершен");
@@ -251,20 +907,38 @@ void BinaryTree::rotateRight(TreeNode* node)
 {
     if (!node || !node->left()) return;
 
+    CountingScope counting(this, TreeOperation::Rotate);
+    ++m_counters.rotations;
+    // Узел, опорный узел и родитель, чья ссылка переписывается
+    m_counters.nodesTouched += node->parent() ? 3 : 2;
     emit operationStarted("Поворот вправо");
 
-    TreeNode* pivot = node->left();
+    rotateLinks(node, false);
+
+    emit structureChanged();
+    emit operationFinished("Поворот завершен");
+}
+
+TreeNode* BinaryTree::rotateLinks(TreeNode* node, bool left)
+{
+    TreeNode* pivot = left ? node->right() : node->left();
     TreeNode* parent = node->parent();
+    // Внутренний внук переходит от опорного узла к node
+    TreeNode* inner = left ? pivot->left() : pivot->right();
 
     // Перенаправляем связи
-    node->setLeft(pivot->right());
-    if (pivot->right()) {
-        pivot->right()->setParent(node);
+    if (left) {
+        node->setRight(inner);
+        pivot->setLeft(node);
+    } else {
+        node->setLeft(inner);
+        pivot->setRight(node);
+    }
+    if (inner) {
+        inner->setParent(node);
     }
 
-    pivot->setRight(node);
     node->setParent(pivot);
-
     pivot->setParent(parent);
 
     // Обновляем ссылку родителя
@@ -281,8 +955,9 @@ void BinaryTree::rotateRight(TreeNode* node)
         m_root = pivot;
     }
 
-    emit structureChanged();
-    emit operationFinished("Поворот завершен");
+    m_hashTreap = false;
+    emit nodeRotated(node, pivot);
+    return pivot;
 }
 
 void BinaryTree::swapNodes(TreeNode* node1, TreeNode* node2)
@@ -293,6 +968,7 @@ void BinaryTree::swapNodes(TreeNode* node1, TreeNode* node2)
 
     // Меняем значения (требует изменения TreeNode)
     std::swap(const_cast<int&>(node1->m_value), const_cast<int&>(node2->m_value));
+    m_hashTreap = false;
 
     emit structureChanged();
     emit operationFinished("Обмен завершен");
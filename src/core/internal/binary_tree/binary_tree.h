@@ -7,7 +7,16 @@
 #include <QVector>
 #include <QDebug>
 
+#include <span>
+
 #include "tree_node.h"
+#include "frozen_tree_index.h"
+#include "operation_counters.h"
+#include "node_access_tracer.h"
+#include "tree_step.h"
+#include "tree_join.h"
+
+class MemoryReport;
 
 
 class BinaryTree : public QObject
@@ -20,14 +29,42 @@ public:
 
     // Базовые операции (для пользовательского кода)
     void insert(int value);
+    // Вставка без дубликатов (семантика множества); false - ключ уже был.
+    // В splay-режиме найденный узел поднимается в корень, как в access()
+    bool insertUnique(int value);
     void remove(int value);
     TreeNode* find(int value) const;
+    // Пакетный поиск: out[i] = find(keys[i]). Поиски идут вперемешку,
+    // следующий узел каждого подгружается заранее, пока обрабатываются
+    // остальные, поэтому промахи кэша разных ключей перекрываются.
+    // Сигналы comparisonMade при этом не отправляются. out не короче keys.
+    void findBatch(std::span<const int> keys, std::span<TreeNode*> out) const;
+    QVector<TreeNode*> findBatch(const QVector<int>& keys) const;
+    // Сколько ключей в [low, high]: спуск к low и обход по порядку до high,
+    // O(высота + ответ). Сигналы не отправляются
+    int countRange(int low, int high) const;
     void clear();
 
+    // Те же операции пошагово: корутина останавливается на каждом сравнении,
+    // посещении и повороте, продвигает ее TreeTask::resume(). Сигналы
+    // comparisonMade не отправляются - визуализатор сам показывает шаги;
+    // структурные сигналы идут как обычно. Статистика записывается в конце,
+    // брошенная на полпути операция в нее не попадает. Пока задача спит,
+    // дерево нельзя менять другими операциями.
+    TreeTask insertSteps(int value);
+    TreeTask removeSteps(int value);
+    // С учетом splay-режима, как access()
+    TreeTask findSteps(int value);
+
+    // Снимок дерева в статический кэш-дружественный индекс (для фаз только чтения)
+    FrozenTreeIndex freeze() const;
+
     // Для работы с визуализацией и алгоритмами
     TreeNode* root() const { return m_root; }
     bool isEmpty() const { return m_root == nullptr; }
     int size() const { return m_size; }
+    // Число уровней (пустое дерево - 0); обход всего дерева без рекурсии
+    int height() const;
 
     // Для учебных целей - прямой доступ к операциям
     // (будут вызываться из пользовательского кода балансировки)
@@ -39,6 +76,50 @@ public:
     // Генерация дерева
     void buildFromValues(const QVector<int>& values);
 
+    // Операции над множествами ключей (tree_join.h). Результат остается в
+    // этом дереве и собирается из узлов обоих; other отдает свои узлы и
+    // становится пустым, как источник в std::set::merge. Повторы ключей
+    // схлопываются. Дерево держится декартовым с приоритетом-хешем ключа:
+    // после вставок, удалений и поворотов оно один раз перестраивается за
+    // O(n), дальше операция с деревом из m <= n узлов стоит ожидаемо
+    // O(m log(n/m + 1)) сравнений плюс O(m) на передачу узлов other.
+    // На больших деревьях ветви рекурсии идут параллельно в QThreadPool.
+    void unionWith(BinaryTree& other);
+    void intersectWith(BinaryTree& other);
+    // Ключи этого дерева, которых нет в other
+    void differenceWith(BinaryTree& other);
+
+    // Стоимость операций: последняя и накопленные суммы по видам.
+    // Вложенные вызовы (find внутри remove, повороты внутри splay)
+    // засчитываются внешней операции.
+    const OperationStatistics& statistics() const { return m_statistics; }
+    void resetStatistics();
+
+    // Счетчики посещений в узлах (для тепловой карты). Выключены - в пути
+    // поиска остается одна проверка флага.
+    void setVisitCounting(bool enabled) { m_countVisits = enabled; }
+    bool visitCounting() const { return m_countVisits; }
+    void resetVisitCounts();
+
+    // Трассировка обращений к узлам (модель кэша и т.п.). Дерево не владеет
+    // трассировщиком; nullptr - выключено.
+    void setAccessTracer(NodeAccessTracer* tracer) { m_tracer = tracer; }
+    NodeAccessTracer* accessTracer() const { return m_tracer; }
+
+    // Память узлов в группу "core": объекты, QObjectPrivate, guard-блоки QPointer
+    void appendMemoryUsage(MemoryReport& report) const;
+
+    // Режим splay-дерева: найденный или вставленный узел поднимается в корень
+    // поворотами rotateLeft/rotateRight, и часто запрашиваемые ключи
+    // оказываются у корня
+    void setSplayMode(bool enabled) { m_splayMode = enabled; }
+    bool splayMode() const { return m_splayMode; }
+    // Поиск с учетом режима: в splay-режиме поднимает в корень найденный
+    // узел (или последний узел на пути, если значения нет)
+    TreeNode* access(int value);
+    // Поднимает узел в корень (zig / zig-zig / zig-zag) без рекурсии
+    void splay(TreeNode* node);
+
 signals:
     // Сигналы для визуализатора
     void nodeInserted(TreeNode* node);
@@ -51,8 +132,12 @@ signals:
     void nodeVisited(TreeNode* node);
     void nodeCurrent(TreeNode* node);
     void comparisonMade(TreeNode* node1, TreeNode* node2);
+    // После каждого поворота: pivot занял место node
+    void nodeRotated(TreeNode* node, TreeNode* pivot);
     void operationStarted(const QString& description);
     void operationFinished(const QString& description);
+    // Внешняя операция завершилась, statistics().last() обновлен
+    void countersUpdated();
 
 public slots:
     // Слоты для визуальной обратной связи
@@ -62,15 +147,106 @@ public slots:
     void markComparison(TreeNode* node1, TreeNode* node2);
 
 private:
+    // Открывает счет операции; вложенные области пишут в счетчики внешней
+    class CountingScope
+    {
+    public:
+        CountingScope(const BinaryTree* tree, TreeOperation operation);
+        ~CountingScope();
+
+    private:
+        const BinaryTree* m_tree;
+        Q_DISABLE_COPY(CountingScope)
+    };
+
+    friend class BinaryTreeBuilder;
+
     // Внутренние вспомогательные методы
-    TreeNode* insertRecursive(TreeNode* node, int value, TreeNode* parent = nullptr);
-    TreeNode* removeRecursive(TreeNode* node, int value);
+    // Общая часть insert/insertUnique; false - unique и ключ уже есть
+    bool insertValue(int value, bool unique);
+    // Новый узел ребенком parent по правилу вставки (корнем при nullptr)
+    TreeNode* linkNewNode(TreeNode* parent, int value);
     TreeNode* findMin(TreeNode* node) const;
-    void deleteSubtree(TreeNode* node);
+    void deleteAllNodes();
+    void runSetOperation(TreeJoin::Operation operation, BinaryTree& other, const QString& description);
+    // Узлы other переходят к этому дереву, выброшенные узлы удаляются.
+    // Возвращает число удаленных
+    qint64 adoptNodes(BinaryTree& other, const std::vector<TreeNode*>& droppedRoots);
     void updateParentLink(TreeNode* node, TreeNode* newChild);
+    // Повороты без structureChanged на каждом шаге; возвращает число поворотов
+    int splayInternal(TreeNode* node);
+
+    struct PlannedRotation
+    {
+        TreeNode* node;
+        bool left;
+    };
+    // Очередной шаг восходящего splay: 0 поворотов (узел - корень),
+    // 1 (zig) или 2 (zig-zig, zig-zag) в порядке выполнения
+    static int planSplayStep(TreeNode* node, PlannedRotation (&plan)[2]);
+    // Перестановка связей поворота и nodeRotated, без счетчиков; возвращает pivot
+    TreeNode* rotateLinks(TreeNode* node, bool left);
+    // Удаляет узел не более чем с одним ребенком, поднимая ребенка на его место
+    void unlinkNode(TreeNode* node);
+    // Splay с остановкой после каждого поворота (depth - глубина узла)
+    TreeTask splaySteps(TreeNode* node, int depth, OperationCounters& counters);
+
+    // depth < 0 - глубина неизвестна (поиск минимума)
+    void touchNode(const TreeNode* node, int depth = -1) const
+    {
+        if (m_countVisits) {
+            node->recordVisit();
+        }
+        if (m_tracer) {
+            m_tracer->nodeTouched(node, depth, NodeRead::WithQObject);
+        }
+
+        ++m_counters.nodesTouched;
+        if (depth > m_counters.maxDepth) {
+            m_counters.maxDepth = depth;
+        }
+    }
+
+    // Пошаговые операции ведут свои счетчики: между остановками
+    // могут идти поиски со своей CountingScope. Трассировщик получает
+    // узлы так же, как от touchNode, - модель кэша видит оба пути
+    void touchStepNode(OperationCounters& counters, const TreeNode* node, int depth) const
+    {
+        if (m_countVisits) {
+            node->recordVisit();
+        }
+        if (m_tracer) {
+            m_tracer->nodeTouched(node, depth, NodeRead::WithQObject);
+        }
+
+        ++counters.nodesTouched;
+        if (depth > counters.maxDepth) {
+            counters.maxDepth = depth;
+        }
+    }
+    // Начало и конец пошаговой операции для трассировщика; finishSteps еще
+    // записывает статистику
+    void startSteps(TreeOperation operation);
+    void finishSteps(TreeOperation operation, const OperationCounters& counters);
 
     TreeNode* m_root = nullptr;
     int m_size = 0;
+    bool m_splayMode = false;
+    bool m_countVisits = false;
+    // Форма - декартово дерево TreeJoin без повторов ключей (пустое - тоже);
+    // сбрасывается любым изменением связей
+    bool m_hashTreap = true;
+    NodeAccessTracer* m_tracer = nullptr;
+
+    // Удаление своего узла ищет его в списке детей QObject за O(n); больше
+    // стольких - дешевле пропустить всех детей через временного владельца
+    static constexpr int kDirectDeleteLimit = 64;
+
+    // Счетчики меняются и в const-поиске
+    mutable OperationCounters m_counters;
+    mutable OperationStatistics m_statistics;
+    mutable TreeOperation m_countingOperation = TreeOperation::Find;
+    mutable int m_countingDepth = 0;
 
     Q_DISABLE_COPY(BinaryTree)
 };
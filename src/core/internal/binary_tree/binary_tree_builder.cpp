@@ -0,0 +1,57 @@
+#include "binary_tree_builder.h"
+
+#include "binary_tree.h"
+
+BinaryTreeBuilder::BinaryTreeBuilder(BinaryTree* tree)
+    : m_tree(tree)
+{
+    Q_ASSERT(m_tree && m_tree->isEmpty());
+}
+
+TreeNode* BinaryTreeBuilder::createNode(int key)
+{
+    TreeNode* node = new TreeNode(key, m_tree);
+    ++m_tree->m_size;
+    m_tree->m_hashTreap = false;
+    ++m_count;
+    return node;
+}
+
+void BinaryTreeBuilder::appendInOrder(int key, quint64 priority)
+{
+    TreeNode* node = createNode(key);
+
+    // Узлы правого пути, вставленные позже нового, уходят в его левое поддерево
+    TreeNode* displaced = nullptr;
+    while (!m_rightPath.empty() && m_rightPath.back().priority > priority) {
+        displaced = m_rightPath.back().node;
+        m_rightPath.pop_back();
+    }
+
+    if (displaced) {
+        node->setLeft(displaced);
+    }
+
+    if (m_rightPath.empty()) {
+        m_tree->m_root = node;
+    } else {
+        m_rightPath.back().node->setRight(node);
+    }
+
+    m_rightPath.push_back({node, priority});
+}
+
+void BinaryTreeBuilder::appendToChain(int key, bool left)
+{
+    TreeNode* node = createNode(key);
+
+    if (!m_chainTail) {
+        m_tree->m_root = node;
+    } else if (left) {
+        m_chainTail->setLeft(node);
+    } else {
+        m_chainTail->setRight(node);
+    }
+
+    m_chainTail = node;
+}
@@ -0,0 +1,48 @@
+// core/internal/binary_tree/binary_tree_builder.h
+#ifndef BINARYTREEBUILDER_H
+#define BINARYTREEBUILDER_H
+
+#include <QtGlobal>
+
+#include <vector>
+
+class BinaryTree;
+class TreeNode;
+
+// Построение большого дерева по одному узлу без спуска от корня и без
+// сигналов - для генераторов, которые собирают дерево кусками.
+// Дерево до начала должно быть пустым; по ходу сборки оно уже корректно,
+// так что прерванную сборку можно просто удалить вместе с деревом.
+class BinaryTreeBuilder
+{
+public:
+    explicit BinaryTreeBuilder(BinaryTree* tree);
+
+    // Ключи строго по возрастанию; priority - момент вставки ключа (меньше -
+    // раньше). Получается ровно то дерево, которое дала бы вставка ключей в
+    // порядке приоритетов (декартово дерево): со случайными приоритетами это
+    // случайное BST. Амортизированно O(1), память - правый путь дерева.
+    void appendInOrder(int key, quint64 priority);
+
+    // Вырожденное дерево: узел становится левым (правым) ребенком предыдущего.
+    // Ключи должны строго убывать (возрастать) - как при вставке по порядку.
+    void appendToChain(int key, bool left);
+
+    qint64 count() const { return m_count; }
+
+private:
+    struct PathEntry
+    {
+        TreeNode* node;
+        quint64 priority;
+    };
+
+    TreeNode* createNode(int key);
+
+    BinaryTree* m_tree;
+    std::vector<PathEntry> m_rightPath;   // Правый путь от корня, приоритеты растут
+    TreeNode* m_chainTail = nullptr;
+    qint64 m_count = 0;
+};
+
+#endif // BINARYTREEBUILDER_H
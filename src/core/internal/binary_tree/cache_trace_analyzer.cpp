@@ -0,0 +1,169 @@
+#include "cache_trace_analyzer.h"
+
+#include <QStringList>
+
+#include <algorithm>
+
+void CacheTraceAnalyzer::MissCounts::add(const CacheSimulator::AccessResult& result, int lineCount)
+{
+    ++accesses;
+    lines += lineCount;
+    l1Misses += result.servedBy > CacheSimulator::ServedBy::L1;
+    l2Misses += result.servedBy > CacheSimulator::ServedBy::L2;
+    llcMisses += result.servedBy == CacheSimulator::ServedBy::Memory;
+    tlbMisses += result.tlbMiss;
+}
+
+CacheTraceAnalyzer::MissCounts& CacheTraceAnalyzer::MissCounts::operator+=(const MissCounts& other)
+{
+    accesses += other.accesses;
+    lines += other.lines;
+    l1Misses += other.l1Misses;
+    l2Misses += other.l2Misses;
+    llcMisses += other.llcMisses;
+    tlbMisses += other.tlbMisses;
+    return *this;
+}
+
+CacheTraceAnalyzer::CacheTraceAnalyzer(const CacheSimulator::Config& config, QObject* parent)
+    : QObject(parent)
+    , m_simulator(config)
+{
+}
+
+CacheTraceAnalyzer::~CacheTraceAnalyzer()
+{
+    attach(nullptr);
+}
+
+void CacheTraceAnalyzer::attach(BinaryTree* tree)
+{
+    if (m_tree && m_tree->accessTracer() == this) {
+        m_tree->setAccessTracer(nullptr);
+    }
+
+    m_tree = tree;
+    m_lastMisses.clear();
+    // Другое дерево - другие адреса, старое содержимое кэшей ни о чем не говорит
+    m_simulator.reset();
+
+    if (m_tree) {
+        m_tree->setAccessTracer(this);
+    }
+}
+
+void CacheTraceAnalyzer::resetStatistics()
+{
+    m_lastOperation = MissCounts();
+    m_total = MissCounts();
+    m_perLevel.clear();
+    m_lastMisses.clear();
+}
+
+void CacheTraceAnalyzer::operationStarted(TreeOperation operation)
+{
+    m_operationKind = operation;
+    m_operation = MissCounts();
+    m_operationMisses.clear();
+}
+
+void CacheTraceAnalyzer::readBlock(const void* address, std::size_t bytes,
+                                   CacheSimulator::AccessResult& step, int& lineCount)
+{
+    const quintptr line = quintptr(m_simulator.lineBytes());
+    const quintptr start = reinterpret_cast<quintptr>(address);
+    lineCount += int((start + bytes - 1) / line - start / line + 1);
+
+    const CacheSimulator::AccessResult result = m_simulator.accessRange(address, bytes);
+    step.servedBy = std::max(step.servedBy, result.servedBy);
+    step.tlbMiss = step.tlbMiss || result.tlbMiss;
+}
+
+void CacheTraceAnalyzer::addStep(const CacheSimulator::AccessResult& step, int lineCount, int depth)
+{
+    m_operation.add(step, lineCount);
+
+    if (depth >= 0) {
+        if (depth >= m_perLevel.size()) {
+            m_perLevel.resize(depth + 1);
+        }
+        m_perLevel[depth].add(step, lineCount);
+    }
+}
+
+void CacheTraceAnalyzer::nodeTouched(const TreeNode* node, int depth, NodeRead read)
+{
+    CacheSimulator::AccessResult result;
+    int lineCount = 0;
+    readBlock(node, sizeof(TreeNode), result, lineCount);
+
+    if (read == NodeRead::WithQObject) {
+        // К корню дерево идет по сырому m_root - guard-блок читается только
+        // при переходе по ссылке родителя. QObjectData - его заголовок
+        if (node->parent()) {
+            if (const void* guard = node->guardBlock()) {
+                readBlock(guard, sizeof(QtSharedPointer::ExternalRefCountData), result, lineCount);
+            }
+        }
+        readBlock(node->qobjectPrivate(), sizeof(QObjectData), result, lineCount);
+    }
+    addStep(result, lineCount, depth);
+
+    if (result.servedBy > CacheSimulator::ServedBy::L1) {
+        // Узел мог встретиться дважды (remove ищет его два раза) - оставляем худшее
+        CacheSimulator::ServedBy& worst = m_operationMisses[node];
+        worst = std::max(worst, result.servedBy);
+    }
+}
+
+void CacheTraceAnalyzer::memoryTouched(const void* address, std::size_t bytes, int depth)
+{
+    CacheSimulator::AccessResult result;
+    int lineCount = 0;
+    readBlock(address, bytes, result, lineCount);
+    addStep(result, lineCount, depth);
+}
+
+void CacheTraceAnalyzer::operationFinished()
+{
+    m_lastOperationKind = m_operationKind;
+    m_lastOperation = m_operation;
+    m_total += m_operation;
+    m_lastMisses.swap(m_operationMisses);
+
+    emit operationAnalyzed();
+}
+
+QString CacheTraceAnalyzer::summary() const
+{
+    const MissCounts& last = m_lastOperation;
+    return QString("Cache (%1): %2 nodes, %3 lines, miss L1 %4 / L2 %5 / LLC %6, TLB %7")
+        .arg(treeOperationName(m_lastOperationKind))
+        .arg(last.accesses)
+        .arg(last.lines)
+        .arg(last.l1Misses)
+        .arg(last.l2Misses)
+        .arg(last.llcMisses)
+        .arg(last.tlbMisses);
+}
+
+QString CacheTraceAnalyzer::levelReport() const
+{
+    QStringList lines;
+    lines.append("depth: accesses  L1  L2  LLC  TLB misses");
+
+    for (int depth = 0; depth < m_perLevel.size(); ++depth) {
+        const MissCounts& level = m_perLevel[depth];
+        if (level.accesses == 0) continue;
+
+        lines.append(QString("%1: %2  %3  %4  %5  %6")
+                         .arg(depth)
+                         .arg(level.accesses)
+                         .arg(level.l1Misses)
+                         .arg(level.l2Misses)
+                         .arg(level.llcMisses)
+                         .arg(level.tlbMisses));
+    }
+
+    return lines.join('\n');
+}
@@ -0,0 +1,89 @@
+// core/internal/binary_tree/cache_trace_analyzer.h
+#ifndef CACHETRACEANALYZER_H
+#define CACHETRACEANALYZER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QVector>
+
+#include "binary_tree.h"
+#include "node_access_tracer.h"
+#include "../../utils/cache_simulator.h"
+
+// Прогоняет адреса узлов, которых касается дерево, через модель кэшей.
+// Кэши остаются теплыми между операциями, как в реальном процессе.
+// Шаг по TreeNode читает сам узел, guard-блок QPointer, по которому к нему
+// пришли, и QObjectData (пакетный поиск - только узел). Промах засчитывается
+// шагу, если хотя бы одна из прочитанных строк не нашлась на уровне.
+// FrozenTreeIndex и BPlusTree подключаются своим setAccessTracer.
+class CacheTraceAnalyzer : public QObject, public NodeAccessTracer
+{
+    Q_OBJECT
+
+public:
+    struct MissCounts
+    {
+        quint64 accesses = 0;   // Шагов: узлов или блоков памяти
+        quint64 lines = 0;      // Прочитанных строк кэша
+        quint64 l1Misses = 0;
+        quint64 l2Misses = 0;
+        quint64 llcMisses = 0;
+        quint64 tlbMisses = 0;
+
+        void add(const CacheSimulator::AccessResult& result, int lineCount);
+        MissCounts& operator+=(const MissCounts& other);
+    };
+
+    explicit CacheTraceAnalyzer(const CacheSimulator::Config& config = CacheSimulator::Config(),
+                                QObject* parent = nullptr);
+    ~CacheTraceAnalyzer() override;
+
+    // Подключается трассировщиком к дереву (отключаясь от прежнего)
+    void attach(BinaryTree* tree);
+    BinaryTree* tree() const { return m_tree; }
+
+    void resetCaches() { m_simulator.reset(); }
+    void resetStatistics();
+
+    TreeOperation lastOperationKind() const { return m_lastOperationKind; }
+    const MissCounts& lastOperation() const { return m_lastOperation; }
+    const MissCounts& total() const { return m_total; }
+    // Индекс - глубина узла (корень - 0), суммы за все операции
+    const QVector<MissCounts>& perLevel() const { return m_perLevel; }
+    // Узлы последней операции, не найденные в L1, и откуда их пришлось брать
+    const QHash<const TreeNode*, CacheSimulator::ServedBy>& lastMisses() const { return m_lastMisses; }
+
+    QString summary() const;
+    QString levelReport() const;
+
+    void operationStarted(TreeOperation operation) override;
+    void nodeTouched(const TreeNode* node, int depth, NodeRead read) override;
+    void memoryTouched(const void* address, std::size_t bytes, int depth) override;
+    void operationFinished() override;
+
+signals:
+    void operationAnalyzed();
+
+private:
+    // Добавляет блок к шагу: худший уровень из блоков, строки суммируются
+    void readBlock(const void* address, std::size_t bytes, CacheSimulator::AccessResult& step, int& lineCount);
+    void addStep(const CacheSimulator::AccessResult& step, int lineCount, int depth);
+
+    QPointer<BinaryTree> m_tree;
+    CacheSimulator m_simulator;
+
+    TreeOperation m_operationKind = TreeOperation::Find;
+    MissCounts m_operation;
+
+    TreeOperation m_lastOperationKind = TreeOperation::Find;
+    MissCounts m_lastOperation;
+    MissCounts m_total;
+    QVector<MissCounts> m_perLevel;
+    QHash<const TreeNode*, CacheSimulator::ServedBy> m_lastMisses;
+    QHash<const TreeNode*, CacheSimulator::ServedBy> m_operationMisses;
+
+    Q_DISABLE_COPY(CacheTraceAnalyzer)
+};
+
+#endif // CACHETRACEANALYZER_H
@@ -0,0 +1,116 @@
+#include "frozen_tree_index.h"
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "node_access_tracer.h"
+#include "../../utils/prefetch.h"
+
+namespace
+{
+
+// Количество младших единичных битов
+inline unsigned countTrailingOnes(std::uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return value == ~std::uint64_t(0) ? 64u : unsigned(__builtin_ctzll(~value));
+#elif defined(_MSC_VER)
+    unsigned long index = 0;
+    return _BitScanForward64(&index, ~value) ? unsigned(index) : 64u;
+#else
+    unsigned count = 0;
+    while (value & 1) {
+        value >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+}
+
+FrozenTreeIndex::FrozenTreeIndex(const std::vector<int>& keys, const std::vector<TreeNode*>& nodes)
+    : m_size(keys.size())
+{
+    if (m_size == 0) return;
+
+    const std::size_t capacity = m_size + 1;
+    m_keys.reset(static_cast<int*>(::operator new[](capacity * sizeof(int), std::align_val_t(kCacheLine))));
+    m_nodes.assign(m_size + 1, nullptr);
+
+    std::size_t sortedIndex = 0;
+    fillEytzinger(keys, nodes, sortedIndex, 1);
+}
+
+void FrozenTreeIndex::fillEytzinger(const std::vector<int>& keys, const std::vector<TreeNode*>& nodes,
+                                    std::size_t& sortedIndex, std::size_t k)
+{
+    // Обход полного дерева в симметричном порядке раскладывает
+    // отсортированные ключи по BFS-позициям. Глубина рекурсии - log2(n).
+    if (k > m_size) return;
+
+    fillEytzinger(keys, nodes, sortedIndex, 2 * k);
+    m_keys[k] = keys[sortedIndex];
+    m_nodes[k] = sortedIndex < nodes.size() ? nodes[sortedIndex] : nullptr;
+    ++sortedIndex;
+    fillEytzinger(keys, nodes, sortedIndex, 2 * k + 1);
+}
+
+std::size_t FrozenTreeIndex::lowerBoundIndex(int key) const
+{
+    const int* keys = m_keys.get();
+    std::uint64_t k = 1;
+
+    while (k <= m_size) {
+        // Потомки на 4 уровня ниже лежат в одной кэш-линии
+        const std::uint64_t ahead = k * kKeysPerLine;
+        if (ahead <= m_size) {
+            prefetchForRead(keys + ahead);
+        }
+        k = 2 * k + (keys[k] < key);
+    }
+
+    // Путь закончился уходом вправо после последнего шага влево:
+    // снимаем хвост из единиц и сам этот шаг
+    k >>= countTrailingOnes(k) + 1;
+    return std::size_t(k);
+}
+
+std::size_t FrozenTreeIndex::tracedLowerBoundIndex(int key) const
+{
+    m_tracer->operationStarted(TreeOperation::Find);
+
+    const int* keys = m_keys.get();
+    std::uint64_t k = 1;
+    int depth = 0;
+    while (k <= m_size) {
+        // Подкачка - не чтение: модель видит только сам ключ уровня
+        m_tracer->memoryTouched(keys + k, sizeof(int), depth++);
+        k = 2 * k + (keys[k] < key);
+    }
+    k >>= countTrailingOnes(k) + 1;
+
+    if (k) {
+        m_tracer->memoryTouched(&m_nodes[k], sizeof(TreeNode*), -1);
+    }
+    m_tracer->operationFinished();
+    return std::size_t(k);
+}
+
+TreeNode* FrozenTreeIndex::lowerBound(int key) const
+{
+    if (m_size == 0) return nullptr;
+
+    const std::size_t k = m_tracer ? tracedLowerBoundIndex(key) : lowerBoundIndex(key);
+    return k ? m_nodes[k] : nullptr;
+}
+
+TreeNode* FrozenTreeIndex::find(int key) const
+{
+    if (m_size == 0) return nullptr;
+
+    const std::size_t k = m_tracer ? tracedLowerBoundIndex(key) : lowerBoundIndex(key);
+    return (k && m_keys[k] == key) ? m_nodes[k] : nullptr;
+}
@@ -0,0 +1,71 @@
+// core/internal/binary_tree/frozen_tree_index.h
+#ifndef FROZENTREEINDEX_H
+#define FROZENTREEINDEX_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+class NodeAccessTracer;
+class TreeNode;
+
+// Статический снимок дерева для фаз "только чтение".
+// Ключи лежат в одном выровненном массиве в порядке Эйтцингера (BFS-порядок
+// полного дерева): потомки k - это 2k и 2k+1, поэтому несколько следующих
+// уровней поиска попадают в одну-две кэш-линии и их можно заранее подгрузить.
+// Поиск без ветвлений: на каждом уровне только сравнение и сдвиг индекса.
+//
+// Снимок не следит за деревом: после insert/remove/rotate его нужно
+// построить заново через BinaryTree::freeze().
+class FrozenTreeIndex
+{
+public:
+    FrozenTreeIndex() = default;
+    // keys должны быть отсортированы, nodes[i] - узел с ключом keys[i]
+    FrozenTreeIndex(const std::vector<int>& keys, const std::vector<TreeNode*>& nodes);
+
+    FrozenTreeIndex(FrozenTreeIndex&&) noexcept = default;
+    FrozenTreeIndex& operator=(FrozenTreeIndex&&) noexcept = default;
+
+    // Узел с заданным ключом или nullptr
+    TreeNode* find(int key) const;
+    // Первый узел с ключом >= key или nullptr
+    TreeNode* lowerBound(int key) const;
+    bool contains(int key) const { return find(key) != nullptr; }
+
+    std::size_t size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    // Трассировка чтений снимка (модель кэша): каждый find/lowerBound - операция
+    // Find, шаг - ключ уровня. Снимок не владеет трассировщиком; nullptr - выключено
+    void setAccessTracer(NodeAccessTracer* tracer) { m_tracer = tracer; }
+    NodeAccessTracer* accessTracer() const { return m_tracer; }
+
+private:
+    struct AlignedDeleter
+    {
+        void operator()(int* ptr) const { ::operator delete[](ptr, std::align_val_t(kCacheLine)); }
+    };
+
+    static constexpr std::size_t kCacheLine = 64;
+    // Сколько ключей помещается в кэш-линию: 16 * k - это потомки k через 4 уровня
+    static constexpr std::size_t kKeysPerLine = kCacheLine / sizeof(int);
+
+    // Индекс Эйтцингера первого ключа >= key, 0 если такого нет
+    std::size_t lowerBoundIndex(int key) const;
+    // То же с трассировкой; отдельный цикл, чтобы не ветвиться в горячем
+    std::size_t tracedLowerBoundIndex(int key) const;
+    void fillEytzinger(const std::vector<int>& keys, const std::vector<TreeNode*>& nodes,
+                       std::size_t& sortedIndex, std::size_t k);
+
+    std::size_t m_size = 0;
+    std::unique_ptr<int[], AlignedDeleter> m_keys;  // 1-based, m_keys[0] не используется
+    std::vector<TreeNode*> m_nodes;                  // Тот же порядок, что и у m_keys
+    NodeAccessTracer* m_tracer = nullptr;
+
+    FrozenTreeIndex(const FrozenTreeIndex&) = delete;
+    FrozenTreeIndex& operator=(const FrozenTreeIndex&) = delete;
+};
+
+#endif // FROZENTREEINDEX_H
@@ -0,0 +1,42 @@
+// core/internal/binary_tree/node_access_tracer.h
+#ifndef NODEACCESSTRACER_H
+#define NODEACCESSTRACER_H
+
+#include <cstddef>
+
+#include "operation_counters.h"
+
+class TreeNode;
+
+// Что прочитано вместе с объектом узла на шаге
+enum class NodeRead
+{
+    // Только сам TreeNode: пакетный поиск идет по сырым ссылкам
+    Object,
+    // Еще guard-блок QPointer, через который пришли к узлу, и QObjectData
+    // узла (d_ptr) - их читают left()/right()/parent() и setLeft/setRight
+    WithQObject
+};
+
+// Получает каждый узел, который дерево читает на пути операции, а также
+// чтения структур без TreeNode (FrozenTreeIndex, BPlusTree).
+// Вызовы идут в потоке, где выполняется операция дерева.
+class NodeAccessTracer
+{
+public:
+    virtual ~NodeAccessTracer() = default;
+
+    virtual void operationStarted(TreeOperation operation) { Q_UNUSED(operation); }
+    // depth < 0 - глубина неизвестна
+    virtual void nodeTouched(const TreeNode* node, int depth, NodeRead read) = 0;
+    // Один шаг спуска, читающий bytes байт с address: ключи снимка, узел B+ дерева
+    virtual void memoryTouched(const void* address, std::size_t bytes, int depth)
+    {
+        Q_UNUSED(address);
+        Q_UNUSED(bytes);
+        Q_UNUSED(depth);
+    }
+    virtual void operationFinished() {}
+};
+
+#endif // NODEACCESSTRACER_H
@@ -0,0 +1,122 @@
+#include "operation_counters.h"
+
+#include <QStringList>
+
+#include <algorithm>
+
+OperationCounters& OperationCounters::operator+=(const OperationCounters& other)
+{
+    operations += other.operations;
+    comparisons += other.comparisons;
+    rotations += other.rotations;
+    nodesTouched += other.nodesTouched;
+    allocations += other.allocations;
+    deallocations += other.deallocations;
+    maxDepth = std::max(maxDepth, other.maxDepth);
+    return *this;
+}
+
+QJsonObject OperationCounters::toJson() const
+{
+    // QJsonValue хранит числа как double - для счетчиков этого хватает с запасом
+    QJsonObject object;
+    object["operations"] = double(operations);
+    object["comparisons"] = double(comparisons);
+    object["rotations"] = double(rotations);
+    object["nodesTouched"] = double(nodesTouched);
+    object["allocations"] = double(allocations);
+    object["deallocations"] = double(deallocations);
+    object["maxDepth"] = maxDepth;
+    return object;
+}
+
+QString OperationCounters::csvHeader()
+{
+    return "operations,comparisons,rotations,nodes_touched,allocations,deallocations,max_depth";
+}
+
+QString OperationCounters::toCsvRow() const
+{
+    return QString("%1,%2,%3,%4,%5,%6,%7")
+        .arg(operations)
+        .arg(comparisons)
+        .arg(rotations)
+        .arg(nodesTouched)
+        .arg(allocations)
+        .arg(deallocations)
+        .arg(maxDepth);
+}
+
+QString treeOperationName(TreeOperation operation)
+{
+    switch (operation) {
+    case TreeOperation::Insert: return "insert";
+    case TreeOperation::Remove: return "remove";
+    case TreeOperation::Find:   return "find";
+    case TreeOperation::Access: return "access";
+    case TreeOperation::Splay:  return "splay";
+    case TreeOperation::Rotate: return "rotate";
+    case TreeOperation::Build:  return "build";
+    case TreeOperation::Clear:  return "clear";
+    case TreeOperation::Range:  return "range";
+    case TreeOperation::SetOperation: return "set";
+    case TreeOperation::Count:  break;
+    }
+    return "unknown";
+}
+
+OperationCounters OperationStatistics::total() const
+{
+    OperationCounters sum;
+    for (const OperationCounters& counters : m_totals) {
+        sum += counters;
+    }
+    return sum;
+}
+
+void OperationStatistics::record(TreeOperation operation, const OperationCounters& counters)
+{
+    m_last = counters;
+    m_last.operations = std::max<quint64>(1, counters.operations);
+    m_lastOperation = operation;
+    m_totals[int(operation)] += m_last;
+}
+
+void OperationStatistics::reset()
+{
+    m_last.reset();
+    m_lastOperation = TreeOperation::Find;
+    for (OperationCounters& counters : m_totals) {
+        counters.reset();
+    }
+}
+
+QJsonObject OperationStatistics::toJson() const
+{
+    QJsonObject perOperation;
+    for (int i = 0; i < kOperationKinds; ++i) {
+        perOperation[treeOperationName(TreeOperation(i))] = m_totals[i].toJson();
+    }
+
+    QJsonObject last = m_last.toJson();
+    last["operation"] = treeOperationName(m_lastOperation);
+
+    QJsonObject object;
+    object["last"] = last;
+    object["total"] = total().toJson();
+    object["operations"] = perOperation;
+    return object;
+}
+
+QString OperationStatistics::toCsv() const
+{
+    QStringList lines;
+    lines.append("operation," + OperationCounters::csvHeader());
+
+    for (int i = 0; i < kOperationKinds; ++i) {
+        lines.append(treeOperationName(TreeOperation(i)) + "," + m_totals[i].toCsvRow());
+    }
+    lines.append("total," + total().toCsvRow());
+
+    return lines.join('\n') + '\n';
+}
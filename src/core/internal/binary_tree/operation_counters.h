@@ -0,0 +1,73 @@
+// core/internal/binary_tree/operation_counters.h
+#ifndef OPERATIONCOUNTERS_H
+#define OPERATIONCOUNTERS_H
+
+#include <QtGlobal>
+#include <QJsonObject>
+#include <QString>
+
+#include <array>
+
+// Стоимость операций дерева в единицах работы, а не времени.
+// Счетчики обычные (не атомарные): дерево живет в одном потоке.
+struct OperationCounters
+{
+    quint64 operations = 0;     // Сколько операций сложено в этот блок
+    quint64 comparisons = 0;    // Сравнений ключей
+    quint64 rotations = 0;
+    quint64 nodesTouched = 0;   // Разыменованных узлов (спуск, повороты, поиск минимума)
+    quint64 allocations = 0;
+    quint64 deallocations = 0;
+    int maxDepth = 0;           // Самый глубокий узел, до которого дошли (корень - 0)
+
+    void reset() { *this = OperationCounters(); }
+    OperationCounters& operator+=(const OperationCounters& other);
+
+    QJsonObject toJson() const;
+    static QString csvHeader();
+    QString toCsvRow() const;
+};
+
+enum class TreeOperation
+{
+    Insert,
+    Remove,
+    Find,
+    Access,
+    Splay,
+    Rotate,
+    Build,
+    Clear,
+    Range,
+    SetOperation,
+    Count
+};
+
+QString treeOperationName(TreeOperation operation);
+
+// Последняя операция плюс суммы по видам операций
+class OperationStatistics
+{
+public:
+    static constexpr int kOperationKinds = int(TreeOperation::Count);
+
+    const OperationCounters& last() const { return m_last; }
+    TreeOperation lastOperation() const { return m_lastOperation; }
+    const OperationCounters& total(TreeOperation operation) const { return m_totals[int(operation)]; }
+    OperationCounters total() const;
+
+    void record(TreeOperation operation, const OperationCounters& counters);
+    void reset();
+
+    // {"last": {...}, "total": {...}, "operations": {"insert": {...}, ...}}
+    QJsonObject toJson() const;
+    // Строка на каждый вид операции и итоговая строка "total"
+    QString toCsv() const;
+
+private:
+    OperationCounters m_last;
+    TreeOperation m_lastOperation = TreeOperation::Find;
+    std::array<OperationCounters, kOperationKinds> m_totals;
+};
+
+#endif // OPERATIONCOUNTERS_H
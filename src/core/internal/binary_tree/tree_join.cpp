@@ -0,0 +1,266 @@
+#include "tree_join.h"
+
+#include "tree_node.h"
+#include "../../utils/parallel.h"
+
+#include <QThreadPool>
+
+#include <utility>
+
+TreeJoin::TreeJoin(int parallelDepth)
+    : m_parallelDepth(parallelDepth)
+{
+}
+
+int TreeJoin::parallelDepthFor(int nodeCount)
+{
+    const int threads = QThreadPool::globalInstance()->maxThreadCount();
+    if (nodeCount < kParallelMinNodes || threads <= 1) {
+        return 0;
+    }
+
+    int depth = 0;
+    while ((1 << depth) < threads * kTasksPerThread) {
+        ++depth;
+    }
+    return depth;
+}
+
+quint64 TreeJoin::priority(int key)
+{
+    // Финализатор splitmix64 - биекция, поэтому разные ключи не совпадают
+    quint64 x = quint64(quint32(key)) + 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+TreeNode* TreeJoin::rebuildAsTreap(TreeNode* root)
+{
+    // Узлы по порядку ключей; обход без рекурсии - дерево бывает вырожденным
+    std::vector<TreeNode*> nodes;
+    std::vector<TreeNode*> stack;
+    TreeNode* current = root;
+
+    while (current || !stack.empty()) {
+        while (current) {
+            stack.push_back(current);
+            current = current->left();
+        }
+        current = stack.back();
+        stack.pop_back();
+        nodes.push_back(current);
+        current = current->right();
+    }
+
+    for (TreeNode* node : nodes) {
+        detachChildren(node);
+    }
+
+    // Декартово дерево из отсортированных узлов, как в BinaryTreeBuilder:
+    // на стеке правый путь, приоритеты вниз убывают
+    struct PathEntry
+    {
+        TreeNode* node;
+        quint64 priority;
+    };
+    std::vector<PathEntry> rightPath;
+
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        TreeNode* node = nodes[i];
+        // Повторы стоят подряд: остается первый
+        if (i > 0 && node->value() == nodes[i - 1]->value()) {
+            m_dropped.push_back(node);
+            continue;
+        }
+
+        const quint64 nodePriority = priority(node->value());
+        TreeNode* displaced = nullptr;
+        while (!rightPath.empty() && rightPath.back().priority < nodePriority) {
+            displaced = rightPath.back().node;
+            rightPath.pop_back();
+        }
+
+        node->setLeft(displaced);
+        if (!rightPath.empty()) {
+            rightPath.back().node->setRight(node);
+        }
+        rightPath.push_back({node, nodePriority});
+    }
+
+    if (rightPath.empty()) {
+        return nullptr;
+    }
+
+    TreeNode* newRoot = rightPath.front().node;
+    newRoot->setParent(nullptr);
+    return newRoot;
+}
+
+TreeNode* TreeJoin::apply(Operation operation, TreeNode* a, TreeNode* b)
+{
+    TreeNode* root = nullptr;
+
+    switch (operation) {
+    case Operation::Union:        root = unite(a, b, 0); break;
+    case Operation::Intersection: root = intersect(a, b, 0); break;
+    case Operation::Difference:   root = subtract(a, b, 0); break;
+    }
+
+    if (root) {
+        root->setParent(nullptr);
+    }
+    return root;
+}
+
+TreeNode* TreeJoin::unite(TreeNode* a, TreeNode* b, int depth)
+{
+    if (!a) return b;
+    if (!b) return a;
+
+    // Корнем остается узел с большим приоритетом, второе дерево режется
+    // по его ключу; все узлы частей ниже его по приоритету
+    if (priority(a->value()) < priority(b->value())) {
+        std::swap(a, b);
+    }
+
+    const SplitResult parts = split(b, a->value());
+    if (parts.found) {
+        m_dropped.push_back(parts.found);
+    }
+
+    TreeNode* left = nullptr;
+    TreeNode* right = nullptr;
+    recurseBoth(&TreeJoin::unite, depth,
+                a->left(), parts.less, left,
+                a->right(), parts.greater, right);
+
+    a->setLeft(left);
+    a->setRight(right);
+    return a;
+}
+
+TreeNode* TreeJoin::intersect(TreeNode* a, TreeNode* b, int depth)
+{
+    if (!a || !b) {
+        if (a) m_dropped.push_back(a);
+        if (b) m_dropped.push_back(b);
+        return nullptr;
+    }
+
+    if (priority(a->value()) < priority(b->value())) {
+        std::swap(a, b);
+    }
+
+    const SplitResult parts = split(b, a->value());
+
+    TreeNode* left = nullptr;
+    TreeNode* right = nullptr;
+    recurseBoth(&TreeJoin::intersect, depth,
+                a->left(), parts.less, left,
+                a->right(), parts.greater, right);
+
+    if (parts.found) {
+        m_dropped.push_back(parts.found);
+        a->setLeft(left);
+        a->setRight(right);
+        return a;
+    }
+
+    // Ключа корня нет во втором дереве - корень уходит, части сшиваются
+    detachChildren(a);
+    m_dropped.push_back(a);
+    return join(left, right);
+}
+
+TreeNode* TreeJoin::subtract(TreeNode* a, TreeNode* b, int depth)
+{
+    if (!a) {
+        if (b) m_dropped.push_back(b);
+        return nullptr;
+    }
+    if (!b) return a;
+
+    // Вычитаемое дерево целиком уходит: режем a по ключу его корня
+    TreeNode* bLeft = b->left();
+    TreeNode* bRight = b->right();
+    detachChildren(b);
+    m_dropped.push_back(b);
+
+    const SplitResult parts = split(a, b->value());
+    if (parts.found) {
+        m_dropped.push_back(parts.found);
+    }
+
+    TreeNode* left = nullptr;
+    TreeNode* right = nullptr;
+    recurseBoth(&TreeJoin::subtract, depth,
+                parts.less, bLeft, left,
+                parts.greater, bRight, right);
+
+    return join(left, right);
+}
+
+TreeJoin::SplitResult TreeJoin::split(TreeNode* tree, int key)
+{
+    // Рекурсия по пути к ключу: глубина декартова дерева - O(log n)
+    if (!tree) return {};
+
+    ++m_comparisons;
+    if (key < tree->value()) {
+        SplitResult result = split(tree->left(), key);
+        tree->setLeft(result.greater);
+        result.greater = tree;
+        return result;
+    }
+    if (tree->value() < key) {
+        SplitResult result = split(tree->right(), key);
+        tree->setRight(result.less);
+        result.less = tree;
+        return result;
+    }
+
+    SplitResult result{tree->left(), tree, tree->right()};
+    detachChildren(tree);
+    return result;
+}
+
+TreeNode* TreeJoin::join(TreeNode* left, TreeNode* right)
+{
+    if (!left) return right;
+    if (!right) return left;
+
+    // Спуск по правому пути left и левому пути right в порядке приоритетов
+    if (priority(left->value()) > priority(right->value())) {
+        left->setRight(join(left->right(), right));
+        return left;
+    }
+    right->setLeft(join(left, right->left()));
+    return right;
+}
+
+void TreeJoin::detachChildren(TreeNode* node)
+{
+    node->setLeft(nullptr);
+    node->setRight(nullptr);
+}
+
+void TreeJoin::recurseBoth(Recursion recurse, int depth,
+                           TreeNode* a1, TreeNode* b1, TreeNode*& result1,
+                           TreeNode* a2, TreeNode* b2, TreeNode*& result2)
+{
+    if (depth >= m_parallelDepth) {
+        result1 = (this->*recurse)(a1, b1, depth + 1);
+        result2 = (this->*recurse)(a2, b2, depth + 1);
+        return;
+    }
+
+    // Ветви не делят узлов, общие у них только счетчики и список выброшенных
+    TreeJoin branch(m_parallelDepth);
+    parallelInvoke(
+        [&]() { result1 = (branch.*recurse)(a1, b1, depth + 1); },
+        [&]() { result2 = (this->*recurse)(a2, b2, depth + 1); });
+
+    m_dropped.insert(m_dropped.end(), branch.m_dropped.begin(), branch.m_dropped.end());
+    m_comparisons += branch.m_comparisons;
+}
@@ -0,0 +1,90 @@
+// core/internal/binary_tree/tree_join.h
+#ifndef TREEJOIN_H
+#define TREEJOIN_H
+
+#include <QtGlobal>
+
+#include <vector>
+
+class TreeNode;
+
+// Объединение, пересечение и разность деревьев через split/join
+// (Blelloch, Ferizovic, Sun, "Just Join for Parallel Ordered Sets").
+// Деревья - декартовы: приоритет узла - хеш ключа (priority), родитель
+// не ниже детей. Форма такого дерева зависит только от набора ключей,
+// ожидаемая глубина - O(log n), а операция над деревьями размеров m <= n
+// стоит ожидаемо O(m log(n/m + 1)).
+//
+// Новые узлы не создаются: результат собирается из узлов обоих деревьев
+// через setLeft/setRight. Лишние узлы (второй из двух равных ключей,
+// отброшенные поддеревья) копятся в dropped(); владение узлами и их
+// удаление - забота вызывающего. Две ветви рекурсии после split
+// независимы, и на верхних parallelDepth уровнях они идут параллельно
+// (parallelInvoke), каждая со своим списком выброшенных узлов.
+class TreeJoin
+{
+public:
+    enum class Operation
+    {
+        Union,
+        Intersection,
+        Difference      // a \ b
+    };
+
+    // Меньше стольких узлов на двоих потоки не окупаются
+    static constexpr int kParallelMinNodes = 1 << 14;
+    // Задач на поток пула: ветви бывают неравными
+    static constexpr int kTasksPerThread = 4;
+
+    explicit TreeJoin(int parallelDepth = 0);
+
+    // Глубина параллельной рекурсии для деревьев с nodeCount узлами на двоих
+    // (0 - последовательно): около kTasksPerThread задач на поток пула
+    static int parallelDepthFor(int nodeCount);
+
+    // splitmix64 от ключа: у разных ключей приоритеты разные
+    static quint64 priority(int key);
+
+    // Перестраивает любое BST в декартово дерево с priority() за O(n) без
+    // рекурсии, переиспользуя узлы. Повторы ключа уходят в dropped()
+    TreeNode* rebuildAsTreap(TreeNode* root);
+
+    // Оба дерева - декартовы с priority() и без повторов ключей.
+    // Возвращает корень результата (parent == nullptr)
+    TreeNode* apply(Operation operation, TreeNode* a, TreeNode* b);
+
+    // Корни выброшенных поддеревьев; одиночные узлы - уже без детей
+    const std::vector<TreeNode*>& dropped() const { return m_dropped; }
+    quint64 comparisons() const { return m_comparisons; }
+
+private:
+    struct SplitResult
+    {
+        TreeNode* less = nullptr;
+        TreeNode* found = nullptr;      // Узел с ключом разреза, без детей
+        TreeNode* greater = nullptr;
+    };
+
+    using Recursion = TreeNode* (TreeJoin::*)(TreeNode* a, TreeNode* b, int depth);
+
+    TreeNode* unite(TreeNode* a, TreeNode* b, int depth);
+    TreeNode* intersect(TreeNode* a, TreeNode* b, int depth);
+    TreeNode* subtract(TreeNode* a, TreeNode* b, int depth);
+
+    SplitResult split(TreeNode* tree, int key);
+    // Все ключи left меньше ключей right
+    static TreeNode* join(TreeNode* left, TreeNode* right);
+    static void detachChildren(TreeNode* node);
+
+    // Ветви рекурсии над (a1, b1) и (a2, b2): выше m_parallelDepth первая
+    // уходит в пул с отдельным TreeJoin, который потом сливается с этим
+    void recurseBoth(Recursion recurse, int depth,
+                     TreeNode* a1, TreeNode* b1, TreeNode*& result1,
+                     TreeNode* a2, TreeNode* b2, TreeNode*& result2);
+
+    int m_parallelDepth;
+    std::vector<TreeNode*> m_dropped;
+    quint64 m_comparisons = 0;
+};
+
+#endif // TREEJOIN_H
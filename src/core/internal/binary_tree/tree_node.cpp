@@ -1,5 +1,16 @@
 #include "tree_node.h"
 
+namespace
+{
+// QPointer - обертка над QWeakPointer<QObject>, а у него первое поле -
+// указатель на guard-блок. Раскладка входит в ABI Qt 6, наружу блок не отдается
+const void* guardOf(const QPointer<TreeNode>& pointer)
+{
+    static_assert(sizeof(QPointer<TreeNode>) == 2 * sizeof(void*));
+    return *reinterpret_cast<const void* const*>(&pointer);
+}
+}
+
 TreeNode::TreeNode(int value, QObject* parent)
     : QObject(parent)
     , m_value(value)
@@ -12,16 +23,21 @@ TreeNode::~TreeNode()
         if (m_parent->m_left == this)
         {
             m_parent->m_left = nullptr;
+            m_parent->m_rawLeft = nullptr;
         }
         else if (m_parent->m_right == this)
         {
             m_parent->m_right = nullptr;
+            m_parent->m_rawRight = nullptr;
         }
     }
 }
 
 void TreeNode::setLeft(TreeNode* left)
 {
+    // Вне проверки: QPointer мог обнулиться сам, а сырая копия - нет
+    m_rawLeft = left;
+
     if (m_left != left)
     {
         TreeNode* oldLeft = m_left;
@@ -38,6 +54,9 @@ void TreeNode::setLeft(TreeNode* left)
 
 void TreeNode::setRight(TreeNode* right)
 {
+    // Вне проверки: QPointer мог обнулиться сам, а сырая копия - нет
+    m_rawRight = right;
+
     if (m_right != right)
     {
         TreeNode* oldRight = m_right;
@@ -61,3 +80,21 @@ void TreeNode::setParent(TreeNode* parent)
         emit parentChanged(oldParent, m_parent);
     }
 }
+
+const void* TreeNode::guardBlock() const
+{
+    // Берем блок у любой ссылки, которая смотрит на этот узел
+    if (const TreeNode* parent = m_parent)
+    {
+        return guardOf(parent->m_rawLeft == this ? parent->m_left : parent->m_right);
+    }
+    if (m_rawLeft)
+    {
+        return guardOf(m_rawLeft->m_parent);
+    }
+    if (m_rawRight)
+    {
+        return guardOf(m_rawRight->m_parent);
+    }
+    return nullptr;
+}
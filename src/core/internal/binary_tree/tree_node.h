@@ -5,6 +5,8 @@
 #include <QObject>
 #include <QPointer>
 
+#include <atomic>
+
 class TreeNode : public QObject
 {
     Q_OBJECT
@@ -27,6 +29,19 @@ public:
     bool hasLeft() const { return m_left != nullptr; }
     bool hasRight() const { return m_right != nullptr; }
 
+    // Сколько раз узел оказался на пути поиска/вставки/удаления.
+    // Relaxed-атомик: пакетные поиски могут идти из нескольких потоков,
+    // а порядок между счетчиками не важен. Лежит в выравнивании после m_value.
+    quint32 visitCount() const { return m_visits.load(std::memory_order_relaxed); }
+    void recordVisit() const { m_visits.fetch_add(1, std::memory_order_relaxed); }
+    void resetVisits() { m_visits.store(0, std::memory_order_relaxed); }
+
+    // Для учета памяти: QObject держит приватные данные отдельным блоком
+    const void* qobjectPrivate() const { return d_ptr.data(); }
+    // Guard-блок (ExternalRefCountData), общий для всех QPointer на узел;
+    // nullptr, если на узел не смотрит ни родитель, ни дети
+    const void* guardBlock() const;
+
 signals:
     void leftChanged(TreeNode* oldLeft, TreeNode* newLeft);
     void rightChanged(TreeNode* oldRight, TreeNode* newRight);
@@ -39,6 +54,14 @@ private:
     friend class BinaryTree;
 
     const int m_value;
+    mutable std::atomic<quint32> m_visits{0};
+    // Те же дети, что в m_left/m_right, но без QPointer: чтение QPointer
+    // проверяет его guard-блок (ExternalRefCountData) - отдельную аллокацию,
+    // то есть второй зависимый промах на каждый уровень спуска. Пакетный
+    // поиск идет по этим копиям; вместе с m_value они лежат в начале узла.
+    // Поддерживаются setLeft/setRight и деструктором ребенка.
+    TreeNode* m_rawLeft = nullptr;
+    TreeNode* m_rawRight = nullptr;
     QPointer<TreeNode> m_left = nullptr;
     QPointer<TreeNode> m_right = nullptr;
     QPointer<TreeNode> m_parent = nullptr;
@@ -0,0 +1,31 @@
+// core/internal/binary_tree/tree_step.h
+#ifndef TREESTEP_H
+#define TREESTEP_H
+
+#include "../../utils/algorithm_task.h"
+
+class TreeNode;
+
+// Точка остановки пошаговой операции бинарного дерева.
+// Узел шага жив как минимум до следующего resume(): удаление
+// выполняется уже после последней остановки.
+struct TreeStep
+{
+    enum class Kind
+    {
+        Compare,    // Ключ сравнивается со значением узла
+        Visit,      // Узел пройден без сравнения (поиск минимума)
+        Found,
+        NotFound,   // node - последний узел пути (или nullptr)
+        Inserted,
+        Rotated     // Шаг splay: node поднялся на один (zig) или два уровня
+    };
+
+    Kind kind = Kind::Compare;
+    TreeNode* node = nullptr;
+    int depth = 0;
+};
+
+using TreeTask = AlgorithmTask<TreeStep>;
+
+#endif // TREESTEP_H
@@ -0,0 +1,105 @@
+#include "bplus_node.h"
+
+#include <limits>
+#include <new>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BPLUS_USE_SSE2
+#endif
+
+namespace
+{
+constexpr std::size_t kNodeAlignment = 64;
+
+constexpr std::size_t alignUp(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Количество ключей из keys[0..count), для которых keys[i] < bound
+int countBelow(const int* keys, int count, int bound)
+{
+    int result = 0;
+    int i = 0;
+
+#if defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi32(bound);
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 8 <= count; i += 8) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        // Маска -1 там, где bound > key: вычитание маски прибавляет единицу
+        acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(needle, block));
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    for (int lane : lanes) {
+        result += lane;
+    }
+#elif defined(BPLUS_USE_SSE2)
+    const __m128i needle = _mm_set1_epi32(bound);
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        acc = _mm_sub_epi32(acc, _mm_cmplt_epi32(block, needle));
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+    for (; i < count; ++i) {
+        result += keys[i] < bound;
+    }
+
+    return result;
+}
+}
+
+BPlusNode::BPlusNode(bool leaf, int fanout)
+    : m_fanout(fanout)
+    , m_leaf(leaf)
+{
+}
+
+BPlusNode* BPlusNode::create(bool leaf, int fanout)
+{
+    // [заголовок | ключи: fanout | дети: fanout + 1] в одном блоке
+    const std::size_t keysOffset = alignUp(sizeof(BPlusNode), 16);
+    const std::size_t childrenOffset = alignUp(keysOffset + fanout * sizeof(int), alignof(BPlusNode*));
+    const std::size_t total = leaf ? childrenOffset
+                                   : childrenOffset + (fanout + 1) * sizeof(BPlusNode*);
+
+    char* memory = static_cast<char*>(::operator new(total, std::align_val_t(kNodeAlignment)));
+    BPlusNode* node = new (memory) BPlusNode(leaf, fanout);
+    node->m_keys = reinterpret_cast<int*>(memory + keysOffset);
+    if (!leaf) {
+        node->m_children = reinterpret_cast<BPlusNode**>(memory + childrenOffset);
+    }
+
+    return node;
+}
+
+void BPlusNode::destroy(BPlusNode* node)
+{
+    if (!node) return;
+
+    node->~BPlusNode();
+    ::operator delete(static_cast<void*>(node), std::align_val_t(kNodeAlignment));
+}
+
+int BPlusNode::countLess(int key) const
+{
+    return countBelow(m_keys, m_count, key);
+}
+
+int BPlusNode::countLessOrEqual(int key) const
+{
+    // Для целых keys <= key равносильно keys < key + 1
+    if (key == std::numeric_limits<int>::max()) {
+        return m_count;
+    }
+    return countBelow(m_keys, m_count, key + 1);
+}
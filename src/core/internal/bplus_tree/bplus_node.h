@@ -0,0 +1,49 @@
+// core/internal/bplus_tree/bplus_node.h
+#ifndef BPLUSNODE_H
+#define BPLUSNODE_H
+
+#include <cstddef>
+
+// Узел B+ дерева.
+// В отличие от TreeNode это не QObject: заголовок, массив ключей и массив
+// детей лежат в одном выровненном блоке памяти, поэтому поиск внутри узла
+// читает несколько соседних кэш-линий, а не разбросанные объекты.
+class BPlusNode
+{
+public:
+    // fanout - максимальное число детей внутреннего узла.
+    // В узле помещается fanout - 1 ключей плюс один временный при переполнении.
+    static BPlusNode* create(bool leaf, int fanout);
+    static void destroy(BPlusNode* node);
+
+    bool isLeaf() const { return m_leaf; }
+    int keyCount() const { return m_count; }
+    int childCount() const { return m_leaf ? 0 : m_count + 1; }
+    int key(int index) const { return m_keys[index]; }
+    const int* keys() const { return m_keys; }
+    BPlusNode* child(int index) const { return m_children[index]; }
+    BPlusNode* next() const { return m_next; }      // Следующий лист (только для листьев)
+
+    // Количество ключей < key и <= key. Сравнение идет блоками
+    // по 4 (SSE2) или 8 (AVX2) ключей без ветвлений.
+    int countLess(int key) const;
+    int countLessOrEqual(int key) const;
+
+private:
+    friend class BPlusTree;
+
+    BPlusNode(bool leaf, int fanout);
+    ~BPlusNode() = default;
+
+    int* m_keys = nullptr;
+    BPlusNode** m_children = nullptr;   // nullptr у листьев
+    BPlusNode* m_next = nullptr;
+    int m_count = 0;
+    int m_fanout = 0;
+    bool m_leaf = true;
+
+    BPlusNode(const BPlusNode&) = delete;
+    BPlusNode& operator=(const BPlusNode&) = delete;
+};
+
+#endif // BPLUSNODE_H
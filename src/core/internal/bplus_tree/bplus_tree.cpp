@@ -0,0 +1,275 @@
+// BPlusTree.cpp
+#include "bplus_tree.h"
+
+#include <algorithm>
+#include <cstring>
+
+BPlusTree::BPlusTree(int fanout, QObject* parent)
+    : QObject(parent)
+    , m_fanout(std::max(fanout, kMinFanout))
+{
+}
+
+BPlusTree::~BPlusTree()
+{
+    deleteSubtree(m_root);
+}
+
+BPlusNode* BPlusTree::findLeaf(int key, TreeOperation operation, QVector<PathEntry>* path) const
+{
+    BPlusNode* node = m_root;
+    NodeAccessTracer* tracer = m_tracer;
+    if (tracer) {
+        tracer->operationStarted(operation);
+    }
+
+    int depth = 0;
+    while (node && !node->isLeaf()) {
+        // Ребенок i содержит ключи из [key(i - 1), key(i))
+        const int index = node->countLessOrEqual(key);
+        if (path) {
+            path->append({node, index});
+        }
+        if (tracer) {
+            // Блок узла от заголовка до прочитанной ссылки на ребенка
+            const auto* end = reinterpret_cast<const char*>(node->m_children + index + 1);
+            tracer->memoryTouched(node, std::size_t(end - reinterpret_cast<const char*>(node)), depth++);
+        }
+        node = node->child(index);
+    }
+
+    if (tracer) {
+        // Лист: заголовок и ключи, по которым вызывающий сразу ищет
+        if (node) {
+            const auto* end = reinterpret_cast<const char*>(node->m_keys + node->m_count);
+            tracer->memoryTouched(node, std::size_t(end - reinterpret_cast<const char*>(node)), depth);
+        }
+        tracer->operationFinished();
+    }
+    return node;
+}
+
+bool BPlusTree::contains(int key) const
+{
+    const BPlusNode* leaf = findLeaf(key, TreeOperation::Find);
+    if (!leaf) return false;
+
+    const int index = leaf->countLess(key);
+    return index < leaf->keyCount() && leaf->key(index) == key;
+}
+
+int BPlusTree::countRange(int low, int high) const
+{
+    if (low > high) return 0;
+
+    const BPlusNode* leaf = findLeaf(low, TreeOperation::Range);
+    int index = leaf ? leaf->countLess(low) : 0;
+    int count = 0;
+
+    while (leaf) {
+        // Ключи листа отсортированы: берем все до первого > high
+        const int end = leaf->countLessOrEqual(high);
+        if (end > index) {
+            count += end - index;
+        }
+        if (end < leaf->keyCount()) break;
+
+        leaf = leaf->next();
+        index = 0;
+    }
+
+    return count;
+}
+
+bool BPlusTree::insert(int key)
+{
+    if (!m_root) {
+        m_root = BPlusNode::create(true, m_fanout);
+        m_height = 1;
+    }
+
+    QVector<PathEntry> path;
+    path.reserve(m_height);
+    BPlusNode* leaf = findLeaf(key, TreeOperation::Insert, &path);
+
+    const int index = leaf->countLess(key);
+    if (index < leaf->m_count && leaf->m_keys[index] == key) {
+        return false;
+    }
+
+    // Сдвигаем хвост и вставляем ключ (в узле всегда есть место под один лишний)
+    std::memmove(leaf->m_keys + index + 1, leaf->m_keys + index,
+                 (leaf->m_count - index) * sizeof(int));
+    leaf->m_keys[index] = key;
+    ++leaf->m_count;
+    ++m_size;
+
+    if (leaf->m_count > maxKeys()) {
+        int separator = 0;
+        BPlusNode* right = splitLeaf(leaf, separator);
+        insertIntoParent(path, separator, right);
+    }
+
+    emit keyInserted(key);
+    emit structureChanged();
+    return true;
+}
+
+BPlusNode* BPlusTree::splitLeaf(BPlusNode* leaf, int& separator)
+{
+    BPlusNode* right = BPlusNode::create(true, m_fanout);
+
+    const int leftCount = leaf->m_count / 2;
+    const int rightCount = leaf->m_count - leftCount;
+
+    std::memcpy(right->m_keys, leaf->m_keys + leftCount, rightCount * sizeof(int));
+    right->m_count = rightCount;
+    leaf->m_count = leftCount;
+
+    right->m_next = leaf->m_next;
+    leaf->m_next = right;
+
+    // В B+ дереве разделитель копируется наверх и остается в правом листе
+    separator = right->m_keys[0];
+    return right;
+}
+
+BPlusNode* BPlusTree::splitInternal(BPlusNode* node, int& separator)
+{
+    BPlusNode* right = BPlusNode::create(false, m_fanout);
+
+    const int middle = node->m_count / 2;
+    const int rightCount = node->m_count - middle - 1;
+
+    // Средний ключ поднимается наверх и из узлов уходит
+    separator = node->m_keys[middle];
+
+    std::memcpy(right->m_keys, node->m_keys + middle + 1, rightCount * sizeof(int));
+    std::memcpy(right->m_children, node->m_children + middle + 1,
+                (rightCount + 1) * sizeof(BPlusNode*));
+    right->m_count = rightCount;
+    node->m_count = middle;
+
+    return right;
+}
+
+void BPlusTree::insertIntoParent(QVector<PathEntry>& path, int separator, BPlusNode* rightChild)
+{
+    while (true) {
+        if (path.isEmpty()) {
+            // Разделился корень - дерево растет вверх
+            BPlusNode* newRoot = BPlusNode::create(false, m_fanout);
+            newRoot->m_keys[0] = separator;
+            newRoot->m_children[0] = m_root;
+            newRoot->m_children[1] = rightChild;
+            newRoot->m_count = 1;
+            m_root = newRoot;
+            ++m_height;
+            return;
+        }
+
+        const PathEntry entry = path.takeLast();
+        BPlusNode* parent = entry.node;
+        const int index = entry.childIndex;
+
+        std::memmove(parent->m_keys + index + 1, parent->m_keys + index,
+                     (parent->m_count - index) * sizeof(int));
+        std::memmove(parent->m_children + index + 2, parent->m_children + index + 1,
+                     (parent->m_count - index) * sizeof(BPlusNode*));
+        parent->m_keys[index] = separator;
+        parent->m_children[index + 1] = rightChild;
+        ++parent->m_count;
+
+        if (parent->m_count <= maxKeys()) {
+            return;
+        }
+
+        rightChild = splitInternal(parent, separator);
+    }
+}
+
+bool BPlusTree::remove(int key)
+{
+    BPlusNode* leaf = findLeaf(key, TreeOperation::Remove);
+    if (!leaf) return false;
+
+    const int index = leaf->countLess(key);
+    if (index >= leaf->m_count || leaf->m_keys[index] != key) {
+        return false;
+    }
+
+    std::memmove(leaf->m_keys + index, leaf->m_keys + index + 1,
+                 (leaf->m_count - index - 1) * sizeof(int));
+    --leaf->m_count;
+    --m_size;
+
+    emit keyRemoved(key);
+    emit structureChanged();
+    return true;
+}
+
+QVector<int> BPlusTree::rangeQuery(int low, int high) const
+{
+    QVector<int> result;
+    if (low > high) return result;
+
+    const BPlusNode* leaf = findLeaf(low, TreeOperation::Range);
+    if (!leaf) return result;
+
+    int index = leaf->countLess(low);
+    while (leaf) {
+        for (; index < leaf->keyCount(); ++index) {
+            if (leaf->key(index) > high) {
+                return result;
+            }
+            result.append(leaf->key(index));
+        }
+
+        leaf = leaf->next();
+        index = 0;
+    }
+
+    return result;
+}
+
+BPlusNode* BPlusTree::firstLeaf() const
+{
+    BPlusNode* node = m_root;
+    while (node && !node->isLeaf()) {
+        node = node->child(0);
+    }
+    return node;
+}
+
+void BPlusTree::clear()
+{
+    deleteSubtree(m_root);
+    m_root = nullptr;
+    m_size = 0;
+    m_height = 0;
+    emit treeCleared();
+    emit structureChanged();
+}
+
+void BPlusTree::deleteSubtree(BPlusNode* node)
+{
+    if (!node) return;
+
+    // Глубина рекурсии равна высоте дерева - это единицы уровней
+    if (!node->isLeaf()) {
+        for (int i = 0; i < node->childCount(); ++i) {
+            deleteSubtree(node->child(i));
+        }
+    }
+
+    BPlusNode::destroy(node);
+}
+
+void BPlusTree::buildFromValues(const QVector<int>& values)
+{
+    clear();
+
+    for (int value : values) {
+        insert(value);
+    }
+}
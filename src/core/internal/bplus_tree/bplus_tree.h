@@ -0,0 +1,82 @@
+// core/internal/bplus_tree/bplus_tree.h
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include <QObject>
+#include <QVector>
+
+#include "bplus_node.h"
+#include "../binary_tree/node_access_tracer.h"
+
+// B+ дерево над множеством целых ключей.
+// Все ключи хранятся в листьях, листья связаны в список для range-запросов,
+// внутренние узлы содержат только разделители. Дубликаты не хранятся.
+class BPlusTree : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kMinFanout = 3;
+    static constexpr int kDefaultFanout = 16;
+
+    explicit BPlusTree(int fanout = kDefaultFanout, QObject* parent = nullptr);
+    ~BPlusTree() override;
+
+    // Возвращает false, если ключ уже есть
+    bool insert(int key);
+    // Удаление без слияния узлов: лист может стать неполным или пустым,
+    // разделители при этом продолжают корректно направлять поиск
+    bool remove(int key);
+    bool contains(int key) const;
+    // Сколько ключей в [low, high]: один спуск и проход по цепочке листьев
+    int countRange(int low, int high) const;
+    // Все ключи из [low, high] по возрастанию - проход по связанным листьям
+    QVector<int> rangeQuery(int low, int high) const;
+    void clear();
+
+    void buildFromValues(const QVector<int>& values);
+
+    BPlusNode* root() const { return m_root; }
+    BPlusNode* firstLeaf() const;
+    bool isEmpty() const { return m_size == 0; }
+    int size() const { return m_size; }
+    int height() const { return m_height; }
+    int fanout() const { return m_fanout; }
+
+    // Трассировка спуска к листу (модель кэша): каждый спуск - операция,
+    // шаг - заголовок и ключи узла до выбранного ребенка. Дерево не владеет
+    // трассировщиком; nullptr - выключено
+    void setAccessTracer(NodeAccessTracer* tracer) { m_tracer = tracer; }
+    NodeAccessTracer* accessTracer() const { return m_tracer; }
+
+signals:
+    void keyInserted(int key);
+    void keyRemoved(int key);
+    void structureChanged();
+    void treeCleared();
+
+private:
+    struct PathEntry {
+        BPlusNode* node;
+        int childIndex;
+    };
+
+    // operation - для трассировщика: какую операцию начинает спуск
+    BPlusNode* findLeaf(int key, TreeOperation operation, QVector<PathEntry>* path = nullptr) const;
+    void insertIntoParent(QVector<PathEntry>& path, int separator, BPlusNode* rightChild);
+    BPlusNode* splitLeaf(BPlusNode* leaf, int& separator);
+    BPlusNode* splitInternal(BPlusNode* node, int& separator);
+    void deleteSubtree(BPlusNode* node);
+
+    int maxKeys() const { return m_fanout - 1; }
+
+    BPlusNode* m_root = nullptr;
+    int m_fanout;
+    int m_size = 0;
+    int m_height = 0;
+    NodeAccessTracer* m_tracer = nullptr;
+
+    Q_DISABLE_COPY(BPlusTree)
+};
+
+#endif // BPLUSTREE_H
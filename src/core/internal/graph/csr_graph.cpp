@@ -0,0 +1,287 @@
+// CsrGraph.cpp
+#include "csr_graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "radix_heap.h"
+#include "../../utils/parallel.h"
+
+namespace
+{
+// Пороги переключения направления из работы Beamer и др.:
+// вниз -> вверх, когда у фронта больше 1/alpha непросмотренных дуг,
+// вверх -> вниз, когда фронт меньше n/beta вершин
+constexpr long long kAlpha = 14;
+constexpr long long kBeta = 24;
+
+// Сколько вершин фронта обрабатывает одна задача параллельного BFS
+constexpr int kParallelChunk = 1024;
+
+// Одна сортировка подсчетом: раскладывает дуги по вершинам-источникам
+void fillCsr(int vertexCount, const std::vector<CsrGraph::Edge>& arcs, bool reversed,
+             std::vector<int>& offsets, std::vector<int>& targets, std::vector<int>* weights)
+{
+    offsets.assign(std::size_t(vertexCount) + 1, 0);
+    for (const CsrGraph::Edge& arc : arcs) {
+        ++offsets[std::size_t(reversed ? arc.to : arc.from) + 1];
+    }
+    for (int v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    targets.resize(arcs.size());
+    if (weights) {
+        weights->resize(arcs.size());
+    }
+
+    std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+    for (const CsrGraph::Edge& arc : arcs) {
+        const int position = cursor[reversed ? arc.to : arc.from]++;
+        targets[position] = reversed ? arc.from : arc.to;
+        if (weights) {
+            (*weights)[position] = arc.weight;
+        }
+    }
+}
+}
+
+CsrGraph::CsrGraph(QObject* parent)
+    : QObject(parent)
+{
+}
+
+void CsrGraph::build(int vertexCount, const std::vector<Edge>& edges, bool directed)
+{
+    vertexCount = std::max(0, vertexCount);
+    m_directed = directed;
+
+    std::vector<Edge> arcs;
+    arcs.reserve(directed ? edges.size() : edges.size() * 2);
+    for (const Edge& edge : edges) {
+        if (edge.from < 0 || edge.from >= vertexCount || edge.to < 0 || edge.to >= vertexCount
+            || edge.weight < 0) {
+            continue;
+        }
+
+        arcs.push_back(edge);
+        if (!directed && edge.from != edge.to) {
+            arcs.push_back({edge.to, edge.from, edge.weight});
+        }
+    }
+
+    fillCsr(vertexCount, arcs, false, m_offsets, m_targets, &m_weights);
+
+    if (directed) {
+        fillCsr(vertexCount, arcs, true, m_inOffsets, m_inSources, nullptr);
+    } else {
+        m_inOffsets.clear();
+        m_inSources.clear();
+    }
+
+    emit structureChanged();
+}
+
+void CsrGraph::clear()
+{
+    m_offsets.assign(1, 0);
+    m_targets.clear();
+    m_weights.clear();
+    m_inOffsets.clear();
+    m_inSources.clear();
+
+    emit graphCleared();
+    emit structureChanged();
+}
+
+int CsrGraph::inDegree(int vertex) const
+{
+    if (!m_directed) return degree(vertex);
+    return m_inOffsets[vertex + 1] - m_inOffsets[vertex];
+}
+
+const int* CsrGraph::inNeighbors(int vertex) const
+{
+    if (!m_directed) return neighbors(vertex);
+    return m_inSources.data() + m_inOffsets[vertex];
+}
+
+bool CsrGraph::topDownStep(std::vector<int>& levels, const std::vector<int>& frontier,
+                           std::vector<int>& next, int depth) const
+{
+    for (int vertex : frontier) {
+        const int* first = neighbors(vertex);
+        const int* last = first + degree(vertex);
+        for (const int* it = first; it != last; ++it) {
+            if (levels[*it] == kUnreachable) {
+                levels[*it] = depth;
+                next.push_back(*it);
+            }
+        }
+    }
+    return !next.empty();
+}
+
+bool CsrGraph::bottomUpStep(std::vector<int>& levels, std::vector<char>& inFrontier,
+                            std::vector<int>& next, int depth) const
+{
+    // Каждая непосещенная вершина ищет родителя во фронте и останавливается на первом
+    const int n = vertexCount();
+    for (int vertex = 0; vertex < n; ++vertex) {
+        if (levels[vertex] != kUnreachable) continue;
+
+        const int* first = inNeighbors(vertex);
+        const int* last = first + inDegree(vertex);
+        for (const int* it = first; it != last; ++it) {
+            if (inFrontier[*it]) {
+                levels[vertex] = depth;
+                next.push_back(vertex);
+                break;
+            }
+        }
+    }
+
+    std::fill(inFrontier.begin(), inFrontier.end(), 0);
+    for (int vertex : next) {
+        inFrontier[vertex] = 1;
+    }
+    return !next.empty();
+}
+
+std::vector<int> CsrGraph::bfs(int source) const
+{
+    const int n = vertexCount();
+    std::vector<int> levels(std::max(n, 0), kUnreachable);
+    if (source < 0 || source >= n) return levels;
+
+    levels[source] = 0;
+    std::vector<int> frontier{source};
+    std::vector<int> next;
+    std::vector<char> inFrontier;
+
+    long long unexploredArcs = arcCount();
+    bool bottomUp = false;
+
+    for (int depth = 1; !frontier.empty(); ++depth) {
+        long long frontierArcs = 0;
+        for (int vertex : frontier) {
+            frontierArcs += degree(vertex);
+        }
+        unexploredArcs -= frontierArcs;
+
+        if (!bottomUp && frontierArcs * kAlpha > unexploredArcs) {
+            bottomUp = true;
+            inFrontier.assign(std::size_t(n), 0);
+            for (int vertex : frontier) {
+                inFrontier[vertex] = 1;
+            }
+        } else if (bottomUp && (long long)frontier.size() * kBeta < n) {
+            bottomUp = false;
+        }
+
+        next.clear();
+        if (bottomUp) {
+            bottomUpStep(levels, inFrontier, next, depth);
+        } else {
+            topDownStep(levels, frontier, next, depth);
+        }
+        frontier.swap(next);
+    }
+
+    return levels;
+}
+
+std::vector<int> CsrGraph::parallelBfs(int source, int maxWorkers) const
+{
+    const int n = vertexCount();
+    if (source < 0 || source >= n) {
+        return std::vector<int>(std::max(n, 0), kUnreachable);
+    }
+
+    // Вершину забирает тот поток, чей compare_exchange прошел первым
+    std::unique_ptr<std::atomic<int>[]> levels(new std::atomic<int>[n]);
+    for (int v = 0; v < n; ++v) {
+        levels[v].store(kUnreachable, std::memory_order_relaxed);
+    }
+    levels[source].store(0, std::memory_order_relaxed);
+
+    std::vector<int> frontier{source};
+
+    for (int depth = 1; !frontier.empty(); ++depth) {
+        const int chunks = (int(frontier.size()) + kParallelChunk - 1) / kParallelChunk;
+        // Каждая часть собирает свой кусок следующего фронта - без общей блокировки
+        std::vector<std::vector<int>> partial(chunks);
+
+        parallelFor(chunks, [&](int chunk) {
+            const std::size_t begin = std::size_t(chunk) * kParallelChunk;
+            const std::size_t end = std::min(frontier.size(), begin + kParallelChunk);
+            std::vector<int>& local = partial[chunk];
+
+            for (std::size_t i = begin; i < end; ++i) {
+                const int vertex = frontier[i];
+                const int* first = neighbors(vertex);
+                const int* last = first + degree(vertex);
+                for (const int* it = first; it != last; ++it) {
+                    int expected = kUnreachable;
+                    if (levels[*it].load(std::memory_order_relaxed) == kUnreachable
+                        && levels[*it].compare_exchange_strong(expected, depth, std::memory_order_relaxed)) {
+                        local.push_back(*it);
+                    }
+                }
+            }
+        }, maxWorkers);
+
+        frontier.clear();
+        for (const std::vector<int>& local : partial) {
+            frontier.insert(frontier.end(), local.begin(), local.end());
+        }
+    }
+
+    std::vector<int> result(n);
+    for (int v = 0; v < n; ++v) {
+        result[v] = levels[v].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+std::vector<int> CsrGraph::dijkstra(int source, std::vector<int>* predecessors) const
+{
+    const int n = vertexCount();
+    std::vector<int> distances(std::max(n, 0), kUnreachable);
+    if (predecessors) {
+        predecessors->assign(std::max(n, 0), -1);
+    }
+    if (source < 0 || source >= n) return distances;
+
+    // Устаревшие записи в куче не удаляем, а пропускаем при извлечении
+    std::vector<std::uint32_t> best(n, UINT32_MAX);
+    best[source] = 0;
+
+    RadixHeap heap;
+    heap.push(0, source);
+
+    while (!heap.isEmpty()) {
+        const RadixHeap::Entry entry = heap.pop();
+        const int vertex = entry.second;
+        if (entry.first != best[vertex] || distances[vertex] != kUnreachable) continue;
+
+        distances[vertex] = int(entry.first);
+
+        const int* targets = neighbors(vertex);
+        const int* arcWeights = weights(vertex);
+        for (int i = 0; i < degree(vertex); ++i) {
+            const std::uint32_t candidate = entry.first + std::uint32_t(arcWeights[i]);
+            if (candidate < best[targets[i]]) {
+                best[targets[i]] = candidate;
+                heap.push(candidate, targets[i]);
+                if (predecessors) {
+                    (*predecessors)[targets[i]] = vertex;
+                }
+            }
+        }
+    }
+
+    return distances;
+}
@@ -0,0 +1,80 @@
+// core/internal/graph/csr_graph.h
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <QObject>
+
+#include <vector>
+
+// Взвешенный граф в формате CSR (compressed sparse row):
+// соседи вершины v - это targets[offsets[v] .. offsets[v + 1]).
+// Вся смежность лежит в двух непрерывных массивах, поэтому обходы читают
+// память последовательно, а не прыгают по спискам.
+// Для ориентированного графа дополнительно хранится обратный CSR -
+// он нужен шагу "снизу вверх" в BFS.
+class CsrGraph : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Edge {
+        int from;
+        int to;
+        int weight;
+    };
+
+    static constexpr int kUnreachable = -1;
+
+    explicit CsrGraph(QObject* parent = nullptr);
+
+    // Строит граф заново. Ребра с вершинами вне [0, vertexCount) и отрицательными весами отбрасываются.
+    // Для неориентированного графа каждое ребро хранится в обе стороны
+    void build(int vertexCount, const std::vector<Edge>& edges, bool directed = false);
+    void clear();
+
+    int vertexCount() const { return int(m_offsets.size()) - 1; }
+    // Количество хранимых дуг (у неориентированного графа - вдвое больше ребер)
+    int arcCount() const { return int(m_targets.size()); }
+    bool isDirected() const { return m_directed; }
+    bool isEmpty() const { return vertexCount() <= 0; }
+
+    int degree(int vertex) const { return m_offsets[vertex + 1] - m_offsets[vertex]; }
+    const int* neighbors(int vertex) const { return m_targets.data() + m_offsets[vertex]; }
+    const int* weights(int vertex) const { return m_weights.data() + m_offsets[vertex]; }
+
+    // Уровни BFS от source (kUnreachable для недостижимых).
+    // Направленно-оптимизирующий обход: пока фронт мал - сверху вниз,
+    // когда фронт покрывает заметную часть ребер - снизу вверх
+    std::vector<int> bfs(int source) const;
+    // То же, но каждый уровень сверху вниз обрабатывается частями на QThreadPool
+    std::vector<int> parallelBfs(int source, int maxWorkers = 0) const;
+    // Кратчайшие расстояния на радиксной куче; predecessors (если задан) - дерево путей
+    std::vector<int> dijkstra(int source, std::vector<int>* predecessors = nullptr) const;
+
+signals:
+    void structureChanged();
+    void graphCleared();
+
+private:
+    bool topDownStep(std::vector<int>& levels, const std::vector<int>& frontier,
+                     std::vector<int>& next, int depth) const;
+    bool bottomUpStep(std::vector<int>& levels, std::vector<char>& inFrontier,
+                      std::vector<int>& next, int depth) const;
+
+    int inDegree(int vertex) const;
+    const int* inNeighbors(int vertex) const;
+
+    std::vector<int> m_offsets{0};
+    std::vector<int> m_targets;
+    std::vector<int> m_weights;
+
+    // Обратный CSR, только для ориентированного графа
+    std::vector<int> m_inOffsets;
+    std::vector<int> m_inSources;
+
+    bool m_directed = false;
+
+    Q_DISABLE_COPY(CsrGraph)
+};
+
+#endif // CSRGRAPH_H
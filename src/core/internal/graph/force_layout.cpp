@@ -0,0 +1,248 @@
+#include "force_layout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "csr_graph.h"
+#include "../../utils/parallel.h"
+
+namespace
+{
+// Глубже дерево не дробим: совпадающие точки остаются в одном листе
+constexpr int kMaxQuadDepth = 40;
+// Вершин на одну задачу при параллельном расчете отталкивания
+constexpr int kRepulsionChunk = 512;
+constexpr double kPi = 3.14159265358979323846;
+}
+
+ForceLayout::ForceLayout(const CsrGraph& graph, const Options& options)
+    : m_vertexCount(std::max(0, graph.vertexCount()))
+    , m_options(options)
+{
+    for (int v = 0; v < m_vertexCount; ++v) {
+        const int* targets = graph.neighbors(v);
+        for (int i = 0; i < graph.degree(v); ++i) {
+            // У неориентированного графа дуга хранится дважды - берем одну
+            if (graph.isDirected() || v < targets[i]) {
+                m_edges.emplace_back(v, targets[i]);
+            }
+        }
+    }
+
+    // Начальные позиции - случайные в круге, но детерминированные
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const double radius = m_options.idealLength * std::sqrt(double(std::max(1, m_vertexCount)));
+
+    m_x.resize(m_vertexCount);
+    m_y.resize(m_vertexCount);
+    for (int v = 0; v < m_vertexCount; ++v) {
+        const double angle = unit(rng) * 2.0 * kPi;
+        const double r = radius * std::sqrt(unit(rng));
+        m_x[v] = r * std::cos(angle);
+        m_y[v] = r * std::sin(angle);
+    }
+}
+
+std::vector<QPointF> ForceLayout::snapshot() const
+{
+    std::vector<QPointF> positions(m_vertexCount);
+    for (int v = 0; v < m_vertexCount; ++v) {
+        positions[v] = QPointF(m_x[v], m_y[v]);
+    }
+    return positions;
+}
+
+int ForceLayout::childFor(int node, double x, double y) const
+{
+    const QuadNode& quad = m_quadTree[node];
+    return quad.firstChild + (x >= quad.centerX ? 1 : 0) + (y >= quad.centerY ? 2 : 0);
+}
+
+void ForceLayout::insertBody(int body)
+{
+    const double x = m_x[body];
+    const double y = m_y[body];
+
+    int node = 0;
+    for (int depth = 0; ; ++depth) {
+        // Пустой лист - просто занимаем
+        if (m_quadTree[node].firstChild < 0 && m_quadTree[node].mass == 0.0) {
+            QuadNode& leaf = m_quadTree[node];
+            leaf.body = body;
+            leaf.mass = 1.0;
+            leaf.massX = x;
+            leaf.massY = y;
+            return;
+        }
+
+        // Лист с телом: делим на четыре и переносим старое тело вниз
+        if (m_quadTree[node].firstChild < 0) {
+            if (depth >= kMaxQuadDepth) {
+                QuadNode& leaf = m_quadTree[node];
+                leaf.mass += 1.0;
+                leaf.massX += x;
+                leaf.massY += y;
+                return;
+            }
+
+            const int firstChild = int(m_quadTree.size());
+            const QuadNode parent = m_quadTree[node];
+            const double quarter = parent.half / 2.0;
+            for (int i = 0; i < 4; ++i) {
+                QuadNode child;
+                child.centerX = parent.centerX + ((i & 1) ? quarter : -quarter);
+                child.centerY = parent.centerY + ((i & 2) ? quarter : -quarter);
+                child.half = quarter;
+                m_quadTree.push_back(child);
+            }
+
+            m_quadTree[node].firstChild = firstChild;
+            m_quadTree[node].body = -1;
+
+            QuadNode& moved = m_quadTree[childFor(node, parent.massX, parent.massY)];
+            moved.body = parent.body;
+            moved.mass = parent.mass;
+            moved.massX = parent.massX;
+            moved.massY = parent.massY;
+        }
+
+        QuadNode& inner = m_quadTree[node];
+        inner.mass += 1.0;
+        inner.massX += x;
+        inner.massY += y;
+        node = childFor(node, x, y);
+    }
+}
+
+void ForceLayout::buildQuadTree()
+{
+    double minX = m_x[0], maxX = m_x[0];
+    double minY = m_y[0], maxY = m_y[0];
+    for (int v = 1; v < m_vertexCount; ++v) {
+        minX = std::min(minX, m_x[v]);
+        maxX = std::max(maxX, m_x[v]);
+        minY = std::min(minY, m_y[v]);
+        maxY = std::max(maxY, m_y[v]);
+    }
+
+    m_quadTree.clear();
+    m_quadTree.reserve(std::size_t(m_vertexCount) * 2);
+
+    QuadNode root;
+    root.centerX = (minX + maxX) / 2.0;
+    root.centerY = (minY + maxY) / 2.0;
+    root.half = std::max(maxX - minX, maxY - minY) / 2.0 + 1.0;
+    m_quadTree.push_back(root);
+
+    for (int v = 0; v < m_vertexCount; ++v) {
+        insertBody(v);
+    }
+}
+
+void ForceLayout::applyRepulsion(int vertex, double& forceX, double& forceY) const
+{
+    const double k2 = m_options.idealLength * m_options.idealLength;
+    const double theta2 = m_options.theta * m_options.theta;
+    const double x = m_x[vertex];
+    const double y = m_y[vertex];
+
+    int stack[4 * kMaxQuadDepth + 8];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const QuadNode& quad = m_quadTree[stack[--top]];
+        if (quad.mass == 0.0 || (quad.body == vertex && quad.mass == 1.0)) continue;
+
+        double dx = x - quad.massX / quad.mass;
+        double dy = y - quad.massY / quad.mass;
+        double distance2 = dx * dx + dy * dy;
+
+        const double size = 2.0 * quad.half;
+        if (quad.firstChild >= 0 && size * size >= theta2 * distance2) {
+            for (int i = 0; i < 4; ++i) {
+                stack[top++] = quad.firstChild + i;
+            }
+            continue;
+        }
+
+        // Совпадающие точки расталкиваем в детерминированном направлении
+        if (distance2 < 1e-6) {
+            dx = ((vertex % 7) - 3) * 0.01 + 0.005;
+            dy = ((vertex % 5) - 2) * 0.01 + 0.005;
+            distance2 = dx * dx + dy * dy;
+        }
+
+        // Сила k^2 / d, направление dx / d
+        const double scale = k2 * quad.mass / distance2;
+        forceX += dx * scale;
+        forceY += dy * scale;
+    }
+}
+
+std::vector<QPointF> ForceLayout::run(const ProgressCallback& progress)
+{
+    if (m_vertexCount == 0) return {};
+
+    const int iterations = std::max(1, m_options.iterations);
+    const double k = m_options.idealLength;
+    std::vector<double> dispX(m_vertexCount);
+    std::vector<double> dispY(m_vertexCount);
+
+    double temperature = k * std::sqrt(double(m_vertexCount)) / 4.0;
+    const double cooling = temperature / iterations;
+
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        buildQuadTree();
+
+        // Отталкивание читает только дерево - части считаются независимо
+        const int chunks = (m_vertexCount + kRepulsionChunk - 1) / kRepulsionChunk;
+        parallelFor(chunks, [&](int chunk) {
+            const int begin = chunk * kRepulsionChunk;
+            const int end = std::min(m_vertexCount, begin + kRepulsionChunk);
+            for (int v = begin; v < end; ++v) {
+                double fx = 0.0;
+                double fy = 0.0;
+                applyRepulsion(v, fx, fy);
+                dispX[v] = fx - m_options.gravity * m_x[v];
+                dispY[v] = fy - m_options.gravity * m_y[v];
+            }
+        }, m_options.maxWorkers);
+
+        // Притяжение вдоль ребер: d^2 / k
+        for (const std::pair<int, int>& edge : m_edges) {
+            const double dx = m_x[edge.first] - m_x[edge.second];
+            const double dy = m_y[edge.first] - m_y[edge.second];
+            const double distance = std::sqrt(dx * dx + dy * dy);
+            if (distance < 1e-9) continue;
+
+            const double scale = distance / k;
+            dispX[edge.first] -= dx * scale;
+            dispY[edge.first] -= dy * scale;
+            dispX[edge.second] += dx * scale;
+            dispY[edge.second] += dy * scale;
+        }
+
+        // Смещение ограничено "температурой", которая линейно остывает
+        for (int v = 0; v < m_vertexCount; ++v) {
+            const double length = std::sqrt(dispX[v] * dispX[v] + dispY[v] * dispY[v]);
+            if (length < 1e-9) continue;
+
+            const double step = std::min(length, temperature) / length;
+            m_x[v] += dispX[v] * step;
+            m_y[v] += dispY[v] * step;
+        }
+        temperature = std::max(temperature - cooling, k * 0.01);
+
+        const bool last = iteration + 1 == iterations;
+        if (progress && (last || (m_options.reportEvery > 0 && iteration % m_options.reportEvery == 0))) {
+            if (!progress(iteration, snapshot())) {
+                break;
+            }
+        }
+    }
+
+    return snapshot();
+}
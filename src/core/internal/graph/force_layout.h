@@ -0,0 +1,65 @@
+// core/internal/graph/force_layout.h
+#ifndef FORCELAYOUT_H
+#define FORCELAYOUT_H
+
+#include <QPointF>
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+class CsrGraph;
+
+// Силовая раскладка графа (Fruchterman-Reingold) с отталкиванием через
+// дерево Barnes-Hut: O(n log n) на итерацию вместо O(n^2).
+// Конструктор копирует ребра, поэтому run() можно вызывать в рабочем потоке,
+// пока исходный граф живет своей жизнью в GUI-потоке.
+class ForceLayout
+{
+public:
+    struct Options {
+        int iterations = 300;
+        double theta = 0.9;             // Порог аппроксимации: размер ячейки / расстояние
+        double idealLength = 60.0;      // Желаемая длина ребра
+        double gravity = 0.05;          // Притяжение к центру, чтобы компоненты не разлетались
+        int reportEvery = 10;           // Как часто отдавать промежуточные позиции
+        int maxWorkers = 0;             // Потоки для отталкивания, <= 0 - все
+    };
+
+    // Возвращает false, чтобы прервать раскладку
+    using ProgressCallback = std::function<bool(int iteration, const std::vector<QPointF>& positions)>;
+
+    ForceLayout(const CsrGraph& graph, const Options& options);
+
+    std::vector<QPointF> run(const ProgressCallback& progress = ProgressCallback());
+
+    int vertexCount() const { return m_vertexCount; }
+
+private:
+    struct QuadNode {
+        double centerX;
+        double centerY;
+        double half;
+        double mass = 0.0;
+        double massX = 0.0;     // Сумма координат, центр масс = massX / mass
+        double massY = 0.0;
+        int firstChild = -1;    // Четыре ребенка подряд
+        int body = -1;
+    };
+
+    void buildQuadTree();
+    void insertBody(int body);
+    int childFor(int node, double x, double y) const;
+    void applyRepulsion(int vertex, double& forceX, double& forceY) const;
+    std::vector<QPointF> snapshot() const;
+
+    int m_vertexCount;
+    std::vector<std::pair<int, int>> m_edges;   // Каждое ребро один раз
+    Options m_options;
+
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<QuadNode> m_quadTree;
+};
+
+#endif // FORCELAYOUT_H
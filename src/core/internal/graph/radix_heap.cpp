@@ -0,0 +1,72 @@
+#include "radix_heap.h"
+
+#include <algorithm>
+
+namespace
+{
+// Количество значащих битов (0 для нуля)
+inline int bitWidth(std::uint32_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return value ? 32 - __builtin_clz(value) : 0;
+#else
+    int width = 0;
+    while (value) {
+        value >>= 1;
+        ++width;
+    }
+    return width;
+#endif
+}
+}
+
+int RadixHeap::bucketFor(std::uint32_t key) const
+{
+    // Корзина 0 - ключи, равные последнему минимуму; корзина i - отличие в бите i - 1
+    return bitWidth(key ^ m_last);
+}
+
+void RadixHeap::push(std::uint32_t key, int value)
+{
+    m_buckets[bucketFor(key)].emplace_back(key, value);
+    ++m_size;
+}
+
+void RadixHeap::redistribute()
+{
+    int index = 1;
+    while (m_buckets[index].empty()) {
+        ++index;
+    }
+
+    // Новый минимум - наименьший ключ первой непустой корзины;
+    // относительно него все ее элементы уходят в корзины с меньшими номерами
+    std::vector<Entry>& bucket = m_buckets[index];
+    m_last = std::min_element(bucket.begin(), bucket.end())->first;
+
+    for (const Entry& entry : bucket) {
+        m_buckets[bucketFor(entry.first)].push_back(entry);
+    }
+    bucket.clear();
+}
+
+RadixHeap::Entry RadixHeap::pop()
+{
+    if (m_buckets[0].empty()) {
+        redistribute();
+    }
+
+    const Entry entry = m_buckets[0].back();
+    m_buckets[0].pop_back();
+    --m_size;
+    return entry;
+}
+
+void RadixHeap::clear()
+{
+    for (std::vector<Entry>& bucket : m_buckets) {
+        bucket.clear();
+    }
+    m_last = 0;
+    m_size = 0;
+}
@@ -0,0 +1,38 @@
+// core/internal/graph/radix_heap.h
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Монотонная очередь с приоритетами для Дейкстры с целыми весами.
+// Извлекаемые ключи не убывают, поэтому элемент раскладывается в корзину
+// по старшему биту, в котором он отличается от последнего извлеченного минимума.
+// Каждый элемент перекладывается не более 32 раз, без сравнений между элементами.
+class RadixHeap
+{
+public:
+    using Entry = std::pair<std::uint32_t, int>;   // Ключ, значение
+
+    // key не должен быть меньше последнего извлеченного ключа
+    void push(std::uint32_t key, int value);
+    Entry pop();
+
+    bool isEmpty() const { return m_size == 0; }
+    std::size_t size() const { return m_size; }
+    void clear();
+
+private:
+    static constexpr int kBucketCount = 33;
+
+    int bucketFor(std::uint32_t key) const;
+    void redistribute();
+
+    std::array<std::vector<Entry>, kBucketCount> m_buckets;
+    std::uint32_t m_last = 0;
+    std::size_t m_size = 0;
+};
+
+#endif // RADIXHEAP_H
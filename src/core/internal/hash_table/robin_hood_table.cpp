@@ -0,0 +1,283 @@
+// RobinHoodTable.cpp
+#include "robin_hood_table.h"
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROBIN_HOOD_USE_SSE2
+#endif
+
+namespace
+{
+// Номер младшего единичного бита (mask != 0)
+inline int lowestBit(unsigned mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int index = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+}
+
+RobinHoodHashTable::RobinHoodHashTable(double maxLoadFactor, QObject* parent)
+    : QObject(parent)
+    , m_maxLoadFactor(std::clamp(maxLoadFactor, 0.1, 0.99))
+{
+    allocate(kMinCapacity);
+}
+
+std::uint64_t RobinHoodHashTable::hashKey(int key)
+{
+    // Финализатор splitmix64: соседние ключи разлетаются по всей таблице
+    std::uint64_t x = std::uint64_t(std::uint32_t(key)) + 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+void RobinHoodHashTable::allocate(int capacity)
+{
+    m_capacity = capacity;
+
+    int bits = 0;
+    while ((1 << bits) < capacity) {
+        ++bits;
+    }
+    // Старшие биты хэша - номер домашнего слота, младший байт - тег
+    m_shift = 64 - bits;
+
+    // Хвост m_probeLimit плюс одна группа, чтобы групповое чтение не выходило за массив
+    m_probeLimit = std::min(kMaxProbe, capacity);
+    const std::size_t total = std::size_t(capacity) + m_probeLimit + kGroupWidth;
+    m_distances.assign(total, 0);
+    m_tags.assign(total, 0);
+    m_keys.assign(total, 0);
+}
+
+int RobinHoodHashTable::findSlot(int key) const
+{
+    const std::uint64_t hash = hashKey(key);
+    const int home = homeSlotForHash(hash);
+    const std::uint8_t tag = tagForHash(hash);
+
+#if defined(ROBIN_HOOD_USE_SSE2)
+    const __m128i tagNeedle = _mm_set1_epi8(char(tag));
+    // Наш ключ на j-м слоте группы имел бы дистанцию offset + j, в байтах - offset + j + 1
+    __m128i expected = _mm_setr_epi8(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+    const __m128i step = _mm_set1_epi8(kGroupWidth);
+
+    for (int offset = 0; offset <= m_probeLimit; offset += kGroupWidth) {
+        const int base = home + offset;
+        const __m128i distances = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_distances.data() + base));
+        const __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_tags.data() + base));
+
+        // Слот с дистанцией меньше нашей (в том числе пустой) обрывает поиск:
+        // по инварианту Robin Hood наш ключ стоял бы раньше него.
+        // Байты беззнаковые: distances < expected, когда max(distances, expected) != distances
+        const __m128i notLess = _mm_cmpeq_epi8(_mm_max_epu8(distances, expected), distances);
+        const unsigned stopMask = ~unsigned(_mm_movemask_epi8(notLess)) & 0xFFFFu;
+        const unsigned limit = stopMask ? (1u << lowestBit(stopMask)) - 1u : 0xFFFFu;
+
+        unsigned candidates = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(tags, tagNeedle))) & limit;
+        while (candidates) {
+            const int slot = base + lowestBit(candidates);
+            if (m_keys[slot] == key) {
+                return slot;
+            }
+            candidates &= candidates - 1;
+        }
+
+        if (stopMask) {
+            return -1;
+        }
+
+        expected = _mm_add_epi8(expected, step);
+    }
+
+    return -1;
+#else
+    for (int distance = 0; distance <= m_probeLimit; ++distance) {
+        const int slot = home + distance;
+        if (m_distances[slot] <= distance) {
+            return -1;
+        }
+        if (m_tags[slot] == tag && m_keys[slot] == key) {
+            return slot;
+        }
+    }
+
+    return -1;
+#endif
+}
+
+QVector<int> RobinHoodHashTable::probeSequence(int key) const
+{
+    QVector<int> sequence;
+
+    const std::uint64_t hash = hashKey(key);
+    const int home = homeSlotForHash(hash);
+
+    for (int distance = 0; distance <= m_probeLimit; ++distance) {
+        const int slot = home + distance;
+        sequence.append(slot);
+
+        if (m_distances[slot] <= distance || m_keys[slot] == key) {
+            break;
+        }
+    }
+
+    return sequence;
+}
+
+bool RobinHoodHashTable::insertUnique(int& key)
+{
+    std::uint64_t hash = hashKey(key);
+    std::uint8_t tag = tagForHash(hash);
+    int slot = homeSlotForHash(hash);
+    std::uint8_t distance = 1;
+
+    while (distance <= m_probeLimit) {
+        if (m_distances[slot] == 0) {
+            m_distances[slot] = distance;
+            m_tags[slot] = tag;
+            m_keys[slot] = key;
+            return true;
+        }
+
+        // "Богатый" элемент (ближе к дому) уступает слот "бедному"
+        if (m_distances[slot] < distance) {
+            std::swap(m_distances[slot], distance);
+            std::swap(m_tags[slot], tag);
+            std::swap(m_keys[slot], key);
+        }
+
+        ++slot;
+        ++distance;
+    }
+
+    return false;
+}
+
+bool RobinHoodHashTable::insert(int key)
+{
+    if (findSlot(key) >= 0) return false;
+
+    if (m_size + 1 > m_capacity * m_maxLoadFactor) {
+        rehash(m_capacity * 2);
+    }
+
+    int pending = key;
+    while (!insertUnique(pending)) {
+        // Слишком длинная цепочка: растем и довставляем вытесненный элемент
+        rehash(m_capacity * 2);
+    }
+    ++m_size;
+
+    emit keyInserted(key);
+    emit structureChanged();
+    return true;
+}
+
+bool RobinHoodHashTable::remove(int key)
+{
+    int slot = findSlot(key);
+    if (slot < 0) return false;
+
+    // Подтягиваем следующие элементы, пока они не на своем домашнем слоте.
+    // Хвост массива всегда пуст, поэтому выход за границу невозможен
+    while (m_distances[slot + 1] > 1) {
+        m_distances[slot] = std::uint8_t(m_distances[slot + 1] - 1);
+        m_tags[slot] = m_tags[slot + 1];
+        m_keys[slot] = m_keys[slot + 1];
+        ++slot;
+    }
+    m_distances[slot] = 0;
+    --m_size;
+
+    emit keyRemoved(key);
+    emit structureChanged();
+    return true;
+}
+
+void RobinHoodHashTable::rehash(int newCapacity)
+{
+    std::vector<int> keys;
+    keys.reserve(std::size_t(m_size));
+    for (std::size_t slot = 0; slot < m_distances.size(); ++slot) {
+        if (m_distances[slot] != 0) {
+            keys.push_back(m_keys[slot]);
+        }
+    }
+
+    int capacity = std::max(newCapacity, kMinCapacity);
+    while (true) {
+        allocate(capacity);
+
+        bool fits = true;
+        for (int key : keys) {
+            int pending = key;
+            if (!insertUnique(pending)) {
+                fits = false;
+                break;
+            }
+        }
+
+        if (fits) return;
+
+        // Крайне маловероятно при разумном хэше - удваиваем еще раз
+        capacity *= 2;
+    }
+}
+
+void RobinHoodHashTable::reserve(int count)
+{
+    int capacity = m_capacity;
+    while (count > capacity * m_maxLoadFactor) {
+        capacity *= 2;
+    }
+
+    if (capacity != m_capacity) {
+        rehash(capacity);
+    }
+}
+
+void RobinHoodHashTable::setMaxLoadFactor(double factor)
+{
+    m_maxLoadFactor = std::clamp(factor, 0.1, 0.99);
+    reserve(m_size);
+}
+
+int RobinHoodHashTable::maxProbeDistance() const
+{
+    int result = 0;
+    for (std::uint8_t distance : m_distances) {
+        result = std::max(result, distance - 1);
+    }
+    return result;
+}
+
+void RobinHoodHashTable::clear()
+{
+    allocate(kMinCapacity);
+    m_size = 0;
+    emit tableCleared();
+    emit structureChanged();
+}
+
+void RobinHoodHashTable::buildFromValues(const QVector<int>& values)
+{
+    clear();
+    reserve(int(values.size()));
+
+    for (int value : values) {
+        insert(value);
+    }
+}
@@ -0,0 +1,93 @@
+// core/internal/hash_table/robin_hood_table.h
+#ifndef ROBINHOODTABLE_H
+#define ROBINHOODTABLE_H
+
+#include <QObject>
+#include <QVector>
+
+#include <cstdint>
+#include <vector>
+
+// Хэш-таблица с открытой адресацией и Robin Hood пробированием над множеством целых ключей.
+// Для каждого слота хранится байт "дистанция + 1" (0 - пусто) и байт-тег из хэша,
+// ключи лежат отдельным массивом. Поиск сравнивает теги и дистанции сразу группой
+// из 16 слотов (SSE2) и читает ключ только у кандидатов.
+// Пробирование не заворачивается в начало: за capacity слотами идет хвост
+// на min(kMaxProbe, capacity) слотов, а если элемент уходит дальше - таблица растет.
+class RobinHoodHashTable : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kGroupWidth = 16;
+    // При заполненности 0.95 на 2^23 слотах самая длинная цепочка около 120:
+    // предел с запасом, чтобы таблица не удваивалась раньше maxLoadFactor.
+    // Дистанция + 1 вместе с шагом группы должна помещаться в байт
+    static constexpr int kMaxProbe = 224;
+    static_assert(kMaxProbe + kGroupWidth <= 255, "distance + 1 must fit in a byte");
+    static constexpr int kMinCapacity = 16;
+    static constexpr double kDefaultMaxLoadFactor = 0.875;
+
+    explicit RobinHoodHashTable(double maxLoadFactor = kDefaultMaxLoadFactor, QObject* parent = nullptr);
+
+    // Возвращает false, если ключ уже есть
+    bool insert(int key);
+    // Удаление со сдвигом назад: без надгробий, хвост кластера подтягивается на слот ближе к дому
+    bool remove(int key);
+    bool contains(int key) const { return findSlot(key) >= 0; }
+    // Номер слота с ключом или -1
+    int findSlot(int key) const;
+    void clear();
+    void reserve(int count);
+
+    void buildFromValues(const QVector<int>& values);
+
+    // Слоты, которые просматривает поиск ключа, по порядку
+    QVector<int> probeSequence(int key) const;
+
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+    int capacity() const { return m_capacity; }
+    // Вместе с хвостом переполнения
+    int slotCount() const { return m_capacity + m_probeLimit; }
+    double loadFactor() const { return double(m_size) / m_capacity; }
+    double maxLoadFactor() const { return m_maxLoadFactor; }
+    void setMaxLoadFactor(double factor);
+
+    bool isOccupied(int slot) const { return m_distances[slot] != 0; }
+    int keyAt(int slot) const { return m_keys[slot]; }
+    int probeDistance(int slot) const { return m_distances[slot] - 1; }
+    int homeSlot(int key) const { return homeSlotForHash(hashKey(key)); }
+    int maxProbeDistance() const;
+
+signals:
+    void keyInserted(int key);
+    void keyRemoved(int key);
+    void structureChanged();
+    void tableCleared();
+
+private:
+    static std::uint64_t hashKey(int key);
+    static std::uint8_t tagForHash(std::uint64_t hash) { return std::uint8_t(hash); }
+    int homeSlotForHash(std::uint64_t hash) const { return int(hash >> m_shift); }
+
+    // Вставка без проверки дубликатов и роста. При превышении m_probeLimit
+    // возвращает false, а в key остается вытесненный элемент
+    bool insertUnique(int& key);
+    void rehash(int newCapacity);
+    void allocate(int capacity);
+
+    std::vector<std::uint8_t> m_distances;  // Дистанция + 1, 0 - пустой слот
+    std::vector<std::uint8_t> m_tags;
+    std::vector<int> m_keys;
+
+    int m_capacity = 0;
+    int m_probeLimit = 0;                   // Длина хвоста: дистанция в таблице меньше capacity
+    int m_shift = 64;
+    int m_size = 0;
+    double m_maxLoadFactor;
+
+    Q_DISABLE_COPY(RobinHoodHashTable)
+};
+
+#endif // ROBINHOODTABLE_H
@@ -0,0 +1,161 @@
+// DaryHeap.cpp
+#include "dary_heap.h"
+
+#include <algorithm>
+
+DaryHeap::DaryHeap(int arity, QObject* parent)
+    : QObject(parent)
+    , m_arity(std::max(kMinArity, arity))
+{
+}
+
+DaryHeap::Handle DaryHeap::push(int priority)
+{
+    Handle handle;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    } else {
+        handle = Handle(m_positions.size());
+        m_positions.push_back(-1);
+    }
+
+    m_items.push_back({priority, handle});
+    m_positions[handle] = int(m_items.size()) - 1;
+    siftUp(int(m_items.size()) - 1);
+
+    emit structureChanged();
+    return handle;
+}
+
+DaryHeap::Handle DaryHeap::topHandle() const
+{
+    return m_items.empty() ? kInvalidHandle : m_items.front().handle;
+}
+
+int DaryHeap::topPriority() const
+{
+    return m_items.empty() ? 0 : m_items.front().priority;
+}
+
+int DaryHeap::pop()
+{
+    if (m_items.empty()) return 0;
+
+    const Entry top = m_items.front();
+    m_positions[top.handle] = -1;
+    m_freeHandles.push_back(top.handle);
+
+    const Entry last = m_items.back();
+    m_items.pop_back();
+
+    if (!m_items.empty()) {
+        place(0, last);
+        siftDown(0);
+    }
+
+    emit structureChanged();
+    return top.priority;
+}
+
+bool DaryHeap::decreaseKey(Handle handle, int newPriority)
+{
+    if (!contains(handle)) return false;
+
+    const int index = m_positions[handle];
+    if (newPriority > m_items[index].priority) return false;
+
+    m_items[index].priority = newPriority;
+    siftUp(index);
+
+    emit structureChanged();
+    return true;
+}
+
+bool DaryHeap::contains(Handle handle) const
+{
+    return handle >= 0 && handle < Handle(m_positions.size()) && m_positions[handle] >= 0;
+}
+
+int DaryHeap::priority(Handle handle) const
+{
+    return contains(handle) ? m_items[m_positions[handle]].priority : 0;
+}
+
+void DaryHeap::clear()
+{
+    m_items.clear();
+    m_positions.clear();
+    m_freeHandles.clear();
+    emit heapCleared();
+    emit structureChanged();
+}
+
+void DaryHeap::buildFromValues(const std::vector<int>& priorities)
+{
+    m_items.clear();
+    m_freeHandles.clear();
+    m_items.reserve(priorities.size());
+    m_positions.resize(priorities.size());
+
+    for (std::size_t i = 0; i < priorities.size(); ++i) {
+        m_items.push_back({priorities[i], Handle(i)});
+        m_positions[i] = int(i);
+    }
+
+    // Построение снизу вверх (Флойд) за O(n): просеиваем всех, у кого есть дети
+    for (int i = parentIndex(size() - 1); i >= 0; --i) {
+        siftDown(i);
+    }
+
+    emit structureChanged();
+}
+
+void DaryHeap::place(int index, const Entry& entry)
+{
+    m_items[index] = entry;
+    m_positions[entry.handle] = index;
+}
+
+void DaryHeap::siftUp(int index)
+{
+    // Вместо обменов двигаем "дырку": каждый элемент пишется один раз
+    const Entry entry = m_items[index];
+
+    while (index > 0) {
+        const int parent = (index - 1) / m_arity;
+        if (m_items[parent].priority <= entry.priority) break;
+
+        place(index, m_items[parent]);
+        index = parent;
+    }
+
+    place(index, entry);
+}
+
+void DaryHeap::siftDown(int index)
+{
+    const Entry entry = m_items[index];
+    const int count = size();
+
+    while (true) {
+        const int first = m_arity * index + 1;
+        if (first >= count) break;
+
+        // Минимальный из (до d) соседних детей - один проход по кэш-линии
+        const int last = std::min(first + m_arity, count);
+        int best = first;
+        for (int child = first + 1; child < last; ++child) {
+            if (m_items[child].priority < m_items[best].priority) {
+                best = child;
+            }
+        }
+
+        if (m_items[best].priority >= entry.priority) break;
+
+        place(index, m_items[best]);
+        index = best;
+    }
+
+    place(index, entry);
+}
@@ -0,0 +1,72 @@
+// core/internal/heap/dary_heap.h
+#ifndef DARYHEAP_H
+#define DARYHEAP_H
+
+#include <QObject>
+
+#include <vector>
+
+// Min-куча с произвольной арностью d на непрерывном массиве.
+// Дети элемента i лежат в [d * i + 1, d * i + d], поэтому при d = 4..8
+// все дети обычно помещаются в одну кэш-линию, а высота в log2(d) раз меньше,
+// чем у двоичной кучи.
+// Каждый элемент получает handle; таблица handle -> индекс позволяет
+// делать decreaseKey за O(log_d n) без поиска элемента.
+class DaryHeap : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Handle = int;
+    static constexpr Handle kInvalidHandle = -1;
+    static constexpr int kMinArity = 2;
+
+    explicit DaryHeap(int arity = 4, QObject* parent = nullptr);
+
+    Handle push(int priority);
+    // Минимальный элемент; для пустой кучи - kInvalidHandle
+    Handle topHandle() const;
+    int topPriority() const;
+    // Удаляет минимум и возвращает его приоритет
+    int pop();
+    // Возвращает false, если handle не в куче или новый приоритет больше текущего
+    bool decreaseKey(Handle handle, int newPriority);
+    bool contains(Handle handle) const;
+    int priority(Handle handle) const;
+    void clear();
+
+    void buildFromValues(const std::vector<int>& priorities);
+
+    int size() const { return int(m_items.size()); }
+    bool isEmpty() const { return m_items.empty(); }
+    int arity() const { return m_arity; }
+
+    // Доступ к массиву для визуализации
+    int priorityAt(int index) const { return m_items[index].priority; }
+    Handle handleAt(int index) const { return m_items[index].handle; }
+    int parentIndex(int index) const { return index > 0 ? (index - 1) / m_arity : -1; }
+    int firstChildIndex(int index) const { return m_arity * index + 1; }
+
+signals:
+    void structureChanged();
+    void heapCleared();
+
+private:
+    struct Entry {
+        int priority;
+        Handle handle;
+    };
+
+    void siftUp(int index);
+    void siftDown(int index);
+    void place(int index, const Entry& entry);
+
+    int m_arity;
+    std::vector<Entry> m_items;
+    std::vector<int> m_positions;       // handle -> индекс в m_items, -1 если удален
+    std::vector<Handle> m_freeHandles;
+
+    Q_DISABLE_COPY(DaryHeap)
+};
+
+#endif // DARYHEAP_H
@@ -0,0 +1,72 @@
+// core/sandbox/sandbox_protocol.h
+#ifndef SANDBOXPROTOCOL_H
+#define SANDBOXPROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Общий формат для GUI, процесса-песочницы и пользовательского кода.
+// Этот заголовок подключает и пользовательская библиотека балансировки:
+// она экспортирует
+//     extern "C" void dsat_balance(const DsatTreeApi* api);
+// и работает с деревом только через api.
+//
+// Дерево лежит в разделяемой памяти: заголовок, за ним массив узлов.
+// Ссылки - индексы в этом массиве, DSAT_NULL_NODE - отсутствие узла.
+// Песочница меняет арену на месте и параллельно шлет в stdout команды,
+// которые GUI повторяет на настоящем BinaryTree:
+//     L <i>          rotateLeft
+//     R <i>          rotateRight
+//     S <i> <j>      swapNodes
+//     T <i>          setRoot
+//     E <i> <текст>  событие трассировки (i может быть -1)
+//     D              пользовательский код завершился
+
+#define DSAT_SANDBOX_ENTRY "dsat_balance"
+
+constexpr std::uint32_t kSandboxMagic = 0x44534154;    // "DSAT"
+constexpr std::uint32_t kSandboxVersion = 1;
+constexpr std::int32_t DSAT_NULL_NODE = -1;
+
+struct DsatArenaHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::int32_t nodeCount;
+    std::int32_t root;
+};
+
+struct DsatArenaNode
+{
+    std::int32_t value;
+    std::int32_t left;
+    std::int32_t right;
+    std::int32_t parent;
+};
+
+struct DsatTreeApi
+{
+    std::uint32_t version;
+
+    int (*nodeCount)();
+    int (*root)();
+    int (*left)(int node);
+    int (*right)(int node);
+    int (*parent)(int node);
+    int (*value)(int node);
+
+    void (*rotateLeft)(int node);
+    void (*rotateRight)(int node);
+    void (*swapNodes)(int node1, int node2);
+    void (*setRoot)(int node);
+    void (*trace)(int node, const char* message);
+};
+
+using DsatBalanceFunction = void (*)(const DsatTreeApi* api);
+
+inline std::size_t sandboxArenaSize(int nodeCount)
+{
+    return sizeof(DsatArenaHeader) + std::size_t(nodeCount > 0 ? nodeCount : 0) * sizeof(DsatArenaNode);
+}
+
+#endif // SANDBOXPROTOCOL_H
@@ -0,0 +1,404 @@
+// SandboxRunner.cpp
+#include "sandbox_runner.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QHash>
+
+namespace
+{
+// Коды возврата dsat_sandbox_host
+const int kExitBadArguments = 2;
+const int kExitNoArena = 3;
+const int kExitNoLibrary = 4;
+
+int nextArenaId = 0;
+}
+
+SandboxRunner::SandboxRunner(QObject* parent)
+    : QObject(parent)
+{
+    QString host = QDir(QCoreApplication::applicationDirPath()).filePath("dsat_sandbox_host");
+#if defined(Q_OS_WIN)
+    host += ".exe";
+#endif
+    m_hostExecutable = host;
+
+    m_timeoutTimer.setSingleShot(true);
+    connect(&m_timeoutTimer, &QTimer::timeout, this, &SandboxRunner::onTimeout);
+
+    m_replayTimer.setInterval(0);
+    connect(&m_replayTimer, &QTimer::timeout, this, &SandboxRunner::replayChunk);
+}
+
+SandboxRunner::~SandboxRunner()
+{
+    if (m_process) {
+        disconnect(m_process, nullptr, this, nullptr);
+        m_process->kill();
+        m_process->waitForFinished(500);
+    }
+}
+
+bool SandboxRunner::writeArena(BinaryTree* tree)
+{
+    // Обход в прямом порядке без рекурсии нумерует узлы
+    m_nodes.clear();
+    QHash<TreeNode*, int> indices;
+
+    QVector<TreeNode*> stack;
+    if (tree->root()) stack.append(tree->root());
+    while (!stack.isEmpty()) {
+        TreeNode* node = stack.takeLast();
+        indices.insert(node, int(m_nodes.size()));
+        m_nodes.append(node);
+
+        if (node->right()) stack.append(node->right());
+        if (node->left()) stack.append(node->left());
+    }
+
+    const int count = int(m_nodes.size());
+    m_arena.setKey(QStringLiteral("dsat_sandbox_%1_%2")
+                       .arg(QCoreApplication::applicationPid())
+                       .arg(++nextArenaId));
+    if (!m_arena.create(qsizetype(sandboxArenaSize(count)))) {
+        m_failure = QStringLiteral("Cannot create shared memory: %1").arg(m_arena.errorString());
+        return false;
+    }
+
+    auto indexOf = [&indices](TreeNode* node) {
+        return node ? indices.value(node, DSAT_NULL_NODE) : DSAT_NULL_NODE;
+    };
+
+    m_arena.lock();
+    auto* header = static_cast<DsatArenaHeader*>(m_arena.data());
+    header->magic = kSandboxMagic;
+    header->version = kSandboxVersion;
+    header->nodeCount = count;
+    header->root = count > 0 ? 0 : DSAT_NULL_NODE;
+
+    auto* nodes = reinterpret_cast<DsatArenaNode*>(header + 1);
+    for (int i = 0; i < count; ++i) {
+        TreeNode* node = m_nodes[i];
+        nodes[i] = {node->value(), indexOf(node->left()), indexOf(node->right()), indexOf(node->parent())};
+    }
+    m_arena.unlock();
+
+    return true;
+}
+
+bool SandboxRunner::run(BinaryTree* tree, const QString& libraryPath, const Limits& limits)
+{
+    if (m_process || !tree) return false;
+
+    m_tree = tree;
+    m_limits = limits;
+    m_pending.clear();
+    m_pendingStart = 0;
+    m_failure.clear();
+    m_appliedCommands = 0;
+    m_doneReceived = false;
+    m_exited = false;
+
+    if (!writeArena(tree)) {
+        emit finished(false, m_failure);
+        return false;
+    }
+
+    m_process = new QProcess(this);
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &SandboxRunner::onReadyReadStandardOutput);
+    connect(m_process, &QProcess::readyReadStandardError, this, &SandboxRunner::onReadyReadStandardError);
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &SandboxRunner::onProcessFinished);
+    connect(m_process, &QProcess::errorOccurred, this, &SandboxRunner::onProcessError);
+
+    m_process->start(m_hostExecutable, {m_arena.key(), libraryPath, QString::number(limits.cpuSeconds)});
+    m_timeoutTimer.start(limits.wallTimeoutMs);
+
+    emit started();
+    return true;
+}
+
+void SandboxRunner::cancel()
+{
+    if (!m_process) return;
+
+    fail(QStringLiteral("Cancelled"));
+}
+
+void SandboxRunner::onTimeout()
+{
+    if (!m_process) return;
+
+    fail(QStringLiteral("Time limit of %1 ms exceeded").arg(m_limits.wallTimeoutMs));
+}
+
+void SandboxRunner::fail(const QString& reason)
+{
+    if (m_failure.isEmpty()) {
+        m_failure = reason;
+    }
+    m_pending.clear();
+    m_pendingStart = 0;
+    m_replayTimer.stop();
+
+    // Уже завершенный процесс ждал только повтора своих команд
+    if (m_exited) {
+        finish(false, m_failure);
+    } else {
+        m_process->kill();
+    }
+}
+
+TreeNode* SandboxRunner::nodeAt(int index) const
+{
+    return index >= 0 && index < m_nodes.size() ? m_nodes[index].data() : nullptr;
+}
+
+bool SandboxRunner::applyCommand(const QByteArray& line)
+{
+    if (line.isEmpty()) return true;
+
+    // Формат строк описан в sandbox_protocol.h
+    const char command = line.at(0);
+    const QList<QByteArray> parts = line.mid(2).split(' ');
+    bool ok = true;
+    const int first = parts.isEmpty() ? DSAT_NULL_NODE : parts.first().toInt(&ok);
+
+    switch (command) {
+    case 'L':
+    case 'R': {
+        TreeNode* node = nodeAt(first);
+        if (!ok || !node) return false;
+        if (command == 'L') {
+            m_tree->rotateLeft(node);
+        } else {
+            m_tree->rotateRight(node);
+        }
+        break;
+    }
+    case 'S': {
+        bool secondOk = parts.size() > 1;
+        const int second = secondOk ? parts[1].toInt(&secondOk) : DSAT_NULL_NODE;
+        TreeNode* node1 = nodeAt(first);
+        TreeNode* node2 = nodeAt(second);
+        if (!ok || !secondOk || !node1 || !node2) return false;
+        m_tree->swapNodes(node1, node2);
+        break;
+    }
+    case 'T': {
+        // Корнем становится только узел без родителя: иначе родитель
+        // сохранил бы ссылку на него, и дерево замкнулось бы в цикл
+        TreeNode* node = nodeAt(first);
+        if (!ok || (first != DSAT_NULL_NODE && !node)) return false;
+        if (node && node->parent()) return false;
+        m_tree->setRoot(node);
+        break;
+    }
+    case 'E': {
+        const int space = line.indexOf(' ', 2);
+        const QString message = space < 0 ? QString() : QString::fromUtf8(line.mid(space + 1));
+        emit traceEvent(nodeAt(first), message);
+        return true;
+    }
+    case 'D':
+        m_doneReceived = true;
+        return true;
+    default:
+        return false;
+    }
+
+    ++m_appliedCommands;
+    return true;
+}
+
+void SandboxRunner::onReadyReadStandardOutput()
+{
+    if (!m_process || !m_failure.isEmpty()) return;
+
+    // Здесь только копим: команды применяет replayChunk по таймеру
+    m_pending.append(m_process->readAllStandardOutput());
+    if (m_pending.size() - m_pendingStart > kMaxPendingBytes) {
+        fail(QStringLiteral("Sandbox output exceeds %1 MB of unapplied commands")
+                 .arg(kMaxPendingBytes / (1024 * 1024)));
+        return;
+    }
+
+    if (!m_replayTimer.isActive()) {
+        m_replayTimer.start();
+    }
+}
+
+void SandboxRunner::replayChunk()
+{
+    if (!m_process) {
+        m_replayTimer.stop();
+        return;
+    }
+
+    QElapsedTimer budget;
+    budget.start();
+
+    int sinceClockCheck = 0;
+    for (qsizetype end = m_pending.indexOf('\n', m_pendingStart); end >= 0;
+         end = m_pending.indexOf('\n', m_pendingStart)) {
+        const QByteArray line = m_pending.mid(m_pendingStart, end - m_pendingStart);
+        m_pendingStart = end + 1;
+
+        if (!m_tree) {
+            fail(QStringLiteral("Tree was destroyed during the run"));
+            return;
+        }
+        if (!applyCommand(line)) {
+            fail(QStringLiteral("Invalid command from sandbox: %1").arg(QString::fromUtf8(line)));
+            return;
+        }
+        if (m_appliedCommands > m_limits.maxCommands) {
+            fail(QStringLiteral("Command limit of %1 exceeded").arg(m_limits.maxCommands));
+            return;
+        }
+
+        if (++sinceClockCheck == kCommandsBetweenClockChecks) {
+            sinceClockCheck = 0;
+            if (budget.elapsed() >= kChunkBudgetMs) {
+                break;
+            }
+        }
+    }
+
+    // Примененное отрезаем целиком раз в кусок, а не на каждой строке
+    const bool drained = m_pending.indexOf('\n', m_pendingStart) < 0;
+    m_pending.remove(0, m_pendingStart);
+    m_pendingStart = 0;
+
+    if (drained) {
+        m_replayTimer.stop();
+        if (m_exited) {
+            finishAfterExit();
+        }
+    }
+}
+
+void SandboxRunner::onReadyReadStandardError()
+{
+    if (!m_process) return;
+
+    const QString text = QString::fromUtf8(m_process->readAllStandardError());
+    if (!text.isEmpty()) {
+        emit outputReceived(text);
+    }
+}
+
+void SandboxRunner::onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    if (!m_process) return;
+
+    m_timeoutTimer.stop();
+    m_exited = true;
+    m_exitCode = exitCode;
+    m_exitStatus = exitStatus;
+
+    // Хвост команд мог прийти вместе с завершением
+    if (m_failure.isEmpty() && m_process->bytesAvailable() > 0) {
+        onReadyReadStandardOutput();
+    }
+
+    // Итог - когда повтор дойдет до конца буфера
+    if (m_failure.isEmpty() && m_replayTimer.isActive()) return;
+
+    finishAfterExit();
+}
+
+void SandboxRunner::finishAfterExit()
+{
+    const int exitCode = m_exitCode;
+    const QProcess::ExitStatus exitStatus = m_exitStatus;
+
+    if (!m_failure.isEmpty()) {
+        finish(false, m_failure);
+    } else if (exitStatus == QProcess::CrashExit) {
+        finish(false, QStringLiteral("Balancing code crashed or exceeded the CPU budget of %1 s")
+                          .arg(m_limits.cpuSeconds));
+    } else if (exitCode == kExitNoLibrary) {
+        finish(false, QStringLiteral("Cannot load the library or resolve %1").arg(DSAT_SANDBOX_ENTRY));
+    } else if (exitCode == kExitNoArena) {
+        finish(false, QStringLiteral("Sandbox could not attach to the shared tree"));
+    } else if (exitCode == kExitBadArguments || exitCode != 0) {
+        finish(false, QStringLiteral("Sandbox exited with code %1").arg(exitCode));
+    } else if (!m_doneReceived) {
+        finish(false, QStringLiteral("Sandbox exited without finishing"));
+    } else if (const QString problem = checkReplayedTree(); !problem.isEmpty()) {
+        finish(false, problem);
+    } else {
+        finish(true, QStringLiteral("Applied %1 commands").arg(m_appliedCommands));
+    }
+}
+
+QString SandboxRunner::checkReplayedTree() const
+{
+    if (!m_tree) return QStringLiteral("Tree was destroyed during the run");
+
+    const int expected = int(m_nodes.size());
+    TreeNode* root = m_tree->root();
+    if (root && root->parent()) return QStringLiteral("Root of the balanced tree has a parent");
+
+    // Симметричный обход без рекурсии: ссылки, порядок ключей и число узлов.
+    // Обход обрывается, как только узлов больше исходного, - так цикл не зависнет
+    QVector<TreeNode*> stack;
+    TreeNode* node = root;
+    TreeNode* previous = nullptr;
+    int count = 0;
+    while (node || !stack.isEmpty()) {
+        while (node) {
+            if (++count > expected) {
+                return QStringLiteral("Balanced tree has more than the original %1 nodes").arg(expected);
+            }
+            for (TreeNode* child : {node->left(), node->right()}) {
+                if (child && child->parent() != node) {
+                    return QStringLiteral("Node %1 does not point back to its parent").arg(child->value());
+                }
+            }
+            stack.append(node);
+            node = node->left();
+        }
+
+        node = stack.takeLast();
+        if (previous && node->value() < previous->value()) {
+            return QStringLiteral("Balanced tree breaks key order at %1 after %2")
+                .arg(node->value()).arg(previous->value());
+        }
+        previous = node;
+        node = node->right();
+    }
+
+    if (count != expected) {
+        return QStringLiteral("Balanced tree has %1 of the original %2 nodes").arg(count).arg(expected);
+    }
+    return QString();
+}
+
+void SandboxRunner::onProcessError(QProcess::ProcessError error)
+{
+    if (error == QProcess::FailedToStart) {
+        finish(false, QStringLiteral("Cannot start %1").arg(m_hostExecutable));
+    }
+}
+
+void SandboxRunner::finish(bool success, const QString& message)
+{
+    if (!m_process) return;
+
+    m_timeoutTimer.stop();
+    m_replayTimer.stop();
+    m_pending.clear();
+    m_pendingStart = 0;
+    m_process->deleteLater();
+    m_process = nullptr;
+
+    if (m_arena.isAttached()) {
+        m_arena.detach();
+    }
+    m_nodes.clear();
+
+    emit finished(success, message);
+}
@@ -0,0 +1,104 @@
+// core/sandbox/sandbox_runner.h
+#ifndef SANDBOXRUNNER_H
+#define SANDBOXRUNNER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QProcess>
+#include <QSharedMemory>
+#include <QPointer>
+#include <QTimer>
+#include <QVector>
+
+#include "sandbox_protocol.h"
+#include "../internal/binary_tree/binary_tree.h"
+
+// Запускает пользовательский код балансировки в отдельном процессе.
+// Дерево кладется в разделяемую память один раз; процесс-песочница читает
+// и поворачивает его прямо там, а в stdout присылает команды, которые
+// runner повторяет на настоящем BinaryTree. Повтор идет кусками по таймеру,
+// как в TraceReplayer: каждая команда - поворот с сигналами, и поток из
+// миллиона команд, прочитанный разом, заморозил бы интерфейс.
+// Падение или зависание пользовательского кода убивает только песочницу.
+class SandboxRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Limits
+    {
+        int cpuSeconds = 2;             // RLIMIT_CPU в песочнице
+        int wallTimeoutMs = 5000;       // Общий таймаут, после него процесс убивается
+        int maxCommands = 1000000;      // Защита от бесконечного потока поворотов
+    };
+
+    explicit SandboxRunner(QObject* parent = nullptr);
+    ~SandboxRunner() override;
+
+    // По умолчанию - dsat_sandbox_host рядом с исполняемым файлом приложения
+    void setHostExecutable(const QString& path) { m_hostExecutable = path; }
+    QString hostExecutable() const { return m_hostExecutable; }
+
+    bool run(BinaryTree* tree, const QString& libraryPath, const Limits& limits = Limits());
+    void cancel();
+    bool isRunning() const { return m_process != nullptr; }
+    int appliedCommandCount() const { return m_appliedCommands; }
+
+signals:
+    void started();
+    void traceEvent(TreeNode* node, const QString& message);
+    void outputReceived(const QString& text);
+    void finished(bool success, const QString& message);
+
+private slots:
+    void onReadyReadStandardOutput();
+    void onReadyReadStandardError();
+    void onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void onProcessError(QProcess::ProcessError error);
+    void onTimeout();
+    void replayChunk();
+
+private:
+    // Время одного куска повтора: остальное в кадре достается интерфейсу
+    static constexpr int kChunkBudgetMs = 12;
+    static constexpr int kCommandsBetweenClockChecks = 256;
+    // Непрочитанных команд в буфере не больше этого: песочница не должна
+    // забивать память быстрее, чем команды применяются
+    static constexpr qsizetype kMaxPendingBytes = 32 * 1024 * 1024;
+
+    bool writeArena(BinaryTree* tree);
+    bool applyCommand(const QByteArray& line);
+    TreeNode* nodeAt(int index) const;
+    void finish(bool success, const QString& message);
+    // Итог по коду завершения процесса, когда все его команды применены
+    void finishAfterExit();
+    // Пустая строка, если после повтора дерево согласовано, упорядочено
+    // и содержит все исходные узлы; иначе - причина отказа
+    QString checkReplayedTree() const;
+    void fail(const QString& reason);
+
+    QString m_hostExecutable;
+    QProcess* m_process = nullptr;
+    QSharedMemory m_arena;
+    QTimer m_timeoutTimer;
+    QTimer m_replayTimer;
+    Limits m_limits;
+
+    QPointer<BinaryTree> m_tree;
+    QVector<QPointer<TreeNode>> m_nodes;    // Индекс в арене -> узел дерева
+    QByteArray m_pending;                   // Еще не примененные команды
+    qsizetype m_pendingStart = 0;           // Начало первой непримененной строки
+
+    QString m_failure;                      // Причина, по которой процесс убит нами
+    int m_appliedCommands = 0;
+    bool m_doneReceived = false;
+
+    // Процесс завершился раньше, чем применены его команды
+    bool m_exited = false;
+    int m_exitCode = 0;
+    QProcess::ExitStatus m_exitStatus = QProcess::NormalExit;
+
+    Q_DISABLE_COPY(SandboxRunner)
+};
+
+#endif // SANDBOXRUNNER_H
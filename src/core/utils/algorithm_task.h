@@ -0,0 +1,155 @@
+// core/utils/algorithm_task.h
+#ifndef ALGORITHMTASK_H
+#define ALGORITHMTASK_H
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+// Пошаговый алгоритм на корутинах C++20.
+// Тело алгоритма делает co_await Step{...} в каждой точке остановки
+// (сравнение, посещение, поворот): шаг запоминается, и корутина спит до
+// следующего resume(). Поэтому визуализатор проигрывает операцию с любой
+// скоростью без потоков, без очереди сигналов и без записанной трассы.
+// Общую часть алгоритма можно вынести в другую задачу и сделать
+// co_await subtask: ее шаги выдаются наружу как шаги внешней.
+//
+// Корутина создается спящей. Уничтожение задачи посреди работы просто
+// освобождает ее кадр, так что структуру алгоритм должен менять целыми
+// кусками между точками остановки.
+template<typename Step>
+class AlgorithmTask
+{
+public:
+    struct promise_type
+    {
+        Step current{};
+        // Вложенная задача, которую сейчас ждет алгоритм
+        std::coroutine_handle<promise_type> child;
+
+        promise_type() = default;
+        ~promise_type()
+        {
+            if (child) {
+                child.destroy();
+            }
+        }
+
+        AlgorithmTask get_return_object()
+        {
+            return AlgorithmTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        // co_await допускает только шаги - случайно ожидать что-то другое нельзя
+        std::suspend_always await_transform(Step step)
+        {
+            current = std::move(step);
+            return {};
+        }
+
+        auto await_transform(AlgorithmTask subtask)
+        {
+            struct SubtaskAwaiter
+            {
+                AlgorithmTask task;
+
+                // Подзадача без остановок не прерывает внешнюю
+                bool await_ready() { return !task.resume(); }
+
+                void await_suspend(std::coroutine_handle<promise_type> parent)
+                {
+                    parent.promise().current = task.step();
+                    parent.promise().child = std::exchange(task.m_handle, {});
+                }
+
+                void await_resume() {}
+            };
+
+            return SubtaskAwaiter{std::move(subtask)};
+        }
+
+        void return_void() {}
+        // Исключения в проекте не используются
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    AlgorithmTask() = default;
+
+    AlgorithmTask(AlgorithmTask&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, {}))
+    {
+    }
+
+    AlgorithmTask& operator=(AlgorithmTask&& other) noexcept
+    {
+        if (this != &other) {
+            destroy();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+
+    ~AlgorithmTask() { destroy(); }
+
+    // До следующей точки остановки. false - алгоритм закончился, step() больше не меняется
+    bool resume() { return resumeHandle(m_handle); }
+
+    // Прогон до конца без остановок; возвращает число пройденных шагов
+    int runToEnd()
+    {
+        int steps = 0;
+        while (resume()) {
+            ++steps;
+        }
+        return steps;
+    }
+
+    bool isValid() const { return bool(m_handle); }
+    bool isDone() const { return !m_handle || m_handle.done(); }
+
+    // Последний шаг (до первого resume() - значение по умолчанию)
+    const Step& step() const { return m_handle.promise().current; }
+
+private:
+    explicit AlgorithmTask(std::coroutine_handle<promise_type> handle)
+        : m_handle(handle)
+    {
+    }
+
+    static bool resumeHandle(std::coroutine_handle<promise_type> handle)
+    {
+        if (!handle || handle.done()) return false;
+
+        promise_type& promise = handle.promise();
+        if (promise.child) {
+            if (resumeHandle(promise.child)) {
+                promise.current = promise.child.promise().current;
+                return true;
+            }
+            // Подзадача закончилась - внешняя продолжает с места co_await
+            promise.child.destroy();
+            promise.child = {};
+        }
+
+        handle.resume();
+        return !handle.done();
+    }
+
+    void destroy()
+    {
+        if (m_handle) {
+            m_handle.destroy();
+            m_handle = {};
+        }
+    }
+
+    std::coroutine_handle<promise_type> m_handle;
+
+    AlgorithmTask(const AlgorithmTask&) = delete;
+    AlgorithmTask& operator=(const AlgorithmTask&) = delete;
+};
+
+#endif // ALGORITHMTASK_H
@@ -0,0 +1,103 @@
+#include "cache_simulator.h"
+
+#include <algorithm>
+
+CacheSimulator::Level::Level(const LevelConfig& config)
+    : m_lineBytes(std::max(1, config.lineBytes))
+    , m_ways(std::max(1, config.ways))
+{
+    // Число наборов не обязано быть степенью двойки (LLC на 12 или 24 МБ)
+    m_sets = std::max(1, config.sizeBytes / (m_lineBytes * m_ways));
+    m_tags.fill(0, m_sets * m_ways);
+    m_stamps.fill(0, m_sets * m_ways);
+}
+
+bool CacheSimulator::Level::lookup(quintptr address)
+{
+    const quintptr line = address / quintptr(m_lineBytes);
+    const int base = int(line % quintptr(m_sets)) * m_ways;
+    const quintptr tag = line + 1;
+    ++m_clock;
+
+    int victim = base;
+    for (int way = base; way < base + m_ways; ++way) {
+        if (m_tags[way] == tag) {
+            m_stamps[way] = m_clock;
+            return true;
+        }
+        // Пустой слот имеет нулевую метку и вытесняется первым
+        if (m_stamps[way] < m_stamps[victim]) {
+            victim = way;
+        }
+    }
+
+    m_tags[victim] = tag;
+    m_stamps[victim] = m_clock;
+    return false;
+}
+
+void CacheSimulator::Level::reset()
+{
+    m_tags.fill(0);
+    m_stamps.fill(0);
+    m_clock = 0;
+}
+
+CacheSimulator::CacheSimulator()
+    : CacheSimulator(Config())
+{
+}
+
+CacheSimulator::CacheSimulator(const Config& config)
+    : m_config(config)
+    , m_l1(config.l1)
+    , m_l2(config.l2)
+    , m_llc(config.llc)
+    , m_tlb(config.tlb)
+{
+}
+
+CacheSimulator::AccessResult CacheSimulator::access(quintptr address)
+{
+    AccessResult result;
+    result.tlbMiss = !m_tlb.lookup(address);
+
+    // Каждый уровень спрашиваем только при промахе предыдущего,
+    // но строку загружаем во все, мимо которых прошли
+    if (m_l1.lookup(address)) {
+        result.servedBy = ServedBy::L1;
+    } else if (m_l2.lookup(address)) {
+        result.servedBy = ServedBy::L2;
+    } else if (m_llc.lookup(address)) {
+        result.servedBy = ServedBy::LLC;
+    } else {
+        result.servedBy = ServedBy::Memory;
+    }
+
+    return result;
+}
+
+CacheSimulator::AccessResult CacheSimulator::accessRange(const void* address, std::size_t bytes)
+{
+    const quintptr start = reinterpret_cast<quintptr>(address);
+    const quintptr line = quintptr(lineBytes());
+    const quintptr first = start / line;
+    const quintptr last = (start + std::max<std::size_t>(bytes, 1) - 1) / line;
+
+    AccessResult worst;
+    for (quintptr i = first; i <= last; ++i) {
+        const AccessResult result = access(i * line);
+        worst.servedBy = std::max(worst.servedBy, result.servedBy);
+        worst.tlbMiss = worst.tlbMiss || result.tlbMiss;
+    }
+
+    return worst;
+}
+
+void CacheSimulator::reset()
+{
+    m_l1.reset();
+    m_l2.reset();
+    m_llc.reset();
+    m_tlb.reset();
+}
@@ -0,0 +1,89 @@
+// core/utils/cache_simulator.h
+#ifndef CACHESIMULATOR_H
+#define CACHESIMULATOR_H
+
+#include <QtGlobal>
+#include <QVector>
+
+#include <cstddef>
+
+// Модель иерархии кэшей: L1 / L2 / LLC и TLB, каждая - множественно-
+// ассоциативный кэш с LRU. Уровни ведут себя как инклюзивные: промах
+// заполняет строку во всех уровнях, вытеснение из нижнего уровня
+// верхние не трогает. Этого хватает, чтобы сравнивать раскладки узлов
+// по промахам без доступа к аппаратным счетчикам.
+class CacheSimulator
+{
+public:
+    struct LevelConfig
+    {
+        int sizeBytes;
+        int lineBytes;
+        int ways;
+    };
+
+    struct Config
+    {
+        LevelConfig l1 {32 * 1024, 64, 8};
+        LevelConfig l2 {1024 * 1024, 64, 16};
+        LevelConfig llc {16 * 1024 * 1024, 64, 16};
+        // TLB: "строка" - страница, размер - число записей * размер страницы
+        LevelConfig tlb {64 * 4096, 4096, 4};
+    };
+
+    // Кто обслужил обращение
+    enum class ServedBy
+    {
+        L1,
+        L2,
+        LLC,
+        Memory
+    };
+
+    struct AccessResult
+    {
+        ServedBy servedBy = ServedBy::L1;
+        bool tlbMiss = false;
+    };
+
+    CacheSimulator();
+    explicit CacheSimulator(const Config& config);
+
+    // Одна строка по адресу
+    AccessResult access(quintptr address);
+    // Все строки диапазона; результат - худший уровень и был ли промах TLB
+    AccessResult accessRange(const void* address, std::size_t bytes);
+
+    // Холодные кэши
+    void reset();
+
+    const Config& config() const { return m_config; }
+    int lineBytes() const { return m_config.l1.lineBytes; }
+
+private:
+    class Level
+    {
+    public:
+        explicit Level(const LevelConfig& config);
+
+        // true - попадание; при промахе строка загружается с вытеснением LRU
+        bool lookup(quintptr address);
+        void reset();
+
+    private:
+        int m_lineBytes;
+        int m_ways;
+        int m_sets;
+        quint64 m_clock = 0;
+        QVector<quintptr> m_tags;   // Номер строки + 1 (0 - пустой слот)
+        QVector<quint64> m_stamps;  // Время последнего обращения
+    };
+
+    Config m_config;
+    Level m_l1;
+    Level m_l2;
+    Level m_llc;
+    Level m_tlb;
+};
+
+#endif // CACHESIMULATOR_H
@@ -0,0 +1,87 @@
+#include "latency_histogram.h"
+
+#include <bit>
+#include <cmath>
+
+int LatencyHistogram::bucketIndex(quint64 value)
+{
+    if (value < quint64(kSubBuckets)) {
+        return int(value);
+    }
+
+    // Старший бит выбирает группу, следующие kSubBucketBits бит - корзину в ней
+    const int msb = 63 - std::countl_zero(value);
+    const int shift = msb - kSubBucketBits;
+    const int sub = int((value >> shift) & (kSubBuckets - 1));
+    return (shift + 1) * kSubBuckets + sub;
+}
+
+quint64 LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < kSubBuckets) {
+        return quint64(index);
+    }
+
+    const int shift = index / kSubBuckets - 1;
+    const quint64 lower = quint64(kSubBuckets + index % kSubBuckets) << shift;
+    return lower + (quint64(1) << shift) - 1;
+}
+
+void LatencyHistogram::record(qint64 nanoseconds)
+{
+    const qint64 value = qMax<qint64>(0, nanoseconds);
+
+    ++m_buckets[bucketIndex(quint64(value))];
+    m_min = m_count == 0 ? value : qMin(m_min, value);
+    m_max = qMax(m_max, value);
+    m_sum += value;
+    ++m_count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    if (other.m_count == 0) return;
+
+    for (int i = 0; i < kBucketCount; ++i) {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_min = m_count == 0 ? other.m_min : qMin(m_min, other.m_min);
+    m_max = qMax(m_max, other.m_max);
+    m_sum += other.m_sum;
+    m_count += other.m_count;
+}
+
+void LatencyHistogram::reset()
+{
+    *this = LatencyHistogram();
+}
+
+qint64 LatencyHistogram::percentile(double quantile) const
+{
+    if (m_count == 0) return 0;
+
+    // Ранг значения, не меньше которого quantile всех записей
+    const qint64 rank = qMax<qint64>(1, qint64(std::ceil(qBound(0.0, quantile, 1.0) * double(m_count))));
+    qint64 seen = 0;
+
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            return qMin<qint64>(m_max, qint64(bucketUpperBound(i)));
+        }
+    }
+    return m_max;
+}
+
+QJsonObject LatencyHistogram::toJson() const
+{
+    QJsonObject object;
+    object["count"] = m_count;
+    object["min"] = min();
+    object["mean"] = mean();
+    object["p50"] = percentile(0.5);
+    object["p99"] = percentile(0.99);
+    object["p999"] = percentile(0.999);
+    object["max"] = m_max;
+    return object;
+}
@@ -0,0 +1,47 @@
+// core/utils/latency_histogram.h
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QJsonObject>
+#include <QtGlobal>
+
+#include <array>
+
+// Гистограмма задержек в наносекундах с логарифмическими корзинами:
+// на каждую степень двойки по 16 корзин, так что перцентиль отличается
+// от точного не больше чем на 1/16. Значения до 16 нс хранятся точно.
+// Память постоянная (~8 КБ), запись - несколько инструкций.
+class LatencyHistogram
+{
+public:
+    void record(qint64 nanoseconds);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    qint64 count() const { return m_count; }
+    qint64 min() const { return m_count > 0 ? m_min : 0; }
+    qint64 max() const { return m_max; }
+    double mean() const { return m_count > 0 ? double(m_sum) / double(m_count) : 0.0; }
+
+    // quantile из [0, 1]: верхняя граница корзины (но не больше max())
+    qint64 percentile(double quantile) const;
+
+    // {"count", "min", "mean", "p50", "p99", "p999", "max"} в наносекундах
+    QJsonObject toJson() const;
+
+private:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    static int bucketIndex(quint64 value);
+    static quint64 bucketUpperBound(int index);
+
+    std::array<qint64, kBucketCount> m_buckets{};
+    qint64 m_count = 0;
+    qint64 m_sum = 0;
+    qint64 m_min = 0;
+    qint64 m_max = 0;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,173 @@
+#include "memory_report.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QStringList>
+
+#include <algorithm>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#define MEMORY_REPORT_USABLE_SIZE
+#elif defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+#if defined(Q_OS_UNIX)
+#include <unistd.h>
+#endif
+
+namespace
+{
+// Заголовок чанка и выравнивание типичного 64-битного malloc
+constexpr std::size_t kChunkHeader = sizeof(std::size_t);
+constexpr std::size_t kChunkAlignment = 16;
+
+QString formatBytes(qint64 bytes)
+{
+    if (bytes < 0) return "n/a";
+    if (bytes < 10 * 1024) return QString("%1 B").arg(bytes);
+    if (bytes < 10 * 1024 * 1024) return QString("%1 KiB").arg(bytes / 1024.0, 0, 'f', 1);
+    return QString("%1 MiB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+}
+}
+
+qint64 MemoryReport::estimateAllocation(std::size_t requested)
+{
+    const std::size_t chunk = (requested + kChunkHeader + kChunkAlignment - 1) & ~(kChunkAlignment - 1);
+    return qint64(std::max(chunk, 2 * kChunkAlignment));
+}
+
+qint64 MemoryReport::allocationBytes(const void* ptr, std::size_t requested)
+{
+    if (!ptr) return estimateAllocation(requested);
+
+#if defined(MEMORY_REPORT_USABLE_SIZE)
+    return qint64(malloc_usable_size(const_cast<void*>(ptr)) + kChunkHeader);
+#elif defined(_MSC_VER)
+    return qint64(_msize(const_cast<void*>(ptr)) + kChunkHeader);
+#else
+    return estimateAllocation(requested);
+#endif
+}
+
+bool MemoryReport::hasAllocatorIntrospection()
+{
+#if defined(MEMORY_REPORT_USABLE_SIZE) || defined(_MSC_VER)
+    return true;
+#else
+    return false;
+#endif
+}
+
+qint64 MemoryReport::residentSetBytes()
+{
+#if defined(Q_OS_LINUX)
+    // statm: size resident shared ... в страницах
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly)) return -1;
+
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) return -1;
+
+    bool ok = false;
+    const qint64 pages = fields[1].toLongLong(&ok);
+    return ok ? pages * sysconf(_SC_PAGESIZE) : -1;
+#else
+    return -1;
+#endif
+}
+
+void MemoryReport::add(const QString& group, const QString& name, qint64 count, qint64 bytes, bool estimated)
+{
+    Category category;
+    category.group = group;
+    category.name = name;
+    category.count = count;
+    category.bytes = bytes;
+    category.estimated = estimated || !hasAllocatorIntrospection();
+    m_categories.append(category);
+}
+
+qint64 MemoryReport::totalBytes() const
+{
+    qint64 total = 0;
+    for (const Category& category : m_categories) {
+        total += category.bytes;
+    }
+    return total;
+}
+
+qint64 MemoryReport::groupBytes(const QString& group) const
+{
+    qint64 total = 0;
+    for (const Category& category : m_categories) {
+        if (category.group == group) {
+            total += category.bytes;
+        }
+    }
+    return total;
+}
+
+QString MemoryReport::toText() const
+{
+    const double perElement = m_elementCount > 0 ? 1.0 / m_elementCount : 0.0;
+
+    QStringList lines;
+    lines.append(QString("Elements: %1").arg(m_elementCount));
+
+    QString currentGroup;
+    for (const Category& category : m_categories) {
+        if (category.group != currentGroup) {
+            currentGroup = category.group;
+            lines.append(QString("[%1] %2, %3 B/element")
+                             .arg(currentGroup)
+                             .arg(formatBytes(groupBytes(currentGroup)))
+                             .arg(groupBytes(currentGroup) * perElement, 0, 'f', 1));
+        }
+
+        lines.append(QString("  %1%2: %3 x%4, %5 B/element")
+                         .arg(category.name)
+                         .arg(category.estimated ? " (est.)" : "")
+                         .arg(formatBytes(category.bytes))
+                         .arg(category.count)
+                         .arg(category.bytes * perElement, 0, 'f', 1));
+    }
+
+    const qint64 total = totalBytes();
+    lines.append(QString("Total: %1, %2 B/element")
+                     .arg(formatBytes(total))
+                     .arg(total * perElement, 0, 'f', 1));
+
+    if (m_rssDelta > 0) {
+        lines.append(QString("RSS growth: %1, accounted %2%")
+                         .arg(formatBytes(m_rssDelta))
+                         .arg(100.0 * total / m_rssDelta, 0, 'f', 1));
+    }
+    lines.append(QString("RSS now: %1").arg(formatBytes(residentSetBytes())));
+
+    return lines.join('\n');
+}
+
+QJsonObject MemoryReport::toJson() const
+{
+    QJsonArray categories;
+    for (const Category& category : m_categories) {
+        QJsonObject object;
+        object["group"] = category.group;
+        object["name"] = category.name;
+        object["count"] = double(category.count);
+        object["bytes"] = double(category.bytes);
+        object["estimated"] = category.estimated;
+        categories.append(object);
+    }
+
+    QJsonObject object;
+    object["elements"] = double(m_elementCount);
+    object["totalBytes"] = double(totalBytes());
+    object["bytesPerElement"] = m_elementCount > 0 ? double(totalBytes()) / m_elementCount : 0.0;
+    object["rssBytes"] = double(residentSetBytes());
+    object["rssDeltaBytes"] = double(m_rssDelta);
+    object["categories"] = categories;
+    return object;
+}
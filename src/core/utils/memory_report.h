@@ -0,0 +1,57 @@
+// core/utils/memory_report.h
+#ifndef MEMORYREPORT_H
+#define MEMORYREPORT_H
+
+#include <QString>
+#include <QVector>
+#include <QJsonObject>
+
+#include <cstddef>
+
+// Учет памяти структуры по категориям (узлы, служебные блоки Qt, элементы сцены).
+// Там, где указатель на блок доступен, размер берется у аллокатора
+// (malloc_usable_size / _msize), иначе - оценка по sizeof с округлением
+// под типичный malloc. Итог сверяется с RSS процесса.
+class MemoryReport
+{
+public:
+    struct Category
+    {
+        QString group;          // "core", "graphics", ...
+        QString name;
+        qint64 count = 0;       // Сколько объектов учтено
+        qint64 bytes = 0;
+        bool estimated = false; // true - хотя бы часть байтов посчитана по оценке
+    };
+
+    // Сколько байт аллокатор реально держит под блок размера requested
+    // (полезная часть плюс заголовок чанка). ptr может быть nullptr -
+    // тогда только оценка.
+    static qint64 allocationBytes(const void* ptr, std::size_t requested);
+    static qint64 estimateAllocation(std::size_t requested);
+    // Размер резидентной памяти процесса или -1, если платформа не умеет
+    static qint64 residentSetBytes();
+    static bool hasAllocatorIntrospection();
+
+    void add(const QString& group, const QString& name, qint64 count, qint64 bytes, bool estimated = false);
+
+    // Объектов, на которые делится итог (узлов дерева)
+    void setElementCount(qint64 count) { m_elementCount = count; }
+    qint64 elementCount() const { return m_elementCount; }
+    // Рост RSS, с которым сравнивается учтенная память (-1 - неизвестно)
+    void setRssDelta(qint64 bytes) { m_rssDelta = bytes; }
+
+    const QVector<Category>& categories() const { return m_categories; }
+    qint64 totalBytes() const;
+    qint64 groupBytes(const QString& group) const;
+
+    QString toText() const;
+    QJsonObject toJson() const;
+
+private:
+    QVector<Category> m_categories;
+    qint64 m_elementCount = 0;
+    qint64 m_rssDelta = -1;
+};
+
+#endif // MEMORYREPORT_H
@@ -0,0 +1,58 @@
+#include "parallel.h"
+
+#include <QThreadPool>
+#include <QSemaphore>
+
+#include <algorithm>
+#include <atomic>
+
+void parallelFor(int count, const std::function<void(int)>& body, int maxWorkers)
+{
+    if (count <= 0) return;
+
+    QThreadPool* pool = QThreadPool::globalInstance();
+    int workers = maxWorkers > 0 ? maxWorkers : pool->maxThreadCount();
+    workers = std::max(1, std::min(workers, count));
+
+    std::atomic<int> next{0};
+    auto drain = [&next, &body, count]() {
+        for (int i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            body(i);
+        }
+    };
+
+    // Дополнительные потоки берем только если пул может их дать прямо сейчас,
+    // иначе вложенные вызовы могли бы ждать друг друга
+    QSemaphore finished;
+    int started = 0;
+    for (int i = 1; i < workers; ++i) {
+        if (!pool->tryStart([&drain, &finished]() {
+                drain();
+                finished.release();
+            })) {
+            break;
+        }
+        ++started;
+    }
+
+    drain();
+    finished.acquire(started);
+}
+
+void parallelInvoke(const std::function<void()>& first, const std::function<void()>& second)
+{
+    QSemaphore finished;
+    const bool started = QThreadPool::globalInstance()->tryStart([&first, &finished]() {
+        first();
+        finished.release();
+    });
+
+    if (!started) {
+        first();
+    }
+    second();
+
+    if (started) {
+        finished.acquire();
+    }
+}
@@ -0,0 +1,21 @@
+// core/utils/parallel.h
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional>
+
+// Выполняет body(i) для всех i из [0, count) на глобальном QThreadPool.
+// Вызывающий поток тоже берет итерации, поэтому функция не блокируется,
+// даже если в пуле нет свободных потоков. Возвращает управление только
+// после завершения всех итераций.
+// maxWorkers <= 0 - использовать все потоки пула.
+void parallelFor(int count, const std::function<void(int)>& body, int maxWorkers = 0);
+
+// Выполняет first и second, по возможности одновременно: first уходит в
+// глобальный QThreadPool, second - в вызывающем потоке. Если свободного
+// потока нет, обе выполняются здесь же по очереди, так что рекурсивные
+// вызовы (разделяй и властвуй) не ждут друг друга. Возвращает управление
+// после завершения обеих.
+void parallelInvoke(const std::function<void()>& first, const std::function<void()>& second);
+
+#endif // PARALLEL_H
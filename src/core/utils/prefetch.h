@@ -0,0 +1,22 @@
+// core/utils/prefetch.h
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+// Подсказка процессору подгрузить кэш-линию с address в L1.
+// Не изменяет семантику программы и не падает на любом адресе.
+inline void prefetchForRead(const void* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+#endif // PREFETCH_H
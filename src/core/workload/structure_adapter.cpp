@@ -0,0 +1,172 @@
+#include "structure_adapter.h"
+
+#include "../internal/binary_tree/binary_tree.h"
+#include "../internal/bplus_tree/bplus_tree.h"
+#include "../internal/hash_table/robin_hood_table.h"
+
+StructureAdapter::~StructureAdapter() = default;
+
+BinaryTreeAdapter::BinaryTreeAdapter(bool splay)
+    : m_tree(new BinaryTree())
+{
+    m_tree->setSplayMode(splay);
+}
+
+BinaryTreeAdapter::~BinaryTreeAdapter()
+{
+    delete m_tree;
+}
+
+QString BinaryTreeAdapter::name() const
+{
+    return m_tree->splayMode() ? "Splay tree" : "BST (unbalanced)";
+}
+
+QObject* BinaryTreeAdapter::structure() const
+{
+    return m_tree;
+}
+
+void BinaryTreeAdapter::apply(const WorkloadOp& op)
+{
+    switch (op.type) {
+    case WorkloadOpType::Insert:
+        // Остальные структуры - множества, дубликаты не вставляем и здесь
+        m_tree->insertUnique(op.key);
+        break;
+    case WorkloadOpType::Find:
+        m_tree->access(op.key);
+        break;
+    case WorkloadOpType::Remove:
+        m_tree->remove(op.key);
+        break;
+    case WorkloadOpType::Range:
+        m_tree->countRange(op.key, op.high());
+        break;
+    }
+}
+
+int BinaryTreeAdapter::size() const
+{
+    return m_tree->size();
+}
+
+int BinaryTreeAdapter::height() const
+{
+    return m_tree->height();
+}
+
+quint64 BinaryTreeAdapter::cost() const
+{
+    return m_tree->statistics().total().comparisons;
+}
+
+BPlusTreeAdapter::BPlusTreeAdapter(int fanout)
+    : m_tree(new BPlusTree(fanout))
+{
+}
+
+BPlusTreeAdapter::~BPlusTreeAdapter()
+{
+    delete m_tree;
+}
+
+QString BPlusTreeAdapter::name() const
+{
+    return QString("B+ tree (fanout %1)").arg(m_tree->fanout());
+}
+
+QObject* BPlusTreeAdapter::structure() const
+{
+    return m_tree;
+}
+
+void BPlusTreeAdapter::apply(const WorkloadOp& op)
+{
+    // Каждая операция спускается от корня до листа: узлов - по высоте
+    m_nodesVisited += quint64(qMax(1, m_tree->height()));
+
+    switch (op.type) {
+    case WorkloadOpType::Insert:
+        m_tree->insert(op.key);
+        break;
+    case WorkloadOpType::Find:
+        m_tree->contains(op.key);
+        break;
+    case WorkloadOpType::Remove:
+        m_tree->remove(op.key);
+        break;
+    case WorkloadOpType::Range:
+        m_tree->countRange(op.key, op.high());
+        break;
+    }
+}
+
+int BPlusTreeAdapter::size() const
+{
+    return m_tree->size();
+}
+
+int BPlusTreeAdapter::height() const
+{
+    return m_tree->height();
+}
+
+HashTableAdapter::HashTableAdapter()
+    : m_table(new RobinHoodHashTable())
+{
+}
+
+HashTableAdapter::~HashTableAdapter()
+{
+    delete m_table;
+}
+
+QString HashTableAdapter::name() const
+{
+    return "Robin Hood hash table";
+}
+
+QObject* HashTableAdapter::structure() const
+{
+    return m_table;
+}
+
+void HashTableAdapter::apply(const WorkloadOp& op)
+{
+    switch (op.type) {
+    case WorkloadOpType::Insert:
+        m_table->insert(op.key);
+        break;
+    case WorkloadOpType::Find: {
+        // Длина пробы известна только для найденного ключа
+        const int slot = m_table->findSlot(op.key);
+        if (slot >= 0) {
+            m_probes += quint64(m_table->probeDistance(slot) + 1);
+        }
+        break;
+    }
+    case WorkloadOpType::Remove:
+        m_table->remove(op.key);
+        break;
+    case WorkloadOpType::Range:
+        // Порядка ключей в таблице нет - проверяем каждый ключ диапазона
+        for (qint64 key = op.key; key <= op.high(); ++key) {
+            const int slot = m_table->findSlot(int(key));
+            if (slot >= 0) {
+                m_probes += quint64(m_table->probeDistance(slot) + 1);
+            }
+        }
+        break;
+    }
+}
+
+int HashTableAdapter::size() const
+{
+    return m_table->size();
+}
+
+int HashTableAdapter::height() const
+{
+    return m_table->maxProbeDistance();
+}
@@ -0,0 +1,95 @@
+// core/workload/structure_adapter.h
+#ifndef STRUCTUREADAPTER_H
+#define STRUCTUREADAPTER_H
+
+#include <QObject>
+#include <QString>
+
+#include "workload.h"
+
+class BinaryTree;
+class BPlusTree;
+class RobinHoodHashTable;
+
+// Единый интерфейс словаря для сравнения: операции нагрузки, размер,
+// высота и своя мера стоимости. Адаптер владеет структурой; структура -
+// обычный QObject, ее можно показать визуализатором через structure().
+class StructureAdapter
+{
+public:
+    virtual ~StructureAdapter();
+
+    virtual QString name() const = 0;
+    virtual QObject* structure() const = 0;
+
+    virtual void apply(const WorkloadOp& op) = 0;
+
+    virtual int size() const = 0;
+    // Уровней дерева или, у хеш-таблицы, наибольшая длина пробы
+    virtual int height() const = 0;
+    virtual QString heightName() const { return "Height"; }
+
+    // Накопленная работа в единицах структуры (сравнения, узлы, пробы)
+    virtual quint64 cost() const = 0;
+    virtual QString costName() const = 0;
+};
+
+// Несбалансированное BST или splay-дерево (политика балансировки)
+class BinaryTreeAdapter : public StructureAdapter
+{
+public:
+    explicit BinaryTreeAdapter(bool splay);
+    ~BinaryTreeAdapter() override;
+
+    QString name() const override;
+    QObject* structure() const override;
+    void apply(const WorkloadOp& op) override;
+    int size() const override;
+    int height() const override;
+    quint64 cost() const override;
+    QString costName() const override { return "Comparisons"; }
+
+private:
+    BinaryTree* m_tree;
+};
+
+class BPlusTreeAdapter : public StructureAdapter
+{
+public:
+    explicit BPlusTreeAdapter(int fanout);
+    ~BPlusTreeAdapter() override;
+
+    QString name() const override;
+    QObject* structure() const override;
+    void apply(const WorkloadOp& op) override;
+    int size() const override;
+    int height() const override;
+    quint64 cost() const override { return m_nodesVisited; }
+    QString costName() const override { return "Nodes visited"; }
+
+private:
+    BPlusTree* m_tree;
+    quint64 m_nodesVisited = 0;
+};
+
+class HashTableAdapter : public StructureAdapter
+{
+public:
+    HashTableAdapter();
+    ~HashTableAdapter() override;
+
+    QString name() const override;
+    QObject* structure() const override;
+    void apply(const WorkloadOp& op) override;
+    int size() const override;
+    int height() const override;
+    QString heightName() const override { return "Max probe"; }
+    quint64 cost() const override { return m_probes; }
+    QString costName() const override { return "Probes (hits)"; }
+
+private:
+    RobinHoodHashTable* m_table;
+    quint64 m_probes = 0;
+};
+
+#endif // STRUCTUREADAPTER_H
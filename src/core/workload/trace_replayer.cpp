@@ -0,0 +1,159 @@
+#include "trace_replayer.h"
+
+#include <QJsonArray>
+#include <QStringList>
+
+LatencyHistogram TraceReplayer::Report::total() const
+{
+    LatencyHistogram sum;
+    for (const LatencyHistogram& histogram : latency) {
+        sum.merge(histogram);
+    }
+    return sum;
+}
+
+QString TraceReplayer::Report::toText() const
+{
+    QStringList lines;
+    lines.append(QString("%1 operations in %2 ms").arg(operations).arg(wallNs / 1e6, 0, 'f', 1));
+
+    auto line = [](const QString& name, const LatencyHistogram& histogram) {
+        return QString("%1: %2 ops, p50 %3 ns, p99 %4 ns, p999 %5 ns, max %6 ns")
+            .arg(name)
+            .arg(histogram.count())
+            .arg(histogram.percentile(0.5))
+            .arg(histogram.percentile(0.99))
+            .arg(histogram.percentile(0.999))
+            .arg(histogram.max());
+    };
+
+    for (int i = 0; i < kOperationKinds; ++i) {
+        if (latency[i].count() > 0) {
+            lines.append(line(workloadOpName(WorkloadOpType(i)), latency[i]));
+        }
+    }
+    lines.append(line("all", total()));
+
+    return lines.join('\n');
+}
+
+QJsonObject TraceReplayer::Report::toJson() const
+{
+    QJsonObject perOperation;
+    for (int i = 0; i < kOperationKinds; ++i) {
+        perOperation[workloadOpName(WorkloadOpType(i))] = latency[i].toJson();
+    }
+
+    QJsonObject object;
+    object["operations"] = operations;
+    object["wallNs"] = wallNs;
+    object["latencyNs"] = perOperation;
+    object["totalLatencyNs"] = total().toJson();
+    return object;
+}
+
+TraceReplayer::TraceReplayer(QObject* parent)
+    : QObject(parent)
+{
+    connect(&m_timer, &QTimer::timeout, this, &TraceReplayer::runChunk);
+}
+
+bool TraceReplayer::start(BinaryTree* tree, const QString& path, double operationsPerSecond, QString* error)
+{
+    cancel();
+    if (!tree) return false;
+
+    if (!m_reader.open(path, error)) {
+        return false;
+    }
+
+    m_tree = tree;
+    m_rate = operationsPerSecond;
+    m_report = Report();
+
+    // Без пауз - следующий кусок сразу после обработки событий
+    m_timer.setInterval(m_rate > 0.0 ? kPacedIntervalMs : 0);
+    m_clock.start();
+    m_timer.start();
+
+    emit progress(0, m_reader.operationCount());
+    return true;
+}
+
+void TraceReplayer::cancel()
+{
+    if (!isRunning()) return;
+    finish(false, "Replay cancelled");
+}
+
+void TraceReplayer::runChunk()
+{
+    if (!m_tree) {
+        finish(false, "The tree was destroyed during replay");
+        return;
+    }
+
+    QElapsedTimer budget;
+    budget.start();
+
+    // В темповом режиме выполняем только операции, чье время уже пришло
+    const qint64 total = m_reader.operationCount();
+    const qint64 due = m_rate > 0.0 ? qMin(total, qint64(double(m_clock.nsecsElapsed()) * m_rate / 1e9)) : total;
+
+    QElapsedTimer operationTimer;
+    WorkloadOp op;
+
+    while (m_reader.operationsRead() < due) {
+        const qint64 chunkEnd = qMin(due, m_reader.operationsRead() + kOperationsBetweenClockChecks);
+
+        while (m_reader.operationsRead() < chunkEnd && m_reader.next(op)) {
+            operationTimer.start();
+            apply(op);
+            m_report.latency[int(op.type)].record(operationTimer.nsecsElapsed());
+        }
+
+        if (m_reader.hasError()) {
+            finish(false, m_reader.errorString());
+            return;
+        }
+
+        if (budget.elapsed() >= kChunkBudgetMs) {
+            break;
+        }
+    }
+
+    m_report.operations = m_reader.operationsRead();
+    emit progress(m_report.operations, total);
+
+    if (m_report.operations >= total) {
+        finish(true, "Replay finished");
+    }
+}
+
+void TraceReplayer::apply(const WorkloadOp& op)
+{
+    switch (op.type) {
+    case WorkloadOpType::Insert:
+        m_tree->insertUnique(op.key);
+        break;
+    case WorkloadOpType::Find:
+        m_tree->access(op.key);
+        break;
+    case WorkloadOpType::Remove:
+        m_tree->remove(op.key);
+        break;
+    case WorkloadOpType::Range:
+        m_tree->countRange(op.key, op.high());
+        break;
+    }
+}
+
+void TraceReplayer::finish(bool completed, const QString& message)
+{
+    m_timer.stop();
+    m_report.operations = m_reader.operationsRead();
+    m_report.wallNs = m_clock.nsecsElapsed();
+    m_reader.close();
+
+    emit finished(completed, message);
+}
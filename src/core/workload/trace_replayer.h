@@ -0,0 +1,74 @@
+// core/workload/trace_replayer.h
+#ifndef TRACEREPLAYER_H
+#define TRACEREPLAYER_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+#include <array>
+
+#include "workload_trace.h"
+#include "../utils/latency_histogram.h"
+#include "../internal/binary_tree/binary_tree.h"
+
+// Проигрывает двоичную трассу (workload_trace.h) на BinaryTree в потоке GUI
+// кусками по таймеру, как генератор больших деревьев: интерфейс не замирает.
+// Трасса читается прямо из отображенного файла. Каждая операция замеряется
+// отдельно, задержки копятся в гистограммах по видам операций.
+// Вставки - без дубликатов (insertUnique), поиск - access() с учетом splay.
+class TraceReplayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kOperationKinds = int(WorkloadOpType::Range) + 1;
+
+    struct Report
+    {
+        std::array<LatencyHistogram, kOperationKinds> latency;
+        qint64 operations = 0;
+        qint64 wallNs = 0;          // От начала до конца, с паузами и отрисовкой
+
+        LatencyHistogram total() const;
+        QString toText() const;
+        QJsonObject toJson() const;
+    };
+
+    explicit TraceReplayer(QObject* parent = nullptr);
+
+    // operationsPerSecond <= 0 - без пауз, иначе операции идут с этим темпом
+    bool start(BinaryTree* tree, const QString& path, double operationsPerSecond = 0.0, QString* error = nullptr);
+    void cancel();
+    bool isRunning() const { return m_timer.isActive(); }
+
+    qint64 operationCount() const { return m_reader.operationCount(); }
+    BinaryTree* tree() const { return m_tree; }
+    const Report& report() const { return m_report; }
+
+signals:
+    void progress(qint64 done, qint64 total);
+    // completed == false - отменено, дерево удалено или трасса повреждена
+    void finished(bool completed, const QString& message);
+
+private:
+    // Время одного куска: остальное в кадре достается интерфейсу
+    static constexpr int kChunkBudgetMs = 12;
+    static constexpr int kOperationsBetweenClockChecks = 256;
+    static constexpr int kPacedIntervalMs = 10;
+
+    void runChunk();
+    void apply(const WorkloadOp& op);
+    void finish(bool completed, const QString& message);
+
+    QTimer m_timer;
+    WorkloadTraceReader m_reader;
+    QPointer<BinaryTree> m_tree;
+    double m_rate = 0.0;
+    QElapsedTimer m_clock;
+    Report m_report;
+};
+
+#endif // TRACEREPLAYER_H
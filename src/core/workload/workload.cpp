@@ -0,0 +1,138 @@
+#include "workload.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QRandomGenerator>
+#include <QTextStream>
+
+#include "workload_trace.h"
+
+QString workloadOpName(WorkloadOpType type)
+{
+    switch (type) {
+    case WorkloadOpType::Insert: return "insert";
+    case WorkloadOpType::Find:   return "find";
+    case WorkloadOpType::Remove: return "remove";
+    case WorkloadOpType::Range:  return "range";
+    }
+    return "unknown";
+}
+
+Workload Workload::generate(const Options& options)
+{
+    Workload workload;
+    const int count = qMax(0, options.operationCount);
+    const int keyRange = qMax(1, options.keyRange);
+    const int insertPercent = qBound(0, options.insertPercent, 100);
+    const int findPercent = qBound(0, options.findPercent, 100 - insertPercent);
+    const int rangePercent = qBound(0, options.rangePercent, 100 - insertPercent - findPercent);
+    const int rangeSpan = qMax(0, options.rangeSpan);
+
+    QRandomGenerator random(options.seed);
+    workload.m_operations.reserve(count);
+
+    int nextAscending = 0;
+    for (int i = 0; i < count; ++i) {
+        const int roll = int(random.bounded(100));
+        const WorkloadOpType type = roll < insertPercent ? WorkloadOpType::Insert
+                                  : roll < insertPercent + findPercent ? WorkloadOpType::Find
+                                  : roll < insertPercent + findPercent + rangePercent ? WorkloadOpType::Range
+                                  : WorkloadOpType::Remove;
+
+        int key = 0;
+        if (options.keyOrder == WorkloadKeyOrder::Uniform) {
+            key = int(random.bounded(keyRange));
+        } else if (type == WorkloadOpType::Insert) {
+            key = nextAscending++;
+        } else {
+            // Среди уже вставленных (до первой вставки - ключ 0)
+            key = nextAscending > 0 ? int(random.bounded(nextAscending)) : 0;
+        }
+
+        workload.m_operations.append({type, key, type == WorkloadOpType::Range ? rangeSpan : 0});
+    }
+
+    workload.m_name = QString("%1 ops, %2% insert / %3% find / %4% range / %5% remove, %6 keys, seed %7")
+                          .arg(count)
+                          .arg(insertPercent)
+                          .arg(findPercent)
+                          .arg(rangePercent)
+                          .arg(100 - insertPercent - findPercent - rangePercent)
+                          .arg(options.keyOrder == WorkloadKeyOrder::Uniform ? QString("uniform") : QString("ascending"))
+                          .arg(options.seed);
+    return workload;
+}
+
+Workload Workload::loadFromFile(const QString& path, QString* error)
+{
+    if (WorkloadTraceReader::isTraceFile(path)) {
+        WorkloadTraceReader reader;
+        if (!reader.open(path, error)) {
+            return Workload();
+        }
+
+        Workload workload;
+        workload.m_operations.reserve(reader.operationCount());
+        WorkloadOp op;
+        while (reader.next(op)) {
+            workload.m_operations.append(op);
+        }
+        if (reader.hasError()) {
+            if (error) *error = reader.errorString();
+            return Workload();
+        }
+
+        workload.m_name = QFileInfo(path).fileName();
+        return workload;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (error) *error = file.errorString();
+        return Workload();
+    }
+
+    Workload workload;
+    QTextStream stream(&file);
+    int lineNumber = 0;
+
+    while (!stream.atEnd()) {
+        const QString line = stream.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith('#')) continue;
+
+        const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
+        const QString op = parts.value(0).toLower();
+        const bool range = op == "range";
+        bool keyOk = false;
+        const int key = parts.size() == (range ? 3 : 2) ? parts[1].toInt(&keyOk) : 0;
+        int span = 0;
+
+        WorkloadOpType type = WorkloadOpType::Insert;
+        if (range) {
+            bool highOk = false;
+            const int high = parts.value(2).toInt(&highOk);
+            keyOk = keyOk && highOk && high >= key;
+            type = WorkloadOpType::Range;
+            span = keyOk ? int(qint64(high) - key) : 0;
+        } else if (op == "insert" || op == "i") {
+            type = WorkloadOpType::Insert;
+        } else if (op == "find" || op == "f") {
+            type = WorkloadOpType::Find;
+        } else if (op == "remove" || op == "r") {
+            type = WorkloadOpType::Remove;
+        } else {
+            keyOk = false;
+        }
+
+        if (!keyOk) {
+            if (error) *error = QString("Line %1: expected \"<insert|find|remove> <key>\" or \"range <low> <high>\"").arg(lineNumber);
+            return Workload();
+        }
+
+        workload.m_operations.append({type, key, span});
+    }
+
+    workload.m_name = QFileInfo(path).fileName();
+    return workload;
+}
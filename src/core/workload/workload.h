@@ -0,0 +1,73 @@
+// core/workload/workload.h
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <QString>
+#include <QVector>
+
+#include <limits>
+
+enum class WorkloadOpType : quint8
+{
+    Insert,
+    Find,
+    Remove,
+    Range
+};
+
+struct WorkloadOp
+{
+    WorkloadOpType type;
+    int key;
+    int span = 0;       // Range: ключи из [key, key + span]
+
+    int high() const { return int(qMin<qint64>(std::numeric_limits<int>::max(), qint64(key) + span)); }
+};
+
+QString workloadOpName(WorkloadOpType type);
+
+enum class WorkloadKeyOrder
+{
+    Uniform,    // Ключи всех операций равномерно из [0, keyRange)
+    Ascending   // Вставки по возрастанию, поиск и удаление - среди вставленных
+};
+
+// Последовательность операций, которую сравнение прогоняет на каждой
+// структуре. Операции неизменяемы после создания, поэтому один Workload
+// без копирования читают сразу несколько рабочих потоков.
+class Workload
+{
+public:
+    struct Options
+    {
+        int operationCount = 100000;
+        int keyRange = 100000;
+        int insertPercent = 50;
+        int findPercent = 40;
+        int rangePercent = 0;       // Остаток - удаления
+        int rangeSpan = 100;
+        WorkloadKeyOrder keyOrder = WorkloadKeyOrder::Uniform;
+        quint32 seed = 1;
+    };
+
+    Workload() = default;
+
+    // При одном seed - те же операции
+    static Workload generate(const Options& options);
+    // Текст: строка на операцию "insert 42" / "find 42" / "remove 42"
+    // (или i/f/r) / "range 10 20", пустые строки и строки с # пропускаются.
+    // Файл двоичной трассы (workload_trace.h) узнается по сигнатуре.
+    // При ошибке - пустой Workload и описание в error.
+    static Workload loadFromFile(const QString& path, QString* error = nullptr);
+
+    const QVector<WorkloadOp>& operations() const { return m_operations; }
+    int size() const { return int(m_operations.size()); }
+    bool isEmpty() const { return m_operations.isEmpty(); }
+    QString name() const { return m_name; }
+
+private:
+    QVector<WorkloadOp> m_operations;
+    QString m_name;
+};
+
+#endif // WORKLOAD_H
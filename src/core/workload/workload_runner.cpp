@@ -0,0 +1,162 @@
+#include "workload_runner.h"
+
+#include <QElapsedTimer>
+
+WorkloadRunner::WorkloadRunner(QObject* parent)
+    : QObject(parent)
+{
+}
+
+WorkloadRunner::~WorkloadRunner()
+{
+    // Без finished: получатели могут уже разбираться вместе с окном
+    if (m_running) {
+        stopThreads();
+    }
+}
+
+void WorkloadRunner::addLane(std::unique_ptr<StructureAdapter> adapter)
+{
+    Q_ASSERT(!m_running);
+    if (m_running || !adapter) return;
+
+    Lane lane;
+    lane.adapter = std::move(adapter);
+    m_lanes.push_back(std::move(lane));
+}
+
+void WorkloadRunner::clearLanes()
+{
+    Q_ASSERT(!m_running);
+    if (m_running) return;
+
+    m_lanes.clear();
+}
+
+bool WorkloadRunner::start(const Workload& workload)
+{
+    if (m_running || m_lanes.empty() || workload.isEmpty()) return false;
+
+    m_workload = workload;
+    m_position = 0;
+    m_stopRequested = false;
+    m_running = true;
+    ++m_generation;
+
+    for (Lane& lane : m_lanes) {
+        lane.statistics = LaneStatistics();
+
+        lane.thread = new QThread();
+        lane.thread->setObjectName(lane.adapter->name());
+        lane.context = new QObject();
+        lane.context->moveToThread(lane.thread);
+
+        // Узлы создаются в потоке дорожки - их родитель должен жить там же
+        QObject* structure = lane.adapter->structure();
+        structure->blockSignals(true);
+        structure->moveToThread(lane.thread);
+
+        lane.thread->start();
+    }
+
+    dispatchRound();
+    return true;
+}
+
+void WorkloadRunner::stop()
+{
+    if (!m_running) return;
+    m_stopRequested = true;
+}
+
+void WorkloadRunner::dispatchRound()
+{
+    const qint64 total = m_workload.size();
+    if (m_stopRequested || m_position >= total) {
+        finishRun(m_position >= total);
+        return;
+    }
+
+    m_roundEnd = qMin(total, m_position + m_roundSize);
+    m_pendingLanes = int(m_lanes.size());
+
+    const int generation = m_generation;
+    const qint64 begin = m_position;
+    const qint64 end = m_roundEnd;
+
+    for (int i = 0; i < int(m_lanes.size()); ++i) {
+        StructureAdapter* adapter = m_lanes[i].adapter.get();
+        const QVector<WorkloadOp> operations = m_workload.operations();
+        LaneStatistics statistics = m_lanes[i].statistics;
+
+        QMetaObject::invokeMethod(m_lanes[i].context, [this, generation, i, adapter, operations, begin, end, statistics]() mutable {
+            const WorkloadOp* ops = operations.constData();
+
+            QElapsedTimer timer;
+            timer.start();
+            for (qint64 k = begin; k < end; ++k) {
+                adapter->apply(ops[k]);
+            }
+            statistics.elapsedNs += timer.nsecsElapsed();
+            statistics.operations += end - begin;
+
+            statistics.size = adapter->size();
+            statistics.height = adapter->height();
+            statistics.cost = adapter->cost();
+
+            QMetaObject::invokeMethod(this, [this, generation, i, statistics]() {
+                onLaneRoundFinished(generation, i, statistics);
+            }, Qt::QueuedConnection);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void WorkloadRunner::onLaneRoundFinished(int generation, int lane, const LaneStatistics& statistics)
+{
+    if (generation != m_generation) return;
+
+    m_lanes[lane].statistics = statistics;
+    if (--m_pendingLanes > 0) return;
+
+    m_position = m_roundEnd;
+    emit roundFinished(m_position, m_workload.size());
+
+    if (m_running) {
+        dispatchRound();
+    }
+}
+
+void WorkloadRunner::finishRun(bool completed)
+{
+    stopThreads();
+    emit finished(completed);
+}
+
+void WorkloadRunner::stopThreads()
+{
+    QThread* guiThread = thread();
+
+    for (Lane& lane : m_lanes) {
+        if (!lane.thread) continue;
+
+        // Возвращать объект может только его текущий поток; очередь дорожки
+        // сначала доделает уже отправленный раунд
+        QObject* structure = lane.adapter->structure();
+        QMetaObject::invokeMethod(lane.context, [structure, guiThread]() {
+            structure->moveToThread(guiThread);
+        }, Qt::BlockingQueuedConnection);
+
+        lane.thread->quit();
+        lane.thread->wait();
+        delete lane.context;
+        delete lane.thread;
+        lane.context = nullptr;
+        lane.thread = nullptr;
+
+        structure->blockSignals(false);
+    }
+
+    m_running = false;
+    m_stopRequested = false;
+    ++m_generation;
+}
@@ -0,0 +1,94 @@
+// core/workload/workload_runner.h
+#ifndef WORKLOADRUNNER_H
+#define WORKLOADRUNNER_H
+
+#include <QObject>
+#include <QThread>
+#include <QVector>
+
+#include <memory>
+#include <vector>
+
+#include "structure_adapter.h"
+#include "workload.h"
+
+struct LaneStatistics
+{
+    qint64 operations = 0;
+    qint64 elapsedNs = 0;       // Только время операций, без сбора статистики
+    int size = 0;
+    int height = 0;
+    quint64 cost = 0;
+
+    double operationsPerSecond() const { return elapsedNs > 0 ? operations * 1e9 / double(elapsedNs) : 0.0; }
+};
+
+// Прогоняет одну нагрузку на нескольких структурах, каждая - в своем потоке.
+// Нагрузка идет раундами по roundSize операций: все дорожки начинают раунд
+// вместе, и следующий начинается, только когда закончили все. Между
+// раундами (в roundFinished) рабочие потоки стоят, и GUI может читать
+// структуры - например, перерисовать визуализаторы.
+// Пока идет прогон, сигналы структур заблокированы: визуализаторы не
+// получают изменений из чужого потока и обновляются только между раундами.
+class WorkloadRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kDefaultRoundSize = 10000;
+
+    explicit WorkloadRunner(QObject* parent = nullptr);
+    ~WorkloadRunner() override;
+
+    // Дорожки меняются только вне прогона
+    void addLane(std::unique_ptr<StructureAdapter> adapter);
+    void clearLanes();
+    int laneCount() const { return int(m_lanes.size()); }
+    const StructureAdapter* adapter(int lane) const { return m_lanes[lane].adapter.get(); }
+    const LaneStatistics& statistics(int lane) const { return m_lanes[lane].statistics; }
+
+    void setRoundSize(int operations) { m_roundSize = qMax(1, operations); }
+    int roundSize() const { return m_roundSize; }
+
+    bool start(const Workload& workload);
+    // Останавливает прогон после текущего раунда
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    qint64 completedOperations() const { return m_position; }
+    qint64 totalOperations() const { return m_workload.size(); }
+
+signals:
+    void roundFinished(qint64 completed, qint64 total);
+    // completed == false - остановлен раньше конца нагрузки
+    void finished(bool completed);
+
+private:
+    struct Lane
+    {
+        std::unique_ptr<StructureAdapter> adapter;
+        LaneStatistics statistics;
+        QThread* thread = nullptr;
+        QObject* context = nullptr;     // Живет в thread, через него туда уходят раунды
+    };
+
+    void dispatchRound();
+    void onLaneRoundFinished(int generation, int lane, const LaneStatistics& statistics);
+    void finishRun(bool completed);
+    // Возвращает структуры в поток GUI и останавливает потоки дорожек
+    void stopThreads();
+
+    std::vector<Lane> m_lanes;
+    Workload m_workload;
+    int m_roundSize = kDefaultRoundSize;
+    qint64 m_position = 0;          // Операций выполнено всеми дорожками
+    qint64 m_roundEnd = 0;
+    int m_pendingLanes = 0;
+    int m_generation = 0;           // Отсекает ответы раундов прерванного прогона
+    bool m_running = false;
+    bool m_stopRequested = false;
+
+    Q_DISABLE_COPY(WorkloadRunner)
+};
+
+#endif // WORKLOADRUNNER_H
@@ -0,0 +1,262 @@
+#include "workload_trace.h"
+
+#include <QtEndian>
+
+#include <cstring>
+#include <limits>
+
+namespace
+{
+void appendVarint(QByteArray& buffer, quint64 value)
+{
+    while (value >= 0x80) {
+        buffer.append(char(value | 0x80));
+        value >>= 7;
+    }
+    buffer.append(char(value));
+}
+
+quint64 zigzag(qint64 value)
+{
+    return (quint64(value) << 1) ^ quint64(value >> 63);
+}
+
+qint64 unzigzag(quint64 value)
+{
+    return qint64(value >> 1) ^ -qint64(value & 1);
+}
+
+QByteArray header(quint64 count)
+{
+    QByteArray bytes(WorkloadTrace::kHeaderSize, '\0');
+    std::memcpy(bytes.data(), WorkloadTrace::kMagic, sizeof(WorkloadTrace::kMagic));
+    qToLittleEndian<quint32>(WorkloadTrace::kVersion, bytes.data() + 8);
+    qToLittleEndian<quint32>(0, bytes.data() + 12);
+    qToLittleEndian<quint64>(count, bytes.data() + 16);
+    return bytes;
+}
+}
+
+WorkloadTraceWriter::~WorkloadTraceWriter()
+{
+    close();
+}
+
+bool WorkloadTraceWriter::open(const QString& path, QString* error)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) *error = m_file.errorString();
+        return false;
+    }
+
+    // Пока трасса не закрыта, число операций неизвестно: оборванная
+    // запись все равно читается до последней целой операции
+    m_buffer = header(WorkloadTrace::kUnknownCount);
+    m_previousKey = 0;
+    m_count = 0;
+    return true;
+}
+
+void WorkloadTraceWriter::append(const WorkloadOp& op)
+{
+    Q_ASSERT(m_file.isOpen());
+
+    m_buffer.append(char(op.type));
+    appendVarint(m_buffer, zigzag(qint64(op.key) - m_previousKey));
+    if (op.type == WorkloadOpType::Range) {
+        appendVarint(m_buffer, quint64(qMax(0, op.span)));
+    }
+
+    m_previousKey = op.key;
+    ++m_count;
+
+    if (m_buffer.size() >= kFlushBytes) {
+        flush();
+    }
+}
+
+void WorkloadTraceWriter::flush()
+{
+    m_file.write(m_buffer);
+    m_buffer.clear();
+}
+
+bool WorkloadTraceWriter::close(QString* error)
+{
+    if (!m_file.isOpen()) return true;
+
+    flush();
+
+    QByteArray count(sizeof(quint64), '\0');
+    qToLittleEndian<quint64>(m_count, count.data());
+    const bool ok = m_file.seek(16) && m_file.write(count) == count.size() && m_file.error() == QFileDevice::NoError;
+
+    if (!ok && error) *error = m_file.errorString();
+    m_file.close();
+    return ok;
+}
+
+bool WorkloadTraceWriter::save(const Workload& workload, const QString& path, QString* error)
+{
+    WorkloadTraceWriter writer;
+    if (!writer.open(path, error)) {
+        return false;
+    }
+
+    for (const WorkloadOp& op : workload.operations()) {
+        writer.append(op);
+    }
+    return writer.close(error);
+}
+
+WorkloadTraceReader::~WorkloadTraceReader()
+{
+    close();
+}
+
+bool WorkloadTraceReader::isTraceFile(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    const QByteArray magic = file.read(sizeof(WorkloadTrace::kMagic));
+    return magic.size() == int(sizeof(WorkloadTrace::kMagic))
+        && std::memcmp(magic.constData(), WorkloadTrace::kMagic, sizeof(WorkloadTrace::kMagic)) == 0;
+}
+
+bool WorkloadTraceReader::open(const QString& path, QString* error)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (error) *error = m_file.errorString();
+        return false;
+    }
+
+    m_size = m_file.size();
+    m_data = m_size >= WorkloadTrace::kHeaderSize ? m_file.map(0, m_size) : nullptr;
+
+    QString problem;
+    if (!m_data) {
+        problem = m_size < WorkloadTrace::kHeaderSize ? QString("File is too short for a trace header")
+                                                      : m_file.errorString();
+    } else if (std::memcmp(m_data, WorkloadTrace::kMagic, sizeof(WorkloadTrace::kMagic)) != 0) {
+        problem = "Not a workload trace";
+    } else if (qFromLittleEndian<quint32>(m_data + 8) != WorkloadTrace::kVersion) {
+        problem = QString("Unsupported trace version %1").arg(qFromLittleEndian<quint32>(m_data + 8));
+    }
+
+    if (!problem.isEmpty()) {
+        if (error) *error = problem;
+        close();
+        return false;
+    }
+
+    const quint64 count = qFromLittleEndian<quint64>(m_data + 16);
+    if (count != WorkloadTrace::kUnknownCount) {
+        m_count = qint64(qMin<quint64>(count, quint64(std::numeric_limits<qint64>::max())));
+    } else {
+        // Запись оборвалась: считаем целые операции до конца файла
+        m_count = std::numeric_limits<qint64>::max();
+        WorkloadOp op;
+        while (next(op)) {
+        }
+        m_count = m_read;
+    }
+
+    rewind();
+    return true;
+}
+
+void WorkloadTraceReader::close()
+{
+    if (m_data) {
+        m_file.unmap(const_cast<uchar*>(m_data));
+        m_data = nullptr;
+    }
+    m_file.close();
+
+    m_size = 0;
+    m_count = 0;
+    rewind();
+}
+
+void WorkloadTraceReader::rewind()
+{
+    m_offset = WorkloadTrace::kHeaderSize;
+    m_read = 0;
+    m_previousKey = 0;
+    m_error.clear();
+}
+
+bool WorkloadTraceReader::fail(const QString& message)
+{
+    m_error = QString("Operation %1: %2").arg(m_read).arg(message);
+    return false;
+}
+
+bool WorkloadTraceReader::readVarint(quint64& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (m_offset >= m_size) return fail("record is truncated");
+
+        const uchar byte = m_data[m_offset++];
+        value |= quint64(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return fail("varint is too long");
+}
+
+bool WorkloadTraceReader::next(WorkloadOp& op)
+{
+    if (!m_data || m_read >= m_count || hasError()) return false;
+
+    if (m_offset >= m_size) {
+        // Конец файла ровно на границе операции - это конец оборванной трассы
+        if (m_count == std::numeric_limits<qint64>::max()) return false;
+        return fail("trace ends before the declared operation count");
+    }
+
+    const qint64 start = m_offset;
+    const uchar type = m_data[m_offset++];
+    if (type > uchar(WorkloadOpType::Range)) {
+        return fail(QString("unknown operation type %1").arg(type));
+    }
+
+    quint64 encoded = 0;
+    quint64 span = 0;
+    bool ok = readVarint(encoded);
+    if (ok && type == uchar(WorkloadOpType::Range)) {
+        ok = readVarint(span);
+    }
+
+    if (!ok) {
+        // Недописанная последняя операция оборванной трассы не ошибка
+        if (m_count == std::numeric_limits<qint64>::max() && m_offset >= m_size) {
+            m_offset = start;
+            m_error.clear();
+        }
+        return false;
+    }
+
+    const qint64 key = qint64(m_previousKey) + unzigzag(encoded);
+    if (key < std::numeric_limits<int>::min() || key > std::numeric_limits<int>::max()) {
+        return fail("key is out of range");
+    }
+    if (span > quint64(std::numeric_limits<int>::max())) {
+        return fail("range span is out of range");
+    }
+
+    op.type = WorkloadOpType(type);
+    op.key = int(key);
+    op.span = int(span);
+
+    m_previousKey = op.key;
+    ++m_read;
+    return true;
+}
@@ -0,0 +1,100 @@
+// core/workload/workload_trace.h
+#ifndef WORKLOADTRACE_H
+#define WORKLOADTRACE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include "workload.h"
+
+// Двоичная трасса операций - компактный формат для записанного
+// production-трафика. Все числа little-endian.
+//
+//   Заголовок (24 байта): "DSATTRC1", quint32 версия, quint32 флаги (0),
+//                         quint64 число операций (kUnknownCount - запись
+//                         оборвалась, операции идут до конца файла)
+//   Операция:             байт типа (WorkloadOpType),
+//                         varint(zigzag(key - key предыдущей операции)),
+//                         у Range еще varint(span)
+//
+// Соседние операции обычно трогают близкие ключи, поэтому разность
+// укладывается в 1-2 байта и операция занимает 2-3 байта вместо 8.
+namespace WorkloadTrace
+{
+constexpr char kMagic[8] = {'D', 'S', 'A', 'T', 'T', 'R', 'C', '1'};
+constexpr quint32 kVersion = 1;
+constexpr int kHeaderSize = 24;
+constexpr quint64 kUnknownCount = ~quint64(0);
+}
+
+// Пишет трассу потоком: операции можно добавлять по мере прихода.
+// Число операций попадает в заголовок в close().
+class WorkloadTraceWriter
+{
+public:
+    WorkloadTraceWriter() = default;
+    ~WorkloadTraceWriter();
+
+    bool open(const QString& path, QString* error = nullptr);
+    void append(const WorkloadOp& op);
+    bool close(QString* error = nullptr);
+    bool isOpen() const { return m_file.isOpen(); }
+
+    static bool save(const Workload& workload, const QString& path, QString* error = nullptr);
+
+private:
+    static constexpr int kFlushBytes = 1 << 16;
+
+    void flush();
+
+    QFile m_file;
+    QByteArray m_buffer;
+    int m_previousKey = 0;
+    quint64 m_count = 0;
+
+    Q_DISABLE_COPY(WorkloadTraceWriter)
+};
+
+// Читает трассу через QFile::map: файл не копируется в память процесса,
+// страницы подгружает ОС по мере чтения, поэтому размер трассы ограничен
+// адресным пространством, а не памятью.
+class WorkloadTraceReader
+{
+public:
+    WorkloadTraceReader() = default;
+    ~WorkloadTraceReader();
+
+    // Проверяет только сигнатуру
+    static bool isTraceFile(const QString& path);
+
+    bool open(const QString& path, QString* error = nullptr);
+    void close();
+
+    qint64 operationCount() const { return m_count; }
+    qint64 operationsRead() const { return m_read; }
+
+    // false - операции кончились или запись повреждена (hasError)
+    bool next(WorkloadOp& op);
+    void rewind();
+
+    bool hasError() const { return !m_error.isEmpty(); }
+    QString errorString() const { return m_error; }
+
+private:
+    bool readVarint(quint64& value);
+    bool fail(const QString& message);
+
+    QFile m_file;
+    const uchar* m_data = nullptr;
+    qint64 m_size = 0;
+    qint64 m_offset = 0;
+    qint64 m_count = 0;
+    qint64 m_read = 0;
+    int m_previousKey = 0;
+    QString m_error;
+
+    Q_DISABLE_COPY(WorkloadTraceReader)
+};
+
+#endif // WORKLOADTRACE_H
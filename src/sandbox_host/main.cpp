@@ -0,0 +1,201 @@
+// Процесс-песочница: подключается к арене с деревом, загружает
+// пользовательскую библиотеку и вызывает dsat_balance.
+// Аргументы: <ключ разделяемой памяти> <путь к библиотеке> <лимит CPU, с>
+#include <QCoreApplication>
+#include <QSharedMemory>
+#include <QLibrary>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "../core/sandbox/sandbox_protocol.h"
+
+#if defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+enum ExitCode
+{
+    kExitOk = 0,
+    kExitBadArguments = 2,
+    kExitNoArena = 3,
+    kExitNoLibrary = 4
+};
+
+// Сбрасываем канал команд пачками: GUI видит прогресс, но без системного вызова на команду
+constexpr int kFlushEvery = 64;
+
+DsatArenaHeader* g_header = nullptr;
+DsatArenaNode* g_nodes = nullptr;
+FILE* g_commands = stdout;
+int g_unflushed = 0;
+
+bool isValid(int node)
+{
+    return node >= 0 && node < g_header->nodeCount;
+}
+
+void sendCommand(const std::string& line, bool flushNow = false)
+{
+    std::fwrite(line.data(), 1, line.size(), g_commands);
+    std::fputc('\n', g_commands);
+
+    if (flushNow || ++g_unflushed >= kFlushEvery) {
+        std::fflush(g_commands);
+        g_unflushed = 0;
+    }
+}
+
+int apiNodeCount() { return g_header->nodeCount; }
+int apiRoot() { return g_header->root; }
+int apiLeft(int node) { return isValid(node) ? g_nodes[node].left : DSAT_NULL_NODE; }
+int apiRight(int node) { return isValid(node) ? g_nodes[node].right : DSAT_NULL_NODE; }
+int apiParent(int node) { return isValid(node) ? g_nodes[node].parent : DSAT_NULL_NODE; }
+int apiValue(int node) { return isValid(node) ? g_nodes[node].value : 0; }
+
+// Повороты повторяют BinaryTree::rotateLeft/rotateRight, чтобы арена и дерево в GUI не расходились
+void replaceChild(int parent, int oldChild, int newChild)
+{
+    if (parent == DSAT_NULL_NODE) {
+        // Как и в BinaryTree, корень меняется только при повороте самого корня
+        if (g_header->root == oldChild) {
+            g_header->root = newChild;
+        }
+    } else if (g_nodes[parent].left == oldChild) {
+        g_nodes[parent].left = newChild;
+    } else {
+        g_nodes[parent].right = newChild;
+    }
+}
+
+void apiRotateLeft(int node)
+{
+    if (!isValid(node) || g_nodes[node].right == DSAT_NULL_NODE) return;
+
+    const int pivot = g_nodes[node].right;
+    const int parent = g_nodes[node].parent;
+
+    g_nodes[node].right = g_nodes[pivot].left;
+    if (g_nodes[pivot].left != DSAT_NULL_NODE) {
+        g_nodes[g_nodes[pivot].left].parent = node;
+    }
+    g_nodes[pivot].left = node;
+    g_nodes[node].parent = pivot;
+    g_nodes[pivot].parent = parent;
+    replaceChild(parent, node, pivot);
+
+    sendCommand("L " + std::to_string(node));
+}
+
+void apiRotateRight(int node)
+{
+    if (!isValid(node) || g_nodes[node].left == DSAT_NULL_NODE) return;
+
+    const int pivot = g_nodes[node].left;
+    const int parent = g_nodes[node].parent;
+
+    g_nodes[node].left = g_nodes[pivot].right;
+    if (g_nodes[pivot].right != DSAT_NULL_NODE) {
+        g_nodes[g_nodes[pivot].right].parent = node;
+    }
+    g_nodes[pivot].right = node;
+    g_nodes[node].parent = pivot;
+    g_nodes[pivot].parent = parent;
+    replaceChild(parent, node, pivot);
+
+    sendCommand("R " + std::to_string(node));
+}
+
+void apiSwapNodes(int node1, int node2)
+{
+    if (!isValid(node1) || !isValid(node2) || node1 == node2) return;
+
+    std::swap(g_nodes[node1].value, g_nodes[node2].value);
+    sendCommand("S " + std::to_string(node1) + " " + std::to_string(node2));
+}
+
+void apiSetRoot(int node)
+{
+    if (node != DSAT_NULL_NODE && !isValid(node)) return;
+
+    g_header->root = node;
+    if (node != DSAT_NULL_NODE) {
+        g_nodes[node].parent = DSAT_NULL_NODE;
+    }
+    sendCommand("T " + std::to_string(node));
+}
+
+void apiTrace(int node, const char* message)
+{
+    // Команда - одна строка, переводы строк в тексте заменяем пробелами
+    std::string text = message ? message : "";
+    for (char& c : text) {
+        if (c == '\n' || c == '\r') c = ' ';
+    }
+
+    sendCommand("E " + std::to_string(isValid(node) ? node : DSAT_NULL_NODE) + " " + text, true);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    if (argc < 4) {
+        std::fprintf(stderr, "usage: %s <shared memory key> <library> <cpu seconds>\n", argv[0]);
+        return kExitBadArguments;
+    }
+
+#if defined(Q_OS_UNIX)
+    // При исчерпании бюджета ядро пришлет SIGXCPU, затем SIGKILL
+    const rlim_t cpuSeconds = rlim_t(std::max(1, std::atoi(argv[3])));
+    rlimit limit{cpuSeconds, cpuSeconds + 1};
+    setrlimit(RLIMIT_CPU, &limit);
+
+    // Канал команд - копия настоящего stdout, а printf пользовательского кода уходит в stderr
+    const int commandFd = dup(STDOUT_FILENO);
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+    g_commands = fdopen(commandFd, "w");
+#endif
+
+    QSharedMemory arena;
+    arena.setKey(QString::fromLocal8Bit(argv[1]));
+    if (!arena.attach(QSharedMemory::ReadWrite)) {
+        std::fprintf(stderr, "sandbox: cannot attach arena: %s\n", qPrintable(arena.errorString()));
+        return kExitNoArena;
+    }
+
+    g_header = static_cast<DsatArenaHeader*>(arena.data());
+    if (std::size_t(arena.size()) < sizeof(DsatArenaHeader) || g_header->magic != kSandboxMagic
+        || g_header->version != kSandboxVersion
+        || std::size_t(arena.size()) < sandboxArenaSize(g_header->nodeCount)) {
+        std::fprintf(stderr, "sandbox: arena layout mismatch\n");
+        return kExitNoArena;
+    }
+    g_nodes = reinterpret_cast<DsatArenaNode*>(g_header + 1);
+
+    QLibrary library(QString::fromLocal8Bit(argv[2]));
+    auto balance = reinterpret_cast<DsatBalanceFunction>(library.resolve(DSAT_SANDBOX_ENTRY));
+    if (!balance) {
+        std::fprintf(stderr, "sandbox: %s\n", qPrintable(library.errorString()));
+        return kExitNoLibrary;
+    }
+
+    const DsatTreeApi api{
+        kSandboxVersion,
+        apiNodeCount, apiRoot, apiLeft, apiRight, apiParent, apiValue,
+        apiRotateLeft, apiRotateRight, apiSwapNodes, apiSetRoot, apiTrace
+    };
+
+    balance(&api);
+
+    sendCommand("D", true);
+    arena.detach();
+    return kExitOk;
+}
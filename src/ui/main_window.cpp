@@ -1,5 +1,19 @@
 #include "main_window.h"
 
+namespace
+{
+QString formatCounters(const OperationCounters& counters)
+{
+    return QString("%1 cmp, %2 rot, %3 nodes, depth %4, +%5/-%6 alloc")
+        .arg(counters.comparisons)
+        .arg(counters.rotations)
+        .arg(counters.nodesTouched)
+        .arg(counters.maxDepth)
+        .arg(counters.allocations)
+        .arg(counters.deallocations);
+}
+}
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
 {
@@ -10,24 +24,584 @@ MainWindow::MainWindow(QWidget *parent)
     QVBoxLayout* layout = new QVBoxLayout(layer);
 
     QComboBox* dataStructSelector = new QComboBox(layer);
-    dataStructSelector->addItems({"Binary tree"});
+    dataStructSelector->addItems({"Binary tree", "B+ tree", "D-ary heap", "Hash table", "Graph"});
     layout->addWidget(dataStructSelector);
 
+    QSpinBox* fanoutSpin = new QSpinBox(layer);
+    fanoutSpin->setPrefix("Fanout: ");
+    fanoutSpin->setRange(BPlusTree::kMinFanout, 256);
+    fanoutSpin->setValue(4);
+    layout->addWidget(fanoutSpin);
+
+    QSpinBox* aritySpin = new QSpinBox(layer);
+    aritySpin->setPrefix("Arity: ");
+    aritySpin->setRange(DaryHeap::kMinArity, 16);
+    aritySpin->setValue(4);
+    layout->addWidget(aritySpin);
+
+    QDoubleSpinBox* loadFactorSpin = new QDoubleSpinBox(layer);
+    loadFactorSpin->setPrefix("Max load factor: ");
+    loadFactorSpin->setRange(0.5, 0.95);
+    loadFactorSpin->setSingleStep(0.05);
+    loadFactorSpin->setValue(RobinHoodHashTable::kDefaultMaxLoadFactor);
+    layout->addWidget(loadFactorSpin);
+
+    QStackedWidget* visualizers = new QStackedWidget(layer);
+    layout->addWidget(visualizers, 1);
+
     BinaryTreeVisualization* binTreeVis = new BinaryTreeVisualization(this);
-    layout->addWidget(binTreeVis, 1);
+    visualizers->addWidget(binTreeVis);
+
+    BPlusTreeVisualization* bplusTreeVis = new BPlusTreeVisualization(this);
+    visualizers->addWidget(bplusTreeVis);
+
+    HeapVisualization* heapVis = new HeapVisualization(this);
+    visualizers->addWidget(heapVis);
+
+    HashTableVisualization* hashTableVis = new HashTableVisualization(this);
+    visualizers->addWidget(hashTableVis);
+
+    GraphVisualization* graphVis = new GraphVisualization(this);
+    visualizers->addWidget(graphVis);
+
+    connect(dataStructSelector, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            visualizers, &QStackedWidget::setCurrentIndex);
 
     QPushButton* generateBtn = new QPushButton("Generate", layer);
     layout->addWidget(generateBtn);
 
-    connect(generateBtn, &QPushButton::clicked, [this, binTreeVis]{
+    // Параметры бинарного дерева: тип, размер (пресеты до 100M), seed
+    QComboBox* treeTypeCombo = new QComboBox(layer);
+    treeTypeCombo->addItem("Random", BinaryTreeType::Random);
+    treeTypeCombo->addItem("Left-heavy", BinaryTreeType::LeftHeavy);
+    treeTypeCombo->addItem("Right-heavy", BinaryTreeType::RightHeavy);
+    layout->addWidget(treeTypeCombo);
+
+    QSpinBox* nodeCountSpin = new QSpinBox(layer);
+    nodeCountSpin->setPrefix("Nodes: ");
+    nodeCountSpin->setRange(1, BinaryTreeGenerator::kMaxNodeCount);
+    nodeCountSpin->setValue(25);
+    layout->addWidget(nodeCountSpin);
+
+    QComboBox* sizePresetCombo = new QComboBox(layer);
+    sizePresetCombo->addItem("Size preset", 0);
+    sizePresetCombo->addItem("25", 25);
+    sizePresetCombo->addItem("1K", 1000);
+    sizePresetCombo->addItem("100K", 100000);
+    sizePresetCombo->addItem("1M", 1000000);
+    sizePresetCombo->addItem("10M", 10000000);
+    sizePresetCombo->addItem("100M", 100000000);
+    layout->addWidget(sizePresetCombo);
+
+    connect(sizePresetCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), [sizePresetCombo, nodeCountSpin](int index){
+        const int count = sizePresetCombo->itemData(index).toInt();
+        if (count > 0) {
+            nodeCountSpin->setValue(count);
+        }
+    });
+
+    QSpinBox* seedSpin = new QSpinBox(layer);
+    seedSpin->setPrefix("Seed: ");
+    seedSpin->setRange(0, std::numeric_limits<int>::max());
+    seedSpin->setSpecialValueText("Seed: random");
+    layout->addWidget(seedSpin);
+
+    QProgressBar* generationProgress = new QProgressBar(layer);
+    generationProgress->setRange(0, 1000);
+    generationProgress->setValue(0);
+    layout->addWidget(generationProgress);
+
+    QPushButton* cancelGenerationBtn = new QPushButton("Cancel generation", layer);
+    cancelGenerationBtn->setEnabled(false);
+    layout->addWidget(cancelGenerationBtn);
+
+    m_binTreeGenerator = new BinaryTreeGenerator(this);
+
+    connect(m_binTreeGenerator, &BinaryTreeGenerator::generationProgress, generationProgress, [generationProgress](qint64 done, qint64 total){
+        generationProgress->setValue(total > 0 ? int(done * 1000 / total) : 1000);
+    });
+    connect(m_binTreeGenerator, &BinaryTreeGenerator::generationCancelled, [generationProgress, generateBtn, cancelGenerationBtn]{
+        generationProgress->setValue(0);
+        generateBtn->setEnabled(true);
+        cancelGenerationBtn->setEnabled(false);
+    });
+    connect(m_binTreeGenerator, &BinaryTreeGenerator::treeGenerated, [generateBtn, cancelGenerationBtn]{
+        generateBtn->setEnabled(true);
+        cancelGenerationBtn->setEnabled(false);
+    });
+    connect(cancelGenerationBtn, &QPushButton::clicked, m_binTreeGenerator, &BinaryTreeGenerator::cancel);
+
+    QCheckBox* splayCheck = new QCheckBox("Splay mode", layer);
+    layout->addWidget(splayCheck);
+
+    connect(splayCheck, &QCheckBox::toggled, [binTreeVis](bool enabled){
+        if (binTreeVis->tree()) {
+            binTreeVis->tree()->setSplayMode(enabled);
+        }
+    });
+
+    QHBoxLayout* findLayout = new QHBoxLayout();
+    QSpinBox* keySpin = new QSpinBox(layer);
+    keySpin->setPrefix("Key: ");
+    keySpin->setRange(-1000000, 1000000);
+    QPushButton* findBtn = new QPushButton("Find", layer);
+    QPushButton* insertBtn = new QPushButton("Insert", layer);
+    QPushButton* removeBtn = new QPushButton("Remove", layer);
+    findLayout->addWidget(keySpin, 1);
+    findLayout->addWidget(findBtn);
+    findLayout->addWidget(insertBtn);
+    findLayout->addWidget(removeBtn);
+    layout->addLayout(findLayout);
 
-        BinaryTreeGenerator* binTreeGen = new BinaryTreeGenerator(this);
-        BinaryTree* tree = binTreeGen->generateTree(BinaryTreeType::Random, 25, false);
+    // Пошаговый режим бинарного дерева: операция - корутина, визуализатор
+    // продвигает ее на заданное число шагов раз в stepDelay миллисекунд
+    QHBoxLayout* stepLayout = new QHBoxLayout();
+    QCheckBox* stepCheck = new QCheckBox("Step-by-step", layer);
+    QSpinBox* stepDelaySpin = new QSpinBox(layer);
+    stepDelaySpin->setPrefix("Frame: ");
+    stepDelaySpin->setSuffix(" ms");
+    stepDelaySpin->setRange(AlgorithmStepper::kDefaultFrameIntervalMs, 2000);
+    stepDelaySpin->setValue(300);
+    QSpinBox* stepsPerFrameSpin = new QSpinBox(layer);
+    stepsPerFrameSpin->setPrefix("Steps per frame: ");
+    stepsPerFrameSpin->setRange(1, AlgorithmStepper::kMaxStepsPerFrame);
+    stepLayout->addWidget(stepCheck);
+    stepLayout->addWidget(stepDelaySpin, 1);
+    stepLayout->addWidget(stepsPerFrameSpin, 1);
+    layout->addLayout(stepLayout);
+
+    AlgorithmStepper* stepper = binTreeVis->algorithmStepper();
+    stepper->setFrameInterval(stepDelaySpin->value());
+    connect(stepDelaySpin, QOverload<int>::of(&QSpinBox::valueChanged),
+            stepper, &AlgorithmStepper::setFrameInterval);
+    connect(stepsPerFrameSpin, QOverload<int>::of(&QSpinBox::valueChanged),
+            stepper, &AlgorithmStepper::setStepsPerFrame);
+    connect(stepCheck, &QCheckBox::toggled, [binTreeVis](bool enabled){
+        if (!enabled) {
+            binTreeVis->cancelSteps();
+        }
+    });
+
+    connect(insertBtn, &QPushButton::clicked, [dataStructSelector, keySpin, stepCheck, binTreeVis]{
+        BinaryTree* tree = binTreeVis->tree();
+        if (dataStructSelector->currentIndex() != 0 || !tree) return;
+
+        if (stepCheck->isChecked()) {
+            binTreeVis->runSteps(tree->insertSteps(keySpin->value()));
+        } else {
+            binTreeVis->cancelSteps();
+            tree->insert(keySpin->value());
+        }
+    });
+
+    connect(removeBtn, &QPushButton::clicked, [dataStructSelector, keySpin, stepCheck, binTreeVis]{
+        BinaryTree* tree = binTreeVis->tree();
+        if (dataStructSelector->currentIndex() != 0 || !tree) return;
+
+        if (stepCheck->isChecked()) {
+            binTreeVis->runSteps(tree->removeSteps(keySpin->value()));
+        } else {
+            binTreeVis->cancelSteps();
+            tree->remove(keySpin->value());
+        }
+    });
+
+    // Стоимость последней операции бинарного дерева и суммы за сессию
+    QLabel* countersLabel = new QLabel(layer);
+    layout->addWidget(countersLabel);
+
+    // Модель кэшей: промахи по операциям и уровням дерева, промахнувшиеся узлы
+    // обводятся в визуализации. Подсказка метки - разбивка по глубине.
+    QCheckBox* cacheCheck = new QCheckBox("Cache simulation", layer);
+    layout->addWidget(cacheCheck);
+    QLabel* cacheLabel = new QLabel(layer);
+    layout->addWidget(cacheLabel);
+
+    CacheTraceAnalyzer* cacheTrace = new CacheTraceAnalyzer(CacheSimulator::Config(), this);
+
+    connect(cacheCheck, &QCheckBox::toggled, [cacheTrace, cacheLabel, binTreeVis](bool enabled){
+        cacheTrace->attach(enabled ? binTreeVis->tree() : nullptr);
+        cacheTrace->resetStatistics();
+        binTreeVis->clearCacheMarks();
+        cacheLabel->clear();
+        cacheLabel->setToolTip(QString());
+    });
+    connect(cacheTrace, &CacheTraceAnalyzer::operationAnalyzed, [cacheTrace, cacheLabel, binTreeVis]{
+        cacheLabel->setText(cacheTrace->summary());
+        cacheLabel->setToolTip(cacheTrace->levelReport());
+        binTreeVis->markCacheMisses(cacheTrace->lastMisses());
+    });
+
+    connect(findBtn, &QPushButton::clicked, [dataStructSelector, keySpin, stepCheck, binTreeVis, bplusTreeVis, heapVis, hashTableVis, graphVis]{
+        if (dataStructSelector->currentIndex() == 1) {
+            bplusTreeVis->highlightSearchPath(keySpin->value());
+            return;
+        }
+
+        if (dataStructSelector->currentIndex() == 2) {
+            // Куча не упорядочена для поиска - просто линейный проход по массиву
+            if (DaryHeap* heap = heapVis->heap()) {
+                int found = -1;
+                for (int i = 0; i < heap->size() && found < 0; ++i) {
+                    if (heap->priorityAt(i) == keySpin->value()) {
+                        found = i;
+                    }
+                }
+                heapVis->highlightIndex(found);
+            }
+            return;
+        }
+
+        if (dataStructSelector->currentIndex() == 3) {
+            hashTableVis->highlightProbeSequence(keySpin->value());
+            return;
+        }
+
+        if (dataStructSelector->currentIndex() == 4) {
+            // Уровни BFS от вершины 0 и кратчайший путь до вершины с номером "ключа"
+            graphVis->clearHighlights();
+            graphVis->showBfsLevels(0);
+            const int distance = graphVis->highlightShortestPath(0, keySpin->value());
+            qDebug() << "Shortest path 0 ->" << keySpin->value() << ":" << distance;
+            return;
+        }
+
+        if (BinaryTree* tree = binTreeVis->tree()) {
+            if (stepCheck->isChecked()) {
+                binTreeVis->runSteps(tree->findSteps(keySpin->value()));
+                return;
+            }
+
+            binTreeVis->cancelSteps();
+            // В splay-режиме найденный узел поднимается в корень с анимацией поворотов
+            // Сбрасываем подсветку до поиска: он отметит промахи кэша
+            binTreeVis->clearHighlights();
+            TreeNode* node = tree->access(keySpin->value());
+            if (node) {
+                binTreeVis->highlightNode(node);
+            }
+        }
+    });
+
+    // Готовое бинарное дерево приходит из генератора, когда собран последний кусок
+    connect(m_binTreeGenerator, &BinaryTreeGenerator::treeGenerated, [this, splayCheck, countersLabel, cacheCheck, cacheTrace, binTreeVis](BinaryTree* tree){
+        tree->setSplayMode(splayCheck->isChecked());
         binTreeVis->setTree(tree);
-        qDebug() << "Tree Is Empty: " << binTreeVis->tree()->isEmpty();
+
+        if (cacheCheck->isChecked()) {
+            cacheTrace->attach(tree);
+            cacheTrace->resetStatistics();
+        }
+
+        // Генерация тоже считалась - начинаем статистику с чистого листа
+        tree->resetStatistics();
+        countersLabel->clear();
+        connect(tree, &BinaryTree::countersUpdated, countersLabel, [countersLabel, tree]{
+            const OperationStatistics& statistics = tree->statistics();
+            const OperationCounters total = statistics.total();
+            countersLabel->setText(QString("Last %1: %2 | Total (%3 ops): %4")
+                                       .arg(treeOperationName(statistics.lastOperation()))
+                                       .arg(formatCounters(statistics.last()))
+                                       .arg(total.operations)
+                                       .arg(formatCounters(total)));
+        });
+        qDebug() << "Tree generated:" << tree->size() << "nodes";
 
         binTreeVis->updateGeometry();
-        qDebug() << "BinTreeVis size after update:" << binTreeVis->size();
+    });
+
+    connect(generateBtn, &QPushButton::clicked, [this, dataStructSelector, fanoutSpin, aritySpin, loadFactorSpin,
+                                              treeTypeCombo, nodeCountSpin, seedSpin, generateBtn, cancelGenerationBtn,
+                                              cacheTrace, binTreeVis, bplusTreeVis, heapVis, hashTableVis, graphVis]{
+
+        if (dataStructSelector->currentIndex() == 1) {
+            BPlusTreeGenerator* bplusTreeGen = new BPlusTreeGenerator(this);
+            BPlusTree* tree = bplusTreeGen->generateTree(BPlusTreeOrder::Random, 25, fanoutSpin->value());
+            bplusTreeVis->setTree(tree);
+            return;
+        }
+
+        if (dataStructSelector->currentIndex() == 2) {
+            HeapGenerator* heapGen = new HeapGenerator(this);
+            DaryHeap* heap = heapGen->generateHeap(25, aritySpin->value());
+            heapVis->setHeap(heap);
+            return;
+        }
+
+        if (dataStructSelector->currentIndex() == 3) {
+            HashTableGenerator* hashTableGen = new HashTableGenerator(this);
+            RobinHoodHashTable* table = hashTableGen->generateTable(25, loadFactorSpin->value());
+            hashTableVis->setTable(table);
+            return;
+        }
+
+        if (dataStructSelector->currentIndex() == 4) {
+            GraphGenerator* graphGen = new GraphGenerator(this);
+            CsrGraph* graph = graphGen->generateGraph(GraphShape::Random, 300, 3);
+            graphVis->setGraph(graph);
+            return;
+        }
+
+        // Старое дерево освобождаем до сборки нового: при 100M узлов
+        // двум деревьям сразу может не хватить памяти
+        if (BinaryTree* oldTree = binTreeVis->tree()) {
+            cacheTrace->attach(nullptr);
+            binTreeVis->setTree(nullptr);
+            oldTree->deleteLater();
+        }
+
+        quint32 seed = quint32(seedSpin->value());
+        if (seed == 0) {
+            seed = QRandomGenerator::global()->generate();
+        }
+        qDebug() << "Generating binary tree:" << nodeCountSpin->value() << "nodes, seed" << seed;
+
+        m_rssBeforeTree = MemoryReport::residentSetBytes();
+        generateBtn->setEnabled(false);
+        cancelGenerationBtn->setEnabled(true);
+        m_binTreeGenerator->startGeneration(BinaryTreeType(treeTypeCombo->currentData().toInt()),
+                                            nodeCountSpin->value(), seed);
+    });
+
+    // Узлы бинарного дерева красятся по частоте посещений
+    QCheckBox* heatmapCheck = new QCheckBox("Access heatmap", layer);
+    layout->addWidget(heatmapCheck);
+
+    connect(heatmapCheck, &QCheckBox::toggled, binTreeVis, &BinaryTreeVisualization::setHeatmapEnabled);
+
+    // Свернутые поддеревья при уменьшении; щелчок по узлу сворачивает вручную
+    QCheckBox* detailCheck = new QCheckBox("Collapse small subtrees", layer);
+    detailCheck->setChecked(binTreeVis->isLevelOfDetailEnabled());
+    layout->addWidget(detailCheck);
+
+    connect(detailCheck, &QCheckBox::toggled, binTreeVis, &BinaryTreeVisualization::setLevelOfDetailEnabled);
+
+    QCheckBox* minimapCheck = new QCheckBox("Minimap", layer);
+    layout->addWidget(minimapCheck);
+
+    connect(minimapCheck, &QCheckBox::toggled, binTreeVis, &VisualizerBase::setMinimapVisible);
+    connect(minimapCheck, &QCheckBox::toggled, bplusTreeVis, &VisualizerBase::setMinimapVisible);
+    connect(minimapCheck, &QCheckBox::toggled, heapVis, &VisualizerBase::setMinimapVisible);
+    connect(minimapCheck, &QCheckBox::toggled, hashTableVis, &VisualizerBase::setMinimapVisible);
+    connect(minimapCheck, &QCheckBox::toggled, graphVis, &VisualizerBase::setMinimapVisible);
+
+    // Оверлей производительности есть только в сборке с DSAT_ENABLE_PERF_HUD
+    if (VisualizerBase::isPerfHudAvailable()) {
+        QCheckBox* perfHudCheck = new QCheckBox("Performance HUD", layer);
+        layout->addWidget(perfHudCheck);
+
+        connect(perfHudCheck, &QCheckBox::toggled, binTreeVis, &VisualizerBase::setPerfHudVisible);
+        connect(perfHudCheck, &QCheckBox::toggled, bplusTreeVis, &VisualizerBase::setPerfHudVisible);
+        connect(perfHudCheck, &QCheckBox::toggled, heapVis, &VisualizerBase::setPerfHudVisible);
+        connect(perfHudCheck, &QCheckBox::toggled, hashTableVis, &VisualizerBase::setPerfHudVisible);
+        connect(perfHudCheck, &QCheckBox::toggled, graphVis, &VisualizerBase::setPerfHudVisible);
+    }
+
+    QPushButton* exportBtn = new QPushButton("Export...", layer);
+    layout->addWidget(exportBtn);
+
+    // Тайлы пишутся в рабочем потоке; окно прогресса позволяет отменить экспорт
+    TileExportTask* tileExport = new TileExportTask(this);
+    QProgressDialog* exportProgress = new QProgressDialog("Exporting PNG tiles...", "Cancel", 0, 1, this);
+    exportProgress->setWindowModality(Qt::WindowModal);
+    exportProgress->setAutoReset(false);
+    exportProgress->setAutoClose(false);
+    exportProgress->reset();
+
+    connect(tileExport, &TileExportTask::progress, exportProgress, [exportProgress](int done, int total){
+        exportProgress->setMaximum(total);
+        exportProgress->setValue(done);
+    });
+    connect(exportProgress, &QProgressDialog::canceled, tileExport, &TileExportTask::cancel);
+    connect(tileExport, &TileExportTask::finished, [exportProgress, exportBtn](bool ok, bool cancelled){
+        exportProgress->reset();
+        exportProgress->hide();
+        exportBtn->setEnabled(true);
+        qDebug() << "PNG tile export" << (ok ? "finished" : cancelled ? "cancelled" : "failed");
+    });
+
+    connect(exportBtn, &QPushButton::clicked, [this, binTreeVis, tileExport, exportProgress, exportBtn]{
+        if (!binTreeVis->tree() || binTreeVis->tree()->isEmpty()) return;
+
+        QString selectedFilter;
+        const QString path = QFileDialog::getSaveFileName(this, "Export tree", QString(),
+                                                          "PNG tiles (*.png);;SVG (*.svg)",
+                                                          &selectedFilter);
+        if (path.isEmpty()) return;
+
+        if (path.endsWith(".svg", Qt::CaseInsensitive)) {
+            const bool ok = binTreeVis->exportToSvg(path);
+            qDebug() << "Export to" << path << (ok ? "finished" : "failed");
+            return;
+        }
+
+        // Тайлы именуются от базового пути без расширения
+        QString basePath = path;
+        if (basePath.endsWith(".png", Qt::CaseInsensitive)) {
+            basePath.chop(4);
+        }
+        if (tileExport->start(binTreeVis->layoutSnapshot(), basePath)) {
+            exportBtn->setEnabled(false);
+            exportProgress->setValue(0);
+            exportProgress->show();
+        }
+    });
+
+    QPushButton* exportCountersBtn = new QPushButton("Export counters...", layer);
+    layout->addWidget(exportCountersBtn);
+
+    connect(exportCountersBtn, &QPushButton::clicked, [this, binTreeVis]{
+        if (!binTreeVis->tree()) return;
+
+        const QString path = QFileDialog::getSaveFileName(this, "Export operation counters", QString(),
+                                                          "JSON (*.json);;CSV (*.csv)");
+        if (path.isEmpty()) return;
+
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qDebug() << "Cannot write" << path << ":" << file.errorString();
+            return;
+        }
+
+        const OperationStatistics& statistics = binTreeVis->tree()->statistics();
+        if (path.endsWith(".csv", Qt::CaseInsensitive)) {
+            file.write(statistics.toCsv().toUtf8());
+        } else {
+            file.write(QJsonDocument(statistics.toJson()).toJson());
+        }
+    });
+
+    QPushButton* memoryBtn = new QPushButton("Memory report", layer);
+    layout->addWidget(memoryBtn);
+
+    connect(memoryBtn, &QPushButton::clicked, [this, binTreeVis]{
+        BinaryTree* tree = binTreeVis->tree();
+        if (!tree) return;
+
+        MemoryReport report;
+        tree->appendMemoryUsage(report);
+        binTreeVis->appendMemoryUsage(report);
+        report.setElementCount(tree->size());
+        if (m_rssBeforeTree >= 0) {
+            report.setRssDelta(MemoryReport::residentSetBytes() - m_rssBeforeTree);
+        }
+
+        qDebug().noquote() << QJsonDocument(report.toJson()).toJson(QJsonDocument::Compact);
+        QMessageBox::information(this, "Memory report", report.toText());
+    });
+
+    // Записанная трасса операций на текущем дереве: темп 0 - без пауз,
+    // и тогда визуализатор на время прогона отключается от дерева
+    QSpinBox* replayRateSpin = new QSpinBox(layer);
+    replayRateSpin->setPrefix("Replay rate: ");
+    replayRateSpin->setSuffix(" ops/s");
+    replayRateSpin->setRange(0, 10000000);
+    replayRateSpin->setSpecialValueText("Replay rate: full speed");
+    replayRateSpin->setValue(0);
+    layout->addWidget(replayRateSpin);
+
+    QPushButton* replayBtn = new QPushButton("Replay trace...", layer);
+    layout->addWidget(replayBtn);
+
+    TraceReplayer* replayer = new TraceReplayer(this);
+
+    connect(replayBtn, &QPushButton::clicked, [this, replayer, replayBtn, replayRateSpin, generateBtn, binTreeVis]{
+        if (replayer->isRunning()) {
+            replayer->cancel();
+            return;
+        }
+        if (m_binTreeGenerator->isGenerating()) return;
+
+        const QString path = QFileDialog::getOpenFileName(this, "Workload trace", QString(),
+                                                          "Workload traces (*.wtrace);;All files (*)");
+        if (path.isEmpty()) return;
+
+        BinaryTree* tree = binTreeVis->tree();
+        if (!tree) {
+            tree = new BinaryTree(this);
+            binTreeVis->setTree(tree);
+        }
+
+        const int rate = replayRateSpin->value();
+        QString error;
+        if (!replayer->start(tree, path, rate, &error)) {
+            QMessageBox::warning(this, "Replay trace", error);
+            return;
+        }
+
+        // На полной скорости сигналы на каждую операцию стоили бы дороже самих операций
+        if (rate == 0) {
+            binTreeVis->setTree(nullptr);
+        }
+        replayBtn->setText("Cancel replay");
+        replayRateSpin->setEnabled(false);
+        generateBtn->setEnabled(false);
+        qDebug() << "Replaying" << replayer->operationCount() << "operations from" << path;
+    });
+
+    connect(replayer, &TraceReplayer::progress, countersLabel, [countersLabel](qint64 done, qint64 total){
+        countersLabel->setText(QString("Replay: %1 / %2 operations").arg(done).arg(total));
+    });
+    connect(replayer, &TraceReplayer::finished, [this, replayer, replayBtn, replayRateSpin, generateBtn, binTreeVis](bool completed, const QString& message){
+        replayBtn->setText("Replay trace...");
+        replayRateSpin->setEnabled(true);
+        generateBtn->setEnabled(true);
+
+        // Визуализатор, отключенный на время прогона, строит дерево заново
+        if (BinaryTree* tree = replayer->tree(); tree && binTreeVis->tree() != tree) {
+            binTreeVis->setTree(tree);
+        }
+
+        qDebug().noquote() << QJsonDocument(replayer->report().toJson()).toJson(QJsonDocument::Compact);
+        QMessageBox::information(this, completed ? "Replay finished" : "Replay stopped",
+                                 message + "\n\n" + replayer->report().toText());
+    });
+
+    // Одна нагрузка на нескольких структурах сразу, в отдельном окне
+    QPushButton* compareBtn = new QPushButton("Compare structures...", layer);
+    layout->addWidget(compareBtn);
+
+    connect(compareBtn, &QPushButton::clicked, [this]{
+        if (!m_comparison) {
+            m_comparison = new ComparisonWidget(this);
+            m_comparison->setWindowFlag(Qt::Window);
+        }
+        m_comparison->show();
+        m_comparison->raise();
+        m_comparison->activateWindow();
+    });
+
+    // Пользовательский код балансировки - разделяемая библиотека с dsat_balance,
+    // выполняется в отдельном процессе (см. core/sandbox/sandbox_protocol.h)
+    QPushButton* sandboxBtn = new QPushButton("Run balancing code...", layer);
+    layout->addWidget(sandboxBtn);
+
+    SandboxRunner* sandbox = new SandboxRunner(this);
+
+    connect(sandboxBtn, &QPushButton::clicked, [this, sandbox, sandboxBtn, binTreeVis]{
+        if (!binTreeVis->tree() || sandbox->isRunning()) return;
+
+        const QString library = QFileDialog::getOpenFileName(this, "Balancing library", QString(),
+                                                             "Libraries (*.so *.dylib *.dll)");
+        if (library.isEmpty()) return;
+
+        if (sandbox->run(binTreeVis->tree(), library)) {
+            sandboxBtn->setEnabled(false);
+        }
+    });
+
+    connect(sandbox, &SandboxRunner::traceEvent, [binTreeVis](TreeNode* node, const QString& message){
+        qDebug() << "Sandbox trace:" << message;
+        if (node) {
+            binTreeVis->highlightNode(node);
+        }
+    });
+    connect(sandbox, &SandboxRunner::outputReceived, [](const QString& text){
+        qDebug().noquote() << "Sandbox output:" << text;
+    });
+    connect(sandbox, &SandboxRunner::finished, [sandboxBtn](bool success, const QString& message){
+        sandboxBtn->setEnabled(true);
+        qDebug() << "Sandbox" << (success ? "finished:" : "failed:") << message;
     });
 
 }
@@ -5,10 +5,37 @@
 #include <QVBoxLayout>
 #include <QComboBox>
 #include <QPushButton>
+#include <QCheckBox>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QStackedWidget>
+#include <QFileDialog>
+#include <QLabel>
+#include <QProgressBar>
+#include <QProgressDialog>
+#include <QFile>
+#include <QJsonDocument>
+#include <QMessageBox>
 #include <QDebug>
 
+#include <limits>
+
 #include "widgets/visualization/binary_tree_visualization.h"
+#include "widgets/visualization/bplus_tree_visualization.h"
+#include "widgets/visualization/heap_visualization.h"
+#include "widgets/visualization/hash_table_visualization.h"
+#include "widgets/visualization/graph_visualization.h"
+#include "widgets/visualization/export/tile_export_task.h"
+#include "widgets/comparison/comparison_widget.h"
 #include "../core/generators/binary_tree_generator.h"
+#include "../core/generators/bplus_tree_generator.h"
+#include "../core/generators/heap_generator.h"
+#include "../core/generators/hash_table_generator.h"
+#include "../core/generators/graph_generator.h"
+#include "../core/sandbox/sandbox_runner.h"
+#include "../core/workload/trace_replayer.h"
+#include "../core/utils/memory_report.h"
+#include "../core/internal/binary_tree/cache_trace_analyzer.h"
 
 class MainWindow : public QMainWindow
 {
@@ -19,5 +46,11 @@ public:
 
 private:
     BinaryTreeType m_binTreeType = BinaryTreeType::Random;
+    // RSS перед генерацией дерева - с ним сверяется отчет о памяти
+    qint64 m_rssBeforeTree = -1;
+    // Один генератор на окно: новая генерация прерывает незаконченную
+    BinaryTreeGenerator* m_binTreeGenerator = nullptr;
+    // Окно сравнения структур, создается при первом открытии
+    ComparisonWidget* m_comparison = nullptr;
 };
 #endif // MAIN_WINDOW_H
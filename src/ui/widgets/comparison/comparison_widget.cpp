@@ -0,0 +1,380 @@
+#include "comparison_widget.h"
+
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QMessageBox>
+#include <QVBoxLayout>
+#include <QDebug>
+
+#include <cmath>
+#include <limits>
+
+#include "../../../core/workload/workload_trace.h"
+#include "../visualization/binary_tree_visualization.h"
+#include "../visualization/bplus_tree_visualization.h"
+#include "../visualization/hash_table_visualization.h"
+
+ComparisonWidget::ComparisonWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_runner(new WorkloadRunner(this))
+{
+    setWindowTitle("Structure comparison");
+    resize(1400, 900);
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+
+    // Структуры и политики балансировки
+    QHBoxLayout* lanesRow = new QHBoxLayout();
+    m_bstCheck = new QCheckBox("BST (unbalanced)", this);
+    m_splayCheck = new QCheckBox("Splay tree", this);
+    m_bplusSmallCheck = new QCheckBox("B+ tree, fanout 4", this);
+    m_bplusLargeCheck = new QCheckBox("B+ tree, fanout 64", this);
+    m_hashCheck = new QCheckBox("Robin Hood hash table", this);
+    m_drawCheck = new QCheckBox("Draw structures", this);
+    for (QCheckBox* check : {m_bstCheck, m_splayCheck, m_bplusSmallCheck, m_bplusLargeCheck, m_hashCheck, m_drawCheck})
+    {
+        check->setChecked(true);
+        lanesRow->addWidget(check);
+    }
+    lanesRow->addStretch();
+    layout->addLayout(lanesRow);
+
+    // Генерируемая нагрузка
+    QHBoxLayout* workloadRow = new QHBoxLayout();
+
+    m_operationsSpin = new QSpinBox(this);
+    m_operationsSpin->setPrefix("Operations: ");
+    m_operationsSpin->setRange(1, 100000000);
+    m_operationsSpin->setValue(200000);
+    workloadRow->addWidget(m_operationsSpin);
+
+    m_keyRangeSpin = new QSpinBox(this);
+    m_keyRangeSpin->setPrefix("Keys: ");
+    m_keyRangeSpin->setRange(1, std::numeric_limits<int>::max());
+    m_keyRangeSpin->setValue(100000);
+    workloadRow->addWidget(m_keyRangeSpin);
+
+    m_insertSpin = new QSpinBox(this);
+    m_insertSpin->setPrefix("Insert: ");
+    m_insertSpin->setSuffix("%");
+    m_insertSpin->setRange(0, 100);
+    m_insertSpin->setValue(50);
+    workloadRow->addWidget(m_insertSpin);
+
+    m_findSpin = new QSpinBox(this);
+    m_findSpin->setPrefix("Find: ");
+    m_findSpin->setSuffix("%");
+    m_findSpin->setRange(0, 100);
+    m_findSpin->setValue(40);
+    workloadRow->addWidget(m_findSpin);
+
+    m_rangeSpin = new QSpinBox(this);
+    m_rangeSpin->setPrefix("Range: ");
+    m_rangeSpin->setSuffix("%");
+    m_rangeSpin->setRange(0, 100);
+    m_rangeSpin->setValue(0);
+    workloadRow->addWidget(m_rangeSpin);
+
+    m_keyOrderCombo = new QComboBox(this);
+    m_keyOrderCombo->addItem("Uniform keys", int(WorkloadKeyOrder::Uniform));
+    m_keyOrderCombo->addItem("Ascending inserts", int(WorkloadKeyOrder::Ascending));
+    workloadRow->addWidget(m_keyOrderCombo);
+
+    m_seedSpin = new QSpinBox(this);
+    m_seedSpin->setPrefix("Seed: ");
+    m_seedSpin->setRange(0, std::numeric_limits<int>::max());
+    m_seedSpin->setValue(1);
+    workloadRow->addWidget(m_seedSpin);
+
+    m_roundSizeSpin = new QSpinBox(this);
+    m_roundSizeSpin->setPrefix("Ops per round: ");
+    m_roundSizeSpin->setRange(1, 10000000);
+    m_roundSizeSpin->setValue(WorkloadRunner::kDefaultRoundSize);
+    workloadRow->addWidget(m_roundSizeSpin);
+
+    workloadRow->addStretch();
+    layout->addLayout(workloadRow);
+
+    // Нагрузка из файла и управление прогоном
+    QHBoxLayout* runRow = new QHBoxLayout();
+
+    m_loadButton = new QPushButton("Load workload...", this);
+    runRow->addWidget(m_loadButton);
+
+    m_generatedButton = new QPushButton("Use generated", this);
+    m_generatedButton->setEnabled(false);
+    runRow->addWidget(m_generatedButton);
+
+    // Текущая нагрузка в двоичную трассу - ее же проигрывает TraceReplayer
+    m_saveTraceButton = new QPushButton("Save as trace...", this);
+    runRow->addWidget(m_saveTraceButton);
+
+    m_workloadLabel = new QLabel("Workload: generated", this);
+    runRow->addWidget(m_workloadLabel, 1);
+
+    m_startButton = new QPushButton("Start", this);
+    runRow->addWidget(m_startButton);
+
+    m_stopButton = new QPushButton("Stop", this);
+    m_stopButton->setEnabled(false);
+    runRow->addWidget(m_stopButton);
+
+    m_progress = new QProgressBar(this);
+    m_progress->setRange(0, 1000);
+    m_progress->setValue(0);
+    runRow->addWidget(m_progress, 1);
+
+    layout->addLayout(runRow);
+
+    m_grid = new QGridLayout();
+    layout->addLayout(m_grid, 1);
+
+    connect(m_startButton, &QPushButton::clicked, this, &ComparisonWidget::onStartClicked);
+    connect(m_stopButton, &QPushButton::clicked, m_runner, &WorkloadRunner::stop);
+    connect(m_loadButton, &QPushButton::clicked, this, &ComparisonWidget::onLoadClicked);
+    connect(m_saveTraceButton, &QPushButton::clicked, this, &ComparisonWidget::onSaveTraceClicked);
+    connect(m_generatedButton, &QPushButton::clicked, [this]{
+        m_loadedWorkload = Workload();
+        m_workloadLabel->setText("Workload: generated");
+        m_generatedButton->setEnabled(false);
+    });
+
+    connect(m_runner, &WorkloadRunner::roundFinished, this, &ComparisonWidget::onRoundFinished);
+    connect(m_runner, &WorkloadRunner::finished, this, &ComparisonWidget::onRunFinished);
+}
+
+ComparisonWidget::~ComparisonWidget()
+{
+    // Визуализаторы отпускают структуры раньше, чем runner их удалит
+    clearCells();
+}
+
+Workload ComparisonWidget::currentWorkload() const
+{
+    if (!m_loadedWorkload.isEmpty())
+    {
+        return m_loadedWorkload;
+    }
+
+    Workload::Options options;
+    options.operationCount = m_operationsSpin->value();
+    options.keyRange = m_keyRangeSpin->value();
+    options.insertPercent = m_insertSpin->value();
+    options.findPercent = m_findSpin->value();
+    options.rangePercent = m_rangeSpin->value();
+    options.keyOrder = WorkloadKeyOrder(m_keyOrderCombo->currentData().toInt());
+    options.seed = quint32(m_seedSpin->value());
+    return Workload::generate(options);
+}
+
+void ComparisonWidget::onLoadClicked()
+{
+    const QString path = QFileDialog::getOpenFileName(this, "Load workload", QString(),
+                                                      "Workloads (*.txt *.workload *.wtrace);;All files (*)");
+    if (path.isEmpty()) return;
+
+    QString error;
+    Workload workload = Workload::loadFromFile(path, &error);
+    if (workload.isEmpty())
+    {
+        QMessageBox::warning(this, "Load workload",
+                             error.isEmpty() ? QString("The file has no operations") : error);
+        return;
+    }
+
+    m_loadedWorkload = workload;
+    m_workloadLabel->setText(QString("Workload: %1 (%2 ops)").arg(workload.name()).arg(workload.size()));
+    m_generatedButton->setEnabled(true);
+}
+
+void ComparisonWidget::onSaveTraceClicked()
+{
+    const QString path = QFileDialog::getSaveFileName(this, "Save workload trace", "workload.wtrace",
+                                                      "Workload traces (*.wtrace)");
+    if (path.isEmpty()) return;
+
+    const Workload workload = currentWorkload();
+    QString error;
+    if (!WorkloadTraceWriter::save(workload, path, &error))
+    {
+        QMessageBox::warning(this, "Save workload trace", error);
+        return;
+    }
+
+    qDebug() << "Saved" << workload.size() << "operations to" << path;
+}
+
+void ComparisonWidget::onStartClicked()
+{
+    if (m_runner->isRunning()) return;
+
+    const Workload workload = currentWorkload();
+    if (workload.isEmpty()) return;
+
+    buildLanes();
+    if (m_runner->laneCount() == 0)
+    {
+        QMessageBox::information(this, "Structure comparison", "Select at least one structure");
+        return;
+    }
+
+    qDebug() << "Comparison workload:" << workload.name();
+
+    m_runner->setRoundSize(m_roundSizeSpin->value());
+    m_progress->setValue(0);
+    m_sinceRefresh.start();
+
+    if (m_runner->start(workload))
+    {
+        m_startButton->setEnabled(false);
+        m_stopButton->setEnabled(true);
+        m_loadButton->setEnabled(false);
+    }
+}
+
+void ComparisonWidget::buildLanes()
+{
+    clearCells();
+    m_runner->clearLanes();
+
+    if (m_bstCheck->isChecked()) m_runner->addLane(std::make_unique<BinaryTreeAdapter>(false));
+    if (m_splayCheck->isChecked()) m_runner->addLane(std::make_unique<BinaryTreeAdapter>(true));
+    if (m_bplusSmallCheck->isChecked()) m_runner->addLane(std::make_unique<BPlusTreeAdapter>(4));
+    if (m_bplusLargeCheck->isChecked()) m_runner->addLane(std::make_unique<BPlusTreeAdapter>(64));
+    if (m_hashCheck->isChecked()) m_runner->addLane(std::make_unique<HashTableAdapter>());
+
+    const int count = m_runner->laneCount();
+    const int columns = qMax(1, int(std::ceil(std::sqrt(double(count)))));
+
+    for (int i = 0; i < count; ++i)
+    {
+        const StructureAdapter* adapter = m_runner->adapter(i);
+
+        Cell cell;
+        cell.frame = new QWidget(this);
+        QVBoxLayout* cellLayout = new QVBoxLayout(cell.frame);
+        cellLayout->setContentsMargins(2, 2, 2, 2);
+
+        QLabel* title = new QLabel(QString("<b>%1</b>").arg(adapter->name()), cell.frame);
+        cellLayout->addWidget(title);
+
+        cell.visualizer = createVisualizer(adapter->structure(), cell.frame);
+        if (cell.visualizer)
+        {
+            cellLayout->addWidget(cell.visualizer, 1);
+        }
+
+        cell.statsLabel = new QLabel(cell.frame);
+        cell.statsLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+        cellLayout->addWidget(cell.statsLabel);
+
+        m_grid->addWidget(cell.frame, i / columns, i % columns);
+        m_cells.append(cell);
+    }
+
+    updateStatistics();
+}
+
+void ComparisonWidget::clearCells()
+{
+    for (const Cell& cell : m_cells)
+    {
+        m_grid->removeWidget(cell.frame);
+        delete cell.frame;
+    }
+    m_cells.clear();
+}
+
+VisualizerBase* ComparisonWidget::createVisualizer(QObject* structure, QWidget* parent)
+{
+    VisualizerBase* visualizer = nullptr;
+
+    if (qobject_cast<BinaryTree*>(structure))
+    {
+        visualizer = new BinaryTreeVisualization(parent);
+    }
+    else if (qobject_cast<BPlusTree*>(structure))
+    {
+        visualizer = new BPlusTreeVisualization(parent);
+    }
+    else if (qobject_cast<RobinHoodHashTable*>(structure))
+    {
+        visualizer = new HashTableVisualization(parent);
+    }
+
+    if (visualizer)
+    {
+        // Структура меняется пачками между кадрами - анимировать нечего
+        visualizer->setAnimationEnabled(false);
+        visualizer->setStructure(structure);
+    }
+    return visualizer;
+}
+
+void ComparisonWidget::onRoundFinished(qint64 completed, qint64 total)
+{
+    m_progress->setValue(total > 0 ? int(completed * 1000 / total) : 1000);
+    updateStatistics();
+
+    // Дорожки стоят, пока идет этот слот: структуры можно читать
+    if (m_sinceRefresh.elapsed() >= kVisualRefreshMs)
+    {
+        refreshVisualizers();
+        m_sinceRefresh.restart();
+    }
+}
+
+void ComparisonWidget::onRunFinished(bool completed)
+{
+    m_startButton->setEnabled(true);
+    m_stopButton->setEnabled(false);
+    m_loadButton->setEnabled(true);
+
+    updateStatistics();
+    refreshVisualizers();
+
+    for (int i = 0; i < m_runner->laneCount(); ++i)
+    {
+        const LaneStatistics& statistics = m_runner->statistics(i);
+        qDebug().noquote() << QString("%1: %2 ops in %3 ms, height %4, cost %5")
+                                  .arg(m_runner->adapter(i)->name())
+                                  .arg(statistics.operations)
+                                  .arg(statistics.elapsedNs / 1000000.0, 0, 'f', 1)
+                                  .arg(statistics.height)
+                                  .arg(statistics.cost);
+    }
+    qDebug() << "Comparison" << (completed ? "finished" : "stopped");
+}
+
+void ComparisonWidget::updateStatistics()
+{
+    for (int i = 0; i < m_cells.size() && i < m_runner->laneCount(); ++i)
+    {
+        const StructureAdapter* adapter = m_runner->adapter(i);
+        const LaneStatistics& statistics = m_runner->statistics(i);
+        const double costPerOp = statistics.operations > 0 ? double(statistics.cost) / statistics.operations : 0.0;
+
+        m_cells[i].statsLabel->setText(QString("%1 ops | %2 Mops/s | size %3 | %4 %5 | %6 %7 (%8/op)")
+                                           .arg(statistics.operations)
+                                           .arg(statistics.operationsPerSecond() / 1e6, 0, 'f', 2)
+                                           .arg(statistics.size)
+                                           .arg(adapter->heightName())
+                                           .arg(statistics.height)
+                                           .arg(adapter->costName())
+                                           .arg(statistics.cost)
+                                           .arg(costPerOp, 0, 'f', 1));
+    }
+}
+
+void ComparisonWidget::refreshVisualizers()
+{
+    if (!m_drawCheck->isChecked()) return;
+
+    for (const Cell& cell : m_cells)
+    {
+        if (cell.visualizer)
+        {
+            cell.visualizer->updateVisualization();
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef COMPARISON_WIDGET_H
+#define COMPARISON_WIDGET_H
+
+#include <QWidget>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QGridLayout>
+#include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QVector>
+
+#include "../../../core/workload/workload.h"
+#include "../../../core/workload/workload_runner.h"
+
+class VisualizerBase;
+
+// Режим сравнения: одна нагрузка (сгенерированная или из файла) на
+// нескольких структурах и политиках балансировки. Каждая структура
+// работает в своем потоке (WorkloadRunner), визуализаторы стоят сеткой
+// и обновляются вместе между раундами, под каждым - пропускная
+// способность, высота и счетчик стоимости.
+class ComparisonWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    // Перерисовка визуализаторов не чаще: на это время дорожки стоят
+    static constexpr int kVisualRefreshMs = 250;
+
+    explicit ComparisonWidget(QWidget* parent = nullptr);
+    ~ComparisonWidget() override;
+
+private slots:
+    void onStartClicked();
+    void onLoadClicked();
+    void onSaveTraceClicked();
+    void onRoundFinished(qint64 completed, qint64 total);
+    void onRunFinished(bool completed);
+
+private:
+    struct Cell
+    {
+        QWidget* frame = nullptr;
+        QLabel* statsLabel = nullptr;
+        VisualizerBase* visualizer = nullptr;
+    };
+
+    Workload currentWorkload() const;
+    void buildLanes();
+    void clearCells();
+    void updateStatistics();
+    void refreshVisualizers();
+    static VisualizerBase* createVisualizer(QObject* structure, QWidget* parent);
+
+    WorkloadRunner* m_runner;
+
+    QCheckBox* m_bstCheck;
+    QCheckBox* m_splayCheck;
+    QCheckBox* m_bplusSmallCheck;
+    QCheckBox* m_bplusLargeCheck;
+    QCheckBox* m_hashCheck;
+    QCheckBox* m_drawCheck;
+
+    QSpinBox* m_operationsSpin;
+    QSpinBox* m_keyRangeSpin;
+    QSpinBox* m_insertSpin;
+    QSpinBox* m_findSpin;
+    QSpinBox* m_rangeSpin;
+    QComboBox* m_keyOrderCombo;
+    QSpinBox* m_seedSpin;
+    QSpinBox* m_roundSizeSpin;
+
+    QPushButton* m_loadButton;
+    QPushButton* m_generatedButton;
+    QPushButton* m_saveTraceButton;
+    QLabel* m_workloadLabel;
+    QPushButton* m_startButton;
+    QPushButton* m_stopButton;
+    QProgressBar* m_progress;
+
+    QGridLayout* m_grid;
+    QVector<Cell> m_cells;
+
+    Workload m_loadedWorkload;      // Пустой - нагрузка генерируется
+    QElapsedTimer m_sinceRefresh;
+};
+
+#endif // COMPARISON_WIDGET_H
@@ -1,5 +1,575 @@
 #include "LSP_client.h"
 
+#include <QCoreApplication>
+#include <QJsonDocument>
+
+#include <climits>
+
+namespace
+{
+const int kDefaultDebounceMs = 150;
+const int kShutdownTimeoutMs = 2000;
+
+// Коды ошибок JSON-RPC / LSP
+const int kRequestCancelled = -32800;
+const int kMethodNotFound = -32601;
+
+QJsonObject position(int line, int character)
+{
+    return QJsonObject{{"line", line}, {"character", character}};
+}
+}
+
 LSPClient::LSPClient(QObject *parent)
     : QObject{parent}
-{}
+{
+    m_debounceTimer.setSingleShot(true);
+    m_debounceTimer.setInterval(kDefaultDebounceMs);
+    connect(&m_debounceTimer, &QTimer::timeout, this, &LSPClient::onDebounceTimeout);
+}
+
+LSPClient::~LSPClient()
+{
+    if (m_process) {
+        disconnect(m_process, nullptr, this, nullptr);
+        m_process->kill();
+    }
+}
+
+bool LSPClient::start(const QString& program, const QStringList& arguments, const QString& rootUri)
+{
+    if (m_state != State::NotRunning) return false;
+
+    m_parser.reset();
+    m_process = new QProcess(this);
+
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &LSPClient::onReadyReadStandardOutput);
+    connect(m_process, &QProcess::readyReadStandardError, this, &LSPClient::onReadyReadStandardError);
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &LSPClient::onProcessFinished);
+    connect(m_process, &QProcess::errorOccurred, this, &LSPClient::onProcessError);
+
+    m_process->start(program, arguments);
+    m_state = State::Initializing;
+
+    const QJsonObject capabilities{
+        {"textDocument", QJsonObject{
+             {"synchronization", QJsonObject{{"dynamicRegistration", false}, {"didSave", false}}},
+             {"completion", QJsonObject{{"completionItem", QJsonObject{{"snippetSupport", false}}}}},
+             {"publishDiagnostics", QJsonObject{}}
+         }}
+    };
+
+    const QJsonObject params{
+        {"processId", qint64(QCoreApplication::applicationPid())},
+        {"rootUri", rootUri},
+        {"capabilities", capabilities},
+        {"clientInfo", QJsonObject{{"name", QCoreApplication::applicationName()}}}
+    };
+
+    // initialize уходит сразу, минуя очередь: остальное ждет его ответа
+    const int id = m_nextId++;
+    m_pending.insert(id, {"initialize", [this](const QJsonValue& result, const QJsonObject& error) {
+        if (!error.isEmpty()) {
+            emit errorOccurred(QStringLiteral("initialize failed: %1").arg(error.value("message").toString()));
+            stop();
+            return;
+        }
+        handleInitializeResult(result);
+    }});
+    writeMessage(QJsonObject{{"jsonrpc", "2.0"}, {"id", id}, {"method", "initialize"}, {"params", params}});
+
+    return true;
+}
+
+void LSPClient::handleInitializeResult(const QJsonValue& result)
+{
+    // textDocumentSync бывает числом или объектом с полем change
+    const QJsonValue sync = result.toObject().value("capabilities").toObject().value("textDocumentSync");
+    const int kind = sync.isObject() ? sync.toObject().value("change").toInt(0) : sync.toInt(0);
+    m_syncKind = kind == 1 ? SyncKind::Full : kind == 2 ? SyncKind::Incremental : SyncKind::None;
+
+    m_state = State::Ready;
+    writeMessage(QJsonObject{{"jsonrpc", "2.0"}, {"method", "initialized"}, {"params", QJsonObject{}}});
+
+    const QVector<QJsonObject> queued = std::move(m_queuedUntilReady);
+    m_queuedUntilReady.clear();
+    for (const QJsonObject& message : queued) {
+        writeMessage(message);
+    }
+
+    emit ready();
+}
+
+void LSPClient::stop()
+{
+    if (!m_process || m_state == State::NotRunning || m_state == State::ShuttingDown) return;
+
+    m_debounceTimer.stop();
+    m_queuedUntilReady.clear();
+
+    QProcess* process = m_process;
+    if (m_state == State::Ready) {
+        m_state = State::ShuttingDown;
+        sendRequest("shutdown", QJsonValue(), [this](const QJsonValue&, const QJsonObject&) {
+            sendNotification("exit", QJsonValue());
+            if (m_process) {
+                m_process->closeWriteChannel();
+            }
+        });
+    } else {
+        m_state = State::ShuttingDown;
+        process->kill();
+    }
+
+    // Не ждем синхронно: если сервер завис, процесс просто убьем
+    QTimer::singleShot(kShutdownTimeoutMs, process, [process]() {
+        if (process->state() != QProcess::NotRunning) {
+            process->kill();
+        }
+    });
+}
+
+int LSPClient::sendRequest(const QString& method, const QJsonValue& params, ResponseHandler handler)
+{
+    const int id = m_nextId++;
+    m_pending.insert(id, {method, std::move(handler)});
+
+    QJsonObject message{{"jsonrpc", "2.0"}, {"id", id}, {"method", method}};
+    if (!params.isUndefined() && !params.isNull()) {
+        message.insert("params", params);
+    }
+
+    if (m_state == State::Initializing) {
+        m_queuedUntilReady.append(message);
+    } else {
+        writeMessage(message);
+    }
+
+    return id;
+}
+
+void LSPClient::sendNotification(const QString& method, const QJsonValue& params)
+{
+    QJsonObject message{{"jsonrpc", "2.0"}, {"method", method}};
+    if (!params.isUndefined() && !params.isNull()) {
+        message.insert("params", params);
+    }
+
+    if (m_state == State::Initializing) {
+        m_queuedUntilReady.append(message);
+    } else {
+        writeMessage(message);
+    }
+}
+
+void LSPClient::cancelRequest(int id)
+{
+    const auto waiter = m_sharedWaiters.find(id);
+    if (waiter != m_sharedWaiters.end()) {
+        const int requestId = waiter.value();
+        m_sharedWaiters.erase(waiter);
+
+        const auto shared = m_shared.find(requestId);
+        if (shared == m_shared.end()) return;
+
+        QVector<SharedRequest::Waiter>& waiters = shared->waiters;
+        for (int i = 0; i < waiters.size(); ++i) {
+            if (waiters[i].id == id) {
+                waiters.removeAt(i);
+                break;
+            }
+        }
+        // Ответ еще нужен кому-то из присоединившихся
+        if (!waiters.isEmpty()) return;
+
+        m_shared.erase(shared);
+        cancelWireRequest(requestId);
+        return;
+    }
+
+    cancelWireRequest(id);
+}
+
+void LSPClient::cancelWireRequest(int id)
+{
+    if (!m_pending.remove(id)) return;
+
+    // Запрос мог еще не уйти - тогда достаточно убрать его из очереди
+    for (int i = 0; i < m_queuedUntilReady.size(); ++i) {
+        if (m_queuedUntilReady[i].value("id").toInt(-1) == id) {
+            m_queuedUntilReady.removeAt(i);
+            return;
+        }
+    }
+
+    sendNotification("$/cancelRequest", QJsonObject{{"id", id}});
+}
+
+void LSPClient::writeMessage(const QJsonObject& message)
+{
+    if (!m_process) return;
+
+    const QByteArray body = QJsonDocument(message).toJson(QJsonDocument::Compact);
+
+    // Заголовок и тело одной записью
+    QByteArray frame;
+    frame.reserve(body.size() + 32);
+    frame.append("Content-Length: ");
+    frame.append(QByteArray::number(body.size()));
+    frame.append("\r\n\r\n");
+    frame.append(body);
+
+    m_process->write(frame);
+}
+
+void LSPClient::onReadyReadStandardOutput()
+{
+    const QVector<QJsonDocument> messages = m_parser.feed(m_process->readAllStandardOutput());
+    for (const QJsonDocument& document : messages) {
+        handleMessage(document.object());
+    }
+}
+
+void LSPClient::onReadyReadStandardError()
+{
+    const QString text = QString::fromUtf8(m_process->readAllStandardError()).trimmed();
+    if (!text.isEmpty()) {
+        emit serverLog(text);
+    }
+}
+
+void LSPClient::handleMessage(const QJsonObject& message)
+{
+    const QJsonValue id = message.value("id");
+    const QString method = message.value("method").toString();
+
+    // Ответ на наш запрос
+    if (method.isEmpty()) {
+        const auto it = m_pending.find(id.toInt(-1));
+        if (it == m_pending.end()) return;    // Отмененный или чужой
+
+        const PendingRequest request = it.value();
+        m_pending.erase(it);
+
+        // Отмену сервером (RequestCancelled) тоже отдаем обработчику: у слитых
+        // запросов он один освобождает запись, к которой присоединяются новые
+        if (request.handler) {
+            request.handler(message.value("result"), message.value("error").toObject());
+        }
+        return;
+    }
+
+    // Запрос от сервера: без ответа некоторые серверы ждут бесконечно
+    if (!id.isUndefined()) {
+        QJsonObject reply{{"jsonrpc", "2.0"}, {"id", id}};
+        if (method == "workspace/configuration" || method == "window/workDoneProgress/create"
+            || method == "client/registerCapability") {
+            reply.insert("result", QJsonValue());
+        } else {
+            reply.insert("error", QJsonObject{{"code", kMethodNotFound}, {"message", "Method not found"}});
+        }
+        writeMessage(reply);
+        return;
+    }
+
+    const QJsonValue params = message.value("params");
+    if (method == "textDocument/publishDiagnostics") {
+        const QJsonObject object = params.toObject();
+        emit diagnosticsPublished(object.value("uri").toString(), object.value("diagnostics").toArray());
+    } else if (method == "window/logMessage" || method == "window/showMessage") {
+        emit serverLog(params.toObject().value("message").toString());
+    }
+
+    emit notificationReceived(method, params);
+}
+
+void LSPClient::openDocument(const QString& uri, const QString& languageId, const QString& text)
+{
+    Document document;
+    document.languageId = languageId;
+    document.text = text;
+    document.version = 1;
+    m_documents.insert(uri, document);
+
+    sendNotification("textDocument/didOpen", QJsonObject{
+        {"textDocument", QJsonObject{
+             {"uri", uri}, {"languageId", languageId}, {"version", document.version}, {"text", text}
+         }}
+    });
+}
+
+int LSPClient::offsetForPosition(const QString& text, int line, int character)
+{
+    int offset = 0;
+    for (int i = 0; i < line; ++i) {
+        const int newline = int(text.indexOf(QLatin1Char('\n'), offset));
+        if (newline < 0) return int(text.size());
+        offset = newline + 1;
+    }
+
+    int lineEnd = int(text.indexOf(QLatin1Char('\n'), offset));
+    if (lineEnd < 0) lineEnd = int(text.size());
+
+    return qBound(offset, offset + character, lineEnd);
+}
+
+void LSPClient::changeDocument(const QString& uri, int startLine, int startCharacter,
+                               int endLine, int endCharacter, const QString& newText)
+{
+    const auto it = m_documents.find(uri);
+    if (it == m_documents.end()) return;
+
+    Document& document = it.value();
+
+    // Своя копия текста нужна для серверов с полной синхронизацией
+    const int start = offsetForPosition(document.text, startLine, startCharacter);
+    const int end = qMax(start, offsetForPosition(document.text, endLine, endCharacter));
+    document.text.replace(start, end - start, newText);
+
+    if (m_syncKind == SyncKind::Incremental) {
+        document.pendingChanges.append(QJsonObject{
+            {"range", QJsonObject{{"start", position(startLine, startCharacter)},
+                                  {"end", position(endLine, endCharacter)}}},
+            {"text", newText}
+        });
+    } else if (m_syncKind == SyncKind::Full) {
+        // Для полной синхронизации важен только факт изменения
+        document.pendingChanges = QJsonArray{QJsonObject{}};
+    }
+
+    m_debounceTimer.start();
+}
+
+void LSPClient::flushDocument(const QString& uri, Document& document)
+{
+    if (document.pendingChanges.isEmpty()) return;
+
+    QJsonArray changes = document.pendingChanges;
+    const int previousVersion = document.version;
+    ++document.version;
+
+    if (m_syncKind == SyncKind::Full) {
+        changes = QJsonArray{QJsonObject{{"text", document.text}}};
+        m_cache.invalidateDocument(uri);
+    } else {
+        // Правки применяются по порядку, и все, что лежит до самого раннего
+        // их начала, не сдвигается - такие ответы кэша остаются верными
+        int line = INT_MAX;
+        int character = INT_MAX;
+        for (const QJsonValue& change : changes) {
+            const QJsonObject start = change.toObject().value("range").toObject().value("start").toObject();
+            const int changeLine = start.value("line").toInt();
+            const int changeCharacter = start.value("character").toInt();
+            if (changeLine < line || (changeLine == line && changeCharacter < character)) {
+                line = changeLine;
+                character = changeCharacter;
+            }
+        }
+        m_cache.applyEdit(uri, previousVersion, document.version, line, character);
+    }
+    document.pendingChanges = QJsonArray();
+
+    sendNotification("textDocument/didChange", QJsonObject{
+        {"textDocument", QJsonObject{{"uri", uri}, {"version", document.version}}},
+        {"contentChanges", changes}
+    });
+}
+
+void LSPClient::flushChanges()
+{
+    m_debounceTimer.stop();
+    for (auto it = m_documents.begin(); it != m_documents.end(); ++it) {
+        flushDocument(it.key(), it.value());
+    }
+}
+
+void LSPClient::onDebounceTimeout()
+{
+    flushChanges();
+}
+
+void LSPClient::closeDocument(const QString& uri)
+{
+    const auto it = m_documents.find(uri);
+    if (it == m_documents.end()) return;
+
+    flushDocument(uri, it.value());
+    m_documents.erase(it);
+    m_cache.invalidateDocument(uri);
+
+    sendNotification("textDocument/didClose", QJsonObject{{"textDocument", QJsonObject{{"uri", uri}}}});
+}
+
+QString LSPClient::documentText(const QString& uri) const
+{
+    return m_documents.value(uri).text;
+}
+
+int LSPClient::cachedRequest(const QString& method, const QString& uri, const LSPRange& range,
+                             const QJsonObject& params, const ResponseHandler& handler)
+{
+    // Сервер должен увидеть текст, для которого задаем вопрос
+    const auto document = m_documents.find(uri);
+    if (document == m_documents.end()) return -1;
+    flushDocument(uri, document.value());
+
+    const LSPResponseCache::Key key{method, document->version, range};
+
+    QJsonValue cached;
+    if (m_cache.lookup(uri, key, &cached)) {
+        ++m_cacheHits;
+        handler(cached, QJsonObject());
+        return 0;
+    }
+
+    for (auto it = m_shared.begin(); it != m_shared.end(); ++it) {
+        if (it->uri == uri && it->key == key) {
+            const int waiterId = m_nextId++;
+            it->waiters.append({waiterId, handler});
+            m_sharedWaiters.insert(waiterId, it.key());
+            return waiterId;
+        }
+    }
+
+    ++m_cacheMisses;
+
+    // Обработчик ставится после отправки: ему нужен id запроса,
+    // а ответ раньше следующего readyRead не придет
+    const int id = sendRequest(method, params);
+    m_pending[id].handler = [this, id](const QJsonValue& result, const QJsonObject& error) {
+        completeSharedRequest(id, result, error);
+    };
+
+    m_shared.insert(id, {uri, key, {{id, handler}}});
+    m_sharedWaiters.insert(id, id);
+    return id;
+}
+
+void LSPClient::completeSharedRequest(int id, const QJsonValue& result, const QJsonObject& error)
+{
+    const auto it = m_shared.find(id);
+    if (it == m_shared.end()) return;
+
+    const SharedRequest shared = it.value();
+    m_shared.erase(it);
+    for (const SharedRequest::Waiter& waiter : shared.waiters) {
+        m_sharedWaiters.remove(waiter.id);
+    }
+
+    if (error.isEmpty()) {
+        // Ответ на уже измененный документ в кэш не кладем - его ключ не встретится
+        const auto document = m_documents.constFind(shared.uri);
+        if (document != m_documents.constEnd() && document->version == shared.key.version) {
+            m_cache.insert(shared.uri, shared.key, result);
+        }
+    }
+
+    for (const SharedRequest::Waiter& waiter : shared.waiters) {
+        waiter.handler(result, error);
+    }
+}
+
+int LSPClient::requestCompletion(const QString& uri, int line, int character)
+{
+    const QJsonObject params{
+        {"textDocument", QJsonObject{{"uri", uri}}},
+        {"position", position(line, character)}
+    };
+
+    const int id = cachedRequest("textDocument/completion", uri, LSPRange::point(line, character), params,
+                                 [this, uri, line, character](const QJsonValue& result, const QJsonObject& error) {
+        if (!error.isEmpty()) return;
+
+        // Ответ - либо массив, либо CompletionList с полем items
+        const QJsonArray items = result.isArray() ? result.toArray()
+                                                  : result.toObject().value("items").toArray();
+        emit completionReady(uri, line, character, items);
+    });
+
+    // Новый символ делает прошлый список бесполезным. Если новый вызов
+    // присоединился к тому же запросу, отменится только прошлый ожидающий
+    if (m_completionRequestId > 0 && m_completionRequestId != id) {
+        cancelRequest(m_completionRequestId);
+    }
+    m_completionRequestId = id > 0 ? id : -1;
+
+    return id;
+}
+
+int LSPClient::requestHover(const QString& uri, int line, int character)
+{
+    const QJsonObject params{
+        {"textDocument", QJsonObject{{"uri", uri}}},
+        {"position", position(line, character)}
+    };
+
+    return cachedRequest("textDocument/hover", uri, LSPRange::point(line, character), params,
+                         [this, uri, line, character](const QJsonValue& result, const QJsonObject& error) {
+        if (error.isEmpty()) {
+            emit hoverReady(uri, line, character, result);
+        }
+    });
+}
+
+int LSPClient::requestSemanticTokens(const QString& uri, int startLine, int startCharacter,
+                                     int endLine, int endCharacter)
+{
+    const QJsonObject params{
+        {"textDocument", QJsonObject{{"uri", uri}}},
+        {"range", QJsonObject{{"start", position(startLine, startCharacter)},
+                              {"end", position(endLine, endCharacter)}}}
+    };
+
+    return cachedRequest("textDocument/semanticTokens/range", uri,
+                         LSPRange{startLine, startCharacter, endLine, endCharacter}, params,
+                         [this, uri, startLine, endLine](const QJsonValue& result, const QJsonObject& error) {
+        if (error.isEmpty()) {
+            emit semanticTokensReady(uri, startLine, endLine, result.toObject().value("data").toArray());
+        }
+    });
+}
+
+void LSPClient::failPendingRequests(const QString& reason)
+{
+    const QHash<int, PendingRequest> pending = std::move(m_pending);
+    m_pending.clear();
+
+    const QJsonObject error{{"code", kRequestCancelled}, {"message", reason}};
+    for (const PendingRequest& request : pending) {
+        if (request.handler) {
+            request.handler(QJsonValue(), error);
+        }
+    }
+}
+
+void LSPClient::onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    Q_UNUSED(exitStatus);
+
+    m_state = State::NotRunning;
+    m_debounceTimer.stop();
+    m_queuedUntilReady.clear();
+    m_completionRequestId = -1;
+
+    failPendingRequests(QStringLiteral("Language server exited"));
+
+    m_process->deleteLater();
+    m_process = nullptr;
+
+    emit stopped(exitCode);
+}
+
+void LSPClient::onProcessError(QProcess::ProcessError error)
+{
+    if (error == QProcess::FailedToStart) {
+        m_state = State::NotRunning;
+        m_queuedUntilReady.clear();
+        failPendingRequests(QStringLiteral("Language server failed to start"));
+
+        m_process->deleteLater();
+        m_process = nullptr;
+    }
+
+    emit errorOccurred(QStringLiteral("Language server process error: %1").arg(int(error)));
+}
@@ -2,14 +2,173 @@
 #define LSP_CLIENT_H
 
 #include <QObject>
+#include <QProcess>
+#include <QTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonValue>
 
+#include <functional>
+
+#include "LSP_frame_parser.h"
+#include "LSP_response_cache.h"
+
+// Клиент языкового сервера поверх stdin/stdout дочернего процесса.
+// Все операции неблокирующие: запись буферизует QProcess, ответы приходят
+// через readyRead и сопоставляются с запросами по id.
+// Правки документа копятся и уходят одним didChange после паузы в наборе;
+// устаревший запрос автодополнения отменяется через $/cancelRequest.
+// Запросы не ждут друг друга; одинаковые запросы к одной версии документа
+// сливаются в один, а ответы дополнения, hover и семантических токенов кэшируются.
 class LSPClient : public QObject
 {
     Q_OBJECT
 public:
+    // error пуст при успехе
+    using ResponseHandler = std::function<void(const QJsonValue& result, const QJsonObject& error)>;
+
+    enum class State
+    {
+        NotRunning,
+        Initializing,   // Процесс запущен, ждем ответа на initialize
+        Ready,
+        ShuttingDown
+    };
+
     explicit LSPClient(QObject *parent = nullptr);
+    ~LSPClient();
+
+    // rootUri - корень рабочей области, например file:///home/user/project
+    bool start(const QString& program, const QStringList& arguments, const QString& rootUri);
+    // shutdown + exit; если сервер не завершится сам, процесс будет убит
+    void stop();
+
+    State state() const { return m_state; }
+    bool isReady() const { return m_state == State::Ready; }
+
+    // Возвращает id запроса. До готовности сервера запросы копятся в очереди
+    int sendRequest(const QString& method, const QJsonValue& params,
+                    ResponseHandler handler = ResponseHandler());
+    void sendNotification(const QString& method, const QJsonValue& params);
+    // Обработчик отмененного запроса не будет вызван. Для слитых запросов
+    // отменяется только этот ожидающий; сам запрос к серверу - когда
+    // отменены все, кто его ждет
+    void cancelRequest(int id);
+    int pendingRequestCount() const { return int(m_pending.size()); }
+
+    void openDocument(const QString& uri, const QString& languageId, const QString& text);
+    // Позиции - строка и символ в UTF-16, как в протоколе (и как в QString)
+    void changeDocument(const QString& uri, int startLine, int startCharacter,
+                        int endLine, int endCharacter, const QString& newText);
+    void closeDocument(const QString& uri);
+    QString documentText(const QString& uri) const;
+
+    // Отправляет накопленные правки сразу, не дожидаясь таймера
+    void flushChanges();
+    void setDebounceInterval(int milliseconds) { m_debounceTimer.setInterval(milliseconds); }
+
+    // Запросы ниже сначала смотрят в кэш: при попадании сигнал приходит сразу,
+    // а возвращаемый id равен 0. Одинаковые запросы в полете сливаются в один
+    // запрос к серверу, но каждый вызов получает свой id для cancelRequest.
+
+    // Предыдущий незавершенный запрос дополнения в другой позиции отменяется
+    int requestCompletion(const QString& uri, int line, int character);
+    int requestHover(const QString& uri, int line, int character);
+    int requestSemanticTokens(const QString& uri, int startLine, int startCharacter,
+                              int endLine, int endCharacter);
+
+    const LSPResponseCache& responseCache() const { return m_cache; }
+    int cacheHitCount() const { return m_cacheHits; }
+    int cacheMissCount() const { return m_cacheMisses; }
 
 signals:
+    void ready();
+    void stopped(int exitCode);
+    void completionReady(const QString& uri, int line, int character, const QJsonArray& items);
+    void hoverReady(const QString& uri, int line, int character, const QJsonValue& hover);
+    void semanticTokensReady(const QString& uri, int startLine, int endLine, const QJsonArray& data);
+    void diagnosticsPublished(const QString& uri, const QJsonArray& diagnostics);
+    void notificationReceived(const QString& method, const QJsonValue& params);
+    void serverLog(const QString& message);
+    void errorOccurred(const QString& message);
+
+private slots:
+    void onReadyReadStandardOutput();
+    void onReadyReadStandardError();
+    void onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void onProcessError(QProcess::ProcessError error);
+    void onDebounceTimeout();
+
+private:
+    enum class SyncKind
+    {
+        None = 0,
+        Full = 1,
+        Incremental = 2
+    };
+
+    struct PendingRequest
+    {
+        QString method;
+        ResponseHandler handler;
+    };
+
+    // Запрос в полете, к которому могут присоединиться такие же
+    struct SharedRequest
+    {
+        struct Waiter
+        {
+            int id;                 // Первый ожидающий - id самого запроса
+            ResponseHandler handler;
+        };
+
+        QString uri;
+        LSPResponseCache::Key key;
+        QVector<Waiter> waiters;
+    };
+
+    struct Document
+    {
+        QString languageId;
+        QString text;
+        int version = 0;
+        QJsonArray pendingChanges;
+    };
+
+    void writeMessage(const QJsonObject& message);
+    void handleMessage(const QJsonObject& message);
+    void handleInitializeResult(const QJsonValue& result);
+    void flushDocument(const QString& uri, Document& document);
+    void failPendingRequests(const QString& reason);
+
+    // Общий путь для кэшируемых запросов: кэш -> запрос в полете -> новый запрос
+    int cachedRequest(const QString& method, const QString& uri, const LSPRange& range,
+                      const QJsonObject& params, const ResponseHandler& handler);
+    // Ответ (или ошибка) на слитый запрос: в кэш и всем ожидающим
+    void completeSharedRequest(int id, const QJsonValue& result, const QJsonObject& error);
+    // Убирает запрос из очереди до готовности или шлет $/cancelRequest
+    void cancelWireRequest(int id);
+
+    static int offsetForPosition(const QString& text, int line, int character);
+
+    QProcess* m_process = nullptr;
+    LSPFrameParser m_parser;
+    QHash<int, PendingRequest> m_pending;
+    QHash<QString, Document> m_documents;
+    QVector<QJsonObject> m_queuedUntilReady;
+    QTimer m_debounceTimer;
+
+    LSPResponseCache m_cache;
+    QHash<int, SharedRequest> m_shared;     // По id запроса
+    QHash<int, int> m_sharedWaiters;        // id ожидающего -> id запроса
+    int m_cacheHits = 0;
+    int m_cacheMisses = 0;
+
+    State m_state = State::NotRunning;
+    SyncKind m_syncKind = SyncKind::Incremental;
+    int m_nextId = 1;
+    int m_completionRequestId = -1;
 };
 
 #endif // LSP_CLIENT_H
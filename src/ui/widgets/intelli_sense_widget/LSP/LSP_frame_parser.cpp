@@ -0,0 +1,123 @@
+#include "LSP_frame_parser.h"
+
+#include <cstring>
+
+namespace
+{
+const char kHeaderEnd[] = "\r\n\r\n";
+const char kContentLength[] = "content-length:";
+
+// Сравнение без учета регистра: имена заголовков LSP регистронезависимы
+bool startsWithIgnoreCase(const char* data, qsizetype size, const char* prefix)
+{
+    const qsizetype length = qsizetype(std::strlen(prefix));
+    if (size < length) return false;
+
+    for (qsizetype i = 0; i < length; ++i) {
+        char c = data[i];
+        if (c >= 'A' && c <= 'Z') c = char(c - 'A' + 'a');
+        if (c != prefix[i]) return false;
+    }
+    return true;
+}
+}
+
+qsizetype LSPFrameParser::parseHeaders(qsizetype& bodyStart)
+{
+    const qsizetype end = m_buffer.indexOf(kHeaderEnd, m_offset);
+    if (end < 0) return kIncompleteHeaders;
+
+    const char* data = m_buffer.constData();
+    qsizetype length = -1;
+
+    // Заголовки разделены \r\n; кроме Content-Length бывает только Content-Type
+    qsizetype line = m_offset;
+    while (line < end) {
+        qsizetype lineEnd = m_buffer.indexOf("\r\n", line);
+        if (lineEnd < 0 || lineEnd > end) lineEnd = end;
+
+        if (startsWithIgnoreCase(data + line, lineEnd - line, kContentLength)) {
+            qsizetype value = 0;
+            bool digits = false;
+            for (qsizetype i = line + qsizetype(sizeof(kContentLength)) - 1; i < lineEnd; ++i) {
+                if (data[i] >= '0' && data[i] <= '9') {
+                    value = value * 10 + (data[i] - '0');
+                    digits = true;
+                } else if (data[i] != ' ' && data[i] != '\t') {
+                    digits = false;
+                    break;
+                }
+            }
+            length = digits ? value : -1;
+        }
+
+        line = lineEnd + 2;
+    }
+
+    bodyStart = end + qsizetype(sizeof(kHeaderEnd)) - 1;
+    if (length < 0) {
+        // Кадр без длины не восстановить - пропускаем его заголовки
+        m_hadError = true;
+        m_offset = bodyStart;
+        return kMalformedFrame;
+    }
+
+    return length;
+}
+
+QVector<QJsonDocument> LSPFrameParser::feed(const QByteArray& data)
+{
+    QVector<QJsonDocument> messages;
+    m_buffer.append(data);
+
+    while (true) {
+        if (m_pendingLength < 0) {
+            qsizetype bodyStart = 0;
+            const qsizetype length = parseHeaders(bodyStart);
+            if (length == kMalformedFrame) continue;
+            if (length < 0) break;
+
+            m_pendingLength = length;
+            m_pendingBody = bodyStart;
+        }
+
+        if (m_buffer.size() - m_pendingBody < m_pendingLength) break;
+
+        // fromRawData не копирует байты: парсер читает прямо из буфера
+        const QByteArray body = QByteArray::fromRawData(m_buffer.constData() + m_pendingBody, m_pendingLength);
+        QJsonParseError error;
+        const QJsonDocument document = QJsonDocument::fromJson(body, &error);
+        if (error.error == QJsonParseError::NoError) {
+            messages.append(document);
+        } else {
+            m_hadError = true;
+        }
+
+        m_offset = m_pendingBody + m_pendingLength;
+        m_pendingLength = -1;
+    }
+
+    compact();
+    return messages;
+}
+
+void LSPFrameParser::compact()
+{
+    // Сдвиг амортизирован: вырезаем прочитанное, только когда его больше, чем остатка
+    if (m_offset == 0 || m_offset < m_buffer.size() - m_offset) return;
+
+    m_buffer.remove(0, m_offset);
+    if (m_pendingLength >= 0) {
+        m_pendingBody -= m_offset;
+    }
+    m_offset = 0;
+}
+
+void LSPFrameParser::reset()
+{
+    m_buffer.clear();
+    m_offset = 0;
+    m_pendingLength = -1;
+    m_pendingBody = 0;
+    m_hadError = false;
+}
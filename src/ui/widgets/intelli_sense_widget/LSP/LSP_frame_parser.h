@@ -0,0 +1,39 @@
+#ifndef LSP_FRAME_PARSER_H
+#define LSP_FRAME_PARSER_H
+
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QVector>
+
+// Разбор потока сообщений LSP: "Content-Length: N\r\n...\r\n\r\n" + N байт JSON.
+// Входящие данные дописываются в один буфер, заголовки разбираются на месте,
+// тело передается в QJsonDocument::fromJson без промежуточной копии.
+// Прочитанная часть буфера вырезается только когда она больше непрочитанной.
+class LSPFrameParser
+{
+public:
+    // Добавляет байты из канала и возвращает все целиком пришедшие сообщения
+    QVector<QJsonDocument> feed(const QByteArray& data);
+    void reset();
+
+    // true, если встретился битый заголовок; такие кадры пропускаются
+    bool hadError() const { return m_hadError; }
+    int bufferedBytes() const { return int(m_buffer.size() - m_offset); }
+
+private:
+    static constexpr qsizetype kIncompleteHeaders = -1;
+    static constexpr qsizetype kMalformedFrame = -2;
+
+    // Разбирает заголовки начиная с m_offset и возвращает длину тела
+    // или один из кодов выше
+    qsizetype parseHeaders(qsizetype& bodyStart);
+    void compact();
+
+    QByteArray m_buffer;
+    qsizetype m_offset = 0;
+    qsizetype m_pendingLength = -1;     // Длина тела уже разобранного заголовка
+    qsizetype m_pendingBody = 0;        // Начало этого тела в буфере
+    bool m_hadError = false;
+};
+
+#endif // LSP_FRAME_PARSER_H
@@ -0,0 +1,65 @@
+#include "LSP_response_cache.h"
+
+bool LSPResponseCache::lookup(const QString& uri, const Key& key, QJsonValue* result) const
+{
+    const auto document = m_documents.constFind(uri);
+    if (document == m_documents.constEnd()) return false;
+
+    const auto entry = document->constFind(key);
+    if (entry == document->constEnd()) return false;
+
+    if (result) {
+        *result = entry.value();
+    }
+    return true;
+}
+
+void LSPResponseCache::insert(const QString& uri, const Key& key, const QJsonValue& result)
+{
+    QHash<Key, QJsonValue>& entries = m_documents[uri];
+    if (entries.size() >= kMaxEntriesPerDocument && !entries.contains(key)) {
+        entries.clear();
+    }
+    entries.insert(key, result);
+}
+
+void LSPResponseCache::applyEdit(const QString& uri, int fromVersion, int toVersion, int line, int character)
+{
+    const auto document = m_documents.find(uri);
+    if (document == m_documents.end()) return;
+
+    // Ответы о тексте до правки остаются верными: координаты в нем не сдвинулись
+    QHash<Key, QJsonValue> kept;
+    for (auto it = document->constBegin(); it != document->constEnd(); ++it) {
+        if (it.key().version == fromVersion && it.key().range.endsBefore(line, character)) {
+            Key moved = it.key();
+            moved.version = toVersion;
+            kept.insert(moved, it.value());
+        }
+    }
+
+    if (kept.isEmpty()) {
+        m_documents.erase(document);
+    } else {
+        document.value() = std::move(kept);
+    }
+}
+
+void LSPResponseCache::invalidateDocument(const QString& uri)
+{
+    m_documents.remove(uri);
+}
+
+void LSPResponseCache::clear()
+{
+    m_documents.clear();
+}
+
+int LSPResponseCache::size() const
+{
+    int total = 0;
+    for (const QHash<Key, QJsonValue>& entries : m_documents) {
+        total += int(entries.size());
+    }
+    return total;
+}
@@ -0,0 +1,76 @@
+#ifndef LSP_RESPONSE_CACHE_H
+#define LSP_RESPONSE_CACHE_H
+
+#include <QHash>
+#include <QJsonValue>
+#include <QString>
+
+// Диапазон в координатах LSP (строка, символ UTF-16); для позиции start == end
+struct LSPRange
+{
+    int startLine = 0;
+    int startCharacter = 0;
+    int endLine = 0;
+    int endCharacter = 0;
+
+    static LSPRange point(int line, int character) { return {line, character, line, character}; }
+
+    bool operator==(const LSPRange& other) const
+    {
+        return startLine == other.startLine && startCharacter == other.startCharacter
+            && endLine == other.endLine && endCharacter == other.endCharacter;
+    }
+
+    // Диапазон целиком до позиции (line, character)
+    bool endsBefore(int line, int character) const
+    {
+        return endLine < line || (endLine == line && endCharacter < character);
+    }
+};
+
+inline size_t qHash(const LSPRange& range, size_t seed = 0)
+{
+    return qHashMulti(seed, range.startLine, range.startCharacter, range.endLine, range.endCharacter);
+}
+
+// Кэш ответов языкового сервера по (метод, uri, версия документа, диапазон).
+// Правка документа не сбрасывает кэш целиком: записи, лежащие строго до
+// начала правки, переносятся на новую версию, остальные удаляются.
+class LSPResponseCache
+{
+public:
+    struct Key
+    {
+        QString method;
+        int version = 0;
+        LSPRange range;
+
+        bool operator==(const Key& other) const
+        {
+            return version == other.version && range == other.range && method == other.method;
+        }
+    };
+
+    // Записей на документ; при переполнении документ очищается целиком
+    static constexpr int kMaxEntriesPerDocument = 1024;
+
+    bool lookup(const QString& uri, const Key& key, QJsonValue* result) const;
+    void insert(const QString& uri, const Key& key, const QJsonValue& result);
+
+    // Документ перешел из fromVersion в toVersion правкой, начинающейся с (line, character)
+    void applyEdit(const QString& uri, int fromVersion, int toVersion, int line, int character);
+    void invalidateDocument(const QString& uri);
+    void clear();
+
+    int size() const;
+
+private:
+    QHash<QString, QHash<Key, QJsonValue>> m_documents;
+};
+
+inline size_t qHash(const LSPResponseCache::Key& key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.method, key.version, key.range);
+}
+
+#endif // LSP_RESPONSE_CACHE_H
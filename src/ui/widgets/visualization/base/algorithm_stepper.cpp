@@ -0,0 +1,110 @@
+#include "algorithm_stepper.h"
+
+AlgorithmStepper::AlgorithmStepper(QObject* parent)
+    : QObject(parent)
+{
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    m_frameTimer.setInterval(kDefaultFrameIntervalMs);
+    connect(&m_frameTimer, &QTimer::timeout, this, &AlgorithmStepper::onFrame);
+}
+
+AlgorithmStepper::~AlgorithmStepper()
+{
+    // Кадр корутины освобождается без сигналов - получателей уже может не быть
+    m_frameTimer.stop();
+    m_step = nullptr;
+}
+
+void AlgorithmStepper::start(const StepFunction& step)
+{
+    // Новый алгоритм изнутри шага старого означал бы уничтожение работающей корутины
+    Q_ASSERT(!m_insideStep);
+    if (m_insideStep) return;
+
+    cancel();
+
+    m_step = step;
+    m_stepCount = 0;
+    if (m_step && !m_paused) {
+        m_frameTimer.start();
+    }
+}
+
+void AlgorithmStepper::cancel()
+{
+    if (!m_step) return;
+
+    if (m_insideStep) {
+        m_cancelRequested = true;
+        return;
+    }
+
+    stop();
+    emit cancelled();
+}
+
+bool AlgorithmStepper::stepOnce()
+{
+    return advance();
+}
+
+void AlgorithmStepper::setPaused(bool paused)
+{
+    m_paused = paused;
+
+    if (m_paused) {
+        m_frameTimer.stop();
+    } else if (m_step) {
+        m_frameTimer.start();
+    }
+}
+
+void AlgorithmStepper::setFrameInterval(int milliseconds)
+{
+    m_frameTimer.setInterval(qMax(1, milliseconds));
+}
+
+void AlgorithmStepper::onFrame()
+{
+    for (int i = 0; i < m_stepsPerFrame; ++i) {
+        if (!advance()) {
+            return;
+        }
+    }
+}
+
+bool AlgorithmStepper::advance()
+{
+    if (!m_step || m_insideStep) return false;
+
+    m_insideStep = true;
+    const bool more = m_step();
+    m_insideStep = false;
+
+    if (m_cancelRequested) {
+        m_cancelRequested = false;
+        stop();
+        emit cancelled();
+        return false;
+    }
+
+    if (!more) {
+        stop();
+        emit finished();
+        return false;
+    }
+
+    ++m_stepCount;
+    emit stepped(m_stepCount);
+    return true;
+}
+
+void AlgorithmStepper::stop()
+{
+    m_frameTimer.stop();
+
+    // Функция держит задачу: обнуляем поле до ее уничтожения, чтобы
+    // сигналы из деструкторов не застали полуразобранный степпер
+    StepFunction step;
+    step.swap(m_step);
+}
@@ -0,0 +1,71 @@
+#ifndef ALGORITHM_STEPPER_H
+#define ALGORITHM_STEPPER_H
+
+#include <QObject>
+#include <QTimer>
+
+#include <functional>
+
+// Проигрывает пошаговый алгоритм (AlgorithmTask) в потоке GUI: раз в кадр
+// продвигает его на stepsPerFrame шагов. Сам алгоритм между кадрами спит
+// в своей корутине, поэтому не нужны ни рабочий поток, ни записанная трасса.
+// Пока алгоритма нет, таймер стоит.
+class AlgorithmStepper : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Продвигает алгоритм на один шаг; false - алгоритм закончился
+    using StepFunction = std::function<bool()>;
+
+    static constexpr int kDefaultFrameIntervalMs = 16;
+    static constexpr int kMaxStepsPerFrame = 100000;
+
+    explicit AlgorithmStepper(QObject* parent = nullptr);
+    ~AlgorithmStepper() override;
+
+    // Прежний алгоритм прерывается
+    void start(const StepFunction& step);
+    // Прерывает алгоритм; изнутри шага - сразу после его завершения
+    void cancel();
+    // Один шаг вне таймера (на паузе); false - алгоритма больше нет
+    bool stepOnce();
+
+    void setPaused(bool paused);
+    bool isPaused() const { return m_paused; }
+
+    void setStepsPerFrame(int steps) { m_stepsPerFrame = qBound(1, steps, kMaxStepsPerFrame); }
+    int stepsPerFrame() const { return m_stepsPerFrame; }
+    // Больше интервал - медленнее проигрывание при одном шаге за кадр
+    void setFrameInterval(int milliseconds);
+    int frameInterval() const { return m_frameTimer.interval(); }
+
+    bool isRunning() const { return bool(m_step); }
+    // true, пока выполняется шаг: изменения структуры в это время сделал сам алгоритм
+    bool isInsideStep() const { return m_insideStep; }
+    int stepCount() const { return m_stepCount; }
+
+signals:
+    void stepped(int stepCount);
+    void finished();
+    void cancelled();
+
+private slots:
+    void onFrame();
+
+private:
+    bool advance();
+    void stop();
+
+    QTimer m_frameTimer;
+    StepFunction m_step;
+    int m_stepsPerFrame = 1;
+    int m_stepCount = 0;
+    bool m_paused = false;
+    bool m_insideStep = false;
+    bool m_cancelRequested = false;
+
+    Q_DISABLE_COPY(AlgorithmStepper)
+};
+
+#endif // ALGORITHM_STEPPER_H
@@ -0,0 +1,100 @@
+#include "graphics_bucket_item.h"
+#include "perf_timer.h"
+#include <QPainter>
+
+GraphicsBucketItem::GraphicsBucketItem(int slot, QGraphicsItem* parent)
+    : QGraphicsRectItem(parent)
+    , m_slot(slot)
+{
+    setSize(48.0, 40.0);
+}
+
+void GraphicsBucketItem::setEmpty()
+{
+    if (m_distance != -1) {
+        m_distance = -1;
+        update();
+    }
+}
+
+void GraphicsBucketItem::setEntry(int key, int distance)
+{
+    if (m_key != key || m_distance != distance) {
+        m_key = key;
+        m_distance = distance;
+        update();
+    }
+}
+
+void GraphicsBucketItem::setProbeState(ProbeState state)
+{
+    if (m_probeState != state) {
+        m_probeState = state;
+        update();
+    }
+}
+
+void GraphicsBucketItem::setSize(qreal width, qreal height)
+{
+    prepareGeometryChange();
+    setRect(-width / 2.0, -height / 2.0, width, height);
+}
+
+QColor GraphicsBucketItem::fillColor() const
+{
+    if (m_distance < 0) {
+        return QColor(110, 110, 110);
+    }
+
+    // Дистанция 0 - зеленый, 8 и больше - красный
+    const int hue = 120 - qMin(m_distance, 8) * 15;
+    return QColor::fromHsv(hue, 170, 190);
+}
+
+void GraphicsBucketItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                               QWidget* widget)
+{
+    DSAT_PERF_COUNT_PAINT();
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    const QRectF r = rect();
+
+    QPen border(QColor(40, 40, 40), 1);
+    switch (m_probeState) {
+    case ProbeState::None:
+        break;
+    case ProbeState::Home:
+        border = QPen(QColor(Qt::cyan), 3);
+        break;
+    case ProbeState::Probed:
+        border = QPen(QColor(255, 200, 0), 3);
+        break;
+    case ProbeState::Found:
+        border = QPen(QColor(Qt::white), 3);
+        break;
+    }
+
+    painter->setPen(border);
+    painter->setBrush(fillColor());
+    painter->drawRect(r);
+
+    QFont small = painter->font();
+    small.setPointSizeF(qMax(5.0, small.pointSizeF() * 0.6));
+
+    painter->setFont(small);
+    painter->setPen(QColor(30, 30, 30));
+    painter->drawText(r.adjusted(3, 1, -3, -1), Qt::AlignTop | Qt::AlignLeft, QString::number(m_slot));
+
+    if (m_distance < 0) return;
+
+    painter->drawText(r.adjusted(3, 1, -3, -1), Qt::AlignBottom | Qt::AlignRight,
+                      QStringLiteral("d%1").arg(m_distance));
+
+    QFont normal = small;
+    normal.setPointSizeF(small.pointSizeF() / 0.6);
+    normal.setBold(true);
+    painter->setFont(normal);
+    painter->setPen(QColor(Qt::black));
+    painter->drawText(r, Qt::AlignCenter, QString::number(m_key));
+}
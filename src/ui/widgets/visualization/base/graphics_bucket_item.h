@@ -0,0 +1,43 @@
+#ifndef GRAPHICS_BUCKET_ITEM_H
+#define GRAPHICS_BUCKET_ITEM_H
+
+#include <QGraphicsRectItem>
+
+// Слот хэш-таблицы: ключ по центру, номер слота и дистанция от домашнего
+// слота мелким шрифтом. Цвет зависит от дистанции - длинные цепочки видно сразу.
+// Прямоугольник центрирован в (0, 0), как и у остальных элементов.
+class GraphicsBucketItem : public QGraphicsRectItem
+{
+public:
+    enum class ProbeState
+    {
+        None,
+        Home,       // Домашний слот искомого ключа
+        Probed,     // Просмотрен при поиске
+        Found
+    };
+
+    explicit GraphicsBucketItem(int slot, QGraphicsItem* parent = nullptr);
+
+    int slot() const { return m_slot; }
+
+    void setEmpty();
+    void setEntry(int key, int distance);
+    void setProbeState(ProbeState state);
+    void setSize(qreal width, qreal height);
+
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+               QWidget* widget = nullptr) override;
+
+private:
+    int m_slot;
+    int m_key = 0;
+    int m_distance = -1;    // -1 - пустой слот
+    ProbeState m_probeState = ProbeState::None;
+
+    QColor fillColor() const;
+
+    Q_DISABLE_COPY(GraphicsBucketItem)
+};
+
+#endif // GRAPHICS_BUCKET_ITEM_H
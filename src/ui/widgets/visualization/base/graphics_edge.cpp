@@ -1,4 +1,6 @@
 #include "graphics_edge.h"
+#include "perf_timer.h"
+#include "../../../../core/utils/memory_report.h"
 #include <QPainter>
 #include <QPen>
 #include <cmath>
@@ -93,9 +95,18 @@ void GraphicsEdge::updatePosition()
     setLine(QLineF(startScenePos, endScenePos));
 }
 
+qint64 GraphicsEdge::memoryBytes() const
+{
+    // Оценка приватных данных нужна только без malloc_usable_size
+    constexpr std::size_t kItemPrivateEstimate = 256;
+    return MemoryReport::allocationBytes(this, sizeof(GraphicsEdge))
+         + MemoryReport::allocationBytes(d_ptr.data(), kItemPrivateEstimate);
+}
+
 void GraphicsEdge::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
                          QWidget* widget)
 {
+    DSAT_PERF_COUNT_PAINT();
     Q_UNUSED(widget);
 
     // Обновляем позицию
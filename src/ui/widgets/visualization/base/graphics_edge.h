@@ -26,6 +26,9 @@ public:
 
     void updatePosition();
 
+    // Учет памяти: объект и QGraphicsItemPrivate (размер от аллокатора)
+    qint64 memoryBytes() const;
+
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
                QWidget* widget = nullptr) override;
 
@@ -0,0 +1,123 @@
+#include "graphics_edge_batch.h"
+#include "perf_timer.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+GraphicsEdgeBatch::GraphicsEdgeBatch(QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+{
+}
+
+void GraphicsEdgeBatch::setLines(const QVector<QLineF>& lines)
+{
+    m_lines = lines;
+    updateBounds();
+}
+
+void GraphicsEdgeBatch::setPoints(const QVector<QPointF>& points, const QVector<QColor>& colors)
+{
+    m_points = points;
+    m_pointColors = colors.size() == points.size() ? colors : QVector<QColor>();
+    updateBounds();
+}
+
+void GraphicsEdgeBatch::setColor(const QColor& color)
+{
+    if (m_color != color) {
+        m_color = color;
+        update();
+    }
+}
+
+void GraphicsEdgeBatch::setWidth(qreal width)
+{
+    if (m_width != width) {
+        m_width = width;
+        update();
+    }
+}
+
+void GraphicsEdgeBatch::setPointRadius(qreal radius)
+{
+    if (m_pointRadius != radius) {
+        m_pointRadius = radius;
+        updateBounds();
+    }
+}
+
+void GraphicsEdgeBatch::updateBounds()
+{
+    qreal left = 0, top = 0, right = 0, bottom = 0;
+    bool first = true;
+
+    auto extend = [&](const QPointF& p) {
+        if (first) {
+            left = right = p.x();
+            top = bottom = p.y();
+            first = false;
+            return;
+        }
+        left = qMin(left, p.x());
+        right = qMax(right, p.x());
+        top = qMin(top, p.y());
+        bottom = qMax(bottom, p.y());
+    };
+
+    for (const QLineF& line : m_lines) {
+        extend(line.p1());
+        extend(line.p2());
+    }
+    for (const QPointF& point : m_points) {
+        extend(point);
+    }
+
+    const qreal margin = qMax(m_width, m_pointRadius) + 1.0;
+    prepareGeometryChange();
+    m_bounds = first ? QRectF() : QRectF(QPointF(left, top), QPointF(right, bottom))
+                                      .adjusted(-margin, -margin, margin, margin);
+    update();
+}
+
+QRectF GraphicsEdgeBatch::boundingRect() const
+{
+    return m_bounds;
+}
+
+void GraphicsEdgeBatch::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                              QWidget* widget)
+{
+    DSAT_PERF_COUNT_PAINT();
+    Q_UNUSED(widget);
+
+    // Сглаживание на сотнях тысяч линий стоит дороже, чем дает
+    painter->setRenderHint(QPainter::Antialiasing, m_lines.size() < 5000);
+
+    QPen pen(m_color, m_width);
+    pen.setCosmetic(true);
+    painter->setPen(pen);
+    painter->drawLines(m_lines);
+
+    if (m_points.isEmpty()) return;
+
+    // Точки - толстым круглым пером; слишком мелкие на экране не рисуем вовсе
+    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    if (m_pointRadius * lod < 0.5) return;
+
+    QPen pointPen(m_color.lighter(140), 2.0 * m_pointRadius, Qt::SolidLine, Qt::RoundCap);
+    if (m_pointColors.isEmpty()) {
+        painter->setPen(pointPen);
+        painter->drawPoints(m_points.constData(), m_points.size());
+        return;
+    }
+
+    // Подряд идущие точки одного цвета рисуем одним вызовом
+    int start = 0;
+    for (int i = 1; i <= m_points.size(); ++i) {
+        if (i < m_points.size() && m_pointColors[i] == m_pointColors[start]) continue;
+
+        pointPen.setColor(m_pointColors[start]);
+        painter->setPen(pointPen);
+        painter->drawPoints(m_points.constData() + start, i - start);
+        start = i;
+    }
+}
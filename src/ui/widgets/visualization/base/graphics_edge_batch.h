@@ -0,0 +1,44 @@
+#ifndef GRAPHICS_EDGE_BATCH_H
+#define GRAPHICS_EDGE_BATCH_H
+
+#include <QGraphicsItem>
+#include <QVector>
+#include <QLineF>
+#include <QColor>
+
+// Много отрезков (и, при необходимости, точек) одним элементом сцены.
+// На графах с сотнями тысяч ребер отдельный GraphicsEdge на каждое ребро
+// съедает память и время индекса сцены; здесь все рисуется одним drawLines.
+class GraphicsEdgeBatch : public QGraphicsItem
+{
+public:
+    explicit GraphicsEdgeBatch(QGraphicsItem* parent = nullptr);
+
+    void setLines(const QVector<QLineF>& lines);
+    // Точки рисуются поверх отрезков; colors либо пуст, либо по цвету на точку
+    void setPoints(const QVector<QPointF>& points, const QVector<QColor>& colors = QVector<QColor>());
+    void setColor(const QColor& color);
+    void setWidth(qreal width);
+    void setPointRadius(qreal radius);
+
+    int lineCount() const { return m_lines.size(); }
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+               QWidget* widget = nullptr) override;
+
+private:
+    QVector<QLineF> m_lines;
+    QVector<QPointF> m_points;
+    QVector<QColor> m_pointColors;
+    QColor m_color = QColor(70, 130, 180);
+    qreal m_width = 1.0;
+    qreal m_pointRadius = 3.0;
+    QRectF m_bounds;
+
+    void updateBounds();
+
+    Q_DISABLE_COPY(GraphicsEdgeBatch)
+};
+
+#endif // GRAPHICS_EDGE_BATCH_H
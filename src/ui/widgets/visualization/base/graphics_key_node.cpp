@@ -0,0 +1,94 @@
+#include "graphics_key_node.h"
+#include "perf_timer.h"
+#include <QPainter>
+
+GraphicsKeyNode::GraphicsKeyNode(const QVector<int>& keys, QGraphicsItem* parent)
+    : QGraphicsRectItem(parent)
+    , m_keys(keys)
+{
+    updateGeometry();
+}
+
+void GraphicsKeyNode::setKeys(const QVector<int>& keys)
+{
+    if (m_keys != keys) {
+        m_keys = keys;
+        updateGeometry();
+    }
+}
+
+void GraphicsKeyNode::setBaseColor(const QColor& color)
+{
+    if (m_baseColor != color) {
+        m_baseColor = color;
+        update();
+    }
+}
+
+void GraphicsKeyNode::setHighlighted(bool highlighted)
+{
+    if (m_highlighted != highlighted) {
+        m_highlighted = highlighted;
+        update();
+    }
+}
+
+void GraphicsKeyNode::setHighlightedCell(int index)
+{
+    if (m_highlightedCell != index) {
+        m_highlightedCell = index;
+        update();
+    }
+}
+
+void GraphicsKeyNode::setCellSize(qreal width, qreal height)
+{
+    if (width > 0 && height > 0) {
+        m_cellWidth = width;
+        m_cellHeight = height;
+        updateGeometry();
+    }
+}
+
+void GraphicsKeyNode::updateGeometry()
+{
+    // Пустой узел (например, лист после удалений) рисуем одной пустой ячейкой
+    const int cells = qMax(1, int(m_keys.size()));
+    const qreal width = cells * m_cellWidth;
+
+    prepareGeometryChange();
+    setRect(-width / 2.0, -m_cellHeight / 2.0, width, m_cellHeight);
+    update();
+}
+
+void GraphicsKeyNode::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                            QWidget* widget)
+{
+    DSAT_PERF_COUNT_PAINT();
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    const QRectF r = rect();
+    const QColor fill = m_highlighted ? m_baseColor.lighter(130) : m_baseColor;
+
+    painter->setPen(QPen(m_highlighted ? QColor(Qt::yellow) : m_borderColor, 2));
+    painter->setBrush(fill);
+    painter->drawRect(r);
+
+    for (int i = 0; i < m_keys.size(); ++i) {
+        const QRectF cell(r.left() + i * m_cellWidth, r.top(), m_cellWidth, m_cellHeight);
+
+        if (i == m_highlightedCell) {
+            painter->fillRect(cell.adjusted(1, 1, -1, -1), QColor(255, 200, 0));
+        }
+
+        // Разделители между ячейками
+        if (i > 0) {
+            painter->setPen(QPen(m_borderColor, 1));
+            painter->drawLine(cell.topLeft(), cell.bottomLeft());
+        }
+
+        painter->setPen(fill.lightness() > 128 ? QColor(Qt::black) : QColor(Qt::white));
+        painter->drawText(cell, Qt::AlignCenter, QString::number(m_keys[i]));
+    }
+}
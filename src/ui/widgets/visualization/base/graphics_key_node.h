@@ -0,0 +1,45 @@
+#ifndef GRAPHICS_KEY_NODE_H
+#define GRAPHICS_KEY_NODE_H
+
+#include <QGraphicsRectItem>
+#include <QVector>
+
+// Узел с несколькими ключами (B+ дерево, массивы и т.п.):
+// прямоугольник, разбитый на ячейки, по ключу в каждой.
+// Прямоугольник центрирован в (0, 0), как и у GraphicsNode,
+// поэтому GraphicsEdge соединяет центры без поправок.
+class GraphicsKeyNode : public QGraphicsRectItem
+{
+public:
+    explicit GraphicsKeyNode(const QVector<int>& keys, QGraphicsItem* parent = nullptr);
+
+    const QVector<int>& keys() const { return m_keys; }
+    void setKeys(const QVector<int>& keys);
+
+    void setBaseColor(const QColor& color);
+    void setHighlighted(bool highlighted);
+    // Подсветка одной ячейки (например, найденного ключа), -1 - без подсветки
+    void setHighlightedCell(int index);
+
+    void setCellSize(qreal width, qreal height);
+    qreal cellWidth() const { return m_cellWidth; }
+    qreal width() const { return rect().width(); }
+
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+               QWidget* widget = nullptr) override;
+
+private:
+    QVector<int> m_keys;
+    QColor m_baseColor = QColor(70, 130, 200);
+    QColor m_borderColor = QColor(30, 60, 100);
+    bool m_highlighted = false;
+    int m_highlightedCell = -1;
+    qreal m_cellWidth = 44.0;
+    qreal m_cellHeight = 32.0;
+
+    void updateGeometry();
+
+    Q_DISABLE_COPY(GraphicsKeyNode)
+};
+
+#endif // GRAPHICS_KEY_NODE_H
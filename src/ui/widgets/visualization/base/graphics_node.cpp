@@ -1,4 +1,6 @@
 #include "graphics_node.h"
+#include "perf_timer.h"
+#include "../../../../core/utils/memory_report.h"
 #include <QPainter>
 #include <QFontMetrics>
 
@@ -41,7 +43,8 @@ void GraphicsNode::setBorderColor(const QColor& color)
 {
     if (m_borderColor != color) {
         m_borderColor = color;
-        update();
+        // Цвет рамки попадает в перо только через updateAppearance
+        updateAppearance();
     }
 }
 
@@ -77,6 +80,20 @@ void GraphicsNode::setActive(bool active)
     }
 }
 
+void GraphicsNode::setStates(bool selected, bool highlighted, bool visited, bool active)
+{
+    if (m_selected == selected && m_highlighted == highlighted
+        && m_visited == visited && m_active == active) {
+        return;
+    }
+
+    m_selected = selected;
+    m_highlighted = highlighted;
+    m_visited = visited;
+    m_active = active;
+    updateAppearance();
+}
+
 void GraphicsNode::setRadius(qreal radius)
 {
     if (radius > 0 && m_radius != radius) {
@@ -86,10 +103,6 @@ void GraphicsNode::setRadius(qreal radius)
         // А не центр и радиус!
         setRect(-radius, -radius, radius * 2, radius * 2);
 
-        qDebug() << "GraphicsNode::setRadius(" << radius << ")";
-        qDebug() << "  Rect set to:" << rect();
-        qDebug() << "  Bounding rect:" << boundingRect();
-
         updateTextPosition();
         update();
     }
@@ -106,6 +119,28 @@ void GraphicsNode::setFont(const QFont& font)
     updateTextPosition();
 }
 
+namespace
+{
+// Приватные данные элемента сцены для платформ без malloc_usable_size
+constexpr std::size_t kItemPrivateEstimate = 256;
+// QGraphicsTextItemPrivate, QWidgetTextControl и QTextDocument с одним блоком
+// текста: их указатели наружу не видны, поэтому только грубая оценка
+constexpr qint64 kLabelInternalsEstimate = 2048;
+}
+
+qint64 GraphicsNode::memoryBytes() const
+{
+    return MemoryReport::allocationBytes(this, sizeof(GraphicsNode))
+         + MemoryReport::allocationBytes(d_ptr.data(), kItemPrivateEstimate);
+}
+
+qint64 GraphicsNode::labelMemoryBytes() const
+{
+    if (!m_textItem) return 0;
+
+    return MemoryReport::allocationBytes(m_textItem, sizeof(QGraphicsTextItem)) + kLabelInternalsEstimate;
+}
+
 QRectF GraphicsNode::boundingRect() const
 {
     // Немного больше для тени/обводки
@@ -116,6 +151,7 @@ QRectF GraphicsNode::boundingRect() const
 void GraphicsNode::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
                          QWidget* widget)
 {
+    DSAT_PERF_COUNT_PAINT();
     Q_UNUSED(option);
     Q_UNUSED(widget);
 
@@ -165,7 +201,6 @@ void GraphicsNode::updateAppearance()
     }
 
     setPen(pen);
-    qDebug() << "Final pen color:" << pen.color();
 
     // 3. Устанавливаем цвет текста
     // Автоматически выбираем контрастный цвет
@@ -178,7 +213,6 @@ void GraphicsNode::updateAppearance()
     }
 
     m_textItem->setDefaultTextColor(textColor);
-    qDebug() << "Text color set to:" << textColor;
 
     update();
 }
@@ -196,9 +230,4 @@ void GraphicsNode::updateTextPosition()
     qreal y = -textRect.height() / 2.0;
 
     m_textItem->setPos(x, y);
-
-    qDebug() << "Text position updated:";
-    qDebug() << "  Text rect:" << textRect;
-    qDebug() << "  Text pos:" << m_textItem->pos();
-    qDebug() << "  Node center: (0, 0)";
 }
@@ -19,6 +19,14 @@ public:
     void setHighlighted(bool highlighted);
     void setVisited(bool visited);
     void setActive(bool active);
+    // Все флаги разом - один пересчет внешнего вида вместо четырех
+    void setStates(bool selected, bool highlighted, bool visited, bool active);
+
+    // Не isSelected/isActive: эти имена уже заняты в QGraphicsItem
+    bool selectedState() const { return m_selected; }
+    bool highlightedState() const { return m_highlighted; }
+    bool visitedState() const { return m_visited; }
+    bool activeState() const { return m_active; }
 
     void setRadius(qreal radius);
     qreal radius() const { return m_radius; }
@@ -31,6 +39,11 @@ public:
                QWidget* widget = nullptr) override;
 
     void updateAppearance();
+
+    // Учет памяти: объект и QGraphicsItemPrivate (размер от аллокатора)
+    qint64 memoryBytes() const;
+    // Подпись - QGraphicsTextItem со своим документом, в основном оценка
+    qint64 labelMemoryBytes() const;
 private:
     int m_value;
     QGraphicsTextItem* m_textItem;
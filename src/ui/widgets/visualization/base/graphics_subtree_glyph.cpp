@@ -0,0 +1,84 @@
+#include "graphics_subtree_glyph.h"
+#include "perf_timer.h"
+#include "../../../../core/utils/memory_report.h"
+#include <QFontMetricsF>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+GraphicsSubtreeGlyph::GraphicsSubtreeGlyph(QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+{
+    // Под ребрами (-1) и узлами: вершина треугольника прячется под корнем
+    setZValue(-2);
+}
+
+void GraphicsSubtreeGlyph::setExtent(qreal leftWidth, qreal rightWidth, qreal depth)
+{
+    prepareGeometryChange();
+
+    m_path = QPainterPath();
+    m_path.moveTo(0, 0);
+    m_path.lineTo(rightWidth, depth);
+    m_path.lineTo(-leftWidth, depth);
+    m_path.closeSubpath();
+}
+
+void GraphicsSubtreeGlyph::setSummary(int nodes, int height, int minKey, int maxKey)
+{
+    m_label = QString("%1 nodes, height %2\nkeys %3..%4").arg(nodes).arg(height).arg(minKey).arg(maxKey);
+    setToolTip(m_label);
+    update();
+}
+
+QRectF GraphicsSubtreeGlyph::boundingRect() const
+{
+    return m_path.boundingRect().adjusted(-2, -2, 2, 2);
+}
+
+QPainterPath GraphicsSubtreeGlyph::shape() const
+{
+    return m_path;
+}
+
+void GraphicsSubtreeGlyph::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                                 QWidget* widget)
+{
+    DSAT_PERF_COUNT_PAINT();
+    Q_UNUSED(widget);
+
+    painter->setPen(QPen(QColor(30, 60, 100), 0));
+    painter->setBrush(QColor(70, 130, 200, 150));
+    painter->drawPath(m_path);
+
+    // Текст - в пикселях экрана, а не сцены: при сильном уменьшении
+    // он иначе превращается в кашу
+    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const QRectF bounds = m_path.boundingRect();
+
+    QFont font = painter->font();
+    font.setPointSizeF(8.0);
+    const QFontMetricsF metrics(font);
+    const QRectF textRect = metrics.boundingRect(QRectF(), Qt::AlignCenter, m_label);
+
+    // Надпись ставим в нижнюю половину треугольника, где он шире
+    if (bounds.width() * lod * 0.5 < textRect.width() || bounds.height() * lod * 0.5 < textRect.height()) {
+        return;
+    }
+
+    const QPointF anchor = painter->worldTransform().map(QPointF(bounds.center().x(), bounds.top() + bounds.height() * 0.7));
+
+    painter->save();
+    painter->resetTransform();
+    painter->setFont(font);
+    painter->setPen(Qt::white);
+    painter->drawText(textRect.translated(anchor - textRect.center()), Qt::AlignCenter, m_label);
+    painter->restore();
+}
+
+qint64 GraphicsSubtreeGlyph::memoryBytes() const
+{
+    // Оценка приватных данных нужна только без malloc_usable_size
+    constexpr std::size_t kItemPrivateEstimate = 256;
+    return MemoryReport::allocationBytes(this, sizeof(GraphicsSubtreeGlyph))
+         + MemoryReport::allocationBytes(d_ptr.data(), kItemPrivateEstimate);
+}
@@ -0,0 +1,35 @@
+#ifndef GRAPHICS_SUBTREE_GLYPH_H
+#define GRAPHICS_SUBTREE_GLYPH_H
+
+#include <QGraphicsItem>
+#include <QPainterPath>
+
+// Свернутое поддерево: треугольник, который свисает из корня поддерева
+// (вершина в (0, 0), сам корень рисуется обычным узлом поверх). Подпись -
+// размер, высота и диапазон ключей; выводится, только когда помещается
+// в треугольник на экране, иначе остается подсказка.
+class GraphicsSubtreeGlyph : public QGraphicsItem
+{
+public:
+    explicit GraphicsSubtreeGlyph(QGraphicsItem* parent = nullptr);
+
+    // Основание от -leftWidth до rightWidth на глубине depth
+    void setExtent(qreal leftWidth, qreal rightWidth, qreal depth);
+    void setSummary(int nodes, int height, int minKey, int maxKey);
+
+    QRectF boundingRect() const override;
+    QPainterPath shape() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+               QWidget* widget = nullptr) override;
+
+    // Учет памяти: объект и QGraphicsItemPrivate (размер от аллокатора)
+    qint64 memoryBytes() const;
+
+private:
+    QPainterPath m_path;
+    QString m_label;
+
+    Q_DISABLE_COPY(GraphicsSubtreeGlyph)
+};
+
+#endif // GRAPHICS_SUBTREE_GLYPH_H
@@ -0,0 +1,191 @@
+#include "minimap_widget.h"
+#include "visualizer_base.h"
+
+#include <QPainter>
+#include <QScrollBar>
+
+MinimapWidget::MinimapWidget(VisualizerBase* visualizer, QGraphicsView* view)
+    : QWidget(view)
+    , m_visualizer(visualizer)
+    , m_view(view)
+{
+    setFixedSize(220, 160);
+    setCursor(Qt::PointingHandCursor);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    // Рамка должна следовать за прокруткой основного вида
+    connect(m_view->horizontalScrollBar(), &QScrollBar::valueChanged,
+            this, QOverload<>::of(&QWidget::update));
+    connect(m_view->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, QOverload<>::of(&QWidget::update));
+
+    // Прижимаем панель к правому нижнему углу при изменении размера вида
+    m_view->viewport()->installEventFilter(this);
+    reposition();
+}
+
+void MinimapWidget::setOverviewRect(const QRectF& rect)
+{
+    if (m_overviewRect == rect) return;
+
+    // Другой масштаб - старый кэш больше не годится
+    m_overviewRect = rect;
+    invalidateAll();
+}
+
+void MinimapWidget::invalidate(const QRectF& sceneRegion)
+{
+    if (sceneRegion.isEmpty()) return;
+
+    m_dirtyRegion = m_dirtyRegion.isEmpty() ? sceneRegion : m_dirtyRegion.united(sceneRegion);
+    update();
+}
+
+void MinimapWidget::invalidateAll()
+{
+    m_fullRefresh = true;
+    m_dirtyRegion = QRectF();
+    update();
+}
+
+QTransform MinimapWidget::sceneToMinimap() const
+{
+    QTransform transform;
+    if (m_overviewRect.isEmpty()) return transform;
+
+    const qreal scale = qMin(width() / m_overviewRect.width(),
+                             height() / m_overviewRect.height());
+
+    // Центрируем структуру внутри панели
+    const qreal offsetX = (width() - m_overviewRect.width() * scale) / 2.0;
+    const qreal offsetY = (height() - m_overviewRect.height() * scale) / 2.0;
+
+    transform.translate(offsetX, offsetY);
+    transform.scale(scale, scale);
+    transform.translate(-m_overviewRect.left(), -m_overviewRect.top());
+    return transform;
+}
+
+QRectF MinimapWidget::visibleSceneRect() const
+{
+    if (!m_view) return QRectF();
+    return m_view->mapToScene(m_view->viewport()->rect()).boundingRect();
+}
+
+void MinimapWidget::refreshCache()
+{
+    const QColor background(50, 50, 50);
+
+    if (m_cache.size() != size()) {
+        m_cache = QImage(size(), QImage::Format_ARGB32_Premultiplied);
+        m_fullRefresh = true;
+    }
+
+    if (!m_fullRefresh && m_dirtyRegion.isEmpty()) return;
+
+    QPainter painter(&m_cache);
+    const QTransform transform = sceneToMinimap();
+
+    QRectF sceneRegion = m_overviewRect;
+    if (m_fullRefresh) {
+        painter.fillRect(m_cache.rect(), background);
+    } else {
+        // Перерисовываем только измененный прямоугольник (с запасом в пиксель)
+        QRect pixelRect = transform.mapRect(m_dirtyRegion).toAlignedRect().adjusted(-1, -1, 1, 1);
+        pixelRect &= m_cache.rect();
+        painter.setClipRect(pixelRect);
+        painter.fillRect(pixelRect, background);
+        sceneRegion = transform.inverted().mapRect(QRectF(pixelRect));
+    }
+
+    if (!m_overviewRect.isEmpty()) {
+        painter.setTransform(transform);
+        m_visualizer->renderOverview(&painter, sceneRegion);
+    }
+
+    m_fullRefresh = false;
+    m_dirtyRegion = QRectF();
+}
+
+void MinimapWidget::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    refreshCache();
+
+    QPainter painter(this);
+    painter.drawImage(0, 0, m_cache);
+
+    // Рамка текущей области просмотра
+    QRectF viewportRect = sceneToMinimap().mapRect(visibleSceneRect());
+    painter.setPen(QPen(QColor(255, 200, 0), 2));
+    painter.setBrush(QColor(255, 200, 0, 40));
+    painter.drawRect(viewportRect.intersected(QRectF(rect()).adjusted(1, 1, -1, -1)));
+
+    painter.setPen(QPen(QColor(20, 20, 20), 1));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRect(rect().adjusted(0, 0, -1, -1));
+}
+
+void MinimapWidget::centerViewAt(const QPoint& pos)
+{
+    if (!m_view || m_overviewRect.isEmpty()) return;
+
+    QPointF scenePos = sceneToMinimap().inverted().map(QPointF(pos));
+    m_view->centerOn(scenePos);
+    update();
+}
+
+void MinimapWidget::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = true;
+        centerViewAt(event->pos());
+        event->accept();
+        return;
+    }
+
+    QWidget::mousePressEvent(event);
+}
+
+void MinimapWidget::mouseMoveEvent(QMouseEvent* event)
+{
+    if (m_dragging) {
+        centerViewAt(event->pos());
+        event->accept();
+        return;
+    }
+
+    QWidget::mouseMoveEvent(event);
+}
+
+void MinimapWidget::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton && m_dragging) {
+        m_dragging = false;
+        event->accept();
+        return;
+    }
+
+    QWidget::mouseReleaseEvent(event);
+}
+
+bool MinimapWidget::eventFilter(QObject* watched, QEvent* event)
+{
+    if (m_view && watched == m_view->viewport() && event->type() == QEvent::Resize) {
+        reposition();
+        update();
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
+
+void MinimapWidget::reposition()
+{
+    if (!m_view) return;
+
+    // Координаты viewport совпадают с координатами вида с точностью до рамки
+    const QRect area = m_view->viewport()->geometry();
+    move(area.right() - width() - m_margin, area.bottom() - height() - m_margin);
+    raise();
+}
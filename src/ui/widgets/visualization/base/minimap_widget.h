@@ -0,0 +1,62 @@
+#ifndef MINIMAP_WIDGET_H
+#define MINIMAP_WIDGET_H
+
+#include <QWidget>
+#include <QGraphicsView>
+#include <QPointer>
+#include <QImage>
+#include <QMouseEvent>
+#include <QPaintEvent>
+
+class VisualizerBase;
+
+// Панель обзора поверх QGraphicsView.
+// Хранит уменьшенный снимок всей структуры в QImage и перерисовывает
+// только измененные области. Рамка текущей области просмотра
+// перетаскивается мышью и двигает основной вид через centerOn(),
+// без resetTransform() и полной перерисовки сцены.
+class MinimapWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit MinimapWidget(VisualizerBase* visualizer, QGraphicsView* view);
+
+    // Область сцены, которую показывает миникарта
+    void setOverviewRect(const QRectF& rect);
+    QRectF overviewRect() const { return m_overviewRect; }
+
+    // Пометить часть сцены как измененную (перерисуется при следующем paintEvent)
+    void invalidate(const QRectF& sceneRegion);
+    void invalidateAll();
+
+    void setMargin(int margin) { m_margin = margin; reposition(); }
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    VisualizerBase* m_visualizer;
+    QPointer<QGraphicsView> m_view;
+
+    QImage m_cache;
+    QRectF m_overviewRect;
+    QRectF m_dirtyRegion;       // В координатах сцены
+    bool m_fullRefresh = true;
+    bool m_dragging = false;
+    int m_margin = 10;
+
+    QTransform sceneToMinimap() const;
+    QRectF visibleSceneRect() const;
+    void refreshCache();
+    void centerViewAt(const QPoint& pos);
+    void reposition();
+
+    Q_DISABLE_COPY(MinimapWidget)
+};
+
+#endif // MINIMAP_WIDGET_H
@@ -0,0 +1,112 @@
+#include "perf_hud_widget.h"
+
+#ifdef DSAT_ENABLE_PERF_HUD
+
+#include <QPainter>
+#include <QFontMetrics>
+#include <QStringList>
+
+namespace
+{
+constexpr int kMargin = 10;
+constexpr int kPadding = 6;
+constexpr int kPanelWidth = 300;
+}
+
+PerfHudWidget::PerfHudWidget(QGraphicsView* view, PerfSections* sections)
+    : QWidget(view->viewport())
+    , m_view(view)
+    , m_sections(sections)
+{
+    // Оверлей только смотрит: мышь и фон остаются за видом
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_NoSystemBackground);
+    setGeometry(view->viewport()->rect());
+
+    m_view->viewport()->installEventFilter(this);
+    m_clock.start();
+
+    m_refreshTimer.setInterval(kRefreshIntervalMs);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &PerfHudWidget::refresh);
+    m_refreshTimer.start();
+}
+
+QRect PerfHudWidget::panelRect() const
+{
+    const int lines = 4 + (m_sections ? m_sections->sections().size() : 0);
+    const int height = lines * fontMetrics().height() + 2 * kPadding;
+    return QRect(kMargin, kMargin, kPanelWidth, height);
+}
+
+bool PerfHudWidget::eventFilter(QObject* watched, QEvent* event)
+{
+    if (m_view && watched == m_view->viewport()) {
+        if (event->type() == QEvent::Resize) {
+            setGeometry(m_view->viewport()->rect());
+        } else if (event->type() == QEvent::Paint) {
+            // Перерисовка одной панели - не кадр сцены
+            const QRect dirty = static_cast<QPaintEvent*>(event)->rect();
+            m_measuring = !panelRect().contains(dirty);
+            if (m_measuring) {
+                PerfSections::takeItemPaints();
+                m_frameTimer.start();
+            }
+        }
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
+
+void PerfHudWidget::refresh()
+{
+    if (m_view && m_view->scene()) {
+        m_sceneItems = m_view->scene()->items().size();
+    }
+    update(panelRect());
+}
+
+void PerfHudWidget::paintEvent(QPaintEvent* event)
+{
+    if (m_measuring) {
+        m_measuring = false;
+        m_lastFrameNs = m_frameTimer.nsecsElapsed();
+        m_lastFramePaints = PerfSections::takeItemPaints();
+
+        const qint64 now = m_clock.elapsed();
+        m_frameTimes.append(now);
+        while (!m_frameTimes.isEmpty() && now - m_frameTimes.first() > 1000) {
+            m_frameTimes.removeFirst();
+        }
+    }
+
+    const QRect panel = panelRect();
+    if (!event->rect().intersects(panel)) return;
+
+    QStringList lines;
+    lines.append(QString("FPS: %1   frame: %2 ms")
+                     .arg(m_frameTimes.size())
+                     .arg(m_lastFrameNs / 1e6, 0, 'f', 2));
+    lines.append(QString("Scene items: %1").arg(m_sceneItems));
+    lines.append(QString("Repainted last frame: %1").arg(m_lastFramePaints));
+    lines.append("Sections (last / avg, ms):");
+
+    if (m_sections) {
+        for (const PerfSections::Section& section : m_sections->sections()) {
+            lines.append(QString("  %1: %2 / %3")
+                             .arg(QString::fromLatin1(section.name))
+                             .arg(section.lastNs / 1e6, 0, 'f', 2)
+                             .arg(section.averageNs / 1e6, 0, 'f', 2));
+        }
+    }
+
+    QPainter painter(this);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 170));
+    painter.drawRoundedRect(panel, 4, 4);
+
+    painter.setPen(QColor(120, 255, 120));
+    painter.drawText(panel.adjusted(kPadding, kPadding, -kPadding, -kPadding),
+                     Qt::AlignLeft | Qt::AlignTop, lines.join('\n'));
+}
+
+#endif // DSAT_ENABLE_PERF_HUD
@@ -0,0 +1,58 @@
+#ifndef PERF_HUD_WIDGET_H
+#define PERF_HUD_WIDGET_H
+
+#ifdef DSAT_ENABLE_PERF_HUD
+
+#include <QWidget>
+#include <QGraphicsView>
+#include <QPointer>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+#include <QPaintEvent>
+
+#include "perf_timer.h"
+
+// Оверлей производительности поверх вьюпорта QGraphicsView.
+// Прозрачный виджет на весь вьюпорт: при любой перерисовке вида он
+// рисуется последним в том же проходе, поэтому время от Paint вьюпорта
+// до paintEvent оверлея - полная стоимость кадра вместе с элементами сцены.
+// Сама панель обновляется несколько раз в секунду, и такие кадры
+// (изменилась только панель) в статистику не попадают.
+class PerfHudWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    PerfHudWidget(QGraphicsView* view, PerfSections* sections);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    static constexpr int kRefreshIntervalMs = 250;
+
+    QPointer<QGraphicsView> m_view;
+    PerfSections* m_sections;
+
+    QElapsedTimer m_clock;
+    QElapsedTimer m_frameTimer;
+    bool m_measuring = false;
+
+    QVector<qint64> m_frameTimes;       // Моменты кадров за последнюю секунду, мс
+    qint64 m_lastFrameNs = 0;
+    int m_lastFramePaints = 0;
+    int m_sceneItems = 0;
+
+    QTimer m_refreshTimer;
+
+    QRect panelRect() const;
+    void refresh();
+
+    Q_DISABLE_COPY(PerfHudWidget)
+};
+
+#endif // DSAT_ENABLE_PERF_HUD
+
+#endif // PERF_HUD_WIDGET_H
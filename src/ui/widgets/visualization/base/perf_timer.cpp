@@ -0,0 +1,39 @@
+#include "perf_timer.h"
+
+#ifdef DSAT_ENABLE_PERF_HUD
+
+namespace
+{
+// Вес нового замера в скользящем среднем
+constexpr double kAverageWeight = 0.1;
+}
+
+int PerfSections::s_itemPaints = 0;
+
+void PerfSections::addSample(const char* name, qint64 nanoseconds)
+{
+    for (Section& section : m_sections) {
+        if (section.name == name) {
+            section.lastNs = nanoseconds;
+            section.averageNs += (nanoseconds - section.averageNs) * kAverageWeight;
+            ++section.calls;
+            return;
+        }
+    }
+
+    Section section;
+    section.name = name;
+    section.lastNs = nanoseconds;
+    section.averageNs = double(nanoseconds);
+    section.calls = 1;
+    m_sections.append(section);
+}
+
+int PerfSections::takeItemPaints()
+{
+    const int paints = s_itemPaints;
+    s_itemPaints = 0;
+    return paints;
+}
+
+#endif // DSAT_ENABLE_PERF_HUD
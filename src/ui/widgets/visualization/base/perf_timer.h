@@ -0,0 +1,75 @@
+#ifndef PERF_TIMER_H
+#define PERF_TIMER_H
+
+// Легкие замеры для оверлея производительности.
+// Без DSAT_ENABLE_PERF_HUD (опция CMake) макросы раскрываются в пустоту,
+// и в горячих путях не остается ни таймеров, ни счетчиков.
+
+#ifdef DSAT_ENABLE_PERF_HUD
+
+#include <QElapsedTimer>
+#include <QVector>
+
+// Время по именованным секциям одного визуализатора.
+// Имена - строковые литералы, сравниваются по указателю.
+class PerfSections
+{
+public:
+    struct Section
+    {
+        const char* name = nullptr;
+        qint64 lastNs = 0;
+        double averageNs = 0.0;     // Экспоненциальное среднее
+        quint64 calls = 0;
+    };
+
+    void addSample(const char* name, qint64 nanoseconds);
+    const QVector<Section>& sections() const { return m_sections; }
+    void reset() { m_sections.clear(); }
+
+    // Сколько элементов сцены отрисовали с последнего сброса (общий на все сцены)
+    static void notePaint() { ++s_itemPaints; }
+    static int takeItemPaints();
+
+private:
+    QVector<Section> m_sections;
+    static int s_itemPaints;
+};
+
+class PerfScopedTimer
+{
+public:
+    PerfScopedTimer(PerfSections* sections, const char* name)
+        : m_sections(sections)
+        , m_name(name)
+    {
+        m_timer.start();
+    }
+
+    ~PerfScopedTimer()
+    {
+        m_sections->addSample(m_name, m_timer.nsecsElapsed());
+    }
+
+private:
+    PerfSections* m_sections;
+    const char* m_name;
+    QElapsedTimer m_timer;
+
+    Q_DISABLE_COPY(PerfScopedTimer)
+};
+
+#define DSAT_PERF_CONCAT_INNER(a, b) a##b
+#define DSAT_PERF_CONCAT(a, b) DSAT_PERF_CONCAT_INNER(a, b)
+#define DSAT_PERF_SCOPE(sections, name) \
+    PerfScopedTimer DSAT_PERF_CONCAT(perfScope_, __LINE__)(&(sections), name)
+#define DSAT_PERF_COUNT_PAINT() PerfSections::notePaint()
+
+#else
+
+#define DSAT_PERF_SCOPE(sections, name) ((void)0)
+#define DSAT_PERF_COUNT_PAINT() ((void)0)
+
+#endif // DSAT_ENABLE_PERF_HUD
+
+#endif // PERF_TIMER_H
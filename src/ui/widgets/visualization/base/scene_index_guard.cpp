@@ -0,0 +1,106 @@
+#include "scene_index_guard.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <cmath>
+
+namespace
+{
+struct FreezeState
+{
+    int depth = 0;
+    bool frozen = false;
+    const char* label = nullptr;
+    int changedItems = 0;
+    QElapsedTimer timer;
+};
+
+// Открытые охранники по сценам (только поток GUI)
+QHash<const QGraphicsScene*, FreezeState> s_frozen;
+}
+
+SceneIndexGuard::SceneIndexGuard(QGraphicsScene* scene, int changedItems, int sceneItems,
+                                 const char* label)
+    : m_scene(scene)
+    , m_sceneKey(scene)
+{
+    if (!m_sceneKey) return;
+
+    FreezeState& state = s_frozen[m_sceneKey];
+    if (state.depth++ > 0) return;
+
+    state.label = isTimingEnabled() ? label : nullptr;
+    state.changedItems = changedItems;
+    if (state.label) {
+        state.timer.start();
+    }
+
+    state.frozen = isEnabled()
+                   && m_scene->itemIndexMethod() == QGraphicsScene::BspTreeIndex
+                   && shouldFreeze(changedItems, sceneItems);
+    if (state.frozen) {
+        m_scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+    }
+}
+
+SceneIndexGuard::~SceneIndexGuard()
+{
+    if (!m_sceneKey) return;
+
+    auto it = s_frozen.find(m_sceneKey);
+    if (it == s_frozen.end() || --it->depth > 0) return;
+
+    const FreezeState state = it.value();
+    s_frozen.erase(it);
+
+    // Сцену могли удалить внутри пачки - восстанавливать нечего
+    if (!m_scene) return;
+
+    const qint64 bulkNs = state.label ? state.timer.nsecsElapsed() : 0;
+
+    if (state.frozen) {
+        // Элементы считаем без индекса: с BSP items() еще и сортирует их.
+        // Глубину Qt принимает только у включенного индекса, а строится
+        // он лениво - при первом запросе
+        const int items = m_scene->items().size();
+        m_scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+        m_scene->setBspTreeDepth(bspDepthFor(items));
+    }
+
+    if (!state.label) return;
+
+    // Запрос в точке заставляет индекс достроиться сейчас, а не при
+    // первой отрисовке - иначе время переиндексации не поймать
+    m_scene->items(m_scene->sceneRect().center());
+    const qint64 totalNs = state.timer.nsecsElapsed();
+
+    qDebug() << "Scene bulk update" << state.label << ":" << state.changedItems << "changed,"
+             << bulkNs / 1e6 << "ms bulk," << (totalNs - bulkNs) / 1e6 << "ms index,"
+             << (state.frozen ? "index frozen" : "index live");
+}
+
+int SceneIndexGuard::bspDepthFor(int itemCount)
+{
+    // BSP делит сцену пополам на каждом уровне: листьев 2^depth
+    const double leaves = double(qMax(1, itemCount)) / kItemsPerLeaf;
+    const int depth = int(std::ceil(std::log2(qMax(1.0, leaves))));
+    return qBound(kMinBspDepth, depth, kMaxBspDepth);
+}
+
+bool SceneIndexGuard::shouldFreeze(int changedItems, int sceneItems)
+{
+    return changedItems >= kMinFrozenItems
+           && qint64(changedItems) * kMaxChangedFraction >= sceneItems;
+}
+
+bool SceneIndexGuard::isEnabled()
+{
+    static const bool enabled = !qEnvironmentVariableIsSet("DSAT_NO_INDEX_FREEZE");
+    return enabled;
+}
+
+bool SceneIndexGuard::isTimingEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIsSet("DSAT_SCENE_INDEX_TIMING");
+    return enabled;
+}
@@ -0,0 +1,52 @@
+#ifndef SCENE_INDEX_GUARD_H
+#define SCENE_INDEX_GUARD_H
+
+#include <QGraphicsScene>
+#include <QPointer>
+
+// Снимает BSP-индекс сцены на время массовых изменений (перестройка,
+// сдвиг большинства узлов, кадры анимации) и строит его заново один раз
+// в деструкторе. Иначе каждый addItem/removeItem/setPos правит индекс
+// по отдельности.
+//
+// Переиндексация стоит O(всех элементов), а правка по месту - O(измененных),
+// поэтому индекс снимается, только если пачка трогает не меньше
+// kMinFrozenItems элементов и не меньше 1/kMaxChangedFraction сцены.
+// Вставка одного узла в большое дерево идет по живому индексу.
+//
+// Охранники одной сцены могут вкладываться и закрываться в любом порядке
+// (охранник анимации живет между кадрами): решение о снятии индекса,
+// время и подпись - от первого открытого, индекс восстанавливает последний
+// закрытый. Глубина BSP задается явно по числу элементов (bspDepthFor).
+//
+// Для замеров «до/после»: DSAT_SCENE_INDEX_TIMING включает лог времени
+// пачек с подписью (label), DSAT_NO_INDEX_FREEZE запрещает снимать индекс.
+class SceneIndexGuard
+{
+public:
+    // changedItems - сколько элементов пачка добавит, удалит или сдвинет,
+    // sceneItems - сколько их на сцене всего; достаточно оценок
+    SceneIndexGuard(QGraphicsScene* scene, int changedItems, int sceneItems,
+                    const char* label = nullptr);
+    ~SceneIndexGuard();
+
+    // Около kItemsPerLeaf элементов на лист
+    static int bspDepthFor(int itemCount);
+    static bool shouldFreeze(int changedItems, int sceneItems);
+    static bool isEnabled();
+    static bool isTimingEnabled();
+
+private:
+    static constexpr int kMinFrozenItems = 2048;
+    static constexpr int kMaxChangedFraction = 2;
+    static constexpr int kItemsPerLeaf = 8;
+    static constexpr int kMinBspDepth = 4;
+    static constexpr int kMaxBspDepth = 16;
+
+    QPointer<QGraphicsScene> m_scene;
+    const QGraphicsScene* m_sceneKey;   // Ключ состояния сцены, даже если ее удалили
+
+    Q_DISABLE_COPY(SceneIndexGuard)
+};
+
+#endif // SCENE_INDEX_GUARD_H
@@ -0,0 +1,108 @@
+#include "visual_update_scheduler.h"
+
+#include <QElapsedTimer>
+
+namespace
+{
+// Как часто смотреть на часы при применении состояний узлов
+constexpr int kBudgetCheckEvery = 256;
+}
+
+VisualUpdateScheduler::VisualUpdateScheduler(QObject* parent)
+    : QObject(parent)
+{
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    m_frameTimer.setInterval(kDefaultFrameIntervalMs);
+    connect(&m_frameTimer, &QTimer::timeout, this, &VisualUpdateScheduler::onFrame);
+}
+
+void VisualUpdateScheduler::setHandlers(const StructureHandler& structureHandler, const NodeHandler& nodeHandler)
+{
+    m_structureHandler = structureHandler;
+    m_nodeHandler = nodeHandler;
+}
+
+void VisualUpdateScheduler::setFrameInterval(int milliseconds)
+{
+    m_frameTimer.setInterval(qMax(1, milliseconds));
+}
+
+void VisualUpdateScheduler::scheduleFrame()
+{
+    if (!m_frameTimer.isActive()) {
+        m_frameTimer.start();
+    }
+}
+
+void VisualUpdateScheduler::setNodeFlag(const void* node, NodeFlag flag, bool on)
+{
+    if (!node) return;
+
+    NodeUpdate& update = m_pendingNodes[node];
+    if (update.mask & flag) {
+        ++m_coalesced;
+    }
+
+    update.mask |= flag;
+    update.values = quint8(on ? (update.values | flag) : (update.values & ~flag));
+    scheduleFrame();
+}
+
+void VisualUpdateScheduler::markStructureChanged()
+{
+    if (m_structureDirty) {
+        ++m_coalesced;
+    }
+
+    m_structureDirty = true;
+    scheduleFrame();
+}
+
+void VisualUpdateScheduler::applyPending(qint64 budgetMs)
+{
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    // Сначала структура: состояния узлов применяются уже к новым элементам
+    if (m_structureDirty) {
+        m_structureDirty = false;
+        if (m_structureHandler) {
+            m_structureHandler();
+        }
+    }
+
+    int applied = 0;
+    auto it = m_pendingNodes.begin();
+    while (it != m_pendingNodes.end()) {
+        if (m_nodeHandler) {
+            m_nodeHandler(it.key(), it.value());
+        }
+        it = m_pendingNodes.erase(it);
+
+        if (budgetMs >= 0 && ++applied % kBudgetCheckEvery == 0 && elapsed.elapsed() >= budgetMs) {
+            break;
+        }
+    }
+}
+
+void VisualUpdateScheduler::onFrame()
+{
+    applyPending(m_frameBudgetMs);
+
+    if (!hasPendingUpdates()) {
+        m_frameTimer.stop();
+    }
+}
+
+void VisualUpdateScheduler::flush()
+{
+    applyPending(-1);
+    m_frameTimer.stop();
+}
+
+void VisualUpdateScheduler::clear()
+{
+    m_pendingNodes.clear();
+    m_structureDirty = false;
+    m_frameTimer.stop();
+}
@@ -0,0 +1,83 @@
+#ifndef VISUAL_UPDATE_SCHEDULER_H
+#define VISUAL_UPDATE_SCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QHash>
+#include <QVector>
+
+#include <functional>
+
+// Копит визуальные события (состояния узлов, изменения структуры) и применяет
+// их пачкой раз в кадр. Если узел успел поменять состояние несколько раз
+// между кадрами, на экран попадает только последнее - промежуточные все равно
+// никто бы не увидел. Применение ограничено бюджетом кадра: что не успели,
+// доделывается в следующем тике.
+// Пока событий нет, таймер стоит и ничего не тратит.
+class VisualUpdateScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum NodeFlag : quint8
+    {
+        Highlighted = 0x1,
+        Visited = 0x2,
+        Current = 0x4,
+        Compared = 0x8
+    };
+
+    // mask - какие флаги менялись, values - их последние значения
+    struct NodeUpdate
+    {
+        quint8 mask = 0;
+        quint8 values = 0;
+
+        bool has(NodeFlag flag) const { return mask & flag; }
+        bool value(NodeFlag flag) const { return values & flag; }
+    };
+
+    using StructureHandler = std::function<void()>;
+    using NodeHandler = std::function<void(const void* node, const NodeUpdate& update)>;
+
+    static constexpr int kDefaultFrameIntervalMs = 16;
+    static constexpr int kDefaultFrameBudgetMs = 8;
+
+    explicit VisualUpdateScheduler(QObject* parent = nullptr);
+
+    void setHandlers(const StructureHandler& structureHandler, const NodeHandler& nodeHandler);
+    void setFrameInterval(int milliseconds);
+    void setFrameBudget(int milliseconds) { m_frameBudgetMs = qMax(1, milliseconds); }
+
+    void setNodeFlag(const void* node, NodeFlag flag, bool on);
+    void markStructureChanged();
+    // Узел удален: его накопленное состояние больше некуда применять
+    void forgetNode(const void* node) { m_pendingNodes.remove(node); }
+
+    // Применить все накопленное прямо сейчас, без бюджета
+    void flush();
+    // Выбросить накопленное (например, при очистке структуры)
+    void clear();
+
+    bool hasPendingUpdates() const { return m_structureDirty || !m_pendingNodes.isEmpty(); }
+    // Сколько событий было поглощено более поздними за все время
+    quint64 coalescedCount() const { return m_coalesced; }
+
+private slots:
+    void onFrame();
+
+private:
+    void scheduleFrame();
+    void applyPending(qint64 budgetMs);
+
+    StructureHandler m_structureHandler;
+    NodeHandler m_nodeHandler;
+    QTimer m_frameTimer;
+
+    QHash<const void*, NodeUpdate> m_pendingNodes;
+    bool m_structureDirty = false;
+    int m_frameBudgetMs = kDefaultFrameBudgetMs;
+    quint64 m_coalesced = 0;
+};
+
+#endif // VISUAL_UPDATE_SCHEDULER_H
@@ -1,15 +1,25 @@
 #include "visualizer_base.h"
+#include "minimap_widget.h"
+#include "perf_hud_widget.h"
+#include "../../../../core/utils/memory_report.h"
 #include <QVBoxLayout>
 #include <QScrollBar>
+#include <QPainter>
 
 VisualizerBase::VisualizerBase(QWidget* parent)
     : QWidget(parent)
     , m_view(new QGraphicsView(this))
     , m_scene(new QGraphicsScene(this))
+    , m_updateScheduler(new VisualUpdateScheduler(this))
+    , m_stepper(new AlgorithmStepper(this))
 {
     setupView();
     setupScene();
 
+    m_updateScheduler->setHandlers(
+        [this]() { applyStructureUpdate(); },
+        [this](const void* node, const VisualUpdateScheduler::NodeUpdate& update) { applyNodeUpdate(node, update); });
+
     QVBoxLayout* layout = new QVBoxLayout(this);
     layout->setContentsMargins(0, 0, 0, 0);
     layout->addWidget(m_view);
@@ -20,6 +30,17 @@ VisualizerBase::~VisualizerBase()
 {
 }
 
+void VisualizerBase::applyStructureUpdate()
+{
+    updateVisualization();
+}
+
+void VisualizerBase::applyNodeUpdate(const void* node, const VisualUpdateScheduler::NodeUpdate& update)
+{
+    Q_UNUSED(node);
+    Q_UNUSED(update);
+}
+
 void VisualizerBase::setupView()
 {
     m_view->setScene(m_scene);
@@ -73,6 +94,96 @@ void VisualizerBase::setAnimationDuration(int ms)
     m_animationDuration = qMax(0, ms);
 }
 
+void VisualizerBase::setMinimapVisible(bool visible)
+{
+    if (visible && !m_minimap) {
+        m_minimap = new MinimapWidget(this, m_view);
+        updateMinimapBounds();
+    }
+
+    if (m_minimap) {
+        m_minimap->setVisible(visible);
+    }
+}
+
+bool VisualizerBase::isMinimapVisible() const
+{
+    return m_minimap && m_minimap->isVisible();
+}
+
+bool VisualizerBase::isPerfHudAvailable()
+{
+#ifdef DSAT_ENABLE_PERF_HUD
+    return true;
+#else
+    return false;
+#endif
+}
+
+void VisualizerBase::setPerfHudVisible(bool visible)
+{
+#ifdef DSAT_ENABLE_PERF_HUD
+    if (visible && !m_perfHud) {
+        m_perfHud = new PerfHudWidget(m_view, &m_perfSections);
+    }
+
+    if (m_perfHud) {
+        m_perfHud->setVisible(visible);
+    }
+#else
+    Q_UNUSED(visible);
+#endif
+}
+
+bool VisualizerBase::isPerfHudVisible() const
+{
+#ifdef DSAT_ENABLE_PERF_HUD
+    return m_perfHud && m_perfHud->isVisible();
+#else
+    return false;
+#endif
+}
+
+void VisualizerBase::appendMemoryUsage(MemoryReport& report) const
+{
+    // Сцена держит элемент в общем списке и в листьях BSP-индекса
+    // (крупный элемент - в нескольких листьях); считаем по три указателя
+    const qint64 items = m_scene->items().size();
+    report.add("graphics", "Scene lists and index", items,
+               items * qint64(3 * sizeof(void*)), true);
+}
+
+void VisualizerBase::renderOverview(QPainter* painter, const QRectF& sceneRegion)
+{
+    m_scene->render(painter, sceneRegion, sceneRegion);
+}
+
+QRectF VisualizerBase::overviewRect() const
+{
+    return m_scene->sceneRect();
+}
+
+void VisualizerBase::updateMinimapBounds()
+{
+    if (m_minimap) {
+        m_minimap->setOverviewRect(overviewRect());
+    }
+}
+
+void VisualizerBase::invalidateMinimap(const QRectF& sceneRegion)
+{
+    if (m_minimap) {
+        m_minimap->invalidate(sceneRegion);
+    }
+}
+
+void VisualizerBase::invalidateMinimap()
+{
+    if (m_minimap) {
+        m_minimap->invalidateAll();
+    }
+}
+
 void VisualizerBase::wheelEvent(QWheelEvent* event)
 {
     // Простой зум без привязки к Ctrl
@@ -92,6 +203,9 @@ void VisualizerBase::wheelEvent(QWheelEvent* event)
 
     m_zoomFactor = newZoom;
     m_view->scale(zoomFactor, zoomFactor);
+    if (m_minimap) {
+        m_minimap->update();
+    }
     event->accept();
 }
 
@@ -6,6 +6,15 @@
 #include <QGraphicsScene>
 #include <QPointer>
 #include <QMouseEvent>
+#include <QPainter>
+
+#include "visual_update_scheduler.h"
+#include "algorithm_stepper.h"
+#include "perf_timer.h"
+
+class MinimapWidget;
+class PerfHudWidget;
+class MemoryReport;
 
 class VisualizerBase : public QWidget
 {
@@ -25,9 +34,33 @@ public:
     void setAnimationDuration(int ms);
 
     bool isAnimationRunning() const { return false; };        // MUST BE OVERRIDED IN INHERITES
+
+    // Миникарта в углу вида (создается при первом включении)
+    void setMinimapVisible(bool visible);
+    bool isMinimapVisible() const;
+
+    // Оверлей с FPS, временем кадра и секций раскладки.
+    // Есть только в сборке с DSAT_ENABLE_PERF_HUD, иначе вызовы ничего не делают.
+    static bool isPerfHudAvailable();
+    void setPerfHudVisible(bool visible);
+    bool isPerfHudVisible() const;
+
+    // Рисует обзор структуры для миникарты в координатах сцены.
+    // Базовая версия рендерит сцену целиком - наследникам стоит
+    // рисовать упрощенную картинку прямо по своей раскладке.
+    virtual void renderOverview(QPainter* painter, const QRectF& sceneRegion);
+    // Память визуализации в группу "graphics". Базовая версия учитывает
+    // только списки и индекс сцены; наследники добавляют свои элементы и карты.
+    virtual void appendMemoryUsage(MemoryReport& report) const;
+
     QGraphicsScene* scene() const { return m_scene; }
     QGraphicsView* view() const { return m_view; }
 
+    // Покадровая очередь визуальных обновлений
+    VisualUpdateScheduler* updateScheduler() const { return m_updateScheduler; }
+    // Проигрыватель пошаговых операций структуры
+    AlgorithmStepper* algorithmStepper() const { return m_stepper; }
+
 signals:
     void visualizationReady();
     void animationStarted();
@@ -46,10 +79,31 @@ protected:
     const qreal MAX_ZOOM = 10.0;
     const qreal ZOOM_STEP = 0.001;
 
+    QPointer<MinimapWidget> m_minimap;
+    VisualUpdateScheduler* m_updateScheduler = nullptr;
+    AlgorithmStepper* m_stepper = nullptr;
+
+#ifdef DSAT_ENABLE_PERF_HUD
+    // Заполняется через DSAT_PERF_SCOPE(m_perfSections, "...") и в const-методах
+    mutable PerfSections m_perfSections;
+    QPointer<PerfHudWidget> m_perfHud;
+#endif
+
     //Scene&view setup
     virtual void setupScene();
     virtual void setupView();
 
+    // Область сцены, которую охватывает миникарта
+    virtual QRectF overviewRect() const;
+    void updateMinimapBounds();
+    void invalidateMinimap(const QRectF& sceneRegion);
+    void invalidateMinimap();
+
+    // Вызываются планировщиком раз в кадр. По умолчанию изменение
+    // структуры - полная перерисовка, состояния узлов игнорируются.
+    virtual void applyStructureUpdate();
+    virtual void applyNodeUpdate(const void* node, const VisualUpdateScheduler::NodeUpdate& update);
+
     void wheelEvent(QWheelEvent* event) override;
     void mousePressEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
@@ -1,4 +1,95 @@
 #include "binary_tree_visualization.h"
+#include "base/minimap_widget.h"
+#include "base/scene_index_guard.h"
+#include "../../../core/utils/memory_report.h"
+
+#include <QApplication>
+#include <QGraphicsSimpleTextItem>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+// Не больше стольких полос в гистограмме уровней сводки
+constexpr int kSummaryMaxBars = 48;
+
+struct TreeShape
+{
+    qint64 nodes = 0;
+    qint64 leaves = 0;
+    qint64 maxDepth = 0;
+    double averageDepth = 0.0;
+    QVector<qint64> levelCounts;    // Узлов в каждой полосе из levelsPerBar уровней
+    qint64 levelsPerBar = 1;
+};
+
+// Обход без рекурсии (дерево может быть цепочкой в миллионы узлов).
+// Глубина заранее неизвестна: когда полос не хватает, соседние
+// сливаются попарно и каждая полоса охватывает вдвое больше уровней.
+TreeShape measureTreeShape(TreeNode* root, int maxBars)
+{
+    TreeShape shape;
+    double depthSum = 0.0;
+
+    std::vector<std::pair<TreeNode*, qint64>> stack;
+    if (root)
+    {
+        stack.push_back({root, 0});
+    }
+
+    while (!stack.empty())
+    {
+        const auto [node, depth] = stack.back();
+        stack.pop_back();
+
+        ++shape.nodes;
+        depthSum += double(depth);
+        shape.maxDepth = qMax(shape.maxDepth, depth);
+        if (node->isLeaf())
+        {
+            ++shape.leaves;
+        }
+
+        while (depth / shape.levelsPerBar >= maxBars)
+        {
+            QVector<qint64> merged((shape.levelCounts.size() + 1) / 2, 0);
+            for (int i = 0; i < shape.levelCounts.size(); ++i)
+            {
+                merged[i / 2] += shape.levelCounts[i];
+            }
+            shape.levelCounts.swap(merged);
+            shape.levelsPerBar *= 2;
+        }
+
+        const int bar = int(depth / shape.levelsPerBar);
+        if (bar >= shape.levelCounts.size())
+        {
+            shape.levelCounts.resize(bar + 1, 0);
+        }
+        ++shape.levelCounts[bar];
+
+        if (node->right()) stack.push_back({node->right(), depth + 1});
+        if (node->left()) stack.push_back({node->left(), depth + 1});
+    }
+
+    if (shape.nodes > 0)
+    {
+        shape.averageDepth = depthSum / double(shape.nodes);
+    }
+    return shape;
+}
+
+// Qt 6 QMap - обертка над std::map: узел красно-черного дерева
+// (цвет и три указателя) плюс пара ключ-значение, каждый отдельным malloc
+template <typename Map>
+qint64 estimateMapBytes(const Map& map)
+{
+    const std::size_t node = 4 * sizeof(void*) + sizeof(typename Map::key_type) + sizeof(typename Map::mapped_type);
+    return map.size() * MemoryReport::estimateAllocation(node);
+}
+}
 
 BinaryTreeVisualization::BinaryTreeVisualization(QWidget* parent)
     : VisualizerBase(parent)
@@ -7,10 +98,19 @@ BinaryTreeVisualization::BinaryTreeVisualization(QWidget* parent)
 
     // Настройка фона сцены
     m_scene->setBackgroundBrush(QBrush(QColor(80, 80, 80)));
+
+    m_detailTimer = new QTimer(this);
+    m_detailTimer->setSingleShot(true);
+    m_detailTimer->setInterval(kDetailUpdateDelayMs);
+    connect(m_detailTimer, &QTimer::timeout, this, &BinaryTreeVisualization::updateLevelOfDetail);
+
+    // Колесо и щелчки по узлам ловим до того, как их разберет вид
+    m_view->viewport()->installEventFilter(this);
 }
 
 BinaryTreeVisualization::~BinaryTreeVisualization()
 {
+    stopRotationAnimation();
     clearAllGraphics();
 }
 
@@ -24,8 +124,16 @@ void BinaryTreeVisualization::setStructure(QObject* structure)
 
 void BinaryTreeVisualization::clear()
 {
+    cancelSteps();
+    resetPendingStates();
+    stopRotationAnimation();
     clearAllGraphics();
+    resetLayoutCache();
     m_tree = nullptr;
+    m_aggregates.clear();
+    m_aggregatesValid = false;
+    m_collapsed.clear();
+    m_expanded.clear();
     m_scene->clear();
 }
 
@@ -33,9 +141,18 @@ void BinaryTreeVisualization::updateVisualization()
 {
     if (!m_tree) return;
 
+    // Явный запрос перерисовки приходит и после изменений с заблокированными
+    // сигналами (режим сравнения) - агрегатам доверять нельзя
+    m_aggregatesValid = false;
+
+    if (showSummaryIfTooLarge())
+    {
+        emit visualizationUpdated();
+        return;
+    }
+
     rebuildVisualization();
-    updateNodePositions();
-    updateEdges();
+    updateLayout();
     fitTreeToView();
 
     emit visualizationUpdated();
@@ -48,20 +165,46 @@ void BinaryTreeVisualization::setTree(BinaryTree* tree)
     if (m_tree)
     {
         disconnect(m_tree, nullptr, this, nullptr);
+        disconnect(m_tree, nullptr, m_updateScheduler, nullptr);
+        m_tree->setVisitCounting(false);
     }
 
+    cancelSteps();
+    resetPendingStates();
+    stopRotationAnimation();
     m_tree = tree;
+    resetLayoutCache();
+    m_heat.clear();
+    m_aggregates.clear();
+    m_aggregatesValid = false;
+    m_collapsed.clear();
+    m_expanded.clear();
 
     if (m_tree)
     {
+        m_tree->setVisitCounting(m_heatmapEnabled);
+
         connect(m_tree, &BinaryTree::nodeInserted,
                 this, &BinaryTreeVisualization::onNodeInserted);
         connect(m_tree, &BinaryTree::nodeRemoved,
                 this, &BinaryTreeVisualization::onNodeRemoved);
+        // Перестройка раскладки - не чаще раза в кадр
+        connect(m_tree, &BinaryTree::structureChanged,
+                m_updateScheduler, &VisualUpdateScheduler::markStructureChanged);
         connect(m_tree, &BinaryTree::structureChanged,
-                this, &BinaryTreeVisualization::onStructureChanged);
+                this, &BinaryTreeVisualization::onTreeModified);
         connect(m_tree, &BinaryTree::treeCleared,
                 this, &BinaryTreeVisualization::onTreeCleared);
+        connect(m_tree, &BinaryTree::nodeRotated,
+                this, &BinaryTreeVisualization::onNodeRotated);
+        connect(m_tree, &BinaryTree::nodeHighlighted,
+                this, &BinaryTreeVisualization::onNodeHighlighted);
+        connect(m_tree, &BinaryTree::nodeVisited,
+                this, &BinaryTreeVisualization::onNodeVisited);
+        connect(m_tree, &BinaryTree::nodeCurrent,
+                this, &BinaryTreeVisualization::onNodeCurrent);
+        connect(m_tree, &BinaryTree::comparisonMade,
+                this, &BinaryTreeVisualization::onComparisonMade);
 
         updateVisualization();
     }
@@ -92,6 +235,7 @@ void BinaryTreeVisualization::clearHighlights()
         gNode->setBaseColor(QColor(70, 130, 200));
         gNode->setBorderColor(QColor(30, 60, 100));
     }
+    m_cacheMarked.clear();
 
     for (auto it = m_edgeMap.begin(); it != m_edgeMap.end(); ++it)
     {
@@ -127,11 +271,138 @@ void BinaryTreeVisualization::markNodeAsCurrent(TreeNode* node)
     }
 }
 
+void BinaryTreeVisualization::setHeatmapEnabled(bool enabled)
+{
+    if (m_heatmapEnabled == enabled) return;
+
+    m_heatmapEnabled = enabled;
+    m_heat.clear();
+
+    if (m_tree)
+    {
+        m_tree->setVisitCounting(enabled);
+    }
+
+    if (!m_heatmapTimer)
+    {
+        m_heatmapTimer = new QTimer(this);
+        m_heatmapTimer->setInterval(kHeatmapIntervalMs);
+        connect(m_heatmapTimer, &QTimer::timeout, this, &BinaryTreeVisualization::updateHeatmap);
+    }
+
+    if (enabled)
+    {
+        m_heatmapTimer->start();
+    }
+    else
+    {
+        m_heatmapTimer->stop();
+        resetNodeColors();
+    }
+}
+
+void BinaryTreeVisualization::updateHeatmap()
+{
+    if (!m_tree) return;
+
+    // Вес старого тепла за один тик: за окно оно затухает в e раз
+    const double decay = std::exp(-double(kHeatmapIntervalMs) / m_heatmapWindowMs);
+
+    // Заново собираем по текущим узлам - записи удаленных узлов отпадают сами
+    QHash<TreeNode*, HeatEntry> next;
+    next.reserve(m_nodeMap.size());
+    double maxHeat = 0.0;
+
+    for (auto it = m_nodeMap.cbegin(); it != m_nodeMap.cend(); ++it)
+    {
+        TreeNode* node = it.key();
+        const quint32 visits = node->visitCount();
+
+        auto previous = m_heat.constFind(node);
+        HeatEntry entry;
+        if (previous != m_heat.cend())
+        {
+            entry = previous.value();
+            entry.heat = entry.heat * decay + double(visits - entry.lastVisits);
+        }
+        entry.lastVisits = visits;
+
+        maxHeat = qMax(maxHeat, entry.heat);
+        next.insert(node, entry);
+    }
+
+    m_heat.swap(next);
+
+    // Логарифмическая шкала: иначе корень забивает все остальные узлы
+    const double scale = maxHeat > 0.0 ? 1.0 / std::log1p(maxHeat) : 0.0;
+    for (auto it = m_nodeMap.cbegin(); it != m_nodeMap.cend(); ++it)
+    {
+        const double t = std::log1p(m_heat.value(it.key()).heat) * scale;
+        // От синего (холодный) к красному (горячий) по оттенку
+        it.value()->setBaseColor(QColor::fromHsvF(0.6 * (1.0 - t), 0.75, 0.85));
+    }
+}
+
+void BinaryTreeVisualization::markCacheMisses(const QHash<const TreeNode*, CacheSimulator::ServedBy>& misses)
+{
+    clearCacheMarks();
+
+    for (auto it = misses.cbegin(); it != misses.cend(); ++it)
+    {
+        TreeNode* node = const_cast<TreeNode*>(it.key());
+        GraphicsNode* gNode = findGraphicsNode(node);
+        if (!gNode) continue;
+
+        switch (it.value())
+        {
+        case CacheSimulator::ServedBy::L1:
+            continue;
+        case CacheSimulator::ServedBy::L2:
+            gNode->setBorderColor(QColor(240, 220, 60));
+            break;
+        case CacheSimulator::ServedBy::LLC:
+            gNode->setBorderColor(QColor(255, 150, 40));
+            break;
+        case CacheSimulator::ServedBy::Memory:
+            gNode->setBorderColor(QColor(230, 40, 40));
+            break;
+        }
+        m_cacheMarked.append(node);
+    }
+}
+
+void BinaryTreeVisualization::clearCacheMarks()
+{
+    for (TreeNode* node : m_cacheMarked)
+    {
+        if (GraphicsNode* gNode = findGraphicsNode(node))
+        {
+            gNode->setBorderColor(QColor(30, 60, 100));
+        }
+    }
+    m_cacheMarked.clear();
+}
+
+void BinaryTreeVisualization::resetNodeColors()
+{
+    for (GraphicsNode* gNode : m_nodeMap)
+    {
+        gNode->setBaseColor(QColor(70, 130, 200));
+    }
+}
+
 void BinaryTreeVisualization::setNodeSpacing(qreal horizontal, qreal vertical)
 {
     m_horizontalSpacing = horizontal;
     m_verticalSpacing = vertical;
-    updateNodePositions();
+
+    // Размеры треугольников и сама детализация зависят от шага раскладки
+    if (!m_glyphMap.isEmpty())
+    {
+        rebuildItems();
+        return;
+    }
+    updateLayout();
 }
 
 void BinaryTreeVisualization::setNodeRadius(qreal radius)
@@ -153,6 +424,81 @@ void BinaryTreeVisualization::setShowValues(bool show)
     }
 }
 
+void BinaryTreeVisualization::runSteps(TreeTask task)
+{
+    if (!m_tree || !task.isValid()) return;
+
+    clearHighlights();
+
+    // std::function копируется, а задача - нет
+    auto shared = std::make_shared<TreeTask>(std::move(task));
+    m_stepper->start([this, shared]()
+    {
+        if (!shared->resume())
+        {
+            return false;
+        }
+
+        applyStep(shared->step());
+        return true;
+    });
+}
+
+void BinaryTreeVisualization::cancelSteps()
+{
+    m_stepper->cancel();
+}
+
+void BinaryTreeVisualization::applyStep(const TreeStep& step)
+{
+    // Шаги идут через планировщик, как сигналы обычных операций:
+    // при многих шагах за кадр на экран попадает только последнее состояние
+    switch (step.kind)
+    {
+    case TreeStep::Kind::Compare:
+        onNodeCurrent(step.node);
+        onComparisonMade(step.node, nullptr);
+        break;
+    case TreeStep::Kind::Visit:
+        onNodeVisited(step.node);
+        onNodeCurrent(step.node);
+        break;
+    case TreeStep::Kind::Found:
+    case TreeStep::Kind::Inserted:
+        onNodeHighlighted(step.node, true);
+        break;
+    case TreeStep::Kind::NotFound:
+        if (step.node)
+        {
+            onNodeVisited(step.node);
+        }
+        break;
+    case TreeStep::Kind::Rotated:
+        onNodeCurrent(step.node);
+        break;
+    }
+}
+
+void BinaryTreeVisualization::onTreeModified()
+{
+    // Изменение без nodeInserted/nodeRemoved/nodeRotated (построение
+    // пачкой, обмен значений) - агрегаты пересчитаем целиком
+    if (m_aggregatesPatched)
+    {
+        m_aggregatesPatched = false;
+    }
+    else
+    {
+        m_aggregatesValid = false;
+    }
+
+    // Свои изменения пошаговая операция делает внутри шага
+    if (m_stepper->isRunning() && !m_stepper->isInsideStep())
+    {
+        m_stepper->cancel();
+    }
+}
+
 void BinaryTreeVisualization::startOperation(const QString& name)
 {
     Q_UNUSED(name);
@@ -163,10 +509,81 @@ void BinaryTreeVisualization::finishOperation(const QString& name)
     Q_UNUSED(name);
 }
 
+TreeLayoutSnapshot BinaryTreeVisualization::layoutSnapshot() const
+{
+    TreeLayoutSnapshot snapshot;
+    snapshot.nodeRadius = m_nodeRadius;
+
+    if (!m_tree || !m_tree->root())
+    {
+        return snapshot;
+    }
+
+    const QMap<TreeNode*, QPointF> positions = calculateNodePositions();
+    snapshot.nodes.reserve(positions.size());
+
+    // Обход в прямом порядке без рекурсии: родитель всегда попадает в снимок раньше детей
+    QVector<QPair<TreeNode*, int>> stack;
+    stack.append({m_tree->root(), -1});
+
+    while (!stack.isEmpty())
+    {
+        const QPair<TreeNode*, int> entry = stack.takeLast();
+        TreeNode* node = entry.first;
+
+        TreeLayoutSnapshot::Node item;
+        item.pos = positions.value(node);
+        item.value = node->value();
+        item.parent = entry.second;
+        item.isLeftChild = node->parent() && node->parent()->left() == node;
+
+        const int index = snapshot.nodes.size();
+        snapshot.nodes.append(item);
+
+        if (node->right()) stack.append({node->right(), index});
+        if (node->left()) stack.append({node->left(), index});
+    }
+
+    return snapshot;
+}
+
+bool BinaryTreeVisualization::exportToPngTiles(const QString& basePath,
+                                               const TreeImageExporter::Options& options,
+                                               const TreeImageExporter::ProgressCallback& progress) const
+{
+    const TreeLayoutSnapshot snapshot = layoutSnapshot();
+    TreeImageExporter exporter(snapshot, options);
+    return exporter.exportPngTiles(basePath, progress);
+}
+
+bool BinaryTreeVisualization::exportToSvg(const QString& path,
+                                          const TreeImageExporter::Options& options) const
+{
+    const TreeLayoutSnapshot snapshot = layoutSnapshot();
+    TreeImageExporter exporter(snapshot, options);
+    return exporter.exportSvg(path);
+}
+
 void BinaryTreeVisualization::onNodeInserted(TreeNode* node)
 {
     if (!node) return;
 
+    patchAggregates(node);
+
+    // Узел мог попасть внутрь свернутого поддерева - пусть решает перестройка
+    if (isTooLargeToDraw() || !m_glyphMap.isEmpty())
+    {
+        m_updateScheduler->markStructureChanged();
+        return;
+    }
+
+    // Прерванная анимация оставила промежуточные ребра - перестраиваем целиком
+    if (stopRotationAnimation())
+    {
+        m_updateScheduler->markStructureChanged();
+        return;
+    }
+
     GraphicsNode* gNode = createGraphicsNode(node);
     m_scene->addItem(gNode);
 
@@ -175,54 +592,407 @@ void BinaryTreeVisualization::onNodeInserted(TreeNode* node)
         createEdge(node->parent(), node);
     }
 
-    updateNodePositions();
-    updateEdges();
+    // Позиции пересчитаются один раз за кадр, а не на каждую вставку
+    m_updateScheduler->markStructureChanged();
 }
 
 void BinaryTreeVisualization::onNodeRemoved(TreeNode* node)
 {
     if (!node) return;
 
-    removeGraphicsNode(node);
+    forgetPendingState(node);
+    m_collapsed.remove(node);
+    m_expanded.remove(node);
+
+    // Сигнал идет уже после отцепления, но ссылка на бывшего родителя еще цела
+    m_aggregates.remove(node);
+    patchAggregates(node->parent());
+
+    // Прерванная анимация оставила промежуточные ребра - перестраиваем целиком
+    if (stopRotationAnimation() || isSummaryMode())
+    {
+        m_updateScheduler->markStructureChanged();
+        return;
+    }
+
+    removeGraphicsNode(node);
+    m_updateScheduler->markStructureChanged();
+}
+
+void BinaryTreeVisualization::onStructureChanged()
+{
+    if (showSummaryIfTooLarge())
+    {
+        return;
+    }
+
+    // Повороты уже записаны кадрами - проигрываем их вместо мгновенной перестройки
+    if (!m_keyframes.isEmpty())
+    {
+        if (!m_rotationAnimation || m_rotationAnimation->state() != QAbstractAnimation::Running)
+        {
+            playNextKeyframe();
+        }
+        return;
+    }
+
+    rebuildVisualization();
+    updateLayout();
+    fitTreeToView();
+}
+
+void BinaryTreeVisualization::onTreeCleared()
+{
+    resetPendingStates();
+    stopRotationAnimation();
+    clearAllGraphics();
+    resetLayoutCache();
+    m_aggregates.clear();
+    m_aggregatesValid = false;
+    m_collapsed.clear();
+    m_expanded.clear();
+    m_scene->clear();
+}
+
+void BinaryTreeVisualization::onNodeHighlighted(TreeNode* node, bool highlighted)
+{
+    m_updateScheduler->setNodeFlag(node, VisualUpdateScheduler::Highlighted, highlighted);
+}
+
+void BinaryTreeVisualization::onNodeVisited(TreeNode* node)
+{
+    m_updateScheduler->setNodeFlag(node, VisualUpdateScheduler::Visited, true);
+}
+
+void BinaryTreeVisualization::onNodeCurrent(TreeNode* node)
+{
+    // Текущий узел один: предыдущий гасим в том же кадре
+    if (m_currentNode && m_currentNode != node)
+    {
+        m_updateScheduler->setNodeFlag(m_currentNode, VisualUpdateScheduler::Current, false);
+    }
+
+    m_currentNode = node;
+    m_updateScheduler->setNodeFlag(node, VisualUpdateScheduler::Current, true);
+}
+
+void BinaryTreeVisualization::onComparisonMade(TreeNode* node1, TreeNode* node2)
+{
+    // Во время спуска сравнения идут пачкой - на экран попадает только последнее
+    for (TreeNode* previous : {m_comparedNodes.first, m_comparedNodes.second})
+    {
+        if (previous && previous != node1 && previous != node2)
+        {
+            m_updateScheduler->setNodeFlag(previous, VisualUpdateScheduler::Compared, false);
+        }
+    }
+
+    m_comparedNodes = qMakePair(node1, node2);
+    m_updateScheduler->setNodeFlag(node1, VisualUpdateScheduler::Compared, true);
+    m_updateScheduler->setNodeFlag(node2, VisualUpdateScheduler::Compared, true);
+}
+
+void BinaryTreeVisualization::applyStructureUpdate()
+{
+    onStructureChanged();
+}
+
+void BinaryTreeVisualization::applyNodeUpdate(const void* node, const VisualUpdateScheduler::NodeUpdate& update)
+{
+    GraphicsNode* gNode = findGraphicsNode(static_cast<TreeNode*>(const_cast<void*>(node)));
+    if (!gNode) return;
+
+    auto pick = [&update](VisualUpdateScheduler::NodeFlag flag, bool current)
+    {
+        return update.has(flag) ? update.value(flag) : current;
+    };
+
+    gNode->setStates(pick(VisualUpdateScheduler::Compared, gNode->selectedState()),
+                     pick(VisualUpdateScheduler::Highlighted, gNode->highlightedState()),
+                     pick(VisualUpdateScheduler::Visited, gNode->visitedState()),
+                     pick(VisualUpdateScheduler::Current, gNode->activeState()));
+}
+
+void BinaryTreeVisualization::forgetPendingState(TreeNode* node)
+{
+    m_updateScheduler->forgetNode(node);
+
+    if (m_currentNode == node)
+    {
+        m_currentNode = nullptr;
+    }
+    if (m_comparedNodes.first == node)
+    {
+        m_comparedNodes.first = nullptr;
+    }
+    if (m_comparedNodes.second == node)
+    {
+        m_comparedNodes.second = nullptr;
+    }
+}
+
+void BinaryTreeVisualization::resetPendingStates()
+{
+    m_updateScheduler->clear();
+    m_currentNode = nullptr;
+    m_comparedNodes = {};
+}
+
+void BinaryTreeVisualization::onNodeRotated(TreeNode* node, TreeNode* pivot)
+{
+    // node теперь ребенок pivot: сначала он, потом путь от pivot
+    if (m_aggregatesValid)
+    {
+        recomputeAggregate(node);
+    }
+    patchAggregates(pivot);
+
+    // Со свернутыми поддеревьями часть узлов не нарисована - без анимации
+    if (!m_animationEnabled || !m_tree || m_tree->size() > kMaxAnimatedNodes || !m_glyphMap.isEmpty()) return;
+
+    // Сигнал приходит уже после поворота, поэтому начальный кадр берем
+    // из того, что сейчас нарисовано
+    if (m_keyframes.isEmpty())
+    {
+        LayoutKeyframe current;
+        current.positions = m_positions;
+        current.edges = m_edgeMap.keys().toVector();
+        m_keyframes.append(current);
+    }
+
+    m_keyframes.append(captureKeyframe());
+}
+
+BinaryTreeVisualization::LayoutKeyframe BinaryTreeVisualization::captureKeyframe() const
+{
+    LayoutKeyframe keyframe;
+    keyframe.positions = calculateNodePositions();
+
+    for (auto it = keyframe.positions.cbegin(); it != keyframe.positions.cend(); ++it)
+    {
+        if (TreeNode* parent = it.key()->parent())
+        {
+            keyframe.edges.append(qMakePair(parent, it.key()));
+        }
+    }
+
+    return keyframe;
+}
+
+void BinaryTreeVisualization::playNextKeyframe()
+{
+    if (m_keyframes.size() < 2)
+    {
+        // Анимация закончилась: синхронизируем кэш раскладки и ребра с деревом
+        m_keyframes.clear();
+        m_animationIndexGuard.reset();
+        updateLayout();
+        emit animationFinished();
+        return;
+    }
+
+    // Каждый кадр двигает все переезжающие узлы и ребра: если их много,
+    // индекс сцены не нужен до конца анимации
+    if (!m_animationIndexGuard)
+    {
+        m_animationIndexGuard = std::make_unique<SceneIndexGuard>(
+            m_scene, movedItemCount(m_keyframes.last().positions), sceneItemCount());
+    }
+
+    if (!m_rotationAnimation)
+    {
+        m_rotationAnimation = new QVariantAnimation(this);
+        m_rotationAnimation->setStartValue(0.0);
+        m_rotationAnimation->setEndValue(1.0);
+        m_rotationAnimation->setEasingCurve(QEasingCurve::InOutQuad);
+
+        connect(m_rotationAnimation, &QVariantAnimation::valueChanged, this, [this](const QVariant& value)
+        {
+            if (m_keyframes.size() < 2) return;
+
+            const qreal t = value.toReal();
+            const LayoutKeyframe& from = m_keyframes[0];
+            const LayoutKeyframe& to = m_keyframes[1];
+
+            for (auto it = to.positions.cbegin(); it != to.positions.cend(); ++it)
+            {
+                if (GraphicsNode* gNode = m_nodeMap.value(it.key()))
+                {
+                    const QPointF start = from.positions.value(it.key(), it.value());
+                    gNode->setPos(start + (it.value() - start) * t);
+                }
+            }
+            updateEdges();
+        });
+
+        connect(m_rotationAnimation, &QVariantAnimation::finished, this, [this]()
+        {
+            if (!m_keyframes.isEmpty())
+            {
+                m_keyframes.removeFirst();
+            }
+            playNextKeyframe();
+        });
+    }
+
+    // Ребра сразу показываем в новой структуре, а узлы плавно переезжают
+    applyKeyframeEdges(m_keyframes[1]);
+
+    if (m_rotationAnimation->state() != QAbstractAnimation::Running)
+    {
+        emit animationStarted();
+    }
+    m_rotationAnimation->setDuration(m_animationDuration);
+    m_rotationAnimation->start();
+}
+
+bool BinaryTreeVisualization::stopRotationAnimation()
+{
+    if (m_keyframes.isEmpty()) return false;
+
+    // Очищаем очередь до stop(): обработчик finished не должен продолжать проигрывание
+    m_keyframes.clear();
+    if (m_rotationAnimation)
+    {
+        m_rotationAnimation->stop();
+    }
+    m_animationIndexGuard.reset();
+    return true;
+}
+
+void BinaryTreeVisualization::applyKeyframeEdges(const LayoutKeyframe& keyframe)
+{
+    SceneIndexGuard indexGuard(m_scene, int(m_edgeMap.size() + keyframe.edges.size()), sceneItemCount());
+
+    for (GraphicsEdge* edge : m_edgeMap)
+    {
+        m_scene->removeItem(edge);
+        delete edge;
+    }
+    m_edgeMap.clear();
+
+    for (const QPair<TreeNode*, TreeNode*>& link : keyframe.edges)
+    {
+        GraphicsNode* parentNode = findGraphicsNode(link.first);
+        GraphicsNode* childNode = findGraphicsNode(link.second);
+        if (!parentNode || !childNode) continue;
 
-    updateNodePositions();
-    updateEdges();
-}
+        GraphicsEdge* edge = new GraphicsEdge(parentNode, childNode);
+        m_scene->addItem(edge);
 
-void BinaryTreeVisualization::onStructureChanged()
-{
-    rebuildVisualization();
-    updateNodePositions();
-    updateEdges();
-    fitTreeToView();
-}
+        // Сторону ребра берем из раскладки кадра: дерево уже может быть в другом состоянии
+        const bool isLeft = keyframe.positions.value(link.second).x() < keyframe.positions.value(link.first).x();
+        edge->setColor(isLeft ? QColor(70, 130, 180) : QColor(60, 179, 113));
+        edge->setWidth(3);
 
-void BinaryTreeVisualization::onTreeCleared()
-{
-    clearAllGraphics();
-    m_scene->clear();
+        m_edgeMap[link] = edge;
+    }
 }
 
 void BinaryTreeVisualization::resetZoom()
 {
     m_view->resetTransform();
     fitTreeToView();
+    scheduleDetailUpdate();
 }
 
 void BinaryTreeVisualization::zoomIn()
 {
     m_view->scale(1.2, 1.2);
+    if (m_minimap) m_minimap->update();
+    scheduleDetailUpdate();
 }
 
 void BinaryTreeVisualization::zoomOut()
 {
     m_view->scale(0.8, 0.8);
+    if (m_minimap) m_minimap->update();
+    scheduleDetailUpdate();
+}
+
+void BinaryTreeVisualization::resetLayoutCache()
+{
+    m_positions.clear();
+    m_parentPositions.clear();
+    m_layoutBounds = QRectF();
+    updateMinimapBounds();
+    invalidateMinimap();
+}
+
+QRectF BinaryTreeVisualization::overviewRect() const
+{
+    return m_layoutBounds;
+}
+
+void BinaryTreeVisualization::renderOverview(QPainter* painter, const QRectF& sceneRegion)
+{
+    // Упрощенная картинка по раскладке: тонкие ребра и точки вместо узлов
+    const qreal r = m_nodeRadius;
+
+    painter->setRenderHint(QPainter::Antialiasing, false);
+    painter->setPen(QPen(QColor(120, 160, 200), 0));
+    for (auto it = m_parentPositions.cbegin(); it != m_parentPositions.cend(); ++it)
+    {
+        const QPointF& childPos = m_positions.value(it.key());
+        if (QRectF(it.value(), childPos).normalized().adjusted(-1, -1, 1, 1).intersects(sceneRegion))
+        {
+            painter->drawLine(it.value(), childPos);
+        }
+    }
+
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(QColor(70, 130, 200));
+    for (auto it = m_positions.cbegin(); it != m_positions.cend(); ++it)
+    {
+        const QRectF rect(it.value().x() - r, it.value().y() - r, 2 * r, 2 * r);
+        if (rect.intersects(sceneRegion))
+        {
+            painter->drawRect(rect);
+        }
+    }
+}
+
+void BinaryTreeVisualization::appendMemoryUsage(MemoryReport& report) const
+{
+    qint64 nodeBytes = 0;
+    qint64 labelBytes = 0;
+    for (const GraphicsNode* gNode : m_nodeMap) {
+        nodeBytes += gNode->memoryBytes();
+        labelBytes += gNode->labelMemoryBytes();
+    }
+
+    qint64 edgeBytes = 0;
+    for (const GraphicsEdge* edge : m_edgeMap) {
+        edgeBytes += edge->memoryBytes();
+    }
+
+    report.add("graphics", "GraphicsNode items", m_nodeMap.size(), nodeBytes);
+    report.add("graphics", "Node labels (QGraphicsTextItem)", m_nodeMap.size(), labelBytes, true);
+    report.add("graphics", "GraphicsEdge items", m_edgeMap.size(), edgeBytes);
+
+    qint64 glyphBytes = 0;
+    for (const GraphicsSubtreeGlyph* glyph : m_glyphMap) {
+        glyphBytes += glyph->memoryBytes();
+    }
+    report.add("graphics", "Collapsed subtree glyphs", m_glyphMap.size(), glyphBytes);
+
+    VisualizerBase::appendMemoryUsage(report);
+
+    report.add("maps", "Node map", m_nodeMap.size(), estimateMapBytes(m_nodeMap), true);
+    report.add("maps", "Edge map", m_edgeMap.size(), estimateMapBytes(m_edgeMap), true);
+    // QHash: узел цепочки с ключом и значением плюс слот в массиве корзин
+    report.add("maps", "Subtree aggregates", m_aggregates.size(),
+               m_aggregates.size() * (MemoryReport::estimateAllocation(sizeof(void*) + sizeof(TreeNode*) + sizeof(SubtreeAggregate))
+                                      + qint64(sizeof(void*))), true);
+    report.add("maps", "Layout cache", m_positions.size() + m_parentPositions.size(),
+               estimateMapBytes(m_positions) + estimateMapBytes(m_parentPositions), true);
 }
 
 void BinaryTreeVisualization::resizeEvent(QResizeEvent* event)
 {
     VisualizerBase::resizeEvent(event);
     fitTreeToView();
+    scheduleDetailUpdate();
 }
 
 GraphicsNode* BinaryTreeVisualization::createGraphicsNode(TreeNode* node)
@@ -306,6 +1076,8 @@ void BinaryTreeVisualization::removeEdge(TreeNode* parent, TreeNode* child)
 
 void BinaryTreeVisualization::clearAllGraphics()
 {
+    SceneIndexGuard indexGuard(m_scene, sceneItemCount(), sceneItemCount());
+
     for (GraphicsEdge* edge : m_edgeMap)
     {
         m_scene->removeItem(edge);
@@ -319,10 +1091,102 @@ void BinaryTreeVisualization::clearAllGraphics()
         delete gNode;
     }
     m_nodeMap.clear();
+    m_cacheMarked.clear();
+
+    for (GraphicsSubtreeGlyph* glyph : m_glyphMap)
+    {
+        m_scene->removeItem(glyph);
+        delete glyph;
+    }
+    m_glyphMap.clear();
+
+    if (m_summaryItem)
+    {
+        m_scene->removeItem(m_summaryItem);
+        delete m_summaryItem;
+        m_summaryItem = nullptr;
+    }
+}
+
+bool BinaryTreeVisualization::showSummaryIfTooLarge()
+{
+    if (!isTooLargeToDraw()) return false;
+
+    stopRotationAnimation();
+    clearAllGraphics();
+    resetLayoutCache();
+    m_aggregates.clear();
+    m_aggregatesValid = false;
+
+    // Полный обход - O(n) на каждую перестройку, но перестройки
+    // приходят не чаще раза в кадр, а узлы больше не рисуются
+    const TreeShape shape = measureTreeShape(m_tree->root(), kSummaryMaxBars);
+
+    constexpr qreal kBarHeight = 18.0;
+    constexpr qreal kBarMaxWidth = 600.0;
+    constexpr qreal kLabelWidth = 140.0;
+    constexpr qreal kHeaderHeight = 70.0;
+    constexpr qreal kPadding = 16.0;
+
+    const qreal height = kHeaderHeight + shape.levelCounts.size() * kBarHeight + 2 * kPadding;
+    const qreal width = kLabelWidth + kBarMaxWidth + 120.0 + 2 * kPadding;
+
+    m_summaryItem = new QGraphicsRectItem(0, 0, width, height);
+    m_summaryItem->setBrush(QColor(60, 60, 60));
+    m_summaryItem->setPen(QPen(QColor(30, 60, 100), 2));
+
+    auto addText = [this](const QString& text, qreal x, qreal y)
+    {
+        QGraphicsSimpleTextItem* item = new QGraphicsSimpleTextItem(text, m_summaryItem);
+        item->setBrush(Qt::white);
+        item->setPos(x, y);
+        return item;
+    };
+
+    addText(QString("Summary view: %1 nodes (nodes are drawn up to %2)")
+                .arg(shape.nodes).arg(kMaxDrawnNodes),
+            kPadding, kPadding);
+    addText(QString("Leaves: %1   Max depth: %2   Average depth: %3   Levels per bar: %4")
+                .arg(shape.leaves).arg(shape.maxDepth)
+                .arg(shape.averageDepth, 0, 'f', 1).arg(shape.levelsPerBar),
+            kPadding, kPadding + 24.0);
+
+    qint64 maxCount = 1;
+    for (qint64 count : shape.levelCounts)
+    {
+        maxCount = qMax(maxCount, count);
+    }
+
+    for (int i = 0; i < shape.levelCounts.size(); ++i)
+    {
+        const qint64 count = shape.levelCounts[i];
+        const qint64 firstLevel = i * shape.levelsPerBar;
+        const qint64 lastLevel = qMin(shape.maxDepth, firstLevel + shape.levelsPerBar - 1);
+        const qreal y = kPadding + kHeaderHeight + i * kBarHeight;
+
+        addText(firstLevel == lastLevel ? QString("depth %1").arg(firstLevel)
+                                        : QString("depth %1-%2").arg(firstLevel).arg(lastLevel),
+                kPadding, y);
+
+        const qreal barWidth = count > 0 ? qMax<qreal>(1.0, kBarMaxWidth * count / maxCount) : 0.0;
+        QGraphicsRectItem* bar = new QGraphicsRectItem(kPadding + kLabelWidth, y + 2, barWidth, kBarHeight - 4,
+                                                       m_summaryItem);
+        bar->setBrush(QColor(70, 130, 200));
+        bar->setPen(Qt::NoPen);
+
+        addText(QString::number(count), kPadding + kLabelWidth + barWidth + 8.0, y);
+    }
+
+    m_scene->addItem(m_summaryItem);
+    m_scene->setSceneRect(m_summaryItem->sceneBoundingRect().adjusted(-50, -50, 50, 50));
+    m_view->fitInView(m_summaryItem, Qt::KeepAspectRatio);
+    return true;
 }
 
 QMap<TreeNode*, QPointF> BinaryTreeVisualization::calculateNodePositions() const
 {
+    DSAT_PERF_SCOPE(m_perfSections, "calculateNodePositions");
+
     QMap<TreeNode*, QPointF> positions;
 
     if (!m_tree || !m_tree->root())
@@ -343,6 +1207,11 @@ int BinaryTreeVisualization::calculateSubtreeWidth(TreeNode* node) const
 {
     if (!node) return 0;
 
+    if (m_aggregatesValid)
+    {
+        return m_aggregates.value(node).size;
+    }
+
     int leftWidth = calculateSubtreeWidth(node->left());
     int rightWidth = calculateSubtreeWidth(node->right());
 
@@ -371,9 +1240,73 @@ void BinaryTreeVisualization::calculatePositionsRecursive(TreeNode* node, qreal
     }
 }
 
+void BinaryTreeVisualization::updateLayout()
+{
+    const QMap<TreeNode*, QPointF> positions = calculateNodePositions();
+
+    SceneIndexGuard indexGuard(m_scene, movedItemCount(positions), sceneItemCount(), "updateLayout");
+    applyNodePositions(positions);
+    updateEdges();
+}
+
 void BinaryTreeVisualization::updateNodePositions()
 {
-    auto positions = calculateNodePositions();
+    applyNodePositions(calculateNodePositions());
+}
+
+void BinaryTreeVisualization::applyNodePositions(const QMap<TreeNode*, QPointF>& positions)
+{
+    // Для миникарты собираем только области, где узлы или их ребра сдвинулись.
+    // Старые ключи не разыменовываем: удаленные узлы могут быть уже уничтожены.
+    const qreal r = m_nodeRadius;
+    auto nodeRect = [r](const QPointF& p) { return QRectF(p.x() - r, p.y() - r, 2 * r, 2 * r); };
+
+    QMap<TreeNode*, QPointF> parentPositions;
+    for (auto it = positions.cbegin(); it != positions.cend(); ++it)
+    {
+        if (TreeNode* parent = it.key()->parent())
+        {
+            parentPositions[it.key()] = positions.value(parent, it.value());
+        }
+    }
+
+    auto entryRect = [&nodeRect](const QMap<TreeNode*, QPointF>& parents, TreeNode* node, const QPointF& pos)
+    {
+        auto parent = parents.constFind(node);
+        return parent == parents.cend() ? nodeRect(pos) : nodeRect(pos) | nodeRect(parent.value());
+    };
+
+    QRectF dirty;
+    QRectF bounds;
+
+    for (auto it = m_positions.cbegin(); it != m_positions.cend(); ++it)
+    {
+        auto found = positions.constFind(it.key());
+        if (found == positions.cend() || found.value() != it.value()
+            || parentPositions.value(it.key()) != m_parentPositions.value(it.key()))
+        {
+            dirty |= entryRect(m_parentPositions, it.key(), it.value());
+        }
+    }
+
+    for (auto it = positions.cbegin(); it != positions.cend(); ++it)
+    {
+        bounds |= nodeRect(it.value());
+
+        auto found = m_positions.constFind(it.key());
+        if (found == m_positions.cend() || found.value() != it.value()
+            || parentPositions.value(it.key()) != m_parentPositions.value(it.key()))
+        {
+            dirty |= entryRect(parentPositions, it.key(), it.value());
+        }
+    }
+
+    m_positions = positions;
+    m_parentPositions = parentPositions;
+    m_layoutBounds = bounds.adjusted(-50, -50, 50, 50);
+
+    updateMinimapBounds();
+    invalidateMinimap(dirty);
 
     qDebug() << "=== UPDATE NODE POSITIONS ===";
     qDebug() << "Calculated" << positions.size() << "positions";
@@ -393,21 +1326,52 @@ void BinaryTreeVisualization::updateNodePositions()
             // Debug: точка в позиции узла
 
         }
-        else
+        else if (m_glyphMap.isEmpty())
         {
+            // Со свернутыми поддеревьями узлы внутри них не рисуются
             qDebug() << "ERROR: No graphics node for tree node" << treeNode->value();
         }
     }
+
+    for (auto it = m_glyphMap.cbegin(); it != m_glyphMap.cend(); ++it)
+    {
+        it.value()->setPos(positions.value(it.key()));
+    }
 }
 
 void BinaryTreeVisualization::updateEdges()
 {
+    DSAT_PERF_SCOPE(m_perfSections, "updateEdges");
+
     for (GraphicsEdge* edge : m_edgeMap)
     {
         edge->updatePosition();
     }
 }
 
+int BinaryTreeVisualization::movedItemCount(const QMap<TreeNode*, QPointF>& positions) const
+{
+    // Сдвинутый узел тянет за собой ребро к родителю
+    int moved = 0;
+    for (auto it = positions.cbegin(); it != positions.cend(); ++it)
+    {
+        if (GraphicsNode* gNode = m_nodeMap.value(it.key()))
+        {
+            if (gNode->pos() != it.value()) moved += 2;
+        }
+        else if (GraphicsSubtreeGlyph* glyph = m_glyphMap.value(it.key()))
+        {
+            if (glyph->pos() != it.value()) moved += 2;
+        }
+    }
+    return moved;
+}
+
+int BinaryTreeVisualization::sceneItemCount() const
+{
+    return int(m_nodeMap.size() + m_edgeMap.size() + m_glyphMap.size());
+}
+
 GraphicsNode* BinaryTreeVisualization::findGraphicsNode(TreeNode* node) const
 {
     return m_nodeMap.value(node, nullptr);
@@ -415,6 +1379,11 @@ GraphicsNode* BinaryTreeVisualization::findGraphicsNode(TreeNode* node) const
 
 void BinaryTreeVisualization::rebuildVisualization()
 {
+    DSAT_PERF_SCOPE(m_perfSections, "rebuildVisualization");
+    // Охранник разрушается раньше замера - переиндексация входит в него.
+    // Старые элементы уходят, новые (не больше двух на узел) приходят
+    const int rebuiltItems = sceneItemCount() + (m_tree ? 2 * m_tree->size() : 0);
+    SceneIndexGuard indexGuard(m_scene, rebuiltItems, rebuiltItems, "rebuildVisualization");
     clearAllGraphics();
 
     if (!m_tree || !m_tree->root()) return;
@@ -422,61 +1391,349 @@ void BinaryTreeVisualization::rebuildVisualization()
     qDebug() << "=== REBUILD VISUALIZATION ===";
     qDebug() << "m_nodeRadius =" << m_nodeRadius;
 
-    // 1. Создаем ВСЕ узлы (пока без позиций и НЕ добавляем на сцену!)
-    std::function<void(TreeNode*)> createNodes = [&](TreeNode* node)
-    {
-        if (!node) return;
+    // За перестройкой всегда идет fitTreeToView: детализацию выбираем
+    // сразу для масштаба после вписывания, а не для текущего
+    ensureAggregates();
+    m_detailScale = fittedScale();
 
-        GraphicsNode* gNode = createGraphicsNode(node); // Только создаем
-        // НЕ добавляем на сцену здесь!
-        // m_scene->addItem(gNode); <-- УБРАТЬ
+    rebuildItems();
+}
 
-        qDebug() << "Node" << node->value() << "created (not on scene yet)";
-        qDebug() << "  Initial pos:" << gNode->pos();
-        qDebug() << "  Initial rect:" << gNode->rect();
+void BinaryTreeVisualization::rebuildItems()
+{
+    // Тысячи addItem подряд - индекс строится один раз в конце
+    const int rebuiltItems = sceneItemCount() + (m_tree ? 2 * m_tree->size() : 0);
+    SceneIndexGuard indexGuard(m_scene, rebuiltItems, rebuiltItems, "rebuildItems");
+    clearAllGraphics();
 
-        createNodes(node->left());
-        createNodes(node->right());
-    };
+    if (!m_tree || !m_tree->root()) return;
+
+    ensureAggregates();
 
-    createNodes(m_tree->root());
+    // 1. Создаем узлы до свернутых поддеревьев и треугольники вместо них
+    //    (пока без позиций и НЕ добавляем на сцену!)
+    QVector<TreeNode*> collapsed;
+    const QVector<TreeNode*> drawn = collectDrawnNodes(&collapsed);
+
+    for (TreeNode* node : drawn)
+    {
+        createGraphicsNode(node);
+    }
+    for (TreeNode* node : collapsed)
+    {
+        createGlyph(node);
+    }
 
-    // 2. Устанавливаем позиции ВСЕХ узлов
+    // 2. Устанавливаем позиции
     updateNodePositions();
 
-    // 3. ТЕПЕРЬ добавляем все узлы на сцену
-    for (GraphicsNode* gNode : m_nodeMap) {
+    // 3. ТЕПЕРЬ добавляем все на сцену
+    for (GraphicsNode* gNode : m_nodeMap)
+    {
         m_scene->addItem(gNode);
-        qDebug() << "Node added to scene at:" << gNode->pos();
+    }
+    for (GraphicsSubtreeGlyph* glyph : m_glyphMap)
+    {
+        m_scene->addItem(glyph);
+    }
+
+    // 4. Создаем ребра: родитель нарисованного узла тоже нарисован
+    for (TreeNode* node : drawn)
+    {
+        if (node->parent())
+        {
+            createEdge(node->parent(), node);
+        }
     }
 
-    // 4. Создаем ребра (после установки позиций и добавления на сцену!)
-    std::function<void(TreeNode*)> createEdges = [&](TreeNode* node)
+    updateEdges();
+}
+
+void BinaryTreeVisualization::ensureAggregates()
+{
+    if (m_aggregatesValid) return;
+
+    m_aggregates.clear();
+    if (m_tree && m_tree->root())
     {
-        if (!node) return;
+        m_aggregates.reserve(m_tree->size());
+
+        // Прямой обход без рекурсии, потом разбор с конца: дети раньше родителей
+        QVector<TreeNode*> order;
+        order.reserve(m_tree->size());
+        QVector<TreeNode*> stack;
+        stack.append(m_tree->root());
 
-        if (node->left())
+        while (!stack.isEmpty())
         {
-            createEdge(node, node->left());
-            createEdges(node->left());
+            TreeNode* node = stack.takeLast();
+            order.append(node);
+
+            if (node->left()) stack.append(node->left());
+            if (node->right()) stack.append(node->right());
         }
 
-        if (node->right())
+        for (auto it = order.crbegin(); it != order.crend(); ++it)
         {
-            createEdge(node, node->right());
-            createEdges(node->right());
+            recomputeAggregate(*it);
         }
-    };
+    }
 
-    createEdges(m_tree->root());
+    m_aggregatesValid = true;
+}
 
-    updateEdges();
+bool BinaryTreeVisualization::recomputeAggregate(TreeNode* node)
+{
+    // У отсутствующего ребенка записи нет - value() дает нулевой агрегат
+    const SubtreeAggregate left = m_aggregates.value(node->left());
+    const SubtreeAggregate right = m_aggregates.value(node->right());
+    // Оба ребенка стоят на (left.size + 1) полушагов от родителя,
+    // как в calculatePositionsRecursive
+    const int offset = left.size + 1;
+
+    SubtreeAggregate aggregate;
+    aggregate.size = left.size + right.size + 1;
+    aggregate.height = qMax(left.height, right.height) + 1;
+    aggregate.minKey = node->left() ? left.minKey : node->value();
+    aggregate.maxKey = node->right() ? right.maxKey : node->value();
+    aggregate.leftReach = qMax(0, qMax(node->left() ? offset + left.leftReach : 0,
+                                       node->right() ? right.leftReach - offset : 0));
+    aggregate.rightReach = qMax(0, qMax(node->left() ? left.rightReach - offset : 0,
+                                        node->right() ? offset + right.rightReach : 0));
+
+    SubtreeAggregate& stored = m_aggregates[node];
+    if (stored == aggregate) return false;
+
+    stored = aggregate;
+    return true;
+}
 
-    fitTreeToView();
+void BinaryTreeVisualization::patchAggregates(TreeNode* from)
+{
+    // Невалидные агрегаты все равно пересчитаются целиком
+    if (!m_aggregatesValid) return;
+
+    // Большое дерево рисуется сводкой - агрегаты не нужны
+    if (isTooLargeToDraw())
+    {
+        m_aggregates.clear();
+        m_aggregatesValid = false;
+        return;
+    }
+
+    // Выше узла, чей агрегат не изменился, не изменится ничего
+    for (TreeNode* node = from; node && recomputeAggregate(node); node = node->parent())
+    {
+    }
+
+    m_aggregatesPatched = true;
+}
+
+qreal BinaryTreeVisualization::fittedScale() const
+{
+    const QSize viewport = m_view->viewport()->size();
+    if (viewport.isEmpty()) return m_detailScale;
+
+    // Та же область, что вписывает fitTreeToView: раскладка, радиус узлов и поля по 50
+    const SubtreeAggregate root = m_aggregates.value(m_tree->root());
+    const qreal width = (root.leftReach + root.rightReach) * m_horizontalSpacing / 2.0 + 2 * m_nodeRadius + 100.0;
+    const qreal height = qMax(0, root.height - 1) * m_verticalSpacing + 2 * m_nodeRadius + 100.0;
+
+    return qMin(viewport.width() / width, viewport.height() / height);
+}
+
+bool BinaryTreeVisualization::isCollapsed(TreeNode* node) const
+{
+    if (node->isLeaf() || m_expanded.contains(node)) return false;
+    if (m_collapsed.contains(node)) return true;
+    if (!m_levelOfDetail) return false;
+
+    // Дети легли бы так близко к узлу, что их уже не различить
+    const qreal dx = (m_aggregates.value(node->left()).size + 1) * m_horizontalSpacing / 2.0;
+    return std::hypot(dx, m_verticalSpacing) * m_detailScale < kMinChildDistancePx;
+}
+
+QVector<TreeNode*> BinaryTreeVisualization::collectDrawnNodes(QVector<TreeNode*>* collapsed) const
+{
+    QVector<TreeNode*> drawn;
+    QVector<TreeNode*> stack;
+    if (m_tree && m_tree->root())
+    {
+        stack.append(m_tree->root());
+    }
+
+    // Внутрь свернутых поддеревьев не спускаемся: обход - O(видимых узлов)
+    while (!stack.isEmpty())
+    {
+        TreeNode* node = stack.takeLast();
+        drawn.append(node);
+
+        if (isCollapsed(node))
+        {
+            if (collapsed) collapsed->append(node);
+            continue;
+        }
+
+        if (node->right()) stack.append(node->right());
+        if (node->left()) stack.append(node->left());
+    }
+
+    return drawn;
+}
+
+void BinaryTreeVisualization::createGlyph(TreeNode* node)
+{
+    const SubtreeAggregate aggregate = m_aggregates.value(node);
+
+    GraphicsSubtreeGlyph* glyph = new GraphicsSubtreeGlyph();
+    glyph->setExtent(aggregate.leftReach * m_horizontalSpacing / 2.0,
+                     aggregate.rightReach * m_horizontalSpacing / 2.0,
+                     (aggregate.height - 1) * m_verticalSpacing);
+    glyph->setSummary(aggregate.size, aggregate.height, aggregate.minKey, aggregate.maxKey);
+
+    m_glyphMap[node] = glyph;
+}
+
+void BinaryTreeVisualization::setLevelOfDetailEnabled(bool enabled)
+{
+    if (m_levelOfDetail == enabled) return;
+
+    m_levelOfDetail = enabled;
+    if (!m_tree || isSummaryMode()) return;
+
+    m_detailScale = m_view->transform().m11();
+    stopRotationAnimation();
+    rebuildItems();
+}
+
+void BinaryTreeVisualization::setSubtreeCollapsed(TreeNode* node, bool collapsed)
+{
+    if (!node || node->isLeaf()) return;
+
+    // Ручной выбор запоминается и переживает смену масштаба
+    if (collapsed)
+    {
+        m_expanded.remove(node);
+        m_collapsed.insert(node);
+    }
+    else
+    {
+        m_collapsed.remove(node);
+        m_expanded.insert(node);
+    }
+
+    // Узел внутри другого свернутого поддерева или сводка - на экране ничего не меняется
+    if (!m_nodeMap.contains(node) || isSubtreeCollapsed(node) == collapsed) return;
+
+    stopRotationAnimation();
+    rebuildItems();
+}
+
+void BinaryTreeVisualization::scheduleDetailUpdate()
+{
+    // Повторный запуск откладывает пересчет, пока колесо крутится
+    if (m_levelOfDetail && m_detailTimer)
+    {
+        m_detailTimer->start();
+    }
+}
+
+void BinaryTreeVisualization::updateLevelOfDetail()
+{
+    if (!m_levelOfDetail || !m_tree || !m_tree->root() || isSummaryMode()) return;
+
+    const qreal scale = m_view->transform().m11();
+    if (qAbs(scale - m_detailScale) <= m_detailScale * kDetailScaleTolerance) return;
+
+    m_detailScale = scale;
+    ensureAggregates();
+
+    QVector<TreeNode*> collapsed;
+    collectDrawnNodes(&collapsed);
+
+    bool unchanged = collapsed.size() == m_glyphMap.size();
+    for (int i = 0; unchanged && i < collapsed.size(); ++i)
+    {
+        unchanged = m_glyphMap.contains(collapsed[i]);
+    }
+    if (unchanged) return;
+
+    stopRotationAnimation();
+    rebuildItems();
+}
+
+void BinaryTreeVisualization::toggleCollapsedAt(const QPoint& viewportPos)
+{
+    QGraphicsItem* item = m_view->itemAt(viewportPos);
+    if (!item) return;
+
+    // Под курсором может оказаться подпись узла
+    item = item->topLevelItem();
+
+    TreeNode* target = nullptr;
+    for (auto it = m_glyphMap.cbegin(); it != m_glyphMap.cend() && !target; ++it)
+    {
+        if (it.value() == item) target = it.key();
+    }
+    for (auto it = m_nodeMap.cbegin(); it != m_nodeMap.cend() && !target; ++it)
+    {
+        if (it.value() == item) target = it.key();
+    }
+
+    if (!target || target->isLeaf()) return;
+
+    // Перестройка удаляет элемент под курсором - не посреди обработки щелчка видом
+    QPointer<TreeNode> guarded(target);
+    QMetaObject::invokeMethod(this, [this, guarded]()
+    {
+        if (guarded)
+        {
+            setSubtreeCollapsed(guarded, !isSubtreeCollapsed(guarded));
+        }
+    }, Qt::QueuedConnection);
+}
+
+bool BinaryTreeVisualization::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == m_view->viewport())
+    {
+        switch (event->type())
+        {
+        case QEvent::Wheel:
+            scheduleDetailUpdate();
+            break;
+        case QEvent::MouseButtonPress:
+        {
+            QMouseEvent* mouse = static_cast<QMouseEvent*>(event);
+            if (mouse->button() == Qt::LeftButton)
+            {
+                m_pressPos = mouse->pos();
+            }
+            break;
+        }
+        case QEvent::MouseButtonRelease:
+        {
+            // Щелчок без сдвига: перетаскивание левой кнопкой двигает вид
+            QMouseEvent* mouse = static_cast<QMouseEvent*>(event);
+            if (mouse->button() == Qt::LeftButton && mouse->modifiers() == Qt::NoModifier
+                && (mouse->pos() - m_pressPos).manhattanLength() < QApplication::startDragDistance())
+            {
+                toggleCollapsedAt(mouse->pos());
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    return VisualizerBase::eventFilter(watched, event);
 }
 
 void BinaryTreeVisualization::fitTreeToView()
 {
+    DSAT_PERF_SCOPE(m_perfSections, "fitTreeToView");
+
     qDebug() << "=== FIT TO VIEW START ===";
     qDebug() << "Scene items count:" << m_scene->items().size();
 
@@ -531,6 +1788,7 @@ void BinaryTreeVisualization::fitTreeToView()
     // Принудительно обновим
     m_view->update();
     m_view->viewport()->update();
+    if (m_minimap) m_minimap->update();
 
     // Проверим результат
     QTimer::singleShot(0, [this, itemsRect]() {
@@ -2,18 +2,28 @@
 #define BINARY_TREE_VISUALIZATION_H
 
 #include <QMap>
+#include <QHash>
 #include <QTimer>
 #include <QPropertyAnimation>
+#include <QVariantAnimation>
 #include <QVBoxLayout>
 #include <QResizeEvent>
 #include <QScrollBar>
+#include <QGraphicsRectItem>
+#include <QSet>
 #include <QDebug>
 
+#include <memory>
+
 #include "../../../core/internal/binary_tree/binary_tree.h"
 #include "../../../core/internal/binary_tree/tree_node.h"
+#include "../../../core/utils/cache_simulator.h"
 #include "base/visualizer_base.h"
 #include "base/graphics_node.h"
 #include "base/graphics_edge.h"
+#include "base/graphics_subtree_glyph.h"
+#include "base/scene_index_guard.h"
+#include "export/tree_image_exporter.h"
 
 class BinaryTreeVisualization : public VisualizerBase
 {
@@ -39,14 +49,65 @@ public:
     void setNodeRadius(qreal radius);
     void setShowValues(bool show);
 
+    // Тепловая карта: узлы красятся по частоте посещений за последние
+    // windowMs миллисекунд (экспоненциальное затухание). Включает счетчики
+    // посещений в дереве, выключение возвращает обычные цвета.
+    void setHeatmapEnabled(bool enabled);
+    bool isHeatmapEnabled() const { return m_heatmapEnabled; }
+    // Рамка узлов, которые в модели кэша не нашлись в L1:
+    // желтая - из L2, оранжевая - из LLC, красная - из памяти
+    void markCacheMisses(const QHash<const TreeNode*, CacheSimulator::ServedBy>& misses);
+    void clearCacheMarks();
+
+    void setHeatmapWindow(int windowMs) { m_heatmapWindowMs = qMax(kHeatmapIntervalMs, windowMs); }
+
+    // Больше узлов - вместо дерева рисуется сводка: размер, глубина
+    // и гистограмма узлов по уровням. Переключение автоматическое.
+    static constexpr int kMaxDrawnNodes = 50000;
+    bool isSummaryMode() const { return m_summaryItem != nullptr; }
+
+    // Уровень детализации: при уменьшении поддеревья, чьи дети легли бы
+    // на экране ближе kMinChildDistancePx к корню, сворачиваются в треугольник
+    // с размером, высотой и диапазоном ключей. При увеличении треугольники
+    // раскрываются. Щелчок по узлу сворачивает или раскрывает его поддерево
+    // вручную, и это сильнее автоматического правила.
+    static constexpr qreal kMinChildDistancePx = 16.0;
+    void setLevelOfDetailEnabled(bool enabled);
+    bool isLevelOfDetailEnabled() const { return m_levelOfDetail; }
+    void setSubtreeCollapsed(TreeNode* node, bool collapsed);
+    bool isSubtreeCollapsed(TreeNode* node) const { return m_glyphMap.contains(node); }
+
+    // Проигрывает пошаговую операцию дерева (insertSteps и т.п.) через
+    // algorithmStepper(). Любое изменение дерева не из самой операции
+    // прерывает ее: узлы, на которых она спит, могли исчезнуть.
+    void runSteps(TreeTask task);
+    void cancelSteps();
+
     void startOperation(const QString& name);
     void finishOperation(const QString& name);
 
+    // Экспорт строится по раскладке, а не по элементам сцены
+    TreeLayoutSnapshot layoutSnapshot() const;
+    bool exportToPngTiles(const QString& basePath,
+                          const TreeImageExporter::Options& options = TreeImageExporter::Options(),
+                          const TreeImageExporter::ProgressCallback& progress = nullptr) const;
+    bool exportToSvg(const QString& path,
+                     const TreeImageExporter::Options& options = TreeImageExporter::Options()) const;
+
+    void renderOverview(QPainter* painter, const QRectF& sceneRegion) override;
+    void appendMemoryUsage(MemoryReport& report) const override;
+
 public slots:
     void onNodeInserted(TreeNode* node);
     void onNodeRemoved(TreeNode* node);
     void onStructureChanged();
     void onTreeCleared();
+    void onNodeRotated(TreeNode* node, TreeNode* pivot);
+    // Состояния узлов копятся в планировщике и применяются раз в кадр
+    void onNodeHighlighted(TreeNode* node, bool highlighted);
+    void onNodeVisited(TreeNode* node);
+    void onNodeCurrent(TreeNode* node);
+    void onComparisonMade(TreeNode* node1, TreeNode* node2);
 
     void resetZoom();
     void zoomIn();
@@ -57,30 +118,145 @@ signals:
 
 protected:
     void resizeEvent(QResizeEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
+    QRectF overviewRect() const override;
+    void applyStructureUpdate() override;
+    void applyNodeUpdate(const void* node, const VisualUpdateScheduler::NodeUpdate& update) override;
 
 private:
+    // Кадр анимации поворотов: раскладка и ребра дерева после очередного поворота
+    struct LayoutKeyframe
+    {
+        QMap<TreeNode*, QPointF> positions;
+        QVector<QPair<TreeNode*, TreeNode*>> edges;
+    };
+
+    // Больше узлов - повороты применяются сразу, без анимации
+    static constexpr int kMaxAnimatedNodes = 2000;
+    static constexpr int kHeatmapIntervalMs = 250;
+    // Детализация пересчитывается после паузы в прокрутке колеса
+    // и только если масштаб заметно изменился
+    static constexpr int kDetailUpdateDelayMs = 80;
+    static constexpr qreal kDetailScaleTolerance = 0.1;
+
+    // Агрегаты поддерева: по ним раскладка берет ширины за O(1),
+    // а треугольники - подписи. При вставке, удалении и повороте
+    // пересчитывается только путь до корня.
+    struct SubtreeAggregate
+    {
+        int size = 0;
+        int height = 0;
+        int minKey = 0;
+        int maxKey = 0;
+        // На сколько полушагов раскладки поддерево выходит влево и вправо от корня
+        int leftReach = 0;
+        int rightReach = 0;
+
+        bool operator==(const SubtreeAggregate&) const = default;
+    };
+
+    struct HeatEntry
+    {
+        quint32 lastVisits = 0;     // Показание счетчика узла на прошлом тике
+        double heat = 0.0;
+    };
+
     BinaryTree* m_tree = nullptr;
 
+    // Очередь кадров: первый - то, что сейчас на экране
+    QVector<LayoutKeyframe> m_keyframes;
+    QVariantAnimation* m_rotationAnimation = nullptr;
+    // Индекс сцены снят, пока идет анимация поворотов
+    std::unique_ptr<SceneIndexGuard> m_animationIndexGuard;
+
+    // Последние узлы, отмеченные текущим и сравниваемыми
+    TreeNode* m_currentNode = nullptr;
+    QPair<TreeNode*, TreeNode*> m_comparedNodes;
+
     QMap<TreeNode*, GraphicsNode*> m_nodeMap;
     QMap<QPair<TreeNode*, TreeNode*>, GraphicsEdge*> m_edgeMap;
 
+    // Последняя примененная раскладка (по ней рисуется миникарта)
+    QMap<TreeNode*, QPointF> m_positions;
+    QMap<TreeNode*, QPointF> m_parentPositions;     // Узел -> позиция его родителя
+    QRectF m_layoutBounds;
+
     qreal m_nodeRadius = 20.0;
     qreal m_horizontalSpacing = 80.0;
     qreal m_verticalSpacing = 100.0;
     bool m_showValues = true;
 
+    bool m_heatmapEnabled = false;
+    int m_heatmapWindowMs = 5000;
+    QTimer* m_heatmapTimer = nullptr;
+    QHash<TreeNode*, HeatEntry> m_heat;
+    QVector<TreeNode*> m_cacheMarked;
+
+    // Сводка вместо дерева (корень группы элементов сцены)
+    QGraphicsRectItem* m_summaryItem = nullptr;
+
+    QHash<TreeNode*, SubtreeAggregate> m_aggregates;
+    bool m_aggregatesValid = false;
+    // Последнее изменение уже учтено по пути до корня - structureChanged
+    // не должен сбрасывать агрегаты
+    bool m_aggregatesPatched = false;
+
+    bool m_levelOfDetail = true;
+    qreal m_detailScale = 1.0;          // Масштаб, для которого собраны элементы
+    QTimer* m_detailTimer = nullptr;
+    QHash<TreeNode*, GraphicsSubtreeGlyph*> m_glyphMap;
+    QSet<TreeNode*> m_collapsed;        // Свернуты щелчком
+    QSet<TreeNode*> m_expanded;         // Раскрыты щелчком вопреки масштабу
+    QPoint m_pressPos;
+
     GraphicsNode* createGraphicsNode(TreeNode* node);
     GraphicsEdge* createEdge(TreeNode* parent, TreeNode* child);
     void removeGraphicsNode(TreeNode* node);
     void removeEdge(TreeNode* parent, TreeNode* child);
     void clearAllGraphics();
+    void resetLayoutCache();
+    void forgetPendingState(TreeNode* node);
+    void resetPendingStates();
+    void applyStep(const TreeStep& step);
+    void onTreeModified();
+    void updateHeatmap();
+    void resetNodeColors();
+
+    bool isTooLargeToDraw() const { return m_tree && m_tree->size() > kMaxDrawnNodes; }
+    // true - дерево велико и на сцене сводка; иначе ничего не делает
+    bool showSummaryIfTooLarge();
+
+    LayoutKeyframe captureKeyframe() const;
+    void playNextKeyframe();
+    bool stopRotationAnimation();     // true, если анимация шла
+    void applyKeyframeEdges(const LayoutKeyframe& keyframe);
 
     QMap<TreeNode*, QPointF> calculateNodePositions() const;
+    // Позиции узлов и ребра одной пачкой под одним охранником индекса
+    void updateLayout();
     void updateNodePositions();
+    void applyNodePositions(const QMap<TreeNode*, QPointF>& positions);
     void updateEdges();
+    // Элементы сцены, которые сдвинет раскладка positions (узлы с ребрами)
+    int movedItemCount(const QMap<TreeNode*, QPointF>& positions) const;
+    int sceneItemCount() const;
+
+    void ensureAggregates();
+    bool recomputeAggregate(TreeNode* node);
+    void patchAggregates(TreeNode* from);
+
+    qreal fittedScale() const;
+    bool isCollapsed(TreeNode* node) const;
+    QVector<TreeNode*> collectDrawnNodes(QVector<TreeNode*>* collapsed) const;
+    void createGlyph(TreeNode* node);
+    void scheduleDetailUpdate();
+    void updateLevelOfDetail();
+    void toggleCollapsedAt(const QPoint& viewportPos);
 
     GraphicsNode* findGraphicsNode(TreeNode* node) const;
     void rebuildVisualization();
+    // Элементы сцены для текущего m_detailScale, без вписывания в вид
+    void rebuildItems();
     void fitTreeToView();
 
     int calculateSubtreeWidth(TreeNode* node) const;
@@ -0,0 +1,277 @@
+#include "bplus_tree_visualization.h"
+#include "base/minimap_widget.h"
+
+BPlusTreeVisualization::BPlusTreeVisualization(QWidget* parent)
+    : VisualizerBase(parent)
+{
+    m_scene->setBackgroundBrush(QBrush(QColor(80, 80, 80)));
+}
+
+BPlusTreeVisualization::~BPlusTreeVisualization()
+{
+    clearAllGraphics();
+}
+
+void BPlusTreeVisualization::setStructure(QObject* structure)
+{
+    if (auto* tree = qobject_cast<BPlusTree*>(structure))
+    {
+        setTree(tree);
+    }
+}
+
+void BPlusTreeVisualization::clear()
+{
+    clearAllGraphics();
+    m_tree = nullptr;
+    m_scene->clear();
+}
+
+void BPlusTreeVisualization::updateVisualization()
+{
+    if (!m_tree) return;
+
+    rebuildVisualization();
+    fitTreeToView();
+
+    emit visualizationUpdated();
+}
+
+void BPlusTreeVisualization::setTree(BPlusTree* tree)
+{
+    if (m_tree == tree) return;
+
+    if (m_tree)
+    {
+        disconnect(m_tree, nullptr, this, nullptr);
+    }
+
+    m_tree = tree;
+
+    if (m_tree)
+    {
+        connect(m_tree, &BPlusTree::structureChanged,
+                this, &BPlusTreeVisualization::onStructureChanged);
+        connect(m_tree, &BPlusTree::treeCleared,
+                this, &BPlusTreeVisualization::onTreeCleared);
+
+        updateVisualization();
+    }
+    else
+    {
+        clear();
+    }
+}
+
+void BPlusTreeVisualization::highlightSearchPath(int key)
+{
+    clearHighlights();
+
+    if (!m_tree) return;
+
+    BPlusNode* node = m_tree->root();
+    while (node)
+    {
+        GraphicsKeyNode* gNode = m_nodeMap.value(node);
+        if (gNode)
+        {
+            gNode->setHighlighted(true);
+        }
+
+        if (node->isLeaf())
+        {
+            const int index = node->countLess(key);
+            if (gNode && index < node->keyCount() && node->key(index) == key)
+            {
+                gNode->setHighlightedCell(index);
+            }
+            break;
+        }
+
+        node = node->child(node->countLessOrEqual(key));
+    }
+}
+
+void BPlusTreeVisualization::clearHighlights()
+{
+    for (GraphicsKeyNode* gNode : m_nodeMap)
+    {
+        gNode->setHighlighted(false);
+        gNode->setHighlightedCell(-1);
+    }
+}
+
+void BPlusTreeVisualization::setShowLeafLinks(bool show)
+{
+    if (m_showLeafLinks != show)
+    {
+        m_showLeafLinks = show;
+        rebuildVisualization();
+    }
+}
+
+void BPlusTreeVisualization::onStructureChanged()
+{
+    rebuildVisualization();
+    fitTreeToView();
+}
+
+void BPlusTreeVisualization::onTreeCleared()
+{
+    clearAllGraphics();
+    m_scene->clear();
+}
+
+void BPlusTreeVisualization::resizeEvent(QResizeEvent* event)
+{
+    VisualizerBase::resizeEvent(event);
+    fitTreeToView();
+}
+
+QRectF BPlusTreeVisualization::overviewRect() const
+{
+    return m_layoutBounds;
+}
+
+GraphicsKeyNode* BPlusTreeVisualization::createGraphicsNode(BPlusNode* node)
+{
+    QVector<int> keys;
+    keys.reserve(node->keyCount());
+    for (int i = 0; i < node->keyCount(); ++i)
+    {
+        keys.append(node->key(i));
+    }
+
+    GraphicsKeyNode* gNode = new GraphicsKeyNode(keys);
+
+    // Листья (где лежат данные) отличаем цветом от внутренних узлов-разделителей
+    gNode->setBaseColor(node->isLeaf() ? QColor(60, 179, 113) : QColor(70, 130, 200));
+
+    m_nodeMap[node] = gNode;
+    return gNode;
+}
+
+void BPlusTreeVisualization::clearAllGraphics()
+{
+    for (GraphicsEdge* edge : m_edges)
+    {
+        m_scene->removeItem(edge);
+        delete edge;
+    }
+    m_edges.clear();
+
+    for (GraphicsKeyNode* gNode : m_nodeMap)
+    {
+        m_scene->removeItem(gNode);
+        delete gNode;
+    }
+    m_nodeMap.clear();
+
+    m_layoutBounds = QRectF();
+}
+
+void BPlusTreeVisualization::rebuildVisualization()
+{
+    clearAllGraphics();
+
+    if (!m_tree || !m_tree->root()) return;
+
+    // 1. Раскладываем узлы по уровням (все листья B+ дерева на одной глубине)
+    QVector<QVector<BPlusNode*>> levels;
+    levels.append(QVector<BPlusNode*>{m_tree->root()});
+
+    while (!levels.last().first()->isLeaf())
+    {
+        QVector<BPlusNode*> nextLevel;
+        for (BPlusNode* node : levels.last())
+        {
+            for (int i = 0; i < node->childCount(); ++i)
+            {
+                nextLevel.append(node->child(i));
+            }
+        }
+        levels.append(nextLevel);
+    }
+
+    for (const QVector<BPlusNode*>& level : levels)
+    {
+        for (BPlusNode* node : level)
+        {
+            createGraphicsNode(node);
+        }
+    }
+
+    // 2. Листья ставим подряд слева направо
+    const qreal leafY = (levels.size() - 1) * m_verticalSpacing;
+    qreal x = 0.0;
+    for (BPlusNode* leaf : levels.last())
+    {
+        GraphicsKeyNode* gNode = m_nodeMap.value(leaf);
+        const qreal width = gNode->width();
+        gNode->setPos(x + width / 2.0, leafY);
+        x += width + m_leafSpacing;
+    }
+
+    // 3. Внутренние узлы - по центру над своими детьми, снизу вверх
+    for (int level = levels.size() - 2; level >= 0; --level)
+    {
+        for (BPlusNode* node : levels[level])
+        {
+            GraphicsKeyNode* first = m_nodeMap.value(node->child(0));
+            GraphicsKeyNode* last = m_nodeMap.value(node->child(node->childCount() - 1));
+            m_nodeMap.value(node)->setPos((first->x() + last->x()) / 2.0, level * m_verticalSpacing);
+        }
+    }
+
+    // 4. Узлы на сцену, затем ребра
+    for (GraphicsKeyNode* gNode : m_nodeMap)
+    {
+        m_scene->addItem(gNode);
+        m_layoutBounds |= gNode->sceneBoundingRect();
+    }
+    m_layoutBounds.adjust(-50, -50, 50, 50);
+
+    for (int level = 0; level + 1 < levels.size(); ++level)
+    {
+        for (BPlusNode* node : levels[level])
+        {
+            GraphicsKeyNode* parentItem = m_nodeMap.value(node);
+            for (int i = 0; i < node->childCount(); ++i)
+            {
+                GraphicsEdge* edge = new GraphicsEdge(parentItem, m_nodeMap.value(node->child(i)));
+                edge->setColor(QColor(70, 130, 180));
+                edge->setWidth(2.0);
+                m_scene->addItem(edge);
+                m_edges.append(edge);
+            }
+        }
+    }
+
+    // 5. Связи между соседними листьями, по которым идут range-запросы
+    if (m_showLeafLinks)
+    {
+        for (BPlusNode* leaf : levels.last())
+        {
+            if (!leaf->next()) continue;
+
+            GraphicsEdge* link = new GraphicsEdge(m_nodeMap.value(leaf), m_nodeMap.value(leaf->next()));
+            link->setColor(QColor(200, 200, 200));
+            link->setWidth(1.5);
+            link->setDashed(true);
+            m_scene->addItem(link);
+            m_edges.append(link);
+        }
+    }
+
+    updateMinimapBounds();
+    invalidateMinimap();
+}
+
+void BPlusTreeVisualization::fitTreeToView()
+{
+    if (m_layoutBounds.isEmpty()) return;
+
+    m_view->resetTransform();
+    m_view->fitInView(m_layoutBounds, Qt::KeepAspectRatio);
+    if (m_minimap) m_minimap->update();
+}
@@ -0,0 +1,66 @@
+#ifndef BPLUS_TREE_VISUALIZATION_H
+#define BPLUS_TREE_VISUALIZATION_H
+
+#include <QMap>
+#include <QVector>
+#include <QResizeEvent>
+#include <QDebug>
+
+#include "../../../core/internal/bplus_tree/bplus_tree.h"
+#include "base/visualizer_base.h"
+#include "base/graphics_key_node.h"
+#include "base/graphics_edge.h"
+
+class BPlusTreeVisualization : public VisualizerBase
+{
+    Q_OBJECT
+
+public:
+    explicit BPlusTreeVisualization(QWidget* parent = nullptr);
+    ~BPlusTreeVisualization();
+
+    void setStructure(QObject* structure) override;
+    void clear() override;
+    void updateVisualization() override;
+
+    void setTree(BPlusTree* tree);
+    BPlusTree* tree() const { return m_tree; }
+
+    // Подсвечивает путь поиска ключа от корня до листа
+    void highlightSearchPath(int key);
+    void clearHighlights();
+
+    void setShowLeafLinks(bool show);
+
+public slots:
+    void onStructureChanged();
+    void onTreeCleared();
+
+signals:
+    void visualizationUpdated();
+
+protected:
+    void resizeEvent(QResizeEvent* event) override;
+    QRectF overviewRect() const override;
+
+private:
+    BPlusTree* m_tree = nullptr;
+
+    QMap<BPlusNode*, GraphicsKeyNode*> m_nodeMap;
+    QVector<GraphicsEdge*> m_edges;
+    QRectF m_layoutBounds;
+
+    qreal m_leafSpacing = 24.0;
+    qreal m_verticalSpacing = 90.0;
+    bool m_showLeafLinks = true;
+
+    void rebuildVisualization();
+    void clearAllGraphics();
+    void fitTreeToView();
+
+    GraphicsKeyNode* createGraphicsNode(BPlusNode* node);
+
+    Q_DISABLE_COPY(BPlusTreeVisualization)
+};
+
+#endif // BPLUS_TREE_VISUALIZATION_H
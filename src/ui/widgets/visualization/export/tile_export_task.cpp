@@ -0,0 +1,50 @@
+#include "tile_export_task.h"
+
+TileExportTask::TileExportTask(QObject* parent)
+    : QObject(parent)
+{
+}
+
+TileExportTask::~TileExportTask()
+{
+    if (m_thread) {
+        m_cancelled = true;
+        m_thread->wait();
+        delete m_thread;
+    }
+}
+
+bool TileExportTask::start(const TreeLayoutSnapshot& snapshot, const QString& basePath,
+                           const TreeImageExporter::Options& options)
+{
+    if (m_thread) return false;
+
+    m_snapshot = snapshot;
+    m_cancelled = false;
+    m_ok = false;
+
+    // Рабочий поток только читает m_snapshot; сигналы из него уходят очередью
+    m_thread = QThread::create([this, basePath, options]() {
+        TreeImageExporter exporter(m_snapshot, options);
+        m_ok = exporter.exportPngTiles(basePath, [this](int done, int total) {
+            emit progress(done, total);
+        }, &m_cancelled);
+    });
+
+    // Итог - уже в потоке задачи, когда рабочий поток завершен: из
+    // обработчика finished можно сразу начать следующий экспорт
+    connect(m_thread, &QThread::finished, this, [this]() {
+        m_thread->deleteLater();
+        m_thread = nullptr;
+        m_snapshot = TreeLayoutSnapshot();
+        emit finished(m_ok, m_cancelled.load());
+    });
+
+    m_thread->start();
+    return true;
+}
+
+void TileExportTask::cancel()
+{
+    m_cancelled = true;
+}
@@ -0,0 +1,44 @@
+#ifndef TILE_EXPORT_TASK_H
+#define TILE_EXPORT_TASK_H
+
+#include <QObject>
+#include <QThread>
+
+#include <atomic>
+
+#include "tree_image_exporter.h"
+
+// Экспорт PNG-тайлов в отдельном потоке: окно не замирает на время
+// экспорта большого дерева. Снимок раскладки копируется в задачу,
+// поэтому дерево можно менять сразу после start(). progress идет из
+// рабочего потока (к объектам GUI - очередью), finished - в потоке задачи.
+class TileExportTask : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TileExportTask(QObject* parent = nullptr);
+    // Отменяет экспорт и ждет рабочий поток
+    ~TileExportTask() override;
+
+    // false - предыдущий экспорт еще идет
+    bool start(const TreeLayoutSnapshot& snapshot, const QString& basePath,
+               const TreeImageExporter::Options& options = TreeImageExporter::Options());
+    void cancel();
+    bool isRunning() const { return m_thread != nullptr; }
+
+signals:
+    void progress(int done, int total);
+    // ok == false - ошибка записи или отмена
+    void finished(bool ok, bool cancelled);
+
+private:
+    TreeLayoutSnapshot m_snapshot;
+    QThread* m_thread = nullptr;
+    std::atomic<bool> m_cancelled{false};
+    bool m_ok = false;      // Пишет рабочий поток, читается после его завершения
+
+    Q_DISABLE_COPY(TileExportTask)
+};
+
+#endif // TILE_EXPORT_TASK_H
@@ -0,0 +1,275 @@
+#include "tree_image_exporter.h"
+
+#include <QImage>
+#include <QPainter>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QDebug>
+
+#include <atomic>
+#include <cmath>
+
+#include "../../../../core/utils/parallel.h"
+
+namespace
+{
+// Те же цвета, что и у элементов сцены в BinaryTreeVisualization
+const QColor kNodeFill(70, 130, 200);
+const QColor kNodeBorder(30, 60, 100);
+const QColor kLeftEdge(70, 130, 180);
+const QColor kRightEdge(60, 179, 113);
+const qreal kEdgeWidth = 3.0;
+const qreal kBorderWidth = 2.0;
+}
+
+QRectF TreeLayoutSnapshot::boundingRect(qreal margin) const
+{
+    if (nodes.isEmpty()) {
+        return QRectF();
+    }
+
+    qreal minX = nodes.first().pos.x();
+    qreal maxX = minX;
+    qreal minY = nodes.first().pos.y();
+    qreal maxY = minY;
+
+    for (const Node& node : nodes) {
+        minX = qMin(minX, node.pos.x());
+        maxX = qMax(maxX, node.pos.x());
+        minY = qMin(minY, node.pos.y());
+        maxY = qMax(maxY, node.pos.y());
+    }
+
+    const qreal pad = nodeRadius + margin;
+    return QRectF(QPointF(minX - pad, minY - pad), QPointF(maxX + pad, maxY + pad));
+}
+
+TreeImageExporter::TreeImageExporter(const TreeLayoutSnapshot& snapshot, const Options& options)
+    : m_snapshot(snapshot)
+    , m_options(options)
+{
+    m_options.tileSize = qMax(64, m_options.tileSize);
+    m_options.scale = m_options.scale > 0 ? m_options.scale : 1.0;
+
+    m_sceneRect = m_snapshot.boundingRect(m_options.margin);
+    if (!m_sceneRect.isEmpty()) {
+        const qreal tileSceneSize = m_options.tileSize / m_options.scale;
+        m_columns = qMax(1, int(std::ceil(m_sceneRect.width() / tileSceneSize)));
+        m_rows = qMax(1, int(std::ceil(m_sceneRect.height() / tileSceneSize)));
+        buildTileBuckets();
+    }
+}
+
+QRect TreeImageExporter::tileRangeFor(const QRectF& sceneRect) const
+{
+    const qreal tileSceneSize = m_options.tileSize / m_options.scale;
+
+    int left = int(std::floor((sceneRect.left() - m_sceneRect.left()) / tileSceneSize));
+    int right = int(std::floor((sceneRect.right() - m_sceneRect.left()) / tileSceneSize));
+    int top = int(std::floor((sceneRect.top() - m_sceneRect.top()) / tileSceneSize));
+    int bottom = int(std::floor((sceneRect.bottom() - m_sceneRect.top()) / tileSceneSize));
+
+    left = qBound(0, left, m_columns - 1);
+    right = qBound(0, right, m_columns - 1);
+    top = qBound(0, top, m_rows - 1);
+    bottom = qBound(0, bottom, m_rows - 1);
+
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+void TreeImageExporter::buildTileBuckets()
+{
+    m_tileNodes.resize(m_columns * m_rows);
+    m_tileEdges.resize(m_columns * m_rows);
+
+    const qreal r = m_snapshot.nodeRadius + kBorderWidth;
+    const qreal halfEdge = kEdgeWidth / 2.0;
+
+    for (int i = 0; i < m_snapshot.nodes.size(); ++i) {
+        const TreeLayoutSnapshot::Node& node = m_snapshot.nodes[i];
+
+        QRect range = tileRangeFor(QRectF(node.pos.x() - r, node.pos.y() - r, 2 * r, 2 * r));
+        for (int row = range.top(); row <= range.bottom(); ++row) {
+            for (int col = range.left(); col <= range.right(); ++col) {
+                m_tileNodes[row * m_columns + col].append(i);
+            }
+        }
+
+        if (node.parent < 0) continue;
+
+        // Ребро попадает во все тайлы своего bounding box
+        QRectF edgeRect = QRectF(m_snapshot.nodes[node.parent].pos, node.pos).normalized()
+                              .adjusted(-halfEdge, -halfEdge, halfEdge, halfEdge);
+        range = tileRangeFor(edgeRect);
+        for (int row = range.top(); row <= range.bottom(); ++row) {
+            for (int col = range.left(); col <= range.right(); ++col) {
+                m_tileEdges[row * m_columns + col].append(i);
+            }
+        }
+    }
+}
+
+bool TreeImageExporter::renderTile(int tileIndex, const QString& path) const
+{
+    const int row = tileIndex / m_columns;
+    const int col = tileIndex % m_columns;
+    const qreal tileSceneSize = m_options.tileSize / m_options.scale;
+
+    // Крайние тайлы обрезаем по границе изображения
+    const int totalWidth = int(std::ceil(m_sceneRect.width() * m_options.scale));
+    const int totalHeight = int(std::ceil(m_sceneRect.height() * m_options.scale));
+    const int width = qMin(m_options.tileSize, totalWidth - col * m_options.tileSize);
+    const int height = qMin(m_options.tileSize, totalHeight - row * m_options.tileSize);
+
+    QImage image(qMax(1, width), qMax(1, height), QImage::Format_ARGB32_Premultiplied);
+    image.fill(m_options.background);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.scale(m_options.scale, m_options.scale);
+    painter.translate(-(m_sceneRect.left() + col * tileSceneSize),
+                      -(m_sceneRect.top() + row * tileSceneSize));
+
+    // Сначала ребра, чтобы узлы были поверх них
+    QPen leftPen(kLeftEdge, kEdgeWidth);
+    QPen rightPen(kRightEdge, kEdgeWidth);
+    for (int index : m_tileEdges[tileIndex]) {
+        const TreeLayoutSnapshot::Node& node = m_snapshot.nodes[index];
+        painter.setPen(node.isLeftChild ? leftPen : rightPen);
+        painter.drawLine(m_snapshot.nodes[node.parent].pos, node.pos);
+    }
+
+    const qreal r = m_snapshot.nodeRadius;
+    painter.setPen(QPen(kNodeBorder, kBorderWidth));
+    painter.setBrush(kNodeFill);
+    for (int index : m_tileNodes[tileIndex]) {
+        painter.drawEllipse(m_snapshot.nodes[index].pos, r, r);
+    }
+
+    if (m_options.showValues) {
+        painter.setPen(Qt::white);
+        for (int index : m_tileNodes[tileIndex]) {
+            const TreeLayoutSnapshot::Node& node = m_snapshot.nodes[index];
+            painter.drawText(QRectF(node.pos.x() - r, node.pos.y() - r, 2 * r, 2 * r),
+                             Qt::AlignCenter, QString::number(node.value));
+        }
+    }
+
+    painter.end();
+
+    return image.save(path, "PNG");
+}
+
+bool TreeImageExporter::exportPngTiles(const QString& basePath, const ProgressCallback& progress,
+                                       const std::atomic<bool>* cancelled) const
+{
+    if (m_snapshot.nodes.isEmpty()) {
+        qWarning() << "TreeImageExporter: nothing to export";
+        return false;
+    }
+
+    // Манифест, чтобы тайлы можно было собрать обратно
+    QFile manifest(basePath + ".tiles");
+    if (!manifest.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "TreeImageExporter: cannot write" << manifest.fileName();
+        return false;
+    }
+
+    const QString name = QFileInfo(basePath).fileName();
+    {
+        QTextStream out(&manifest);
+        out << "columns " << m_columns << "\n"
+            << "rows " << m_rows << "\n"
+            << "tileSize " << m_options.tileSize << "\n"
+            << "scale " << m_options.scale << "\n"
+            << "pattern " << name << "_r%1_c%2.png\n";
+    }
+    manifest.close();
+
+    const int total = m_columns * m_rows;
+    std::atomic<int> done{0};
+    std::atomic<bool> ok{true};
+
+    parallelFor(total, [&](int tileIndex) {
+        if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+            ok = false;
+            return;
+        }
+
+        const QString path = QString("%1_r%2_c%3.png")
+                                 .arg(basePath)
+                                 .arg(tileIndex / m_columns)
+                                 .arg(tileIndex % m_columns);
+
+        if (!renderTile(tileIndex, path)) {
+            qWarning() << "TreeImageExporter: cannot write" << path;
+            ok = false;
+        }
+
+        const int finished = ++done;
+        if (progress) {
+            progress(finished, total);
+        }
+    }, m_options.maxThreads);
+
+    return ok;
+}
+
+bool TreeImageExporter::exportSvg(const QString& path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "TreeImageExporter: cannot write" << path;
+        return false;
+    }
+
+    QTextStream out(&file);
+    const QRectF rect = m_sceneRect;
+    const qreal r = m_snapshot.nodeRadius;
+
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<svg xmlns=\"http://www.w3.org/2000/svg\""
+        << " width=\"" << rect.width() * m_options.scale << "\""
+        << " height=\"" << rect.height() * m_options.scale << "\""
+        << " viewBox=\"" << rect.left() << ' ' << rect.top() << ' '
+        << rect.width() << ' ' << rect.height() << "\">\n"
+        << "<rect x=\"" << rect.left() << "\" y=\"" << rect.top()
+        << "\" width=\"" << rect.width() << "\" height=\"" << rect.height()
+        << "\" fill=\"" << m_options.background.name() << "\"/>\n";
+
+    // Общие стили выносим в группы, чтобы не повторять их у каждого элемента
+    out << "<g stroke-width=\"" << kEdgeWidth << "\">\n";
+    for (const TreeLayoutSnapshot::Node& node : m_snapshot.nodes) {
+        if (node.parent < 0) continue;
+
+        const QPointF& from = m_snapshot.nodes[node.parent].pos;
+        out << "<line x1=\"" << from.x() << "\" y1=\"" << from.y()
+            << "\" x2=\"" << node.pos.x() << "\" y2=\"" << node.pos.y()
+            << "\" stroke=\"" << (node.isLeftChild ? kLeftEdge : kRightEdge).name() << "\"/>\n";
+    }
+    out << "</g>\n";
+
+    out << "<g fill=\"" << kNodeFill.name() << "\" stroke=\"" << kNodeBorder.name()
+        << "\" stroke-width=\"" << kBorderWidth << "\">\n";
+    for (const TreeLayoutSnapshot::Node& node : m_snapshot.nodes) {
+        out << "<circle cx=\"" << node.pos.x() << "\" cy=\"" << node.pos.y()
+            << "\" r=\"" << r << "\"/>\n";
+    }
+    out << "</g>\n";
+
+    if (m_options.showValues) {
+        out << "<g fill=\"#ffffff\" font-family=\"sans-serif\" font-size=\"" << r * 0.7
+            << "\" text-anchor=\"middle\" dominant-baseline=\"central\">\n";
+        for (const TreeLayoutSnapshot::Node& node : m_snapshot.nodes) {
+            out << "<text x=\"" << node.pos.x() << "\" y=\"" << node.pos.y() << "\">"
+                << node.value << "</text>\n";
+        }
+        out << "</g>\n";
+    }
+
+    out << "</svg>\n";
+    out.flush();
+
+    return out.status() == QTextStream::Ok && file.error() == QFileDevice::NoError;
+}
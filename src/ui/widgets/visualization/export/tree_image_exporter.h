@@ -0,0 +1,85 @@
+#ifndef TREE_IMAGE_EXPORTER_H
+#define TREE_IMAGE_EXPORTER_H
+
+#include <QVector>
+#include <QPointF>
+#include <QRect>
+#include <QRectF>
+#include <QColor>
+#include <QString>
+
+#include <atomic>
+#include <functional>
+
+// Плоский снимок раскладки дерева: только позиции и значения,
+// без элементов сцены. Его можно читать из нескольких потоков.
+struct TreeLayoutSnapshot
+{
+    struct Node
+    {
+        QPointF pos;
+        int value = 0;
+        int parent = -1;        // Индекс родителя в nodes, -1 для корня
+        bool isLeftChild = false;
+    };
+
+    QVector<Node> nodes;
+    qreal nodeRadius = 20.0;
+
+    QRectF boundingRect(qreal margin = 0.0) const;
+};
+
+// Экспорт больших деревьев без QGraphicsScene::render:
+// область раскладки режется на тайлы, тайлы рисуются параллельно
+// и сразу пишутся на диск, поэтому в памяти одновременно живет
+// не больше одного тайла на поток.
+class TreeImageExporter
+{
+public:
+    struct Options
+    {
+        int tileSize = 2048;        // Размер тайла в пикселях
+        qreal scale = 1.0;          // Пикселей на единицу сцены
+        qreal margin = 50.0;        // Поля вокруг дерева (в единицах сцены)
+        int maxThreads = 0;         // 0 - все потоки глобального пула
+        bool showValues = true;
+        QColor background = QColor(80, 80, 80);
+    };
+
+    // done, total - сколько тайлов уже записано.
+    // Вызывается из рабочих потоков.
+    using ProgressCallback = std::function<void(int done, int total)>;
+
+    explicit TreeImageExporter(const TreeLayoutSnapshot& snapshot, const Options& options = Options());
+
+    // Пишет тайлы basePath_r<строка>_c<столбец>.png и манифест basePath.tiles.
+    // cancelled проверяется перед каждым тайлом: после отмены оставшиеся
+    // тайлы не рисуются, а результат - false
+    bool exportPngTiles(const QString& basePath, const ProgressCallback& progress = nullptr,
+                        const std::atomic<bool>* cancelled = nullptr) const;
+
+    // Потоковая запись SVG: элементы пишутся в файл по мере обхода снимка
+    bool exportSvg(const QString& path) const;
+
+    int tileColumns() const { return m_columns; }
+    int tileRows() const { return m_rows; }
+
+private:
+    const TreeLayoutSnapshot& m_snapshot;
+    Options m_options;
+
+    QRectF m_sceneRect;
+    int m_columns = 0;
+    int m_rows = 0;
+
+    // Для каждого тайла - индексы узлов и ребер (ребро = индекс дочернего узла),
+    // которые его пересекают
+    QVector<QVector<int>> m_tileNodes;
+    QVector<QVector<int>> m_tileEdges;
+
+    void buildTileBuckets();
+    QRect tileRangeFor(const QRectF& sceneRect) const;
+    bool renderTile(int tileIndex, const QString& path) const;
+};
+
+#endif // TREE_IMAGE_EXPORTER_H
@@ -0,0 +1,375 @@
+#include "graph_visualization.h"
+#include "base/minimap_widget.h"
+
+#include <QMetaObject>
+
+GraphVisualization::GraphVisualization(QWidget* parent)
+    : VisualizerBase(parent)
+{
+    m_scene->setBackgroundBrush(QBrush(QColor(80, 80, 80)));
+    m_layoutPool.setMaxThreadCount(1);
+}
+
+GraphVisualization::~GraphVisualization()
+{
+    cancelLayout();
+    m_layoutPool.waitForDone();
+    clearAllGraphics();
+}
+
+void GraphVisualization::setStructure(QObject* structure)
+{
+    if (auto* graph = qobject_cast<CsrGraph*>(structure))
+    {
+        setGraph(graph);
+    }
+}
+
+void GraphVisualization::clear()
+{
+    cancelLayout();
+    clearAllGraphics();
+    m_graph = nullptr;
+    m_scene->clear();
+}
+
+void GraphVisualization::updateVisualization()
+{
+    if (!m_graph) return;
+
+    rebuildVisualization();
+    startLayout();
+
+    emit visualizationUpdated();
+}
+
+void GraphVisualization::setGraph(CsrGraph* graph)
+{
+    if (m_graph == graph) return;
+
+    if (m_graph)
+    {
+        disconnect(m_graph, nullptr, this, nullptr);
+    }
+
+    m_graph = graph;
+
+    if (m_graph)
+    {
+        connect(m_graph, &CsrGraph::structureChanged,
+                this, &GraphVisualization::onStructureChanged);
+        connect(m_graph, &CsrGraph::graphCleared,
+                this, &GraphVisualization::onGraphCleared);
+
+        updateVisualization();
+    }
+    else
+    {
+        clear();
+    }
+}
+
+void GraphVisualization::onStructureChanged()
+{
+    updateVisualization();
+}
+
+void GraphVisualization::onGraphCleared()
+{
+    cancelLayout();
+    clearAllGraphics();
+    m_scene->clear();
+}
+
+void GraphVisualization::resizeEvent(QResizeEvent* event)
+{
+    VisualizerBase::resizeEvent(event);
+    fitGraphToView();
+}
+
+QRectF GraphVisualization::overviewRect() const
+{
+    return m_layoutBounds;
+}
+
+void GraphVisualization::clearAllGraphics()
+{
+    for (GraphicsNode* gNode : m_nodes)
+    {
+        m_scene->removeItem(gNode);
+        delete gNode;
+    }
+    m_nodes.clear();
+
+    if (m_edgeBatch)
+    {
+        m_scene->removeItem(m_edgeBatch);
+        delete m_edgeBatch;
+        m_edgeBatch = nullptr;
+    }
+
+    if (m_pathBatch)
+    {
+        m_scene->removeItem(m_pathBatch);
+        delete m_pathBatch;
+        m_pathBatch = nullptr;
+    }
+
+    m_edgeList.clear();
+    m_positions.clear();
+    m_vertexColors.clear();
+    m_layoutBounds = QRectF();
+}
+
+void GraphVisualization::rebuildVisualization()
+{
+    cancelLayout();
+    clearAllGraphics();
+
+    if (!m_graph || m_graph->isEmpty()) return;
+
+    const int n = m_graph->vertexCount();
+
+    // Каждое ребро неориентированного графа рисуем один раз
+    m_edgeList.reserve(std::size_t(m_graph->arcCount()));
+    for (int v = 0; v < n; ++v)
+    {
+        const int* targets = m_graph->neighbors(v);
+        for (int i = 0; i < m_graph->degree(v); ++i)
+        {
+            if (m_graph->isDirected() || v < targets[i])
+            {
+                m_edgeList.emplace_back(v, targets[i]);
+            }
+        }
+    }
+
+    m_positions.fill(QPointF(), n);
+    m_vertexColors.fill(QColor(70, 130, 200), n);
+
+    m_edgeBatch = new GraphicsEdgeBatch();
+    m_edgeBatch->setColor(QColor(150, 170, 190));
+    m_edgeBatch->setZValue(-1);
+    m_scene->addItem(m_edgeBatch);
+
+    m_pathBatch = new GraphicsEdgeBatch();
+    m_pathBatch->setColor(QColor(255, 200, 0));
+    m_pathBatch->setWidth(3.0);
+    m_pathBatch->setZValue(0.5);
+    m_scene->addItem(m_pathBatch);
+
+    if (n <= kMaxNodeItems)
+    {
+        m_nodes.reserve(n);
+        for (int v = 0; v < n; ++v)
+        {
+            GraphicsNode* gNode = new GraphicsNode(v);
+            gNode->setRadius(m_nodeRadius);
+            gNode->setTextColor(Qt::white);
+            m_scene->addItem(gNode);
+            m_nodes.append(gNode);
+        }
+    }
+}
+
+void GraphVisualization::startLayout()
+{
+    if (!m_graph || m_graph->isEmpty()) return;
+
+    cancelLayout();
+
+    const quint64 generation = ++m_layoutGeneration;
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    m_layoutCancel = cancel;
+    m_layoutRunning = true;
+
+    // Ребра копируются здесь, в GUI-потоке; дальше поток с графом не связан
+    auto layout = std::make_shared<ForceLayout>(*m_graph, m_layoutOptions);
+
+    m_layoutPool.start([this, layout, cancel, generation]() {
+        const std::vector<QPointF> positions = layout->run(
+            [this, cancel, generation](int, const std::vector<QPointF>& current) {
+                if (cancel->load(std::memory_order_relaxed)) return false;
+
+                QMetaObject::invokeMethod(this, [this, generation, current]() {
+                    applyPositions(generation, current, false);
+                }, Qt::QueuedConnection);
+                return true;
+            });
+
+        if (cancel->load(std::memory_order_relaxed)) return;
+
+        QMetaObject::invokeMethod(this, [this, generation, positions]() {
+            applyPositions(generation, positions, true);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void GraphVisualization::cancelLayout()
+{
+    if (m_layoutCancel)
+    {
+        m_layoutCancel->store(true, std::memory_order_relaxed);
+        m_layoutCancel.reset();
+    }
+
+    // Уже отправленные результаты старой раскладки отбросятся по номеру поколения
+    ++m_layoutGeneration;
+    m_layoutRunning = false;
+}
+
+void GraphVisualization::applyPositions(quint64 generation, const std::vector<QPointF>& positions, bool finished)
+{
+    if (generation != m_layoutGeneration || int(positions.size()) != m_positions.size()) return;
+
+    const bool firstUpdate = m_layoutBounds.isNull();
+
+    for (int v = 0; v < m_positions.size(); ++v)
+    {
+        m_positions[v] = positions[std::size_t(v)];
+    }
+    updateSceneGeometry();
+
+    // Вид подгоняем только в начале и в конце, чтобы не мешать навигации
+    if (firstUpdate || finished)
+    {
+        fitGraphToView();
+    }
+
+    if (finished)
+    {
+        m_layoutRunning = false;
+        m_layoutCancel.reset();
+        emit layoutFinished();
+    }
+}
+
+void GraphVisualization::updateSceneGeometry()
+{
+    QVector<QLineF> lines;
+    lines.reserve(int(m_edgeList.size()));
+    for (const std::pair<int, int>& edge : m_edgeList)
+    {
+        lines.append(QLineF(m_positions[edge.first], m_positions[edge.second]));
+    }
+    m_edgeBatch->setLines(lines);
+
+    if (m_nodes.isEmpty())
+    {
+        m_edgeBatch->setPoints(m_positions, m_vertexColors);
+    }
+    else
+    {
+        for (int v = 0; v < m_nodes.size(); ++v)
+        {
+            m_nodes[v]->setPos(m_positions[v]);
+        }
+    }
+
+    m_layoutBounds = m_edgeBatch->boundingRect();
+    for (const QPointF& position : m_positions)
+    {
+        m_layoutBounds |= QRectF(position, QSizeF(1, 1));
+    }
+    m_layoutBounds.adjust(-50, -50, 50, 50);
+
+    updateMinimapBounds();
+    invalidateMinimap();
+}
+
+void GraphVisualization::applyVertexColors()
+{
+    if (m_nodes.isEmpty())
+    {
+        if (m_edgeBatch)
+        {
+            m_edgeBatch->setPoints(m_positions, m_vertexColors);
+        }
+    }
+    else
+    {
+        for (int v = 0; v < m_nodes.size(); ++v)
+        {
+            m_nodes[v]->setBaseColor(m_vertexColors[v]);
+        }
+    }
+
+    invalidateMinimap();
+}
+
+void GraphVisualization::showBfsLevels(int source)
+{
+    if (!m_graph || source < 0 || source >= m_graph->vertexCount()) return;
+
+    const std::vector<int> levels = m_graph->arcCount() > kParallelBfsArcs
+        ? m_graph->parallelBfs(source)
+        : m_graph->bfs(source);
+
+    for (int v = 0; v < m_vertexColors.size(); ++v)
+    {
+        // Соседние уровни - заметно разные оттенки
+        m_vertexColors[v] = levels[std::size_t(v)] == CsrGraph::kUnreachable
+            ? QColor(120, 120, 120)
+            : QColor::fromHsv((levels[std::size_t(v)] * 37) % 360, 170, 210);
+    }
+
+    applyVertexColors();
+}
+
+int GraphVisualization::highlightShortestPath(int source, int target)
+{
+    if (m_pathBatch)
+    {
+        m_pathBatch->setLines(QVector<QLineF>());
+    }
+
+    if (!m_graph || source < 0 || target < 0
+        || source >= m_graph->vertexCount() || target >= m_graph->vertexCount())
+    {
+        return -1;
+    }
+
+    std::vector<int> predecessors;
+    const std::vector<int> distances = m_graph->dijkstra(source, &predecessors);
+    if (distances[std::size_t(target)] == CsrGraph::kUnreachable) return -1;
+
+    QVector<QLineF> path;
+    for (int v = target; v != source; v = predecessors[std::size_t(v)])
+    {
+        path.append(QLineF(m_positions[predecessors[std::size_t(v)]], m_positions[v]));
+    }
+    m_pathBatch->setLines(path);
+
+    if (!m_nodes.isEmpty())
+    {
+        m_nodes[source]->setHighlighted(true);
+        m_nodes[target]->setHighlighted(true);
+    }
+
+    invalidateMinimap();
+    return distances[std::size_t(target)];
+}
+
+void GraphVisualization::clearHighlights()
+{
+    if (m_pathBatch)
+    {
+        m_pathBatch->setLines(QVector<QLineF>());
+    }
+
+    m_vertexColors.fill(QColor(70, 130, 200));
+    for (GraphicsNode* gNode : m_nodes)
+    {
+        gNode->setHighlighted(false);
+    }
+    applyVertexColors();
+}
+
+void GraphVisualization::fitGraphToView()
+{
+    if (m_layoutBounds.isEmpty()) return;
+
+    m_view->resetTransform();
+    m_view->fitInView(m_layoutBounds, Qt::KeepAspectRatio);
+    if (m_minimap) m_minimap->update();
+}
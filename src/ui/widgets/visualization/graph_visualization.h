@@ -0,0 +1,97 @@
+#ifndef GRAPH_VISUALIZATION_H
+#define GRAPH_VISUALIZATION_H
+
+#include <QVector>
+#include <QResizeEvent>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../../../core/internal/graph/csr_graph.h"
+#include "../../../core/internal/graph/force_layout.h"
+#include "base/visualizer_base.h"
+#include "base/graphics_node.h"
+#include "base/graphics_edge_batch.h"
+
+// Визуализация графа с силовой раскладкой.
+// Раскладка считается в отдельном потоке и присылает промежуточные позиции,
+// сцена обновляется по мере их прихода. Все ребра - один GraphicsEdgeBatch;
+// на больших графах вершины тоже рисуются им же точками, а не GraphicsNode.
+class GraphVisualization : public VisualizerBase
+{
+    Q_OBJECT
+
+public:
+    // Выше этого числа вершин GraphicsNode не создаются
+    static constexpr int kMaxNodeItems = 1500;
+    // Выше этого числа дуг BFS для раскраски идет параллельно
+    static constexpr int kParallelBfsArcs = 200000;
+
+    explicit GraphVisualization(QWidget* parent = nullptr);
+    ~GraphVisualization();
+
+    void setStructure(QObject* structure) override;
+    void clear() override;
+    void updateVisualization() override;
+
+    void setGraph(CsrGraph* graph);
+    CsrGraph* graph() const { return m_graph; }
+
+    void setLayoutOptions(const ForceLayout::Options& options) { m_layoutOptions = options; }
+    bool isLayoutRunning() const { return m_layoutRunning; }
+
+    // Раскрашивает вершины по уровню BFS от source
+    void showBfsLevels(int source);
+    // Рисует кратчайший путь по весам; возвращает его длину или -1
+    int highlightShortestPath(int source, int target);
+    void clearHighlights();
+
+public slots:
+    void onStructureChanged();
+    void onGraphCleared();
+
+signals:
+    void visualizationUpdated();
+    void layoutFinished();
+
+protected:
+    void resizeEvent(QResizeEvent* event) override;
+    QRectF overviewRect() const override;
+
+private:
+    CsrGraph* m_graph = nullptr;
+
+    std::vector<std::pair<int, int>> m_edgeList;
+    QVector<QPointF> m_positions;
+    QVector<QColor> m_vertexColors;
+    QVector<GraphicsNode*> m_nodes;             // Пуст, если вершин больше kMaxNodeItems
+    GraphicsEdgeBatch* m_edgeBatch = nullptr;
+    GraphicsEdgeBatch* m_pathBatch = nullptr;
+    QRectF m_layoutBounds;
+
+    // Отдельный пул на один поток: деструктор ждет только свою раскладку
+    QThreadPool m_layoutPool;
+    std::shared_ptr<std::atomic<bool>> m_layoutCancel;
+    quint64 m_layoutGeneration = 0;
+    bool m_layoutRunning = false;
+    ForceLayout::Options m_layoutOptions;
+
+    qreal m_nodeRadius = 12.0;
+
+    void rebuildVisualization();
+    void clearAllGraphics();
+    void fitGraphToView();
+
+    void startLayout();
+    void cancelLayout();
+    void applyPositions(quint64 generation, const std::vector<QPointF>& positions, bool finished);
+    void updateSceneGeometry();
+    void applyVertexColors();
+
+    Q_DISABLE_COPY(GraphVisualization)
+};
+
+#endif // GRAPH_VISUALIZATION_H
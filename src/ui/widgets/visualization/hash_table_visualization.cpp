@@ -0,0 +1,233 @@
+#include "hash_table_visualization.h"
+#include "base/minimap_widget.h"
+
+#include <QPen>
+
+HashTableVisualization::HashTableVisualization(QWidget* parent)
+    : VisualizerBase(parent)
+{
+    m_scene->setBackgroundBrush(QBrush(QColor(80, 80, 80)));
+}
+
+HashTableVisualization::~HashTableVisualization()
+{
+    clearAllGraphics();
+}
+
+void HashTableVisualization::setStructure(QObject* structure)
+{
+    if (auto* table = qobject_cast<RobinHoodHashTable*>(structure))
+    {
+        setTable(table);
+    }
+}
+
+void HashTableVisualization::clear()
+{
+    clearAllGraphics();
+    m_table = nullptr;
+    m_scene->clear();
+}
+
+void HashTableVisualization::updateVisualization()
+{
+    if (!m_table) return;
+
+    rebuildVisualization();
+    fitTableToView();
+
+    emit visualizationUpdated();
+}
+
+void HashTableVisualization::setTable(RobinHoodHashTable* table)
+{
+    if (m_table == table) return;
+
+    if (m_table)
+    {
+        disconnect(m_table, nullptr, this, nullptr);
+    }
+
+    m_table = table;
+
+    if (m_table)
+    {
+        connect(m_table, &RobinHoodHashTable::structureChanged,
+                this, &HashTableVisualization::onStructureChanged);
+        connect(m_table, &RobinHoodHashTable::tableCleared,
+                this, &HashTableVisualization::onTableCleared);
+
+        updateVisualization();
+    }
+    else
+    {
+        clear();
+    }
+}
+
+void HashTableVisualization::highlightProbeSequence(int key)
+{
+    clearHighlights();
+
+    if (!m_table) return;
+
+    const QVector<int> sequence = m_table->probeSequence(key);
+    if (sequence.isEmpty()) return;
+
+    const int found = m_table->findSlot(key);
+
+    QPainterPath path(slotPosition(sequence.first()));
+    for (int i = 0; i < sequence.size(); ++i)
+    {
+        const int slot = sequence[i];
+        if (slot >= m_buckets.size()) break;
+
+        GraphicsBucketItem::ProbeState state = GraphicsBucketItem::ProbeState::Probed;
+        if (slot == found)
+        {
+            state = GraphicsBucketItem::ProbeState::Found;
+        }
+        else if (i == 0)
+        {
+            state = GraphicsBucketItem::ProbeState::Home;
+        }
+        m_buckets[slot]->setProbeState(state);
+
+        if (i > 0)
+        {
+            path.lineTo(slotPosition(slot));
+        }
+    }
+
+    m_probePath = new QGraphicsPathItem(path);
+    m_probePath->setPen(QPen(QColor(255, 200, 0), 2, Qt::DashLine));
+    m_probePath->setZValue(1);
+    m_scene->addItem(m_probePath);
+}
+
+void HashTableVisualization::clearHighlights()
+{
+    for (GraphicsBucketItem* bucket : m_buckets)
+    {
+        bucket->setProbeState(GraphicsBucketItem::ProbeState::None);
+    }
+
+    if (m_probePath)
+    {
+        m_scene->removeItem(m_probePath);
+        delete m_probePath;
+        m_probePath = nullptr;
+    }
+}
+
+void HashTableVisualization::onStructureChanged()
+{
+    // Пока емкость не менялась, перерисовываем содержимое существующих слотов
+    if (m_table && m_buckets.size() == m_table->slotCount())
+    {
+        clearHighlights();
+        syncBuckets();
+        return;
+    }
+
+    rebuildVisualization();
+    fitTableToView();
+}
+
+void HashTableVisualization::onTableCleared()
+{
+    clearAllGraphics();
+    m_scene->clear();
+}
+
+void HashTableVisualization::resizeEvent(QResizeEvent* event)
+{
+    VisualizerBase::resizeEvent(event);
+    fitTableToView();
+}
+
+QRectF HashTableVisualization::overviewRect() const
+{
+    return m_layoutBounds;
+}
+
+QPointF HashTableVisualization::slotPosition(int slot) const
+{
+    const int capacity = m_table ? m_table->capacity() : 0;
+    qreal y = (slot / kSlotsPerRow) * m_cellHeight;
+
+    // Хвост начинается с новой строки (capacity кратна 16) и отделен зазором
+    if (slot >= capacity)
+    {
+        y += m_tailGap;
+    }
+
+    return QPointF((slot % kSlotsPerRow) * m_cellWidth, y);
+}
+
+void HashTableVisualization::clearAllGraphics()
+{
+    clearHighlights();
+
+    for (GraphicsBucketItem* bucket : m_buckets)
+    {
+        m_scene->removeItem(bucket);
+        delete bucket;
+    }
+    m_buckets.clear();
+
+    m_layoutBounds = QRectF();
+}
+
+void HashTableVisualization::rebuildVisualization()
+{
+    clearAllGraphics();
+
+    if (!m_table) return;
+
+    const int slotCount = m_table->slotCount();
+    m_buckets.reserve(slotCount);
+
+    for (int slot = 0; slot < slotCount; ++slot)
+    {
+        GraphicsBucketItem* bucket = new GraphicsBucketItem(slot);
+        bucket->setSize(m_cellWidth - 4.0, m_cellHeight - 4.0);
+        bucket->setPos(slotPosition(slot));
+        m_scene->addItem(bucket);
+        m_buckets.append(bucket);
+        m_layoutBounds |= bucket->sceneBoundingRect();
+    }
+    m_layoutBounds.adjust(-50, -50, 50, 50);
+
+    syncBuckets();
+
+    updateMinimapBounds();
+    invalidateMinimap();
+}
+
+void HashTableVisualization::syncBuckets()
+{
+    for (GraphicsBucketItem* bucket : m_buckets)
+    {
+        const int slot = bucket->slot();
+        if (m_table->isOccupied(slot))
+        {
+            bucket->setEntry(m_table->keyAt(slot), m_table->probeDistance(slot));
+        }
+        else
+        {
+            bucket->setEmpty();
+        }
+    }
+
+    invalidateMinimap();
+}
+
+void HashTableVisualization::fitTableToView()
+{
+    if (m_layoutBounds.isEmpty()) return;
+
+    m_view->resetTransform();
+    m_view->fitInView(m_layoutBounds, Qt::KeepAspectRatio);
+    if (m_minimap) m_minimap->update();
+}
@@ -0,0 +1,66 @@
+#ifndef HASH_TABLE_VISUALIZATION_H
+#define HASH_TABLE_VISUALIZATION_H
+
+#include <QVector>
+#include <QResizeEvent>
+#include <QGraphicsPathItem>
+
+#include "../../../core/internal/hash_table/robin_hood_table.h"
+#include "base/visualizer_base.h"
+#include "base/graphics_bucket_item.h"
+
+// Слоты хэш-таблицы сеткой по kSlotsPerRow - ровно одна SIMD-группа в строке.
+// Хвост переполнения за capacity рисуется отдельно, под основной сеткой.
+class HashTableVisualization : public VisualizerBase
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kSlotsPerRow = RobinHoodHashTable::kGroupWidth;
+
+    explicit HashTableVisualization(QWidget* parent = nullptr);
+    ~HashTableVisualization();
+
+    void setStructure(QObject* structure) override;
+    void clear() override;
+    void updateVisualization() override;
+
+    void setTable(RobinHoodHashTable* table);
+    RobinHoodHashTable* table() const { return m_table; }
+
+    // Показывает последовательность проб для ключа: домашний слот, просмотренные и найденный
+    void highlightProbeSequence(int key);
+    void clearHighlights();
+
+public slots:
+    void onStructureChanged();
+    void onTableCleared();
+
+signals:
+    void visualizationUpdated();
+
+protected:
+    void resizeEvent(QResizeEvent* event) override;
+    QRectF overviewRect() const override;
+
+private:
+    RobinHoodHashTable* m_table = nullptr;
+
+    QVector<GraphicsBucketItem*> m_buckets;     // По номеру слота
+    QGraphicsPathItem* m_probePath = nullptr;
+    QRectF m_layoutBounds;
+
+    qreal m_cellWidth = 52.0;
+    qreal m_cellHeight = 44.0;
+    qreal m_tailGap = 30.0;
+
+    void rebuildVisualization();
+    void syncBuckets();
+    void clearAllGraphics();
+    void fitTableToView();
+    QPointF slotPosition(int slot) const;
+
+    Q_DISABLE_COPY(HashTableVisualization)
+};
+
+#endif // HASH_TABLE_VISUALIZATION_H
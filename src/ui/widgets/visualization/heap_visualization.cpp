@@ -0,0 +1,223 @@
+#include "heap_visualization.h"
+#include "base/minimap_widget.h"
+
+#include <cmath>
+
+HeapVisualization::HeapVisualization(QWidget* parent)
+    : VisualizerBase(parent)
+{
+    m_scene->setBackgroundBrush(QBrush(QColor(80, 80, 80)));
+}
+
+HeapVisualization::~HeapVisualization()
+{
+    clearAllGraphics();
+}
+
+void HeapVisualization::setStructure(QObject* structure)
+{
+    if (auto* heap = qobject_cast<DaryHeap*>(structure))
+    {
+        setHeap(heap);
+    }
+}
+
+void HeapVisualization::clear()
+{
+    clearAllGraphics();
+    m_heap = nullptr;
+    m_scene->clear();
+}
+
+void HeapVisualization::updateVisualization()
+{
+    if (!m_heap) return;
+
+    rebuildVisualization();
+    fitHeapToView();
+
+    emit visualizationUpdated();
+}
+
+void HeapVisualization::setHeap(DaryHeap* heap)
+{
+    if (m_heap == heap) return;
+
+    if (m_heap)
+    {
+        disconnect(m_heap, nullptr, this, nullptr);
+    }
+
+    m_heap = heap;
+
+    if (m_heap)
+    {
+        connect(m_heap, &DaryHeap::structureChanged,
+                this, &HeapVisualization::onStructureChanged);
+        connect(m_heap, &DaryHeap::heapCleared,
+                this, &HeapVisualization::onHeapCleared);
+
+        updateVisualization();
+    }
+    else
+    {
+        clear();
+    }
+}
+
+void HeapVisualization::highlightIndex(int index)
+{
+    clearHighlights();
+
+    if (index < 0 || index >= m_nodes.size()) return;
+
+    m_nodes[index]->setHighlighted(true);
+    if (m_arrayItem)
+    {
+        m_arrayItem->setHighlightedCell(index);
+    }
+}
+
+void HeapVisualization::clearHighlights()
+{
+    for (GraphicsNode* gNode : m_nodes)
+    {
+        gNode->setHighlighted(false);
+    }
+
+    if (m_arrayItem)
+    {
+        m_arrayItem->setHighlightedCell(-1);
+    }
+}
+
+void HeapVisualization::onStructureChanged()
+{
+    rebuildVisualization();
+    fitHeapToView();
+}
+
+void HeapVisualization::onHeapCleared()
+{
+    clearAllGraphics();
+    m_scene->clear();
+}
+
+void HeapVisualization::resizeEvent(QResizeEvent* event)
+{
+    VisualizerBase::resizeEvent(event);
+    fitHeapToView();
+}
+
+QRectF HeapVisualization::overviewRect() const
+{
+    return m_layoutBounds;
+}
+
+void HeapVisualization::clearAllGraphics()
+{
+    for (GraphicsEdge* edge : m_edges)
+    {
+        m_scene->removeItem(edge);
+        delete edge;
+    }
+    m_edges.clear();
+
+    for (GraphicsNode* gNode : m_nodes)
+    {
+        m_scene->removeItem(gNode);
+        delete gNode;
+    }
+    m_nodes.clear();
+
+    if (m_arrayItem)
+    {
+        m_scene->removeItem(m_arrayItem);
+        delete m_arrayItem;
+        m_arrayItem = nullptr;
+    }
+
+    m_layoutBounds = QRectF();
+}
+
+void HeapVisualization::rebuildVisualization()
+{
+    clearAllGraphics();
+
+    if (!m_heap || m_heap->isEmpty()) return;
+
+    const int count = m_heap->size();
+    const int arity = m_heap->arity();
+
+    // Уровень l начинается с индекса (d^l - 1) / (d - 1); считаем число уровней
+    int levels = 0;
+    for (qint64 levelStart = 0, levelSize = 1; levelStart < count; levelStart += levelSize, levelSize *= arity)
+    {
+        ++levels;
+    }
+
+    // Нижний уровень задает ширину: d^(levels - 1) слотов
+    const qreal slotWidth = m_horizontalSpacing;
+    qint64 levelStart = 0;
+    qint64 levelSize = 1;
+    qreal slotsPerNode = std::pow(qreal(arity), levels - 1);
+
+    m_nodes.reserve(count);
+    for (int level = 0; level < levels; ++level)
+    {
+        for (qint64 i = levelStart; i < qMin<qint64>(levelStart + levelSize, count); ++i)
+        {
+            GraphicsNode* gNode = new GraphicsNode(m_heap->priorityAt(int(i)));
+            gNode->setRadius(m_nodeRadius);
+            gNode->setTextColor(Qt::white);
+
+            const qreal position = qreal(i - levelStart);
+            gNode->setPos((position + 0.5) * slotsPerNode * slotWidth, level * m_verticalSpacing);
+
+            m_scene->addItem(gNode);
+            m_nodes.append(gNode);
+            m_layoutBounds |= gNode->sceneBoundingRect();
+        }
+
+        levelStart += levelSize;
+        levelSize *= arity;
+        slotsPerNode /= arity;
+    }
+
+    for (int i = 1; i < count; ++i)
+    {
+        GraphicsEdge* edge = new GraphicsEdge(m_nodes[m_heap->parentIndex(i)], m_nodes[i]);
+        edge->setColor(QColor(70, 130, 180));
+        edge->setWidth(2.0);
+        m_scene->addItem(edge);
+        m_edges.append(edge);
+    }
+
+    // Массив-хранилище под деревом, выровненный по левому краю дерева
+    QVector<int> priorities;
+    priorities.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        priorities.append(m_heap->priorityAt(i));
+    }
+
+    m_arrayItem = new GraphicsKeyNode(priorities);
+    m_arrayItem->setBaseColor(QColor(60, 179, 113));
+    m_arrayItem->setPos(m_arrayItem->width() / 2.0, levels * m_verticalSpacing + m_arrayGap);
+    m_scene->addItem(m_arrayItem);
+    m_layoutBounds |= m_arrayItem->sceneBoundingRect();
+
+    m_layoutBounds.adjust(-50, -50, 50, 50);
+
+    updateMinimapBounds();
+    invalidateMinimap();
+}
+
+void HeapVisualization::fitHeapToView()
+{
+    if (m_layoutBounds.isEmpty()) return;
+
+    m_view->resetTransform();
+    m_view->fitInView(m_layoutBounds, Qt::KeepAspectRatio);
+    if (m_minimap) m_minimap->update();
+}
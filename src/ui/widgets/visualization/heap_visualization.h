@@ -0,0 +1,65 @@
+#ifndef HEAP_VISUALIZATION_H
+#define HEAP_VISUALIZATION_H
+
+#include <QVector>
+#include <QResizeEvent>
+
+#include "../../../core/internal/heap/dary_heap.h"
+#include "base/visualizer_base.h"
+#include "base/graphics_node.h"
+#include "base/graphics_edge.h"
+#include "base/graphics_key_node.h"
+
+// Рисует d-арную кучу двумя способами сразу: неявное дерево сверху
+// и массив, в котором оно на самом деле хранится, снизу
+class HeapVisualization : public VisualizerBase
+{
+    Q_OBJECT
+
+public:
+    explicit HeapVisualization(QWidget* parent = nullptr);
+    ~HeapVisualization();
+
+    void setStructure(QObject* structure) override;
+    void clear() override;
+    void updateVisualization() override;
+
+    void setHeap(DaryHeap* heap);
+    DaryHeap* heap() const { return m_heap; }
+
+    // Подсвечивает элемент и в дереве, и в массиве
+    void highlightIndex(int index);
+    void clearHighlights();
+
+public slots:
+    void onStructureChanged();
+    void onHeapCleared();
+
+signals:
+    void visualizationUpdated();
+
+protected:
+    void resizeEvent(QResizeEvent* event) override;
+    QRectF overviewRect() const override;
+
+private:
+    DaryHeap* m_heap = nullptr;
+
+    QVector<GraphicsNode*> m_nodes;     // По индексу в массиве кучи
+    QVector<GraphicsEdge*> m_edges;
+    GraphicsKeyNode* m_arrayItem = nullptr;
+    QRectF m_layoutBounds;
+
+    qreal m_nodeRadius = 20.0;
+    qreal m_horizontalSpacing = 50.0;
+    qreal m_verticalSpacing = 90.0;
+    qreal m_arrayGap = 70.0;
+
+    void rebuildVisualization();
+    void clearAllGraphics();
+    void fitHeapToView();
+
+    Q_DISABLE_COPY(HeapVisualization)
+};
+
+#endif // HEAP_VISUALIZATION_H
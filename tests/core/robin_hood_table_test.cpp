@@ -0,0 +1,158 @@
+// Тесты RobinHoodHashTable против std::set при заполненности 0.5, 0.75 и 0.95:
+// случайные вставки, удаления и поиски дают те же ответы, что и std::set,
+// а слоты таблицы после каждой серии операций остаются согласованными.
+#include <QTest>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../../src/core/internal/hash_table/robin_hood_table.h"
+
+namespace
+{
+// Сверяет слоты таблицы с эталоном: дистанция каждого элемента равна
+// расстоянию от домашнего слота, соседи по кластеру отличаются не больше
+// чем на 1 (иначе Robin Hood поменял бы их местами), все ключи находятся
+void verifyTable(const RobinHoodHashTable& table, const std::set<int>& expected)
+{
+    int occupied = 0;
+    int previousDistance = -1;
+    for (int slot = 0; slot < table.slotCount(); ++slot) {
+        if (!table.isOccupied(slot)) {
+            previousDistance = -1;
+            continue;
+        }
+        ++occupied;
+
+        const int key = table.keyAt(slot);
+        const int distance = table.probeDistance(slot);
+        QVERIFY2(expected.count(key) == 1, qPrintable(QString("unexpected key %1").arg(key)));
+        QCOMPARE(distance, slot - table.homeSlot(key));
+        QVERIFY(distance <= RobinHoodHashTable::kMaxProbe);
+        QVERIFY(distance <= previousDistance + 1);
+        previousDistance = distance;
+    }
+
+    QCOMPARE(occupied, int(expected.size()));
+    QCOMPARE(table.size(), int(expected.size()));
+    QVERIFY(table.loadFactor() <= table.maxLoadFactor());
+    for (int key : expected) {
+        QCOMPARE(table.findSlot(key) >= 0, true);
+    }
+}
+}
+
+class RobinHoodTableTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void matchesStdSet_data();
+    void matchesStdSet();
+    void fillsToMaxLoadFactor_data();
+    void fillsToMaxLoadFactor();
+    void largeTableReachesHighLoad();
+};
+
+void RobinHoodTableTest::matchesStdSet_data()
+{
+    QTest::addColumn<double>("maxLoadFactor");
+    QTest::newRow("0.5") << 0.5;
+    QTest::newRow("0.75") << 0.75;
+    QTest::newRow("0.95") << 0.95;
+}
+
+void RobinHoodTableTest::matchesStdSet()
+{
+    QFETCH(double, maxLoadFactor);
+
+    RobinHoodHashTable table(maxLoadFactor);
+    std::set<int> expected;
+    std::mt19937 random(7);
+    // Узкий диапазон ключей: много повторных вставок и удалений существующих
+    std::uniform_int_distribution<int> key(-3000, 3000);
+    std::uniform_int_distribution<int> operation(0, 9);
+
+    for (int round = 0; round < 40; ++round) {
+        for (int i = 0; i < 500; ++i) {
+            const int value = key(random);
+            const int kind = operation(random);
+            // Первая половина раундов растит таблицу, вторая - опустошает
+            const int insertShare = round < 20 ? 5 : 2;
+            if (kind < insertShare) {
+                QCOMPARE(table.insert(value), expected.insert(value).second);
+            } else if (kind < 8) {
+                QCOMPARE(table.remove(value), expected.erase(value) == 1);
+            } else {
+                QCOMPARE(table.contains(value), expected.count(value) == 1);
+            }
+        }
+        verifyTable(table, expected);
+        if (QTest::currentTestFailed()) return;
+    }
+}
+
+void RobinHoodTableTest::fillsToMaxLoadFactor_data()
+{
+    matchesStdSet_data();
+}
+
+void RobinHoodTableTest::fillsToMaxLoadFactor()
+{
+    QFETCH(double, maxLoadFactor);
+
+    // Заполняем ровно до maxLoadFactor: reserve не должен выделить больше слотов
+    constexpr int kCapacity = 1 << 14;
+    const int count = int(kCapacity * maxLoadFactor);
+    RobinHoodHashTable table(maxLoadFactor);
+    table.reserve(count);
+    QCOMPARE(table.capacity(), kCapacity);
+
+    std::set<int> expected;
+    std::mt19937 random(11);
+    std::uniform_int_distribution<int> key(0, 1 << 30);
+    while (int(expected.size()) < count) {
+        const int value = key(random);
+        QCOMPARE(table.insert(value), expected.insert(value).second);
+    }
+    verifyTable(table, expected);
+    if (QTest::currentTestFailed()) return;
+
+    // Удаление со сдвигом назад сохраняет инварианты на плотной таблице
+    std::vector<int> keys(expected.begin(), expected.end());
+    std::shuffle(keys.begin(), keys.end(), random);
+    for (std::size_t i = 0; i < keys.size() / 2; ++i) {
+        QVERIFY(table.remove(keys[i]));
+        expected.erase(keys[i]);
+    }
+    verifyTable(table, expected);
+}
+
+void RobinHoodTableTest::largeTableReachesHighLoad()
+{
+    // На больших таблицах при 0.95 цепочки длиннее, чем на 2^14: рост
+    // из-за переполнения пробы вдвое опустил бы заполненность
+    constexpr int kCapacity = 1 << 20;
+    constexpr double kMaxLoadFactor = 0.95;
+    const int count = int(kCapacity * kMaxLoadFactor);
+    RobinHoodHashTable table(kMaxLoadFactor);
+    table.reserve(count);
+    QCOMPARE(table.capacity(), kCapacity);
+
+    std::set<int> expected;
+    std::mt19937 random(13);
+    std::uniform_int_distribution<int> key(0, 1 << 30);
+    while (int(expected.size()) < count) {
+        const int value = key(random);
+        QCOMPARE(table.insert(value), expected.insert(value).second);
+    }
+
+    QCOMPARE(table.capacity(), kCapacity);
+    QVERIFY(table.loadFactor() > 0.949);
+    verifyTable(table, expected);
+}
+
+QTEST_GUILESS_MAIN(RobinHoodTableTest)
+#include "robin_hood_table_test.moc"
@@ -0,0 +1,263 @@
+// Тесты BinaryTree::unionWith/intersectWith/differenceWith против
+// std::set_union/set_intersection/set_difference. После каждой операции
+// проверяются ключи по порядку, size(), ссылки родитель-ребенок, свойство
+// кучи по TreeJoin::priority, QObject-владелец узлов и пустота other.
+#include <QTest>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../../src/core/internal/binary_tree/binary_tree.h"
+
+namespace
+{
+enum class SetOp
+{
+    Union,
+    Intersection,
+    Difference
+};
+
+void apply(SetOp op, BinaryTree& tree, BinaryTree& other)
+{
+    switch (op) {
+    case SetOp::Union: tree.unionWith(other); break;
+    case SetOp::Intersection: tree.intersectWith(other); break;
+    case SetOp::Difference: tree.differenceWith(other); break;
+    }
+}
+
+std::vector<int> expectedKeys(SetOp op, const std::set<int>& a, const std::set<int>& b)
+{
+    std::vector<int> result;
+    auto out = std::back_inserter(result);
+    switch (op) {
+    case SetOp::Union: std::set_union(a.begin(), a.end(), b.begin(), b.end(), out); break;
+    case SetOp::Intersection: std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), out); break;
+    case SetOp::Difference: std::set_difference(a.begin(), a.end(), b.begin(), b.end(), out); break;
+    }
+    return result;
+}
+
+// count ключей из [0, range); с duplicates каждый десятый вставляется дважды.
+// Порядок вставки случайный: дерево не декартово и перед операцией перестраивается
+std::set<int> fillTree(BinaryTree& tree, int count, int range, bool duplicates, std::uint32_t seed)
+{
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> key(0, std::max(0, range - 1));
+    std::set<int> keys;
+    while (int(keys.size()) < count) {
+        const int value = key(random);
+        if (!keys.insert(value).second) continue;
+        tree.insert(value);
+        if (duplicates && keys.size() % 10 == 0) {
+            tree.insert(value);
+        }
+    }
+    return keys;
+}
+
+// Узлы по порядку ключей, без рекурсии
+std::vector<TreeNode*> inOrder(const BinaryTree& tree)
+{
+    std::vector<TreeNode*> nodes;
+    std::vector<TreeNode*> stack;
+    TreeNode* node = tree.root();
+
+    while (node || !stack.empty()) {
+        while (node) {
+            stack.push_back(node);
+            node = node->left();
+        }
+        node = stack.back();
+        stack.pop_back();
+        nodes.push_back(node);
+        node = node->right();
+    }
+    return nodes;
+}
+
+std::vector<int> inOrderKeys(const BinaryTree& tree)
+{
+    std::vector<int> keys;
+    for (TreeNode* node : inOrder(tree)) {
+        keys.push_back(node->value());
+    }
+    return keys;
+}
+
+// Результат операции: ключи, ссылки, декартовость и владелец каждого узла
+void verifyTree(const BinaryTree& tree, const std::vector<int>& expected)
+{
+    if (tree.root()) QVERIFY(!tree.root()->parent());
+
+    std::vector<int> keys;
+    for (TreeNode* node : inOrder(tree)) {
+        QVERIFY(static_cast<QObject*>(node)->parent() == &tree);
+        for (TreeNode* child : {node->left(), node->right()}) {
+            if (!child) continue;
+            QCOMPARE(child->parent(), node);
+            QVERIFY(TreeJoin::priority(child->value()) <= TreeJoin::priority(node->value()));
+        }
+        keys.push_back(node->value());
+    }
+
+    QCOMPARE(int(keys.size()), int(expected.size()));
+    QVERIFY(keys == expected);
+    QCOMPARE(tree.size(), int(expected.size()));
+    QCOMPARE(tree.isEmpty(), expected.empty());
+}
+}
+
+class TreeJoinTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void matchesStdSetAlgorithms_data();
+    void matchesStdSetAlgorithms();
+    void operationWithItself();
+    void treapInputsAreReused();
+
+private:
+    int m_savedThreadCount = 0;
+};
+
+void TreeJoinTest::initTestCase()
+{
+    // Параллельные ветви нужны и на одноядерной машине: иначе выше порога
+    // parallelDepthFor вернет 0 и parallelInvoke не будет вызван
+    QThreadPool* pool = QThreadPool::globalInstance();
+    m_savedThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(std::max(4, m_savedThreadCount));
+}
+
+void TreeJoinTest::cleanupTestCase()
+{
+    QThreadPool::globalInstance()->setMaxThreadCount(m_savedThreadCount);
+}
+
+void TreeJoinTest::matchesStdSetAlgorithms_data()
+{
+    QTest::addColumn<int>("op");
+    QTest::addColumn<int>("sizeA");
+    QTest::addColumn<int>("sizeB");
+    QTest::addColumn<bool>("duplicates");
+
+    const struct
+    {
+        const char* name;
+        SetOp op;
+    } ops[] = {{"union", SetOp::Union}, {"intersection", SetOp::Intersection}, {"difference", SetOp::Difference}};
+
+    // Порог параллельности - TreeJoin::kParallelMinNodes (16K) узлов на двоих
+    const struct
+    {
+        const char* name;
+        int sizeA;
+        int sizeB;
+        bool duplicates;
+    } shapes[] = {
+        {"small", 200, 150, false},
+        {"duplicates", 300, 300, true},
+        {"empty a", 0, 500, false},
+        {"empty b", 500, 0, false},
+        {"both empty", 0, 0, false},
+        {"below cutoff", 6000, 6000, false},
+        {"above cutoff", 20000, 20000, true},
+        {"large a small b", 40000, 100, false},
+        {"small a large b", 100, 40000, false},
+    };
+
+    for (const auto& op : ops) {
+        for (const auto& shape : shapes) {
+            const QByteArray name = QByteArray(op.name) + ' ' + shape.name;
+            QTest::newRow(name.constData()) << int(op.op) << shape.sizeA << shape.sizeB << shape.duplicates;
+        }
+    }
+}
+
+void TreeJoinTest::matchesStdSetAlgorithms()
+{
+    QFETCH(int, op);
+    QFETCH(int, sizeA);
+    QFETCH(int, sizeB);
+    QFETCH(bool, duplicates);
+
+    // Общий диапазон вдвое шире суммы: ключи частично пересекаются
+    const int range = 2 * (sizeA + sizeB) + 1;
+    BinaryTree a;
+    BinaryTree b;
+    const std::set<int> keysA = fillTree(a, sizeA, range, duplicates, 1);
+    const std::set<int> keysB = fillTree(b, sizeB, range, duplicates, 2);
+
+    apply(SetOp(op), a, b);
+
+    verifyTree(a, expectedKeys(SetOp(op), keysA, keysB));
+    if (QTest::currentTestFailed()) return;
+    QVERIFY(b.isEmpty());
+    QCOMPARE(b.size(), 0);
+    QVERIFY(!b.root());
+
+    // Пустое other пригодно для дальнейшей работы
+    b.insert(7);
+    QCOMPARE(b.size(), 1);
+    QVERIFY(b.find(7));
+}
+
+void TreeJoinTest::operationWithItself()
+{
+    // A ∪ A = A ∩ A = A: дерево не трогается, даже повторы ключей остаются
+    BinaryTree tree;
+    fillTree(tree, 1000, 5000, true, 3);
+    const std::vector<int> before = inOrderKeys(tree);
+    const int size = tree.size();
+
+    tree.unionWith(tree);
+    QCOMPARE(tree.size(), size);
+    QVERIFY(inOrderKeys(tree) == before);
+    tree.intersectWith(tree);
+    QCOMPARE(tree.size(), size);
+    QVERIFY(inOrderKeys(tree) == before);
+
+    // A \ A - пусто
+    tree.differenceWith(tree);
+    verifyTree(tree, {});
+}
+
+void TreeJoinTest::treapInputsAreReused()
+{
+    // Первая операция перестраивает оба дерева, вторая идет по уже
+    // декартовым: результат и пустое other после нее
+    BinaryTree a;
+    BinaryTree b;
+    BinaryTree c;
+    std::set<int> keysA = fillTree(a, 20000, 80000, false, 4);
+    const std::set<int> keysB = fillTree(b, 15000, 80000, false, 5);
+    const std::set<int> keysC = fillTree(c, 15000, 80000, false, 6);
+
+    a.unionWith(b);
+    std::vector<int> expected = expectedKeys(SetOp::Union, keysA, keysB);
+    verifyTree(a, expected);
+    if (QTest::currentTestFailed()) return;
+
+    // c становится декартовым через объединение с пустым деревом
+    BinaryTree empty;
+    c.unionWith(empty);
+    verifyTree(c, std::vector<int>(keysC.begin(), keysC.end()));
+    if (QTest::currentTestFailed()) return;
+
+    keysA = std::set<int>(expected.begin(), expected.end());
+    a.differenceWith(c);
+    verifyTree(a, expectedKeys(SetOp::Difference, keysA, keysC));
+    QVERIFY(c.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TreeJoinTest)
+#include "tree_join_test.moc"
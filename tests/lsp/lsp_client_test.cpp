@@ -0,0 +1,422 @@
+// Тесты LSPClient и LSPFrameParser. Клиент говорит с mock_lsp_server
+// (путь приходит из CMake в MOCK_LSP_SERVER_PATH), который режет каждый
+// кадр на куски и ведет журнал всего, что получил.
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include <memory>
+#include <optional>
+
+#include "../../src/ui/widgets/intelli_sense_widget/LSP/LSP_client.h"
+#include "../../src/ui/widgets/intelli_sense_widget/LSP/LSP_frame_parser.h"
+
+namespace
+{
+constexpr int kTimeoutMs = 5000;
+const QString kUri = QStringLiteral("file:///mock/main.cpp");
+
+QByteArray frame(const QByteArray& body, const QByteArray& headerName = "Content-Length")
+{
+    return headerName + ": " + QByteArray::number(body.size()) + "\r\n\r\n" + body;
+}
+
+QStringList loggedMethods(const QJsonArray& log)
+{
+    QStringList methods;
+    for (const QJsonValue& entry : log) {
+        if (entry.toObject().contains("method")) {
+            methods.append(entry.toObject().value("method").toString());
+        }
+    }
+    return methods;
+}
+
+// Параметры уведомлений method в журнале заглушки, по порядку
+QVector<QJsonObject> loggedParams(const QJsonArray& log, const QString& method)
+{
+    QVector<QJsonObject> params;
+    for (const QJsonValue& entry : log) {
+        if (entry.toObject().value("method").toString() == method) {
+            params.append(entry.toObject().value("params").toObject());
+        }
+    }
+    return params;
+}
+
+QJsonObject changeRange(int startLine, int startCharacter, int endLine, int endCharacter)
+{
+    return QJsonObject{
+        {"start", QJsonObject{{"line", startLine}, {"character", startCharacter}}},
+        {"end", QJsonObject{{"line", endLine}, {"character", endCharacter}}}
+    };
+}
+
+// Индекс ответа клиента на запрос сервера с этим id или -1
+int responseIndex(const QJsonArray& log, int id)
+{
+    for (int i = 0; i < log.size(); ++i) {
+        if (log[i].toObject().value("response").toInt(-1) == id) return i;
+    }
+    return -1;
+}
+}
+
+class LSPClientTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void frameParserSplitsAcrossReads();
+    void frameParserSkipsMalformedHeaders();
+    void initializeQueuesUntilReady();
+    void serverRequestsGetReplies();
+    void joinedWaiterCancelKeepsSharedRequest();
+    void lastWaiterCancelSendsCancelRequest();
+    void serverCancellationReleasesSharedRequest();
+    void changesWithinDebounceWindowCoalesce();
+    void newCompletionCancelsStaleOne();
+    void editAfterHoverKeepsCachedHover();
+    void editBeforeOrOverHoverEvictsIt();
+    void anyEditEvictsWholeDocumentTokens();
+
+private:
+    // Запускает клиента с заглушкой и ждет ready; документ kUri открыт
+    std::unique_ptr<LSPClient> startClient();
+    // Запрос к заглушке с ожиданием ответа. Заглушка отвечает после
+    // ответов, которые этот запрос вызвал, поэтому их обработчики уже отработали
+    static bool call(LSPClient& client, const QString& method, QJsonValue* result = nullptr);
+    static QJsonArray serverLog(LSPClient& client);
+};
+
+std::unique_ptr<LSPClient> LSPClientTest::startClient()
+{
+    auto client = std::make_unique<LSPClient>();
+    QSignalSpy readySpy(client.get(), &LSPClient::ready);
+
+    if (!client->start(QStringLiteral(MOCK_LSP_SERVER_PATH), {}, QStringLiteral("file:///mock"))) return {};
+    client->openDocument(kUri, "cpp", "int value = 0;\nint other = value;\n");
+    if (!readySpy.wait(kTimeoutMs)) return {};
+
+    return client;
+}
+
+bool LSPClientTest::call(LSPClient& client, const QString& method, QJsonValue* result)
+{
+    // Ответ может прийти и после таймаута - состояние не на стеке
+    const auto reply = std::make_shared<std::optional<QJsonValue>>();
+    client.sendRequest(method, QJsonValue(), [reply](const QJsonValue& value, const QJsonObject&) {
+        *reply = value;
+    });
+    if (!QTest::qWaitFor([reply]() { return reply->has_value(); }, kTimeoutMs)) return false;
+
+    if (result) *result = **reply;
+    return true;
+}
+
+QJsonArray LSPClientTest::serverLog(LSPClient& client)
+{
+    QJsonValue log;
+    return call(client, "mock/log", &log) ? log.toArray() : QJsonArray();
+}
+
+void LSPClientTest::frameParserSplitsAcrossReads()
+{
+    // Второе тело с многобайтовым UTF-8: длина в байтах, а не в символах
+    const QByteArray first = frame(R"({"id":1,"result":null})");
+    const QByteArray second = frame(R"({"id":2,"result":"значение"})", "content-length");
+    const QByteArray stream = first + second;
+
+    LSPFrameParser parser;
+    QList<int> ids;
+    QList<qsizetype> completedAt;
+
+    // По байту: разрезы приходятся и на заголовок, и на \r\n\r\n, и на тело
+    for (qsizetype i = 0; i < stream.size(); ++i) {
+        for (const QJsonDocument& document : parser.feed(stream.mid(i, 1))) {
+            ids.append(document.object().value("id").toInt());
+            completedAt.append(i);
+        }
+    }
+
+    QCOMPARE(ids, QList<int>({1, 2}));
+    QCOMPARE(completedAt, QList<qsizetype>({first.size() - 1, stream.size() - 1}));
+    QCOMPARE(parser.bufferedBytes(), 0);
+    QVERIFY(!parser.hadError());
+
+    // Два кадра и начало третьего одним куском
+    parser.reset();
+    const QByteArray third = frame(R"({"id":3})");
+    QCOMPARE(parser.feed(stream + third.left(5)).size(), 2);
+    QCOMPARE(parser.bufferedBytes(), 5);
+    const QVector<QJsonDocument> rest = parser.feed(third.mid(5));
+    QCOMPARE(rest.size(), 1);
+    QCOMPARE(rest.first().object().value("id").toInt(), 3);
+}
+
+void LSPClientTest::frameParserSkipsMalformedHeaders()
+{
+    LSPFrameParser parser;
+    const QByteArray stream = QByteArray("Content-Type: application/vscode-jsonrpc\r\n\r\n")
+                              + frame(R"({"id":7})");
+
+    const QVector<QJsonDocument> messages = parser.feed(stream);
+    QCOMPARE(messages.size(), 1);
+    QCOMPARE(messages.first().object().value("id").toInt(), 7);
+    QVERIFY(parser.hadError());
+}
+
+void LSPClientTest::initializeQueuesUntilReady()
+{
+    LSPClient client;
+    QSignalSpy readySpy(&client, &LSPClient::ready);
+
+    QVERIFY(client.start(QStringLiteral(MOCK_LSP_SERVER_PATH), {}, QStringLiteral("file:///mock")));
+    QCOMPARE(client.state(), LSPClient::State::Initializing);
+
+    // Уходят в очередь: сервер не должен увидеть их раньше initialized
+    client.openDocument(kUri, "cpp", "int value = 0;\n");
+    const QJsonArray log = serverLog(client);
+
+    QCOMPARE(readySpy.count(), 1);
+    QVERIFY(client.isReady());
+    QCOMPARE(loggedMethods(log),
+             QStringList({"initialize", "initialized", "textDocument/didOpen", "mock/log"}));
+}
+
+void LSPClientTest::serverRequestsGetReplies()
+{
+    const std::unique_ptr<LSPClient> client = startClient();
+    QVERIFY(client);
+
+    const QJsonArray log = serverLog(*client);
+    const int configuration = responseIndex(log, 9001);
+    const int unknown = responseIndex(log, 9002);
+    QVERIFY(configuration >= 0);
+    QVERIFY(unknown >= 0);
+
+    // Известный запрос - пустой результат, неизвестный - MethodNotFound
+    QVERIFY(log[configuration].toObject().contains("result"));
+    QCOMPARE(log[unknown].toObject().value("error").toInt(), -32601);
+
+    // Сервер спросил до ответа на initialize - клиент ответил сразу, не в очередь
+    int initialized = -1;
+    for (int i = 0; i < log.size() && initialized < 0; ++i) {
+        if (log[i].toObject().value("method").toString() == "initialized") {
+            initialized = i;
+        }
+    }
+    QVERIFY(initialized >= 0);
+    QVERIFY(configuration < initialized);
+    QVERIFY(unknown < initialized);
+}
+
+void LSPClientTest::joinedWaiterCancelKeepsSharedRequest()
+{
+    const std::unique_ptr<LSPClient> client = startClient();
+    QVERIFY(client);
+    QSignalSpy hoverSpy(client.get(), &LSPClient::hoverReady);
+
+    const int first = client->requestHover(kUri, 0, 4);
+    const int second = client->requestHover(kUri, 0, 4);
+    QVERIFY(first > 0);
+    QVERIFY(second > 0);
+    QVERIFY(first != second);
+    QCOMPARE(client->pendingRequestCount(), 1);
+
+    // Второй ожидающий уходит, запрос к серверу нужен первому
+    client->cancelRequest(second);
+    QCOMPARE(client->pendingRequestCount(), 1);
+
+    QVERIFY(call(*client, "mock/releaseHovers"));
+    QCOMPARE(hoverSpy.count(), 1);
+    QVERIFY(!loggedMethods(serverLog(*client)).contains("$/cancelRequest"));
+
+    // Ответ попал в кэш
+    QCOMPARE(client->requestHover(kUri, 0, 4), 0);
+    QCOMPARE(hoverSpy.count(), 2);
+}
+
+void LSPClientTest::lastWaiterCancelSendsCancelRequest()
+{
+    const std::unique_ptr<LSPClient> client = startClient();
+    QVERIFY(client);
+    QSignalSpy hoverSpy(client.get(), &LSPClient::hoverReady);
+
+    const int first = client->requestHover(kUri, 0, 4);
+    const int second = client->requestHover(kUri, 0, 4);
+
+    // Отмена в порядке прихода: первый - это id самого запроса к серверу
+    client->cancelRequest(first);
+    QCOMPARE(client->pendingRequestCount(), 1);
+    client->cancelRequest(second);
+    QCOMPARE(client->pendingRequestCount(), 0);
+
+    const QJsonArray log = serverLog(*client);
+    QCOMPARE(loggedMethods(log).count("$/cancelRequest"), 1);
+    QCOMPARE(hoverSpy.count(), 0);
+
+    // Отмененный запрос не держит запись: такой же вопрос уходит заново
+    const int again = client->requestHover(kUri, 0, 4);
+    QVERIFY(again > 0);
+    QCOMPARE(client->pendingRequestCount(), 1);
+    QVERIFY(call(*client, "mock/releaseHovers"));
+    QCOMPARE(hoverSpy.count(), 1);
+}
+
+void LSPClientTest::serverCancellationReleasesSharedRequest()
+{
+    const std::unique_ptr<LSPClient> client = startClient();
+    QVERIFY(client);
+    QSignalSpy hoverSpy(client.get(), &LSPClient::hoverReady);
+
+    QVERIFY(client->requestHover(kUri, 1, 12) > 0);
+    QVERIFY(client->requestHover(kUri, 1, 12) > 0);
+
+    // Сервер сам отвечает RequestCancelled: оба ожидающих получают ошибку
+    QVERIFY(call(*client, "mock/cancelHovers"));
+    QCOMPARE(client->pendingRequestCount(), 0);
+    QCOMPARE(hoverSpy.count(), 0);
+
+    // Новый запрос не присоединяется к мертвой записи
+    QVERIFY(client->requestHover(kUri, 1, 12) > 0);
+    QCOMPARE(client->pendingRequestCount(), 1);
+    QVERIFY(call(*client, "mock/releaseHovers"));
+    QCOMPARE(hoverSpy.count(), 1);
+}
+
+void LSPClientTest::changesWithinDebounceWindowCoalesce()
+{
+    constexpr int kDebounceMs = 500;
+    const std::unique_ptr<LSPClient> client = startClient();
+    QVERIFY(client);
+    client->setDebounceInterval(kDebounceMs);
+
+    // "int value = 0;\nint other = value;\n": три правки подряд, быстрее паузы
+    client->changeDocument(kUri, 0, 12, 0, 13, "1");
+    client->changeDocument(kUri, 0, 13, 0, 13, "2");
+    client->changeDocument(kUri, 1, 4, 1, 9, "copy");
+    QCOMPARE(client->documentText(kUri), QString("int value = 12;\nint copy = value;\n"));
+
+    // Таймер еще не сработал - сервер правок не видел
+    QVERIFY(!loggedMethods(serverLog(*client)).contains("textDocument/didChange"));
+
+    QTest::qWait(kDebounceMs * 2);
+    const QVector<QJsonObject> changes = loggedParams(serverLog(*client), "textDocument/didChange");
+    QCOMPARE(changes.size(), 1);
+
+    // Одна версия после didOpen (версия 1) и все правки по порядку
+    const QJsonObject document = changes.first().value("textDocument").toObject();
+    QCOMPARE(document.value("uri").toString(), kUri);
+    QCOMPARE(document.value("version").toInt(), 2);
+
+    const QJsonArray contentChanges = changes.first().value("contentChanges").toArray();
+    const QJsonArray expected{
+        QJsonObject{{"range", changeRange(0, 12, 0, 13)}, {"text", "1"}},
+        QJsonObject{{"range", changeRange(0, 13, 0, 13)}, {"text", "2"}},
+        QJsonObject{{"range", changeRange(1, 4, 1, 9)}, {"text", "copy"}}
+    };
+    QCOMPARE(contentChanges, expected);
+}
+
+void LSPClientTest::newCompletionCancelsStaleOne()
+{
+    const std::unique_ptr<LSPClient> client = startClient();
+    QVERIFY(client);
+    QSignalSpy completionSpy(client.get(), &LSPClient::completionReady);
+
+    // Ответ на первый запрос еще не прочитан, когда уходит второй
+    const int first = client->requestCompletion(kUri, 1, 10);
+    const int second = client->requestCompletion(kUri, 1, 11);
+    QVERIFY(first > 0);
+    QVERIFY(second > first);
+    QCOMPARE(client->pendingRequestCount(), 1);
+
+    // Заглушка отвечает на дополнение сразу, поэтому ответ на первый запрос
+    // приходит уже после отмены, и клиент должен его выбросить
+    const QJsonArray log = serverLog(*client);
+    QCOMPARE(loggedMethods(log).count("textDocument/completion"), 2);
+    const QVector<QJsonObject> cancels = loggedParams(log, "$/cancelRequest");
+    QCOMPARE(cancels.size(), 1);
+    QCOMPARE(cancels.first().value("id").toInt(), first);
+
+    QCOMPARE(completionSpy.count(), 1);
+    QCOMPARE(completionSpy.first().at(2).toInt(), 11);
+    QCOMPARE(client->pendingRequestCount(), 0);
+
+    // Выброшенный ответ не попал и в кэш: та же позиция снова идет к серверу
+    QVERIFY(client->requestCompletion(kUri, 1, 10) > 0);
+}
+
+void LSPClientTest::editAfterHoverKeepsCachedHover()
+{
+    const std::unique_ptr<LSPClient> client = startClient();
+    QVERIFY(client);
+    QSignalSpy hoverSpy(client.get(), &LSPClient::hoverReady);
+
+    QVERIFY(client->requestHover(kUri, 0, 4) > 0);
+    QVERIFY(call(*client, "mock/releaseHovers"));
+    QCOMPARE(hoverSpy.count(), 1);
+
+    // Правка во второй строке: координаты первой не сдвинулись
+    client->changeDocument(kUri, 1, 4, 1, 9, "copy");
+    QCOMPARE(client->requestHover(kUri, 0, 4), 0);
+    QCOMPARE(hoverSpy.count(), 2);
+    QCOMPARE(hoverSpy.at(1).at(3).value<QJsonValue>(), hoverSpy.at(0).at(3).value<QJsonValue>());
+
+    // Правка ушла на сервер (запрос сбрасывает ее сразу), а hover - нет
+    const QJsonArray log = serverLog(*client);
+    QCOMPARE(loggedMethods(log).count("textDocument/didChange"), 1);
+    QCOMPARE(loggedMethods(log).count("textDocument/hover"), 1);
+}
+
+void LSPClientTest::editBeforeOrOverHoverEvictsIt()
+{
+    const std::unique_ptr<LSPClient> client = startClient();
+    QVERIFY(client);
+    QSignalSpy hoverSpy(client.get(), &LSPClient::hoverReady);
+
+    QVERIFY(client->requestHover(kUri, 1, 12) > 0);
+    QVERIFY(call(*client, "mock/releaseHovers"));
+    QCOMPARE(client->requestHover(kUri, 1, 12), 0);
+
+    // Правка в строке выше: "const int value = 0;" - позиция hover могла сдвинуться
+    client->changeDocument(kUri, 0, 0, 0, 0, "const ");
+    QVERIFY(client->requestHover(kUri, 1, 12) > 0);
+    QVERIFY(call(*client, "mock/releaseHovers"));
+
+    QVERIFY(client->requestHover(kUri, 0, 10) > 0);
+    QVERIFY(call(*client, "mock/releaseHovers"));
+    QCOMPARE(client->requestHover(kUri, 0, 10), 0);
+
+    // Правка начинается в позиции hover: "value" -> "count"
+    client->changeDocument(kUri, 0, 10, 0, 15, "count");
+    QVERIFY(client->requestHover(kUri, 0, 10) > 0);
+    QVERIFY(call(*client, "mock/releaseHovers"));
+
+    QCOMPARE(hoverSpy.count(), 6);
+    QCOMPARE(loggedMethods(serverLog(*client)).count("textDocument/hover"), 4);
+}
+
+void LSPClientTest::anyEditEvictsWholeDocumentTokens()
+{
+    const std::unique_ptr<LSPClient> client = startClient();
+    QVERIFY(client);
+    QSignalSpy tokensSpy(client.get(), &LSPClient::semanticTokensReady);
+
+    // Весь документ: строки 0-1 и пустая строка 2 после последнего \n
+    QVERIFY(client->requestSemanticTokens(kUri, 0, 0, 2, 0) > 0);
+    QVERIFY(QTest::qWaitFor([&tokensSpy]() { return tokensSpy.count() == 1; }, kTimeoutMs));
+    QCOMPARE(client->requestSemanticTokens(kUri, 0, 0, 2, 0), 0);
+    QCOMPARE(tokensSpy.count(), 2);
+
+    // Даже дописывание в самый конец задевает диапазон на весь документ
+    client->changeDocument(kUri, 2, 0, 2, 0, "int last = 1;\n");
+    QVERIFY(client->requestSemanticTokens(kUri, 0, 0, 2, 0) > 0);
+    QVERIFY(QTest::qWaitFor([&tokensSpy]() { return tokensSpy.count() == 3; }, kTimeoutMs));
+    QCOMPARE(loggedMethods(serverLog(*client)).count("textDocument/semanticTokens/range"), 2);
+}
+
+QTEST_GUILESS_MAIN(LSPClientTest)
+#include "lsp_client_test.moc"
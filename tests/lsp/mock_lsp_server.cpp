@@ -0,0 +1,184 @@
+// Заглушка языкового сервера для lsp_client_test: говорит по stdin/stdout
+// кадрами Content-Length и ведет себя по сценарию, который проверяет тест.
+//
+// - initialize: сначала два запроса к клиенту (workspace/configuration и
+//   неизвестный mock/unknownRequest), затем ответ с инкрементальной синхронизацией;
+// - textDocument/hover: ответ придерживается до mock/releaseHovers
+//   (результат) или до $/cancelRequest либо mock/cancelHovers (RequestCancelled);
+// - textDocument/completion и textDocument/semanticTokens/range: ответ сразу;
+// - mock/log: ответ - журнал всего полученного по порядку, у уведомлений
+//   (didChange, $/cancelRequest) - вместе с параметрами;
+// - shutdown/exit - как у настоящего сервера.
+// Каждый кадр пишется тремя кусками со сбросом между ними, чтобы клиент
+// получал заголовки и тела по частям.
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#if defined(Q_OS_WIN)
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace
+{
+constexpr int kRequestCancelled = -32800;
+constexpr int kMethodNotFound = -32601;
+
+// id запросов сервера к клиенту
+constexpr int kConfigurationRequestId = 9001;
+constexpr int kUnknownRequestId = 9002;
+
+// Пауза между кусками кадра: клиент успевает прочитать каждый отдельно
+constexpr auto kChunkPause = std::chrono::milliseconds(2);
+
+QJsonArray g_log;
+QVector<QJsonValue> g_heldHovers;      // id придержанных hover
+
+bool readFrame(QByteArray* body)
+{
+    long long length = -1;
+    char line[256];
+
+    // Заголовки до пустой строки; имя Content-Length без учета регистра
+    while (std::fgets(line, sizeof(line), stdin)) {
+        if (std::strcmp(line, "\r\n") == 0 || std::strcmp(line, "\n") == 0) {
+            if (length < 0) return false;
+
+            body->resize(qsizetype(length));
+            return std::fread(body->data(), 1, size_t(length), stdin) == size_t(length);
+        }
+        if (QByteArray(line).toLower().startsWith("content-length:")) {
+            length = QByteArray(line + 15).trimmed().toLongLong();
+        }
+    }
+    return false;
+}
+
+void writeChunk(const QByteArray& data)
+{
+    std::fwrite(data.constData(), 1, size_t(data.size()), stdout);
+    std::fflush(stdout);
+    std::this_thread::sleep_for(kChunkPause);
+}
+
+void writeMessage(QJsonObject message)
+{
+    message.insert("jsonrpc", "2.0");
+    const QByteArray body = QJsonDocument(message).toJson(QJsonDocument::Compact);
+    const QByteArray header = "Content-Length: " + QByteArray::number(body.size()) + "\r\n\r\n";
+
+    // Разрез внутри заголовка и внутри тела
+    const qsizetype headerCut = header.size() / 2;
+    writeChunk(header.left(headerCut));
+    writeChunk(header.mid(headerCut) + body.left(body.size() / 2));
+    writeChunk(body.mid(body.size() / 2));
+}
+
+void reply(const QJsonValue& id, const QJsonValue& result)
+{
+    writeMessage(QJsonObject{{"id", id}, {"result", result}});
+}
+
+void replyError(const QJsonValue& id, int code, const QString& message)
+{
+    writeMessage(QJsonObject{{"id", id}, {"error", QJsonObject{{"code", code}, {"message", message}}}});
+}
+
+void cancelHover(const QJsonValue& id)
+{
+    for (int i = 0; i < g_heldHovers.size(); ++i) {
+        if (g_heldHovers[i] == id) {
+            g_heldHovers.removeAt(i);
+            replyError(id, kRequestCancelled, "Request cancelled");
+            return;
+        }
+    }
+}
+
+// false - пора завершаться
+bool handle(const QJsonObject& message)
+{
+    const QJsonValue id = message.value("id");
+    const QString method = message.value("method").toString();
+    const QJsonObject params = message.value("params").toObject();
+
+    // Ответ клиента на наш запрос
+    if (method.isEmpty()) {
+        QJsonObject entry{{"response", id}};
+        if (message.contains("error")) {
+            entry.insert("error", message.value("error").toObject().value("code"));
+        } else {
+            entry.insert("result", message.value("result"));
+        }
+        g_log.append(entry);
+        return true;
+    }
+
+    QJsonObject entry{{"method", method}, {"id", id}};
+    if (id.isUndefined()) {
+        entry.insert("params", params);
+    }
+    g_log.append(entry);
+
+    if (method == "initialize") {
+        writeMessage(QJsonObject{{"id", kConfigurationRequestId}, {"method", "workspace/configuration"},
+                                 {"params", QJsonObject{{"items", QJsonArray{}}}}});
+        writeMessage(QJsonObject{{"id", kUnknownRequestId}, {"method", "mock/unknownRequest"}});
+        reply(id, QJsonObject{{"capabilities", QJsonObject{{"textDocumentSync", 2}}}});
+    } else if (method == "textDocument/hover") {
+        g_heldHovers.append(id);
+    } else if (method == "textDocument/completion") {
+        reply(id, QJsonArray{QJsonObject{{"label", "insert"}}});
+    } else if (method == "textDocument/semanticTokens/range") {
+        reply(id, QJsonObject{{"data", QJsonArray{0, 0, 3, 0, 0}}});
+    } else if (method == "$/cancelRequest") {
+        cancelHover(params.value("id"));
+    } else if (method == "mock/cancelHovers") {
+        while (!g_heldHovers.isEmpty()) {
+            cancelHover(g_heldHovers.first());
+        }
+    } else if (method == "mock/releaseHovers") {
+        for (const QJsonValue& hoverId : std::as_const(g_heldHovers)) {
+            reply(hoverId, QJsonObject{{"contents", "int value"}});
+        }
+        g_heldHovers.clear();
+    } else if (method == "mock/log") {
+        reply(id, g_log);
+    } else if (method == "shutdown") {
+        reply(id, QJsonValue());
+    } else if (method == "exit") {
+        return false;
+    } else if (!id.isUndefined()) {
+        replyError(id, kMethodNotFound, "Method not found");
+    }
+
+    // Запросы mock/* отвечают после hover, отпущенных ими
+    if (method.startsWith("mock/") && method != "mock/log" && !id.isUndefined()) {
+        reply(id, QJsonValue());
+    }
+    return true;
+}
+}
+
+int main()
+{
+#if defined(Q_OS_WIN)
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    QByteArray body;
+    while (readFrame(&body)) {
+        if (!handle(QJsonDocument::fromJson(body).object())) break;
+    }
+    return 0;
+}